@@ -83,6 +83,8 @@ public:
 	virtual void			LoadMap( const idMapFile *mapFile ) = 0;
 	// Frees all the collision models.
 	virtual void			FreeMap( void ) = 0;
+	// Frees the map and the trace state of all threads, no traces may run afterwards.
+	virtual void			Shutdown( void ) = 0;
 
 	// Gets the clip handle for a model.
 	virtual cmHandle_t		LoadModel( const char *modelName, const bool precache ) = 0;
@@ -136,4 +138,7 @@ public:
 
 extern idCollisionModelManager *		collisionModelManager;
 
+// runs random traces serially and on the job pool and compares the results
+void CM_TestThreads_f( const class idCmdArgs &args );
+
 #endif /* !__COLLISIONMODELMANAGER_H__ */
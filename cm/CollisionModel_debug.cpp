@@ -316,7 +316,10 @@ void idCollisionModelManagerLocal::DrawModel( cmHandle_t handle, const idVec3 &m
 		cm_drawColor.ClearModified();
 	}
 
-	model = models[ handle ];
+	model = ModelForHandle( handle );
+	if ( !model ) {
+		return;
+	}
 	viewPos = (viewOrigin - modelOrigin) * modelAxis.Transpose();
 	checkCount++;
 	DrawNodePolygons( model, model->node, modelOrigin, modelAxis, viewPos, radius );
@@ -479,3 +482,207 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 	Mem_Free( testend );
 	testend = NULL;
 }
+
+/*
+===============================================================================
+
+Multithreaded trace test
+
+===============================================================================
+*/
+
+#define CM_TEST_MAX_CONTACTS	8
+
+typedef enum {
+	CM_TEST_POINT,
+	CM_TEST_BOX,
+	CM_TEST_ROTATION,
+	CM_TEST_CONTENTS,
+	CM_TEST_CONTACTS,
+	CM_TEST_TRM,
+	CM_TEST_NUM_TYPES
+} cmTestType_t;
+
+typedef struct {
+	cmTestType_t	type;
+	idVec3			start;
+	idVec3			end;
+	idMat3			axis;
+} cmTestQuery_t;
+
+typedef struct {
+	trace_t			trace;
+	int				contents;
+	int				numContacts;
+	contactInfo_t	contacts[CM_TEST_MAX_CONTACTS];
+} cmTestResult_t;
+
+typedef struct {
+	const cmTestQuery_t *	queries;
+	cmTestResult_t *		results;
+	idTraceModel			box;
+	idTraceModel			smallBox;
+} cmTestJob_t;
+
+/*
+================
+CM_TestQuery
+================
+*/
+static void CM_TestQuery( void *data, int index ) {
+	cmTestJob_t *job = (cmTestJob_t *)data;
+	const cmTestQuery_t &q = job->queries[index];
+	cmTestResult_t &r = job->results[index];
+	const int mask = CONTENTS_SOLID | CONTENTS_PLAYERCLIP;
+
+	memset( &r, 0, sizeof( r ) );
+
+	switch( q.type ) {
+		case CM_TEST_POINT: {
+			collisionModelManager->Translation( &r.trace, q.start, q.end, NULL, mat3_identity, mask, 0, vec3_origin, mat3_identity );
+			break;
+		}
+		case CM_TEST_BOX: {
+			collisionModelManager->Translation( &r.trace, q.start, q.end, &job->box, q.axis, mask, 0, vec3_origin, mat3_identity );
+			break;
+		}
+		case CM_TEST_ROTATION: {
+			idRotation rotation( q.end, q.axis[2], 45.0f );
+			collisionModelManager->Rotation( &r.trace, q.start, rotation, &job->box, q.axis, mask, 0, vec3_origin, mat3_identity );
+			break;
+		}
+		case CM_TEST_CONTENTS: {
+			r.contents = collisionModelManager->Contents( q.start, &job->box, q.axis, -1, 0, vec3_origin, mat3_identity );
+			break;
+		}
+		case CM_TEST_CONTACTS: {
+			idVec6 dir( 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f );
+			r.numContacts = collisionModelManager->Contacts( r.contacts, CM_TEST_MAX_CONTACTS, q.start, dir, 64.0f, &job->box, q.axis, mask, 0, vec3_origin, mat3_identity );
+			break;
+		}
+		case CM_TEST_TRM: {
+			// the trace model handle refers to the model set up by this thread
+			cmHandle_t handle = collisionModelManager->SetupTrmModel( job->box, NULL );
+			collisionModelManager->Translation( &r.trace, q.start, q.end, &job->smallBox, mat3_identity, mask, handle, q.end, q.axis );
+			break;
+		}
+		default: {
+			break;
+		}
+	}
+}
+
+/*
+================
+CM_CompareTestResults
+================
+*/
+static bool CM_CompareTestResults( const cmTestResult_t &a, const cmTestResult_t &b ) {
+	int i;
+
+	if ( a.trace.fraction != b.trace.fraction || a.trace.endpos != b.trace.endpos ) {
+		return false;
+	}
+	// the contact is only filled in on collision
+	if ( a.trace.fraction < 1.0f ) {
+		if ( a.trace.c.normal != b.trace.c.normal || a.trace.c.point != b.trace.c.point || a.trace.c.contents != b.trace.c.contents ) {
+			return false;
+		}
+	}
+	if ( a.contents != b.contents || a.numContacts != b.numContacts ) {
+		return false;
+	}
+	for ( i = 0; i < a.numContacts; i++ ) {
+		if ( a.contacts[i].point != b.contacts[i].point || a.contacts[i].normal != b.contacts[i].normal ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+================
+CM_TestThreads_f
+
+Runs random collision queries against the world model serially and on the job pool
+and reports any result that differs between the two.
+================
+*/
+void CM_TestThreads_f( const idCmdArgs &args ) {
+	int i, j, numQueries, numPasses, numErrors, serialTime, parallelTime;
+	int errorsByType[CM_TEST_NUM_TYPES];
+	idBounds bounds;
+	cmTestJob_t job;
+	cmTestQuery_t *queries;
+	cmTestResult_t *serialResults, *parallelResults;
+	idRandom random( 0 );
+	idTimer timer;
+
+	if ( !collisionModelManager->GetModelBounds( 0, bounds ) ) {
+		common->Printf( "testCollisionThreads: no map loaded\n" );
+		return;
+	}
+
+	numQueries = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 10000;
+	numPasses = ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 4;
+	numQueries = idMath::ClampInt( 1, 1000000, numQueries );
+	numPasses = idMath::ClampInt( 1, 100, numPasses );
+
+	queries = (cmTestQuery_t *) Mem_Alloc( numQueries * sizeof( cmTestQuery_t ) );
+	serialResults = (cmTestResult_t *) Mem_Alloc( numQueries * sizeof( cmTestResult_t ) );
+	parallelResults = (cmTestResult_t *) Mem_Alloc( numQueries * sizeof( cmTestResult_t ) );
+
+	for ( i = 0; i < numQueries; i++ ) {
+		cmTestQuery_t &q = queries[i];
+		q.type = (cmTestType_t)( i % CM_TEST_NUM_TYPES );
+		for ( j = 0; j < 3; j++ ) {
+			q.start[j] = bounds[0][j] + random.RandomFloat() * ( bounds[1][j] - bounds[0][j] );
+			q.end[j] = q.start[j] + random.CRandomFloat() * 512.0f;
+		}
+		idAngles angles( random.CRandomFloat() * 180.0f, random.CRandomFloat() * 180.0f, random.CRandomFloat() * 180.0f );
+		q.axis = angles.ToMat3();
+	}
+
+	job.queries = queries;
+	job.box.SetupBox( idBounds( idVec3( -16.0f, -16.0f, 0.0f ), idVec3( 16.0f, 16.0f, 64.0f ) ) );
+	job.smallBox.SetupBox( 8.0f );
+
+	// reference results
+	job.results = serialResults;
+	timer.Start();
+	for ( i = 0; i < numQueries; i++ ) {
+		CM_TestQuery( &job, i );
+	}
+	timer.Stop();
+	serialTime = timer.Milliseconds();
+
+	numErrors = 0;
+	memset( errorsByType, 0, sizeof( errorsByType ) );
+	job.results = parallelResults;
+	timer.Clear();
+	for ( j = 0; j < numPasses; j++ ) {
+		timer.Start();
+		jobPool.ParallelFor( CM_TestQuery, &job, numQueries );
+		timer.Stop();
+		for ( i = 0; i < numQueries; i++ ) {
+			if ( !CM_CompareTestResults( serialResults[i], parallelResults[i] ) ) {
+				errorsByType[queries[i].type]++;
+				numErrors++;
+			}
+		}
+	}
+	parallelTime = timer.Milliseconds() / numPasses;
+
+	common->Printf( "%d queries, serial %d msec, %d threads %d msec\n", numQueries, serialTime, jobPool.GetNumThreads() + 1, parallelTime );
+	if ( numErrors ) {
+		common->Warning( "testCollisionThreads: %d of %d results differ from the serial run (point %d, box %d, rotation %d, contents %d, contacts %d, trm %d)",
+							numErrors, numQueries * numPasses, errorsByType[CM_TEST_POINT], errorsByType[CM_TEST_BOX], errorsByType[CM_TEST_ROTATION],
+							errorsByType[CM_TEST_CONTENTS], errorsByType[CM_TEST_CONTACTS], errorsByType[CM_TEST_TRM] );
+	} else {
+		common->Printf( "all results match\n" );
+	}
+
+	Mem_Free( queries );
+	Mem_Free( serialResults );
+	Mem_Free( parallelResults );
+}
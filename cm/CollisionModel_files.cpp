@@ -36,6 +36,10 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #define CM_FILEID			"CM"
 #define CM_FILEVERSION		"1.00"
 
+#define CMB_FILE_EXT		"cmb"
+#define CMB_FILEID			"CMB"
+#define CMB_FILEVERSION		1
+
 
 /*
 ===============================================================================
@@ -219,6 +223,183 @@ void idCollisionModelManagerLocal::WriteCollisionModel( idFile *fp, cm_model_t *
 	fp->WriteFloatString( "}\n" );
 }
 
+/*
+================
+CM_PointerHashKey
+================
+*/
+static ID_INLINE int CM_PointerHashKey( const void *ptr ) {
+	return (int) ( ( (size_t) ptr ) >> 4 );
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModel
+
+  The binary model stores the polygons and brushes once and the nodes in
+  preorder with the indexes of the polygons and brushes they reference, so
+  loading only has to relocate the indexes instead of filtering everything
+  into the tree again.
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModel( idFile *fp, cm_model_t *model ) {
+	int i, j, numPolygonEdges, numBrushPlanes, numPolygonRefs, numBrushRefs;
+	idList<cm_node_t *> nodes, stack;
+	idList<cm_polygon_t *> polygons;
+	idList<cm_brush_t *> brushes;
+	idList<const idMaterial *> materials;
+	idHashIndex polygonHash, brushHash;
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+	cm_node_t *node;
+	cm_polygon_t *p;
+	cm_brush_t *b;
+
+	// gather the nodes in preorder and number the polygons and brushes in the order they are first referenced
+	numPolygonEdges = numBrushPlanes = numPolygonRefs = numBrushRefs = 0;
+	stack.Append( model->node );
+	while( stack.Num() ) {
+		node = stack[ stack.Num() - 1 ];
+		stack.RemoveIndex( stack.Num() - 1 );
+		nodes.Append( node );
+		for ( pref = node->polygons; pref; pref = pref->next ) {
+			p = pref->p;
+			numPolygonRefs++;
+			for ( j = polygonHash.First( CM_PointerHashKey( p ) ); j != -1 && polygons[j] != p; j = polygonHash.Next( j ) ) {
+			}
+			if ( j == -1 ) {
+				polygonHash.Add( CM_PointerHashKey( p ), polygons.Append( p ) );
+				numPolygonEdges += p->numEdges;
+				materials.AddUnique( p->material );
+			}
+		}
+		for ( bref = node->brushes; bref; bref = bref->next ) {
+			b = bref->b;
+			numBrushRefs++;
+			for ( j = brushHash.First( CM_PointerHashKey( b ) ); j != -1 && brushes[j] != b; j = brushHash.Next( j ) ) {
+			}
+			if ( j == -1 ) {
+				brushHash.Add( CM_PointerHashKey( b ), brushes.Append( b ) );
+				numBrushPlanes += b->numPlanes;
+			}
+		}
+		if ( node->planeType != -1 ) {
+			stack.Append( node->children[1] );
+			stack.Append( node->children[0] );
+		}
+	}
+
+	fp->WriteString( model->name );
+	// vertices
+	fp->WriteInt( model->numVertices );
+	for ( i = 0; i < model->numVertices; i++ ) {
+		fp->WriteVec3( model->vertices[i].p );
+	}
+	// edges
+	fp->WriteInt( model->numEdges );
+	for ( i = 0; i < model->numEdges; i++ ) {
+		fp->WriteInt( model->edges[i].vertexNum[0] );
+		fp->WriteInt( model->edges[i].vertexNum[1] );
+		fp->WriteUnsignedShort( model->edges[i].internal );
+		fp->WriteUnsignedShort( model->edges[i].numUsers );
+	}
+	// materials
+	fp->WriteInt( materials.Num() );
+	for ( i = 0; i < materials.Num(); i++ ) {
+		fp->WriteString( materials[i]->GetName() );
+	}
+	// polygons
+	fp->WriteInt( polygons.Num() );
+	fp->WriteInt( numPolygonEdges );
+	for ( i = 0; i < polygons.Num(); i++ ) {
+		p = polygons[i];
+		fp->WriteInt( p->numEdges );
+		for ( j = 0; j < p->numEdges; j++ ) {
+			fp->WriteInt( p->edges[j] );
+		}
+		fp->WriteVec3( p->plane.Normal() );
+		fp->WriteFloat( p->plane.Dist() );
+		fp->WriteVec3( p->bounds[0] );
+		fp->WriteVec3( p->bounds[1] );
+		fp->WriteInt( materials.FindIndex( p->material ) );
+	}
+	// brushes
+	fp->WriteInt( brushes.Num() );
+	fp->WriteInt( numBrushPlanes );
+	for ( i = 0; i < brushes.Num(); i++ ) {
+		b = brushes[i];
+		fp->WriteInt( b->numPlanes );
+		for ( j = 0; j < b->numPlanes; j++ ) {
+			fp->WriteVec3( b->planes[j].Normal() );
+			fp->WriteFloat( b->planes[j].Dist() );
+		}
+		fp->WriteVec3( b->bounds[0] );
+		fp->WriteVec3( b->bounds[1] );
+		fp->WriteInt( b->contents );
+	}
+	// nodes with their polygon and brush references
+	fp->WriteInt( nodes.Num() );
+	fp->WriteInt( numPolygonRefs );
+	fp->WriteInt( numBrushRefs );
+	for ( i = 0; i < nodes.Num(); i++ ) {
+		node = nodes[i];
+		fp->WriteInt( node->planeType );
+		fp->WriteFloat( node->planeDist );
+		for ( j = 0, pref = node->polygons; pref; pref = pref->next ) {
+			j++;
+		}
+		fp->WriteInt( j );
+		for ( pref = node->polygons; pref; pref = pref->next ) {
+			for ( j = polygonHash.First( CM_PointerHashKey( pref->p ) ); polygons[j] != pref->p; j = polygonHash.Next( j ) ) {
+			}
+			fp->WriteInt( j );
+		}
+		for ( j = 0, bref = node->brushes; bref; bref = bref->next ) {
+			j++;
+		}
+		fp->WriteInt( j );
+		for ( bref = node->brushes; bref; bref = bref->next ) {
+			for ( j = brushHash.First( CM_PointerHashKey( bref->b ) ); brushes[j] != bref->b; j = brushHash.Next( j ) ) {
+			}
+			fp->WriteInt( j );
+		}
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC ) {
+	int i;
+	idFile *fp;
+	idStr name;
+
+	name = filename;
+	name.SetFileExtension( CMB_FILE_EXT );
+
+	common->Printf( "writing %s\n", name.c_str() );
+	fp = fileSystem->OpenFileWrite( name, "fs_devpath", "" );
+	if ( !fp ) {
+		common->Warning( "idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile: Error opening file %s", name.c_str() );
+		return;
+	}
+
+	// write file id, version and the map file crc
+	fp->Write( CMB_FILEID, 4 );
+	fp->WriteInt( CMB_FILEVERSION );
+	fp->WriteUnsignedInt( mapFileCRC );
+
+	// write the collision models
+	fp->WriteInt( lastModel - firstModel );
+	for ( i = firstModel; i < lastModel; i++ ) {
+		WriteBinaryCollisionModel( fp, models[ i ] );
+	}
+
+	fileSystem->CloseFile( fp );
+}
+
 /*
 ================
 idCollisionModelManagerLocal::WriteCollisionModelsToFile
@@ -250,6 +431,9 @@ void idCollisionModelManagerLocal::WriteCollisionModelsToFile( const char *filen
 	}
 
 	fileSystem->CloseFile( fp );
+
+	// the binary file is loaded instead of the text file as long as its map file crc matches
+	WriteBinaryCollisionModelsToFile( filename, firstModel, lastModel, mapFileCRC );
 }
 
 /*
@@ -320,9 +504,6 @@ void idCollisionModelManagerLocal::ParseVertices( idLexer *src, cm_model_t *mode
 	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
 	for ( i = 0; i < model->numVertices; i++ ) {
 		src->Parse1DMatrix( 3, model->vertices[i].p.ToFloatPtr() );
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
-		model->vertices[i].checkcount = 0;
 	}
 	src->ExpectTokenString( "}" );
 }
@@ -344,8 +525,6 @@ void idCollisionModelManagerLocal::ParseEdges( idLexer *src, cm_model_t *model )
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString( ")" );
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
@@ -467,6 +646,29 @@ void idCollisionModelManagerLocal::ParseBrushes( idLexer *src, cm_model_t *model
 	}
 }
 
+/*
+================
+idCollisionModelManagerLocal::FinishLoadedModel
+================
+*/
+void idCollisionModelManagerLocal::FinishLoadedModel( cm_model_t *model ) {
+	// calculate edge normals
+	checkCount++;
+	CalculateEdgeNormals( model, model->node );
+	// get model bounds from brush and polygon bounds
+	CM_GetNodeBounds( &model->bounds, model->node );
+	// get model contents
+	model->contents = CM_GetNodeContents( model->node );
+	// total memory used by this model
+	model->usedMemory = model->numVertices * sizeof(cm_vertex_t) +
+						model->numEdges * sizeof(cm_edge_t) +
+						model->polygonMemory +
+						model->brushMemory +
+						model->numNodes * sizeof(cm_node_t) +
+						model->numPolygonRefs * sizeof(cm_polygonRef_t) +
+						model->numBrushRefs * sizeof(cm_brushRef_t);
+}
+
 /*
 ================
 idCollisionModelManagerLocal::ParseCollisionModel
@@ -520,21 +722,325 @@ bool idCollisionModelManagerLocal::ParseCollisionModel( idLexer *src ) {
 
 		src->Error( "ParseCollisionModel: bad token \"%s\"", token.c_str() );
 	}
-	// calculate edge normals
-	checkCount++;
-	CalculateEdgeNormals( model, model->node );
-	// get model bounds from brush and polygon bounds
-	CM_GetNodeBounds( &model->bounds, model->node );
-	// get model contents
-	model->contents = CM_GetNodeContents( model->node );
-	// total memory used by this model
-	model->usedMemory = model->numVertices * sizeof(cm_vertex_t) +
-						model->numEdges * sizeof(cm_edge_t) +
-						model->polygonMemory +
-						model->brushMemory +
-						model->numNodes * sizeof(cm_node_t) +
-						model->numPolygonRefs * sizeof(cm_polygonRef_t) +
-						model->numBrushRefs * sizeof(cm_brushRef_t);
+	FinishLoadedModel( model );
+
+	return true;
+}
+
+/*
+================
+CM_ReadBinaryCount
+
+  Reads a count and makes sure the file is large enough to hold that many
+  elements of the given minimum size, so a damaged file can't cause huge
+  allocations.
+================
+*/
+static bool CM_ReadBinaryCount( idFile *fp, int &count, int minElementSize ) {
+	if ( fp->ReadInt( count ) != sizeof( count ) ) {
+		return false;
+	}
+	if ( count < 0 || (long long) count * minElementSize > fp->Length() - fp->Tell() ) {
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+CM_ReadBinaryString
+================
+*/
+static bool CM_ReadBinaryString( idFile *fp, idStr &string ) {
+	int len;
+
+	if ( !CM_ReadBinaryCount( fp, len, 1 ) ) {
+		return false;
+	}
+	string.Fill( ' ', len );
+	return ( fp->Read( &string[0], len ) == len );
+}
+
+/*
+================
+idCollisionModelManagerLocal::ReadBinaryCollisionModel
+================
+*/
+bool idCollisionModelManagerLocal::ReadBinaryCollisionModel( idFile *fp, cm_model_t *model ) {
+	int i, j, numMaterials, numPolygonEdges, numBrushPlanes, numPolygonRefs, numBrushRefs, totalPolygonRefs, totalBrushRefs, num, index;
+	idList<const idMaterial *> materials;
+	idList<cm_polygon_t *> polygons;
+	idList<cm_brush_t *> brushes;
+	idList<cm_node_t *> stack;
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+	cm_node_t *node, *parent;
+	cm_polygon_t *p;
+	cm_brush_t *b;
+	idVec3 normal;
+	float dist;
+	idStr str;
+
+	if ( !CM_ReadBinaryString( fp, str ) ) {
+		return false;
+	}
+	model->name = str;
+
+	// vertices
+	if ( !CM_ReadBinaryCount( fp, model->numVertices, 12 ) ) {
+		return false;
+	}
+	model->maxVertices = model->numVertices;
+	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
+	for ( i = 0; i < model->numVertices; i++ ) {
+		fp->ReadVec3( model->vertices[i].p );
+	}
+
+	// edges
+	if ( !CM_ReadBinaryCount( fp, model->numEdges, 12 ) ) {
+		return false;
+	}
+	model->maxEdges = model->numEdges;
+	model->edges = (cm_edge_t *) Mem_Alloc( model->maxEdges * sizeof( cm_edge_t ) );
+	for ( i = 0; i < model->numEdges; i++ ) {
+		cm_edge_t &edge = model->edges[i];
+		fp->ReadInt( edge.vertexNum[0] );
+		fp->ReadInt( edge.vertexNum[1] );
+		fp->ReadUnsignedShort( edge.internal );
+		fp->ReadUnsignedShort( edge.numUsers );
+		if ( edge.vertexNum[0] < 0 || edge.vertexNum[0] >= model->numVertices || edge.vertexNum[1] < 0 || edge.vertexNum[1] >= model->numVertices ) {
+			return false;
+		}
+		edge.normal = vec3_origin;
+		edge.checkcount = 0;
+		model->numInternalEdges += edge.internal;
+	}
+
+	// materials
+	if ( !CM_ReadBinaryCount( fp, numMaterials, 4 ) ) {
+		return false;
+	}
+	materials.SetNum( numMaterials );
+	for ( i = 0; i < numMaterials; i++ ) {
+		if ( !CM_ReadBinaryString( fp, str ) ) {
+			return false;
+		}
+		materials[i] = declManager->FindMaterial( str );
+	}
+
+	// polygons, all allocated from a single block
+	if ( !CM_ReadBinaryCount( fp, num, 48 ) || !CM_ReadBinaryCount( fp, numPolygonEdges, 4 ) || numPolygonEdges < num ) {
+		return false;
+	}
+	polygons.SetNum( num );
+	if ( num ) {
+		i = num * sizeof( cm_polygon_t ) + ( numPolygonEdges - num ) * sizeof( p->edges[0] );
+		model->polygonBlock = (cm_polygonBlock_t *) Mem_Alloc( sizeof( cm_polygonBlock_t ) + i );
+		model->polygonBlock->bytesRemaining = i;
+		model->polygonBlock->next = ( (byte *) model->polygonBlock ) + sizeof( cm_polygonBlock_t );
+	}
+	for ( i = 0; i < polygons.Num(); i++ ) {
+		if ( !CM_ReadBinaryCount( fp, num, 4 ) || num < 1 || num > numPolygonEdges ) {
+			return false;
+		}
+		numPolygonEdges -= num;
+		p = AllocPolygon( model, num );
+		p->numEdges = num;
+		for ( j = 0; j < p->numEdges; j++ ) {
+			fp->ReadInt( p->edges[j] );
+			if ( abs( p->edges[j] ) >= model->numEdges ) {
+				return false;
+			}
+		}
+		fp->ReadVec3( normal );
+		fp->ReadFloat( dist );
+		p->plane.SetNormal( normal );
+		p->plane.SetDist( dist );
+		fp->ReadVec3( p->bounds[0] );
+		fp->ReadVec3( p->bounds[1] );
+		fp->ReadInt( index );
+		if ( index < 0 || index >= materials.Num() ) {
+			return false;
+		}
+		p->material = materials[index];
+		p->contents = p->material->GetContentFlags();
+		p->checkcount = 0;
+		polygons[i] = p;
+	}
+
+	// brushes, all allocated from a single block
+	if ( !CM_ReadBinaryCount( fp, num, 32 ) || !CM_ReadBinaryCount( fp, numBrushPlanes, 16 ) || numBrushPlanes < num ) {
+		return false;
+	}
+	brushes.SetNum( num );
+	if ( num ) {
+		i = num * sizeof( cm_brush_t ) + ( numBrushPlanes - num ) * sizeof( b->planes[0] );
+		model->brushBlock = (cm_brushBlock_t *) Mem_Alloc( sizeof( cm_brushBlock_t ) + i );
+		model->brushBlock->bytesRemaining = i;
+		model->brushBlock->next = ( (byte *) model->brushBlock ) + sizeof( cm_brushBlock_t );
+	}
+	for ( i = 0; i < brushes.Num(); i++ ) {
+		if ( !CM_ReadBinaryCount( fp, num, 16 ) || num < 1 || num > numBrushPlanes ) {
+			return false;
+		}
+		numBrushPlanes -= num;
+		b = AllocBrush( model, num );
+		b->numPlanes = num;
+		for ( j = 0; j < b->numPlanes; j++ ) {
+			fp->ReadVec3( normal );
+			fp->ReadFloat( dist );
+			b->planes[j].SetNormal( normal );
+			b->planes[j].SetDist( dist );
+		}
+		fp->ReadVec3( b->bounds[0] );
+		fp->ReadVec3( b->bounds[1] );
+		fp->ReadInt( b->contents );
+		b->checkcount = 0;
+		b->primitiveNum = 0;
+		brushes[i] = b;
+	}
+
+	// nodes in preorder, all allocated from a single block together with their references
+	if ( !CM_ReadBinaryCount( fp, num, 16 ) || num < 1 || !CM_ReadBinaryCount( fp, numPolygonRefs, 4 ) || !CM_ReadBinaryCount( fp, numBrushRefs, 4 ) ) {
+		return false;
+	}
+	totalPolygonRefs = numPolygonRefs;
+	totalBrushRefs = numBrushRefs;
+	parent = NULL;
+	for ( i = 0; i < num; i++ ) {
+		model->numNodes++;
+		node = AllocNode( model, num );
+		node->polygons = NULL;
+		node->brushes = NULL;
+		node->parent = parent;
+		fp->ReadInt( node->planeType );
+		fp->ReadFloat( node->planeDist );
+		if ( node->planeType < -1 || node->planeType > 2 ) {
+			return false;
+		}
+		// the references are written in list order, add them in reverse to restore that order
+		if ( !CM_ReadBinaryCount( fp, j, 4 ) || j > numPolygonRefs ) {
+			return false;
+		}
+		numPolygonRefs -= j;
+		for ( ; j > 0; j-- ) {
+			fp->ReadInt( index );
+			if ( index < 0 || index >= polygons.Num() ) {
+				return false;
+			}
+			pref = AllocPolygonReference( model, totalPolygonRefs );
+			pref->p = polygons[index];
+			pref->next = node->polygons;
+			node->polygons = pref;
+			model->numPolygonRefs++;
+		}
+		if ( !CM_ReadBinaryCount( fp, j, 4 ) || j > numBrushRefs ) {
+			return false;
+		}
+		numBrushRefs -= j;
+		for ( ; j > 0; j-- ) {
+			fp->ReadInt( index );
+			if ( index < 0 || index >= brushes.Num() ) {
+				return false;
+			}
+			bref = AllocBrushReference( model, totalBrushRefs );
+			bref->b = brushes[index];
+			bref->next = node->brushes;
+			node->brushes = bref;
+			model->numBrushRefs++;
+		}
+		// link the node into the tree
+		if ( !parent ) {
+			if ( model->node ) {
+				return false;
+			}
+			model->node = node;
+		} else if ( !parent->children[0] ) {
+			parent->children[0] = node;
+		} else {
+			parent->children[1] = node;
+			stack.RemoveIndex( stack.Num() - 1 );
+		}
+		if ( node->planeType != -1 ) {
+			stack.Append( node );
+		}
+		parent = stack.Num() ? stack[ stack.Num() - 1 ] : NULL;
+	}
+	if ( stack.Num() ) {
+		return false;
+	}
+
+	FinishLoadedModel( model );
+
+	return true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::LoadBinaryCollisionModelFile
+================
+*/
+bool idCollisionModelManagerLocal::LoadBinaryCollisionModelFile( const char *name, const unsigned int mapFileCRC ) {
+	idStr fileName;
+	idFile_Memory *fp;
+	void *buffer;
+	char id[4];
+	int i, length, version, count, firstModel;
+	unsigned int crc;
+	cm_model_t *model;
+
+	fileName = name;
+	fileName.SetFileExtension( CMB_FILE_EXT );
+	length = fileSystem->ReadFile( fileName, &buffer );
+	if ( length <= 0 ) {
+		return false;
+	}
+
+	fp = new idFile_Memory( fileName, (const char *) buffer, length );
+	fp->Read( id, sizeof( id ) );
+	fp->ReadInt( version );
+	fp->ReadUnsignedInt( crc );
+	if ( memcmp( id, CMB_FILEID, sizeof( id ) ) != 0 || version != CMB_FILEVERSION ) {
+		common->Warning( "%s is not a version %d CMB file.", fileName.c_str(), CMB_FILEVERSION );
+		delete fp;
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+	if ( mapFileCRC && crc != mapFileCRC ) {
+		common->Printf( "%s is out of date\n", fileName.c_str() );
+		delete fp;
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	firstModel = numModels;
+	if ( !CM_ReadBinaryCount( fp, count, 4 ) || numModels + count > MAX_SUBMODELS ) {
+		count = -1;
+	}
+	for ( i = 0; i < count; i++ ) {
+		model = AllocModel();
+		models[numModels] = model;
+		numModels++;
+		if ( !ReadBinaryCollisionModel( fp, model ) ) {
+			// the tree may only be partially linked, all polygons and brushes are in the model blocks
+			model->node = NULL;
+			count = -1;
+			break;
+		}
+	}
+
+	delete fp;
+	fileSystem->FreeFile( buffer );
+
+	if ( count == -1 ) {
+		common->Warning( "%s is damaged, falling back to the text file", fileName.c_str() );
+		for ( i = firstModel; i < numModels; i++ ) {
+			FreeModel( models[i] );
+			models[i] = NULL;
+		}
+		numModels = firstModel;
+		return false;
+	}
 
 	return true;
 }
@@ -542,9 +1048,78 @@ bool idCollisionModelManagerLocal::ParseCollisionModel( idLexer *src ) {
 /*
 ================
 idCollisionModelManagerLocal::LoadCollisionModelFile
+
+  Prefers the binary file. When only the text file is up to date for a map,
+  the binary file is written after parsing it so the next load is fast.
 ================
 */
 bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, const unsigned int mapFileCRC ) {
+	int i, firstModel, numBinaryModels, mismatches;
+	idTimer binaryTimer, textTimer;
+	bool textLoaded;
+
+	firstModel = numModels;
+
+	binaryTimer.Start();
+	if ( LoadBinaryCollisionModelFile( name, mapFileCRC ) ) {
+		binaryTimer.Stop();
+
+		if ( com_developer.GetBool() ) {
+			// parse the text file as well to compare the load times and the results
+			numBinaryModels = numModels;
+			if ( numBinaryModels + ( numBinaryModels - firstModel ) > MAX_SUBMODELS ) {
+				common->Printf( "%s: %.1f msec to load binary collision models\n", name, binaryTimer.Milliseconds() );
+				return true;
+			}
+			textTimer.Start();
+			textLoaded = LoadTextCollisionModelFile( name, mapFileCRC );
+			textTimer.Stop();
+			mismatches = 0;
+			if ( textLoaded ) {
+				if ( numModels - numBinaryModels != numBinaryModels - firstModel ) {
+					mismatches++;
+				} else {
+					for ( i = firstModel; i < numBinaryModels; i++ ) {
+						const cm_model_t *b = models[i];
+						const cm_model_t *t = models[i + numBinaryModels - firstModel];
+						if ( b->numVertices != t->numVertices || b->numEdges != t->numEdges || b->numNodes != t->numNodes ||
+								b->numPolygons != t->numPolygons || b->numBrushes != t->numBrushes ||
+								b->numPolygonRefs != t->numPolygonRefs || b->numBrushRefs != t->numBrushRefs ||
+								b->contents != t->contents || !b->bounds.Compare( t->bounds, 0.01f ) ) {
+							common->Printf( "%s: binary collision model %s differs from the text version\n", name, b->name.c_str() );
+							mismatches++;
+						}
+					}
+				}
+				common->Printf( "%s: %.1f msec to load binary, %.1f msec to parse text collision models, %d mismatches\n",
+									name, binaryTimer.Milliseconds(), textTimer.Milliseconds(), mismatches );
+			}
+			for ( i = numBinaryModels; i < numModels; i++ ) {
+				FreeModel( models[i] );
+				models[i] = NULL;
+			}
+			numModels = numBinaryModels;
+		}
+		return true;
+	}
+
+	if ( !LoadTextCollisionModelFile( name, mapFileCRC ) ) {
+		return false;
+	}
+
+	if ( mapFileCRC ) {
+		WriteBinaryCollisionModelsToFile( name, firstModel, numModels, mapFileCRC );
+	}
+
+	return true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::LoadTextCollisionModelFile
+================
+*/
+bool idCollisionModelManagerLocal::LoadTextCollisionModelFile( const char *name, const unsigned int mapFileCRC ) {
 	idStr fileName;
 	idToken token;
 	idLexer *src;
@@ -599,7 +1174,7 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, con
 			continue;
 		}
 
-		src->Error( "idCollisionModelManagerLocal::LoadCollisionModelFile: bad token \"%s\"", token.c_str() );
+		src->Error( "idCollisionModelManagerLocal::LoadTextCollisionModelFile: bad token \"%s\"", token.c_str() );
 	}
 
 	delete src;
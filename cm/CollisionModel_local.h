@@ -71,17 +71,12 @@ Collision model
 
 typedef struct cm_vertex_s {
 	idVec3					p;					// vertex point
-	int						checkcount;			// for multi-check avoidance
-	unsigned long			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
 } cm_vertex_t;
 
 typedef struct cm_edge_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while loading and debug drawing
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	unsigned long			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
 } cm_edge_t;
@@ -93,7 +88,8 @@ typedef struct cm_polygonBlock_s {
 
 typedef struct cm_polygon_s {
 	idBounds				bounds;				// polygon bounds
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while loading and writing
+	int						index;				// unique index in the model for the per trace check counts
 	int						contents;			// contents behind polygon
 	const idMaterial *		material;			// material
 	idPlane					plane;				// polygon plane
@@ -117,7 +113,8 @@ typedef struct cm_brushBlock_s {
 } cm_brushBlock_t;
 
 typedef struct cm_brush_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while loading and writing
+	int						index;				// unique index in the model for the per trace check counts
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial *		material;			// material
@@ -169,6 +166,8 @@ typedef struct cm_model_s {
 	cm_brushRefBlock_t *	brushRefBlocks;		// list with blocks of brush references
 	cm_polygonBlock_t *		polygonBlock;		// memory block with all polygons
 	cm_brushBlock_t *		brushBlock;			// memory block with all brushes
+	int						numPolygonIndexes;	// number of polygon indexes handed out
+	int						numBrushIndexes;	// number of brush indexes handed out
 	// statistics
 	int						numPolygons;
 	int						polygonMemory;
@@ -222,6 +221,29 @@ typedef struct cm_trmPolygon_s {
 	idBounds rotationBounds;						// rotation bounds for this polygon
 } cm_trmPolygon_t;
 
+typedef struct cm_sideCache_s {
+	int checkcount;									// check count of the trace that last visited the vertex or edge
+	unsigned long side;								// each bit tells at which side of a trace model edge or vertex this one passes
+	unsigned long sideSet;							// each bit tells if sidedness for the trace model feature has been calculated yet
+} cm_sideCache_t;
+
+// Everything a trace writes to while walking a model. There is one context per thread
+// so traces against the same model can run concurrently.
+typedef struct cm_traceContext_s {
+	bool inUse;										// owned by a thread
+	idList<cm_sideCache_t> vertexCache;				// indexed like cm_model_t::vertices
+	idList<cm_sideCache_t> edgeCache;				// indexed like cm_model_t::edges
+	idList<int> polygonCheckCount;					// indexed by cm_polygon_t::index
+	idList<int> brushCheckCount;					// indexed by cm_brush_t::index
+	cm_model_t *trmModel;							// trace model converted by SetupTrmModel
+	cm_polygonRef_t *trmPolygons[MAX_TRACEMODEL_POLYS];
+	cm_brushRef_t *trmBrushes[1];
+	bool getContacts;								// set while retrieving contacts
+	contactInfo_t *contacts;
+	int maxContacts;
+	int numContacts;
+} cm_traceContext_t;
+
 typedef struct cm_traceWork_s {
 	int numVerts;
 	cm_trmVertex_t vertices[MAX_TRACEMODEL_VERTS];	// trm vertices
@@ -246,6 +268,12 @@ typedef struct cm_traceWork_s {
 	bool axisIntersectsTrm;							// true if the rotation axis intersects the trace model
 	bool getContacts;								// true if retrieving contacts
 	bool quickExit;									// set to quickly stop the collision detection calculations
+	int checkCount;									// for multi-check avoidance, unique per trace so traces can run concurrently
+	cm_traceContext_t *context;						// context of the thread running the trace
+	cm_sideCache_t *vertexCache;					// sidedness and check counts for the model vertices
+	cm_sideCache_t *edgeCache;						// sidedness and check counts for the model edges
+	int *polygonCheckCount;							// check counts for the model polygons
+	int *brushCheckCount;							// check counts for the model brushes
 
 	idVec3 origin;									// origin of rotation in model space
 	idVec3 axis;									// rotation axis in model space
@@ -287,6 +315,7 @@ public:
 	void			LoadMap( const idMapFile *mapFile );
 	// frees all the collision models
 	void			FreeMap( void );
+	void			Shutdown( void );
 
 	// get clip handle for model
 	cmHandle_t		LoadModel( const char *modelName, const bool precache );
@@ -389,10 +418,16 @@ private:			// CollisionMap_trace.cpp
 	void			TraceThroughAxialBSPTree_r( cm_traceWork_t *tw, cm_node_t *node, float p1f, float p2f, idVec3 &p1, idVec3 &p2);
 	void			TraceThroughModel( cm_traceWork_t *tw );
 	void			RecurseProcBSP_r( trace_t *results, int parentNodeNum, int nodeNum, float p1f, float p2f, const idVec3 &p1, const idVec3 &p2 );
+					// per thread trace state
+	cm_traceContext_t *GetTraceContext( void );
+	void			FreeTraceContexts( void );
+	void			DeleteTraceContexts( void );
+	cm_model_t *	ModelForHandle( cmHandle_t model );
+	void			SetupTraceWork( cm_traceWork_t *tw, cm_model_t *model );
 
 private:			// CollisionMap_load.cpp
 	void			Clear( void );
-	void			FreeTrmModelStructure( void );
+	void			FreeTrmModelStructure( cm_traceContext_t *context );
 					// model deallocation
 	void			RemovePolygonReferences_r( cm_node_t *node, cm_polygon_t *p );
 	void			RemoveBrushReferences_r( cm_node_t *node, cm_brush_t *b );
@@ -432,7 +467,7 @@ private:			// CollisionMap_load.cpp
 	cm_brush_t *	AllocBrush( cm_model_t *model, int numPlanes );
 	void			AddPolygonToNode( cm_model_t *model, cm_node_t *node, cm_polygon_t *p );
 	void			AddBrushToNode( cm_model_t *model, cm_node_t *node, cm_brush_t *b );
-	void			SetupTrmModelStructure( void );
+	void			SetupTrmModelStructure( cm_traceContext_t *context );
 	void			R_FilterPolygonIntoTree( cm_model_t *model, cm_node_t *node, cm_polygonRef_t *pref, cm_polygon_t *p );
 	void			R_FilterBrushIntoTree( cm_model_t *model, cm_node_t *node, cm_brushRef_t *pref, cm_brush_t *b );
 	cm_node_t *		R_CreateAxialBSPTree( cm_model_t *model, cm_node_t *node, const idBounds &bounds );
@@ -472,6 +507,8 @@ private:			// CollisionMap_files.cpp
 	void			WriteBrushes( idFile *fp, cm_node_t *node );
 	void			WriteCollisionModel( idFile *fp, cm_model_t *model );
 	void			WriteCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC );
+	void			WriteBinaryCollisionModel( idFile *fp, cm_model_t *model );
+	void			WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC );
 					// loading
 	cm_node_t *		ParseNodes( idLexer *src, cm_model_t *model, cm_node_t *parent );
 	void			ParseVertices( idLexer *src, cm_model_t *model );
@@ -479,6 +516,10 @@ private:			// CollisionMap_files.cpp
 	void			ParsePolygons( idLexer *src, cm_model_t *model );
 	void			ParseBrushes( idLexer *src, cm_model_t *model );
 	bool			ParseCollisionModel( idLexer *src );
+	void			FinishLoadedModel( cm_model_t *model );
+	bool			LoadTextCollisionModelFile( const char *name, const unsigned int mapFileCRC );
+	bool			ReadBinaryCollisionModel( idFile *fp, cm_model_t *model );
+	bool			LoadBinaryCollisionModelFile( const char *name, const unsigned int mapFileCRC );
 	bool			LoadCollisionModelFile( const char *name, const unsigned int mapFileCRC );
 
 private:			// CollisionMap_debug
@@ -495,23 +536,20 @@ private:			// collision map data
 	ID_TIME_T			mapFileTime;
 	int				loaded;
 					// for multi-check avoidance
-	int				checkCount;
+	volatile int	checkCount;
+					// returns a fresh check count for a trace, safe to call from any thread
+	int				NextCheckCount( void );
 					// models
 	int				maxModels;
 	int				numModels;
 	cm_model_t **	models;
-					// polygons and brush for trm model
-	cm_polygonRef_t*trmPolygons[MAX_TRACEMODEL_POLYS];
-	cm_brushRef_t *	trmBrushes[1];
+					// material for trm model polygons
 	const idMaterial *trmMaterial;
 					// for data pruning
 	int				numProcNodes;
 	cm_procNode_t *	procNodes;
-					// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t *	contacts;
-	int				maxContacts;
-	int				numContacts;
+					// trace contexts of all threads that ever traced, reused when a thread exits
+	idList<cm_traceContext_t *> traceContexts;
 };
 
 // for debugging
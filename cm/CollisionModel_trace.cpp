@@ -32,6 +32,177 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "CollisionModel_local.h"
 
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+static boost::mutex	traceContextMutex;
+
+/*
+================
+CM_ReleaseTraceContext
+
+Called when a thread that traced exits, the context is handed to the next new thread.
+================
+*/
+static void CM_ReleaseTraceContext( cm_traceContext_t *context ) {
+	boost::mutex::scoped_lock lock( traceContextMutex );
+	context->inUse = false;
+}
+
+static boost::thread_specific_ptr<cm_traceContext_t> threadTraceContext( CM_ReleaseTraceContext );
+
+/*
+================
+CM_GrowCache
+
+Makes sure the cache can be indexed with [0, num) and clears the new entries.
+================
+*/
+template< class type >
+static ID_INLINE type *CM_GrowCache( idList<type> &cache, int num ) {
+	int oldNum = cache.Num();
+	if ( oldNum < num ) {
+		cache.SetNum( num );
+		memset( cache.Ptr() + oldNum, 0, ( num - oldNum ) * sizeof( type ) );
+	}
+	return cache.Ptr();
+}
+
+/*
+================
+idCollisionModelManagerLocal::NextCheckCount
+
+Every trace stamps the polygons, edges and brushes it visited with its own
+check count in the context of its thread. A unique count per trace makes
+sure stamps left in a context by earlier traces never match.
+================
+*/
+int idCollisionModelManagerLocal::NextCheckCount( void ) {
+	return Sys_InterlockedIncrement( checkCount );
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetTraceContext
+
+Returns the trace context of the calling thread.
+================
+*/
+cm_traceContext_t *idCollisionModelManagerLocal::GetTraceContext( void ) {
+	cm_traceContext_t *context;
+	int i;
+
+	context = threadTraceContext.get();
+	if ( context ) {
+		return context;
+	}
+
+	boost::mutex::scoped_lock lock( traceContextMutex );
+	for ( i = 0; i < traceContexts.Num(); i++ ) {
+		if ( !traceContexts[i]->inUse ) {
+			context = traceContexts[i];
+			break;
+		}
+	}
+	if ( !context ) {
+		context = new cm_traceContext_t;
+		context->trmModel = NULL;
+		memset( context->trmPolygons, 0, sizeof( context->trmPolygons ) );
+		context->trmBrushes[0] = NULL;
+		context->getContacts = false;
+		context->contacts = NULL;
+		context->maxContacts = 0;
+		context->numContacts = 0;
+		traceContexts.Append( context );
+	}
+	context->inUse = true;
+	threadTraceContext.reset( context );
+	return context;
+}
+
+/*
+================
+idCollisionModelManagerLocal::FreeTraceContexts
+
+Frees the trace models and caches of all contexts, no traces may be running.
+================
+*/
+void idCollisionModelManagerLocal::FreeTraceContexts( void ) {
+	int i;
+
+	boost::mutex::scoped_lock lock( traceContextMutex );
+	for ( i = 0; i < traceContexts.Num(); i++ ) {
+		cm_traceContext_t *context = traceContexts[i];
+		FreeTrmModelStructure( context );
+		context->vertexCache.Clear();
+		context->edgeCache.Clear();
+		context->polygonCheckCount.Clear();
+		context->brushCheckCount.Clear();
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::DeleteTraceContexts
+
+Deletes the contexts of all threads. Threads that traced must have exited
+by now, except for the calling thread, which lets go of its context here.
+================
+*/
+void idCollisionModelManagerLocal::DeleteTraceContexts( void ) {
+	FreeTraceContexts();
+
+	threadTraceContext.release();
+
+	boost::mutex::scoped_lock lock( traceContextMutex );
+	traceContexts.DeleteContents( true );
+}
+
+/*
+================
+idCollisionModelManagerLocal::ModelForHandle
+================
+*/
+cm_model_t *idCollisionModelManagerLocal::ModelForHandle( cmHandle_t model ) {
+	if ( model == TRACE_MODEL_HANDLE ) {
+		if ( !trmMaterial ) {
+			return NULL;
+		}
+		cm_traceContext_t *context = GetTraceContext();
+		if ( !context->trmModel ) {
+			SetupTrmModelStructure( context );
+		}
+		return context->trmModel;
+	}
+	return models[model];
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupTraceWork
+
+Points the trace work at the caches of the calling thread, sized for the model.
+The caches only grow here so the pointers stay valid for the whole trace.
+================
+*/
+void idCollisionModelManagerLocal::SetupTraceWork( cm_traceWork_t *tw, cm_model_t *model ) {
+	cm_traceContext_t *context;
+
+	context = GetTraceContext();
+
+	tw->model = model;
+	tw->checkCount = NextCheckCount();
+	tw->context = context;
+	tw->vertexCache = CM_GrowCache( context->vertexCache, model->maxVertices );
+	tw->edgeCache = CM_GrowCache( context->edgeCache, model->maxEdges );
+	tw->polygonCheckCount = CM_GrowCache( context->polygonCheckCount, model->numPolygonIndexes );
+	tw->brushCheckCount = CM_GrowCache( context->brushCheckCount, model->numBrushIndexes );
+	tw->getContacts = context->getContacts;
+	tw->contacts = context->contacts;
+	tw->maxContacts = context->maxContacts;
+	tw->numContacts = 0;
+}
+
 /*
 ===============================================================================
 
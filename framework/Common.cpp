@@ -84,6 +84,7 @@ idCVar com_asyncSound( "com_asyncSound", "1", CVAR_INTEGER|CVAR_SYSTEM, ASYNCSOU
 #endif
 
 idCVar com_forceGenericSIMD( "com_forceGenericSIMD", "0", CVAR_BOOL | CVAR_SYSTEM | CVAR_NOCHEAT, "force generic platform independent SIMD" );
+idCVar com_jobThreads( "com_jobThreads", "-1", CVAR_INTEGER | CVAR_SYSTEM | CVAR_INIT, "number of job pool worker threads, -1 = one less than the number of cores, 0 = run jobs on the main thread" );
 idCVar com_developer( "developer", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "developer mode" );
 idCVar com_allowConsole( "com_allowConsole", "0", CVAR_BOOL | CVAR_SYSTEM | CVAR_NOCHEAT, "allow toggling console with the tilde key" );
 idCVar com_speeds( "com_speeds", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "show engine timings" );
@@ -2294,6 +2295,7 @@ void idCommonLocal::InitCommands( void ) {
 	cmdSystem->AddCommand( "reloadEngine", Com_ReloadEngine_f, CMD_FL_SYSTEM, "reloads the engine down to including the file system" );
 	cmdSystem->AddCommand( "setMachineSpec", Com_SetMachineSpec_f, CMD_FL_SYSTEM, "detects system capabilities and sets com_machineSpec to appropriate value" );
 	cmdSystem->AddCommand( "execMachineSpec", Com_ExecMachineSpec_f, CMD_FL_SYSTEM, "execs the appropriate config files and sets cvars based on com_machineSpec" );
+	cmdSystem->AddCommand( "testCollisionThreads", CM_TestThreads_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "runs random collision queries serially and on the job pool and compares the results" );
 
 #if !defined( ID_DEDICATED )
 	// compilers
@@ -2331,6 +2333,7 @@ void idCommonLocal::InitCommands( void ) {
 	cmdSystem->AddCommand( "listDictKeys", idDict::ListKeys_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all keys used by dictionaries" );
 	cmdSystem->AddCommand( "listDictValues", idDict::ListValues_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all values used by dictionaries" );
 	cmdSystem->AddCommand( "testSIMD", idSIMD::Test_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "test SIMD code" );
+	cmdSystem->AddCommand( "testHeap", Mem_Test_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "compares the small allocation performance of the slab allocator and idHeap" );
 
 	// localization
 	cmdSystem->AddCommand( "localizeGuis", Com_LocalizeGuis_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "localize guis" );
@@ -2790,6 +2793,10 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline )
 		// initialize processor specific SIMD implementation
 		InitSIMD();
 
+		// start the job pool worker threads
+		jobPool.Init( com_jobThreads.GetInteger() );
+		Printf( "%d job pool worker threads\n", jobPool.GetNumThreads() );
+
 		// init commands
 		InitCommands();
 
@@ -2870,6 +2877,12 @@ void idCommonLocal::Shutdown( void ) {
 	warningCaption.Clear();
 	errorList.Clear();
 
+	// stop the job pool worker threads
+	jobPool.Shutdown();
+
+	// free the collision trace state the threads left behind
+	collisionModelManager->Shutdown();
+
 	// enable leak test
 	Mem_EnableLeakTest( "tdm_main" );
 
@@ -146,6 +146,37 @@ private:
 	idDeclLocal *				nextInFile;				// next decl in the decl file
 };
 
+/*
+  The decl cache remembers where the decls are in every decl file, so a file
+  that didn't change since the last run is split into its decls without
+  running the lexer over it. An entry is only used if the checksum of the
+  file text matches, and the decl types that were registered when the file
+  was scanned are part of its key since they decide how the text is split.
+
+  Bump DECL_CACHE_VERSION whenever idDeclFile::LoadAndParse changes.
+*/
+#define DECL_CACHE_FILE				"decls.dcache"
+#define DECL_CACHE_FILEID			"DCL"
+#define DECL_CACHE_VERSION			1
+
+typedef struct declCacheSpan_s {
+	int							type;
+	idStr						name;
+	int							offset;
+	int							length;
+	int							line;
+} declCacheSpan_t;
+
+class idDeclCacheFile {
+public:
+	idStr						key;					// see idDeclManagerLocal::DeclCacheKey
+	int							checksum;
+	int							fileSize;
+	int							numLines;
+	bool						used;					// looked up or scanned in this session, only these are written back
+	idList<declCacheSpan_t>		spans;
+};
+
 class idDeclFile {
 public:
 								idDeclFile();
@@ -154,6 +185,9 @@ public:
 	void						Reload( bool force );
 	int							LoadAndParse();
 
+private:
+	void						AddDecl( declType_t type, const char *name, const char *text, int offset, int size, int line, idLexer *src );
+
 public:
 	idStr						fileName;
 	declType_t					defaultType;
@@ -211,6 +245,9 @@ public:
 	static void					MakeNameCanonical( const char *name, char *result, int maxLength );
 	idDeclLocal *				FindTypeWithoutParsing( declType_t type, const char *name, bool makeDefault = true );
 
+	const idDeclCacheFile *		FindDeclCacheFile( const char *fileName, declType_t defaultType, int checksum, int fileSize );
+	void						AddDeclCacheFile( const char *fileName, declType_t defaultType, idDeclCacheFile *cacheFile );
+
 	idDeclType *				GetDeclType( int type ) const { return declTypes[type]; }
 	const idDeclFile *			GetImplicitDeclFile( void ) const { return &implicitDecls; }
 
@@ -228,7 +265,22 @@ private:
 	int							indent;			// for MediaPrint
 	bool						insideLevelLoad;
 
+	idList<idDeclCacheFile *>	declCacheFiles;
+	idHashIndex					declCacheHash;
+	bool						declCacheLoaded;
+	bool						declCacheChanged;
+	int							declCacheHits;		// files taken from the decl cache by the current RegisterDeclFolder
+	unsigned int				declTypesChecksum;	// of the registered decl types, set by RegisterDeclFolder for DeclCacheKey
+
 	static idCVar				decl_show;
+	static idCVar				decl_cache;
+
+private:
+	idStr						DeclCacheKey( const char *fileName, declType_t defaultType ) const;
+	int							FindDeclCacheIndex( const char *key ) const;
+	void						LoadDeclCache( void );
+	void						WriteDeclCache( void );
+	void						FreeDeclCache( void );
 
 private:
 	static void					ListDecls_f( const idCmdArgs &args );
@@ -237,6 +289,7 @@ private:
 };
 
 idCVar idDeclManagerLocal::decl_show( "decl_show", "0", CVAR_SYSTEM, "set to 1 to print parses, 2 to also print references", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar idDeclManagerLocal::decl_cache( "decl_cache", "1", CVAR_SYSTEM | CVAR_BOOL, "remember where the decls are in each decl file in " DECL_CACHE_FILE " so unchanged files don't have to be scanned at startup" );
 
 idDeclManagerLocal	declManagerLocal;
 idDeclManager *		declManager = &declManagerLocal;
@@ -601,8 +654,8 @@ int idDeclFile::LoadAndParse() {
 	int			length, size;
 	int			sourceLine;
 	idStr		name;
-	idDeclLocal *newDecl;
-	bool		reparse;
+	const idDeclCacheFile *cached;
+	idDeclCacheFile *scanned;
 
 	// load the text
 	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
@@ -612,146 +665,134 @@ int idDeclFile::LoadAndParse() {
 		return 0;
 	}
 
-	if ( !src.LoadMemory( buffer, length, fileName ) ) {
-		common->Error( "Couldn't parse %s", fileName.c_str() );
-		Mem_Free( buffer );
-		return 0;
-	}
-
 	// mark all the defs that were from the last reload of this file
 	for ( idDeclLocal *decl = decls; decl; decl = decl->nextInFile ) {
 		decl->redefinedInReload = false;
 	}
 
-	src.SetFlags( DECL_LEXER_FLAGS );
-
 	checksum = MD5_BlockChecksum( buffer, length );
 
 	fileSize = length;
 
-	// scan through, identifying each individual declaration
-	while( 1 ) {
-
-		startMarker = src.GetFileOffset();
-		sourceLine = src.GetLineNum();
+	// if the text didn't change since the last scan take the decls from the decl cache
+	cached = declManagerLocal.FindDeclCacheFile( fileName, defaultType, checksum, fileSize );
+	if ( cached ) {
+		for ( i = 0; i < cached->spans.Num(); i++ ) {
+			const declCacheSpan_t &span = cached->spans[i];
+			AddDecl( (declType_t)span.type, span.name, buffer, span.offset, span.length, span.line, NULL );
+		}
+		numLines = cached->numLines;
+	} else {
 
-		// parse the decl type name
-		if ( !src.ReadToken( &token ) ) {
-			break;
+		if ( !src.LoadMemory( buffer, length, fileName ) ) {
+			common->Error( "Couldn't parse %s", fileName.c_str() );
+			fileSystem->FreeFile( buffer );
+			return 0;
 		}
 
-		declType_t identifiedType = DECL_MAX_TYPES;
+		src.SetFlags( DECL_LEXER_FLAGS );
+
+		scanned = new idDeclCacheFile;
+		scanned->checksum = checksum;
+		scanned->fileSize = fileSize;
 
-		// get the decl type from the type name
-		numTypes = declManagerLocal.GetNumDeclTypes();
-		for ( i = 0; i < numTypes; i++ ) {
-			idDeclType *typeInfo = declManagerLocal.GetDeclType( i );
-			if ( typeInfo && typeInfo->typeName.Icmp( token ) == 0 ) {
-				identifiedType = (declType_t) typeInfo->type;
+		// scan through, identifying each individual declaration
+		while( 1 ) {
+
+			startMarker = src.GetFileOffset();
+			sourceLine = src.GetLineNum();
+
+			// parse the decl type name
+			if ( !src.ReadToken( &token ) ) {
 				break;
 			}
-		}
 
-		if ( i >= numTypes ) {
+			declType_t identifiedType = DECL_MAX_TYPES;
 
-			if ( token.Icmp( "{" ) == 0 ) {
+			// get the decl type from the type name
+			numTypes = declManagerLocal.GetNumDeclTypes();
+			for ( i = 0; i < numTypes; i++ ) {
+				idDeclType *typeInfo = declManagerLocal.GetDeclType( i );
+				if ( typeInfo && typeInfo->typeName.Icmp( token ) == 0 ) {
+					identifiedType = (declType_t) typeInfo->type;
+					break;
+				}
+			}
 
-				// if we ever see an open brace, we somehow missed the [type] <name> prefix
-				src.Warning( "Missing decl name" );
-				src.SkipBracedSection( false );
-				continue;
+			if ( i >= numTypes ) {
 
-			} else {
+				if ( token.Icmp( "{" ) == 0 ) {
 
-				if ( defaultType == DECL_MAX_TYPES ) {
-					src.Warning( "No type" );
+					// if we ever see an open brace, we somehow missed the [type] <name> prefix
+					src.Warning( "Missing decl name" );
+					src.SkipBracedSection( false );
 					continue;
+
+				} else {
+
+					if ( defaultType == DECL_MAX_TYPES ) {
+						src.Warning( "No type" );
+						continue;
+					}
+					src.UnreadToken( &token );
+					// use the default type
+					identifiedType = defaultType;
 				}
-				src.UnreadToken( &token );
-				// use the default type
-				identifiedType = defaultType;
 			}
-		}
 
-		// now parse the name
-		if ( !src.ReadToken( &token ) ) {
-			src.Warning( "Type without definition at end of file" );
-			break;
-		}
+			// now parse the name
+			if ( !src.ReadToken( &token ) ) {
+				src.Warning( "Type without definition at end of file" );
+				break;
+			}
 
-		if ( !token.Icmp( "{" ) ) {
-			// if we ever see an open brace, we somehow missed the [type] <name> prefix
-			src.Warning( "Missing decl name" );
-			src.SkipBracedSection( false );
-			continue;
-		}
+			if ( !token.Icmp( "{" ) ) {
+				// if we ever see an open brace, we somehow missed the [type] <name> prefix
+				src.Warning( "Missing decl name" );
+				src.SkipBracedSection( false );
+				continue;
+			}
 
-		// FIXME: export decls are only used by the model exporter, they are skipped here for now
-		if ( identifiedType == DECL_MODELEXPORT ) {
-			src.SkipBracedSection();
-			continue;
-		}
+			// FIXME: export decls are only used by the model exporter, they are skipped here for now
+			if ( identifiedType == DECL_MODELEXPORT ) {
+				src.SkipBracedSection();
+				continue;
+			}
 
-		name = token;
+			name = token;
 
-		// make sure there's a '{'
-		if ( !src.ReadToken( &token ) ) {
-			src.Warning( "Type without definition at end of file" );
-			break;
-		}
-		if ( token != "{" ) {
-			src.Warning( "Expecting '{' but found '%s'", token.c_str() );
-			continue;
-		}
-		src.UnreadToken( &token );
-
-		// now take everything until a matched closing brace
-		src.SkipBracedSection();
-		size = src.GetFileOffset() - startMarker;
-
-		// look it up, possibly getting a newly created default decl
-		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
-		if ( newDecl ) {
-			// update the existing copy
-			if ( newDecl->sourceFile != this || newDecl->redefinedInReload ) {
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-								name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
-				continue;
+			// make sure there's a '{'
+			if ( !src.ReadToken( &token ) ) {
+				src.Warning( "Type without definition at end of file" );
+				break;
 			}
-			if ( newDecl->declState != DS_UNPARSED ) {
-				reparse = true;
+			if ( token != "{" ) {
+				src.Warning( "Expecting '{' but found '%s'", token.c_str() );
+				continue;
 			}
-		} else {
-			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
-			newDecl->nextInFile = this->decls;
-			this->decls = newDecl;
-		}
+			src.UnreadToken( &token );
+
+			// now take everything until a matched closing brace
+			src.SkipBracedSection();
+			size = src.GetFileOffset() - startMarker;
 
-		newDecl->redefinedInReload = true;
+			declCacheSpan_t &span = scanned->spans.Alloc();
+			span.type = identifiedType;
+			span.name = name;
+			span.offset = startMarker;
+			span.length = size;
+			span.line = sourceLine;
 
-		if ( newDecl->textSource ) {
-			Mem_Free( newDecl->textSource );
-			newDecl->textSource = NULL;
+			AddDecl( identifiedType, name, buffer, startMarker, size, sourceLine, &src );
 		}
 
-		newDecl->SetTextLocal( buffer + startMarker, size );
-		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
-		newDecl->declState = DS_UNPARSED;
+		numLines = src.GetLineNum();
 
-		// if it is currently in use, reparse it immedaitely
-		if ( reparse ) {
-			newDecl->ParseLocal();
-		}
+		scanned->numLines = numLines;
+		declManagerLocal.AddDeclCacheFile( fileName, defaultType, scanned );
 	}
 
-	numLines = src.GetLineNum();
-
-	Mem_Free( buffer );
+	fileSystem->FreeFile( buffer );
 
 	// any defs that weren't redefinedInReload should now be defaulted
 	for ( idDeclLocal *decl = decls ; decl ; decl = decl->nextInFile ) {
@@ -766,6 +807,63 @@ int idDeclFile::LoadAndParse() {
 	return checksum;
 }
 
+/*
+================
+idDeclFile::AddDecl
+
+Adds or updates the decl defined at offset in the text of this file. src is
+the lexer that found the decl, or NULL if it came from the decl cache.
+================
+*/
+void idDeclFile::AddDecl( declType_t type, const char *name, const char *text, int offset, int size, int line, idLexer *src ) {
+	idDeclLocal *newDecl;
+	bool		reparse;
+
+	// look it up, possibly getting a newly created default decl
+	reparse = false;
+	newDecl = declManagerLocal.FindTypeWithoutParsing( type, name, false );
+	if ( newDecl ) {
+		// update the existing copy
+		if ( newDecl->sourceFile != this || newDecl->redefinedInReload ) {
+			if ( src ) {
+				src->Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( type ),
+								name, newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+			} else {
+				common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), line,
+								declManagerLocal.GetDeclNameFromType( type ), name, newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+			}
+			return;
+		}
+		if ( newDecl->declState != DS_UNPARSED ) {
+			reparse = true;
+		}
+	} else {
+		// allow it to be created as a default, then add it to the per-file list
+		newDecl = declManagerLocal.FindTypeWithoutParsing( type, name, true );
+		newDecl->nextInFile = this->decls;
+		this->decls = newDecl;
+	}
+
+	newDecl->redefinedInReload = true;
+
+	if ( newDecl->textSource ) {
+		Mem_Free( newDecl->textSource );
+		newDecl->textSource = NULL;
+	}
+
+	newDecl->SetTextLocal( text + offset, size );
+	newDecl->sourceFile = this;
+	newDecl->sourceTextOffset = offset;
+	newDecl->sourceTextLength = size;
+	newDecl->sourceLine = line;
+	newDecl->declState = DS_UNPARSED;
+
+	// if it is currently in use, reparse it immedaitely
+	if ( reparse ) {
+		newDecl->ParseLocal();
+	}
+}
+
 /*
 ====================================================================================
 
@@ -787,6 +885,11 @@ void idDeclManagerLocal::Init( void ) {
 
 	checksum = 0;
 
+	declCacheLoaded = false;
+	declCacheChanged = false;
+	declCacheHits = 0;
+	declTypesChecksum = 0;
+
 #ifdef USE_COMPRESSED_DECLS
 	SetupHuffman();
 #endif
@@ -851,6 +954,9 @@ void idDeclManagerLocal::Shutdown( void ) {
 	int			i, j;
 	idDeclLocal *decl;
 
+	WriteDeclCache();
+	FreeDeclCache();
+
 	// free decls
 	for ( i = 0; i < DECL_MAX_TYPES; i++ ) {
 		for ( j = 0; j < linearLists[i].Num(); j++ ) {
@@ -919,6 +1025,9 @@ idDeclManagerLocal::EndLevelLoad
 void idDeclManagerLocal::EndLevelLoad() {
 	insideLevelLoad = false;
 
+	// all decl folders are registered by now
+	WriteDeclCache();
+
 	// we don't need to do anything here, but the image manager, model manager,
 	// and sound sample manager will need to free media that was not referenced
 }
@@ -958,6 +1067,7 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 	idDeclFolder *declFolder;
 	idFileList *fileList;
 	idDeclFile *df;
+	int startTime;
 
 	// check whether this folder / extension combination already exists
 	for ( i = 0; i < declFolders.Num(); i++ ) {
@@ -978,6 +1088,18 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 	// scan for decl files
 	fileList = fileSystem->ListFiles( declFolder->folder, declFolder->extension, true );
 
+	startTime = Sys_Milliseconds();
+	declCacheHits = 0;
+
+	// the registered types decide how the files are split into decls, they are part of the decl cache keys
+	idStr types;
+	for ( i = 0; i < declTypes.Num(); i++ ) {
+		if ( declTypes[i] ) {
+			types += va( "%s %d ", declTypes[i]->typeName.c_str(), declTypes[i]->type );
+		}
+	}
+	declTypesChecksum = (unsigned int)MD5_BlockChecksum( types.c_str(), types.Length() );
+
 	// load and parse decl files
 	for ( i = 0; i < fileList->GetNumFiles(); i++ ) {
 		fileName = declFolder->folder + "/" + fileList->GetFile( i );
@@ -997,9 +1119,232 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 		df->LoadAndParse();
 	}
 
+	common->Printf( "...%d %s/*%s files in %d msec, %d from the decl cache\n", fileList->GetNumFiles(), declFolder->folder.c_str(),
+					declFolder->extension.c_str(), Sys_Milliseconds() - startTime, declCacheHits );
+
 	fileSystem->FreeFileList( fileList );
 }
 
+/*
+===================
+idDeclManagerLocal::DeclCacheKey
+===================
+*/
+idStr idDeclManagerLocal::DeclCacheKey( const char *fileName, declType_t defaultType ) const {
+	return va( "%s %d %08x", fileName, defaultType, declTypesChecksum );
+}
+
+/*
+===================
+idDeclManagerLocal::FindDeclCacheFile
+
+Returns NULL if the file has to be scanned.
+===================
+*/
+const idDeclCacheFile *idDeclManagerLocal::FindDeclCacheFile( const char *fileName, declType_t defaultType, int checksum, int fileSize ) {
+	idDeclCacheFile *cacheFile;
+	int index;
+
+	if ( !decl_cache.GetBool() ) {
+		return NULL;
+	}
+	if ( !declCacheLoaded ) {
+		LoadDeclCache();
+	}
+
+	index = FindDeclCacheIndex( DeclCacheKey( fileName, defaultType ) );
+	if ( index < 0 || declCacheFiles[index]->checksum != checksum || declCacheFiles[index]->fileSize != fileSize ) {
+		return NULL;
+	}
+
+	cacheFile = declCacheFiles[index];
+	if ( !cacheFile->used ) {
+		cacheFile->used = true;
+		// entries that are no longer used get dropped from the file
+		declCacheChanged = true;
+	}
+	declCacheHits++;
+	return cacheFile;
+}
+
+/*
+===================
+idDeclManagerLocal::FindDeclCacheIndex
+===================
+*/
+int idDeclManagerLocal::FindDeclCacheIndex( const char *key ) const {
+	int hash = declCacheHash.GenerateKey( key, true );
+	for ( int i = declCacheHash.First( hash ); i != -1; i = declCacheHash.Next( i ) ) {
+		if ( declCacheFiles[i]->key.Cmp( key ) == 0 ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+===================
+idDeclManagerLocal::AddDeclCacheFile
+
+Takes ownership of cacheFile.
+===================
+*/
+void idDeclManagerLocal::AddDeclCacheFile( const char *fileName, declType_t defaultType, idDeclCacheFile *cacheFile ) {
+	int index;
+
+	if ( !decl_cache.GetBool() ) {
+		delete cacheFile;
+		return;
+	}
+
+	cacheFile->key = DeclCacheKey( fileName, defaultType );
+	cacheFile->used = true;
+	declCacheChanged = true;
+
+	index = FindDeclCacheIndex( cacheFile->key );
+	if ( index >= 0 ) {
+		delete declCacheFiles[index];
+		declCacheFiles[index] = cacheFile;
+	} else {
+		index = declCacheFiles.Append( cacheFile );
+		declCacheHash.Add( declCacheHash.GenerateKey( cacheFile->key, true ), index );
+	}
+}
+
+/*
+===================
+idDeclManagerLocal::LoadDeclCache
+===================
+*/
+void idDeclManagerLocal::LoadDeclCache( void ) {
+	void *		buffer;
+	int			length, version, num, numSpans, bodyLength;
+	unsigned int bodyChecksum;
+	char		id[4];
+
+	declCacheLoaded = true;
+
+	length = fileSystem->ReadFile( DECL_CACHE_FILE, &buffer, NULL );
+	if ( length < 0 ) {
+		return;
+	}
+
+	idFile_Memory file( DECL_CACHE_FILE, (const char *)buffer, length );
+
+	file.Read( id, sizeof( id ) );
+	file.ReadInt( version );
+	file.ReadInt( bodyLength );
+	file.ReadUnsignedInt( bodyChecksum );
+	if ( memcmp( id, DECL_CACHE_FILEID, sizeof( id ) ) != 0 || version != DECL_CACHE_VERSION ) {
+		fileSystem->FreeFile( buffer );
+		return;
+	}
+	if ( bodyLength != file.Length() - file.Tell() || CRC32_BlockChecksum( file.GetDataPtr() + file.Tell(), bodyLength ) != bodyChecksum ) {
+		common->Warning( "%s is damaged", DECL_CACHE_FILE );
+		fileSystem->FreeFile( buffer );
+		return;
+	}
+
+	file.ReadInt( num );
+	for ( int i = 0; i < num; i++ ) {
+		idDeclCacheFile *cacheFile = new idDeclCacheFile;
+
+		file.ReadString( cacheFile->key );
+		file.ReadInt( cacheFile->checksum );
+		file.ReadInt( cacheFile->fileSize );
+		file.ReadInt( cacheFile->numLines );
+		file.ReadInt( numSpans );
+		if ( numSpans < 0 || FindDeclCacheIndex( cacheFile->key ) >= 0 ) {
+			common->Warning( "%s is damaged", DECL_CACHE_FILE );
+			delete cacheFile;
+			break;
+		}
+		cacheFile->used = false;
+		cacheFile->spans.SetNum( numSpans );
+		for ( int j = 0; j < numSpans; j++ ) {
+			declCacheSpan_t &span = cacheFile->spans[j];
+			file.ReadInt( span.type );
+			file.ReadString( span.name );
+			file.ReadInt( span.offset );
+			file.ReadInt( span.length );
+			file.ReadInt( span.line );
+		}
+		declCacheHash.Add( declCacheHash.GenerateKey( cacheFile->key, true ), declCacheFiles.Append( cacheFile ) );
+	}
+
+	fileSystem->FreeFile( buffer );
+}
+
+/*
+===================
+idDeclManagerLocal::WriteDeclCache
+
+Writes the entries of all decl files that were loaded in this session.
+===================
+*/
+void idDeclManagerLocal::WriteDeclCache( void ) {
+	int i, j, num;
+
+	if ( !declCacheChanged || !decl_cache.GetBool() ) {
+		return;
+	}
+	declCacheChanged = false;
+
+	idFile_Memory body( DECL_CACHE_FILE );
+
+	num = 0;
+	for ( i = 0; i < declCacheFiles.Num(); i++ ) {
+		if ( declCacheFiles[i]->used ) {
+			num++;
+		}
+	}
+
+	body.WriteInt( num );
+	for ( i = 0; i < declCacheFiles.Num(); i++ ) {
+		const idDeclCacheFile *cacheFile = declCacheFiles[i];
+		if ( !cacheFile->used ) {
+			continue;
+		}
+		body.WriteString( cacheFile->key );
+		body.WriteInt( cacheFile->checksum );
+		body.WriteInt( cacheFile->fileSize );
+		body.WriteInt( cacheFile->numLines );
+		body.WriteInt( cacheFile->spans.Num() );
+		for ( j = 0; j < cacheFile->spans.Num(); j++ ) {
+			const declCacheSpan_t &span = cacheFile->spans[j];
+			body.WriteInt( span.type );
+			body.WriteString( span.name );
+			body.WriteInt( span.offset );
+			body.WriteInt( span.length );
+			body.WriteInt( span.line );
+		}
+	}
+
+	idFile *file = fileSystem->OpenFileWrite( DECL_CACHE_FILE );
+	if ( !file ) {
+		common->Warning( "Couldn't write %s", DECL_CACHE_FILE );
+		return;
+	}
+	file->Write( DECL_CACHE_FILEID, 4 );
+	file->WriteInt( DECL_CACHE_VERSION );
+	file->WriteInt( body.Length() );
+	file->WriteUnsignedInt( CRC32_BlockChecksum( body.GetDataPtr(), body.Length() ) );
+	file->Write( body.GetDataPtr(), body.Length() );
+	fileSystem->CloseFile( file );
+}
+
+/*
+===================
+idDeclManagerLocal::FreeDeclCache
+===================
+*/
+void idDeclManagerLocal::FreeDeclCache( void ) {
+	declCacheFiles.DeleteContents( true );
+	declCacheHash.Free();
+	declCacheLoaded = false;
+	declCacheChanged = false;
+}
+
 /*
 ===================
 idDeclManagerLocal::GetChecksum
@@ -1262,6 +1262,9 @@ idFile_InZip::idFile_InZip( void ) {
 	fileSize = 0;
     fileLastMod = 0;
 	memset( &z, 0, sizeof( z ) );
+	pak = NULL;
+	dataPos = 0;
+	stored = false;
 }
 
 /*
@@ -209,6 +209,8 @@ private:
 };
 
 
+struct pack_s;
+
 class idFile_InZip : public idFile {
 	friend class			idFileSystemLocal;
 
@@ -234,6 +236,9 @@ private:
 	int						fileSize;		// size of the file
     ID_TIME_T               fileLastMod;    // last modified date/time of the file
 	void *					z;				// unzip info
+	struct pack_s *			pak;			// pak the file is in
+	int						dataPos;		// offset of the file data in the pak
+	bool					stored;			// file is stored without compression
 };
 
 #endif /* !__FILE_H__ */
@@ -24,6 +24,9 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "Unzip.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #ifdef WIN32
 	#include <io.h>	// for _read
 #else
@@ -122,6 +125,11 @@ in search order, fs_mod > BASE_TDM
 
 #define MAX_ZIPPED_FILE_NAME	2048
 #define FILE_HASH_SIZE			1024
+#define MIN_MAPPED_FILE_SIZE	( 64 * 1024 )	// smaller stored files are cheaper to copy than to map
+
+#define PAK_INDEX_FILE			"pk4index.dat"
+#define PAK_INDEX_ID			( ( 'X' << 24 ) + ( 'I' << 16 ) + ( 'K' << 8 ) + 'P' )
+#define PAK_INDEX_VERSION		1
 
 typedef struct fileInPack_s {
 	idStr				name;						// name of the file
@@ -140,14 +148,17 @@ typedef struct {
 	idList<idDict *>	mapDecls;
 } addonInfo_t;
 
-typedef struct {
+typedef struct pack_s {
 	idStr				pakFilename;				// c:\doom\base\pak0.pk4
 	unzFile				handle;
+	boost::interprocess::file_mapping *mapping;		// created by the first mapped read from the pak
 	int					checksum;
 	int					numfiles;
 	int					length;
+	ID_TIME_T			timestamp;					// modification time of the pak, for the pak index
 	bool				referenced;
 	binaryStatus_t		binary;
+	int					binaryOSMask;				// OS ids listed in the binary.conf of the pak
 	bool				addon;						// this is an addon pack - addon_search tells if it's 'active'
 	bool				addon_search;				// is in the search list
 	addonInfo_t			*addon_info;
@@ -161,6 +172,25 @@ typedef struct {
 	idStr				gamedir;					// base
 } directory_t;
 
+// the parsed central directory of a pak from the pak index of the last startup
+typedef struct {
+	idStr				pakFilename;
+	int					length;
+	int					timestamp;
+	int					checksum;
+	binaryStatus_t		binary;
+	int					binaryOSMask;
+	int					numfiles;
+	int					filesOffset;				// offset of the file list in the index
+	bool				used;
+} pakIndexEntry_t;
+
+// a ReadFile buffer pointing into a mapped pak, released by FreeFile
+typedef struct {
+	void *				buffer;
+	boost::interprocess::mapped_region *region;
+} mappedFile_t;
+
 typedef struct searchpath_s {
 	pack_t *			pack;						// only one of pack / dir will be non NULL
 	directory_t *		dir;
@@ -272,6 +302,8 @@ private:
 	static idCVar			fs_devpath;
 	static idCVar			fs_caseSensitiveOS;
 	static idCVar			fs_searchAddons;
+	static idCVar			fs_mapStoredFiles;
+	static idCVar			fs_pakIndex;
 
     // taaaki: fs_game and fs_game_base have been removed as TDM is no longer a mod and these fs cvars were causing
     // confusion due to inconsistent usage. fs_mod has been added to allow for mods of TDM.
@@ -301,6 +333,16 @@ private:
 	int						dir_cache_index;
 	int						dir_cache_count;
 
+	idList<mappedFile_t>	mappedFiles;			// ReadFile buffers that are mapped from paks
+
+	// the pak index is only loaded during Startup
+	boost::interprocess::file_mapping *pakIndexMapping;
+	boost::interprocess::mapped_region *pakIndexRegion;
+	idFile_Memory *			pakIndexFile;
+	idList<pakIndexEntry_t>	pakIndex;
+	idHashIndex				pakIndexHash;
+	bool					pakIndexChanged;		// a pak wasn't found in the index, write a new one
+
 private:
 	void					ReplaceSeparators( idStr &path, char sep = PATHSEPERATOR_CHAR );
 	long					HashFileName( const char *fname ) const;
@@ -315,6 +357,11 @@ private:
 
 	int						GetFileListTree( const char *relativePath, const idStrList &extensions, idStrList &list, idHashIndex &hashIndex, const char* gamedir = NULL );
 	pack_t *				LoadZipFile( const char *zipfile );
+	int						ParseBinaryConfig( pack_t *pak, fileInPack_t *pakFile );
+	void					LoadPakIndex( void );
+	void					WritePakIndex( void );
+	void					FreePakIndex( void );
+	bool					ReadPakFromIndex( pack_t *pak, const char *zipfile );
 	void					AddGameDirectory( const char *path, const char *dir );
 	void					SetupGameDirectories( const char *gameName );
 	void					Startup( void );
@@ -325,6 +372,7 @@ private:
 							// searches all the paks
 	pack_t *				FindPakForFileChecksum( const char *relativePath, int fileChecksum, bool bReference );
 	idFile_InZip *			ReadFileFromZip( pack_t *pak, fileInPack_t *pakFile, const char *relativePath );
+	byte *					MapStoredFile( idFile_InZip *file );
 	int						GetFileChecksum( idFile *file );
 	addonInfo_t *			ParseAddonDef( const char *buf, const int len );
 	void					FollowAddonDependencies( pack_t *pak );
@@ -348,6 +396,8 @@ idCVar	idFileSystemLocal::fs_caseSensitiveOS( "fs_caseSensitiveOS", "0", CVAR_SY
 idCVar	idFileSystemLocal::fs_caseSensitiveOS( "fs_caseSensitiveOS", "1", CVAR_SYSTEM | CVAR_BOOL, "" );
 #endif
 idCVar	idFileSystemLocal::fs_searchAddons( "fs_searchAddons", "0", CVAR_SYSTEM | CVAR_BOOL, "search all addon pk4s ( disables addon functionality )" );
+idCVar	idFileSystemLocal::fs_pakIndex( "fs_pakIndex", "1", CVAR_SYSTEM | CVAR_BOOL, "cache the file lists of the pk4s in " PAK_INDEX_FILE " to speed up startup" );
+idCVar	idFileSystemLocal::fs_mapStoredFiles( "fs_mapStoredFiles", "1", CVAR_SYSTEM | CVAR_BOOL, "ReadFile maps uncompressed files in pk4s instead of copying them" );
 
 // greebo: Custom savepath in darkmod/fms/
 idCVar	idFileSystemLocal::fs_modSavePath( "fs_modSavePath", "", CVAR_SYSTEM | CVAR_INIT, "This is where all screenshots and savegames will be written to." );
@@ -371,6 +421,10 @@ idFileSystemLocal::idFileSystemLocal( void ) {
 	restartGamePakChecksum = 0;
 	memset( &backgroundThread, 0, sizeof( backgroundThread ) );
 	addonPaks = NULL;
+	pakIndexMapping = NULL;
+	pakIndexRegion = NULL;
+	pakIndexFile = NULL;
+	pakIndexChanged = false;
 }
 
 /*
@@ -951,6 +1005,20 @@ int idFileSystemLocal::ReadFile( const char *relativePath, void **buffer, ID_TIM
 	loadCount++;
 	loadStack++;
 
+	// files stored without compression in a pak are handed out straight from the mapped pak
+	if ( !isConfig && len >= MIN_MAPPED_FILE_SIZE && fs_mapStoredFiles.GetBool() ) {
+		idFile_InZip *zipFile = dynamic_cast<idFile_InZip *>( f );
+		if ( zipFile && zipFile->stored ) {
+			buf = MapStoredFile( zipFile );
+			if ( buf ) {
+				*buffer = buf;
+				AddToReadCount( len );
+				CloseFile( f );
+				return len;
+			}
+		}
+	}
+
 	*buffer = buf = (byte *)Mem_ClearedAlloc(len+1);
 
 	f->Read( buf, len );
@@ -983,6 +1051,14 @@ void idFileSystemLocal::FreeFile( void *buffer ) {
 	}
 	loadStack--;
 
+	for ( int i = mappedFiles.Num() - 1; i >= 0; i-- ) {
+		if ( mappedFiles[i].buffer == buffer ) {
+			delete mappedFiles[i].region;
+			mappedFiles.RemoveIndex( i );
+			return;
+		}
+	}
+
 	Mem_Free( buffer );
 }
 
@@ -1114,6 +1190,41 @@ addonInfo_t *idFileSystemLocal::ParseAddonDef( const char *buf, const int len )
 	return NULL;
 }
 
+/*
+=================
+idFileSystemLocal::ParseBinaryConfig
+
+Returns a bit mask of the OS ids listed in the binary.conf of a pak
+=================
+*/
+int idFileSystemLocal::ParseBinaryConfig( pack_t *pak, fileInPack_t *pakFile ) {
+	idFile *	confFile;
+	char *		buf;
+	idToken		token;
+	int			mask = 0;
+
+	confFile = ReadFileFromZip( pak, pakFile, BINARY_CONFIG );
+
+	buf = new char[ confFile->Length() + 1 ];
+	confFile->Read( (void *)buf, confFile->Length() );
+	buf[ confFile->Length() ] = '\0';
+
+	idLexer lexConf( buf, confFile->Length(), confFile->GetFullPath() );
+	while ( lexConf.ReadToken( &token ) ) {
+		if ( token.IsNumeric() ) {
+			const int id = atoi( token );
+			if ( id >= 0 && id < MAX_GAME_OS ) {
+				mask |= 1 << id;
+			}
+		}
+	}
+
+	CloseFile( confFile );
+	delete[] buf;
+
+	return mask;
+}
+
 /*
 =================
 idFileSystemLocal::LoadZipFile
@@ -1132,6 +1243,7 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 	int *			fs_headerLongs;
 	FILE			*f;
 	int				len;
+	ID_TIME_T		timestamp;
 	int				confHash;
 	fileInPack_t	*pakFile;
 
@@ -1141,6 +1253,7 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 	}
 	fseek( f, 0, SEEK_END );
 	len = ftell( f );
+	timestamp = Sys_FileTimeStamp( f );
 	fclose( f );
 
 	fs_numHeaderLongs = 0;
@@ -1160,38 +1273,62 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 
 	pack->pakFilename = zipfile;
 	pack->handle = uf;
+	pack->mapping = NULL;
 	pack->numfiles = gi.number_entry;
 	pack->buildBuffer = buildBuffer;
 	pack->referenced = false;
 	pack->binary = BINARY_UNKNOWN;
+	pack->binaryOSMask = 0;
 	pack->addon = false;
 	pack->addon_search = false;
 	pack->addon_info = NULL;
 	pack->isNew = false;
 
 	pack->length = len;
-
-	unzGoToFirstFile(uf);
-	fs_headerLongs = (int *)Mem_ClearedAlloc( gi.number_entry * sizeof(int) );
-	for ( int i = 0; i < (int)gi.number_entry; i++ ) {
-		err = unzGetCurrentFileInfo( uf, &file_info, filename_inzip, sizeof(filename_inzip), NULL, 0, NULL, 0 );
-		if ( err != UNZ_OK ) {
-			break;
-		}
-		if ( file_info.uncompressed_size > 0 ) {
-			fs_headerLongs[fs_numHeaderLongs++] = LittleLong( file_info.crc );
+	pack->timestamp = timestamp;
+
+	// an unchanged pak doesn't need its central directory parsed again
+	if ( !ReadPakFromIndex( pack, zipfile ) ) {
+		unzGoToFirstFile(uf);
+		fs_headerLongs = (int *)Mem_ClearedAlloc( gi.number_entry * sizeof(int) );
+		for ( int i = 0; i < (int)gi.number_entry; i++ ) {
+			err = unzGetCurrentFileInfo( uf, &file_info, filename_inzip, sizeof(filename_inzip), NULL, 0, NULL, 0 );
+			if ( err != UNZ_OK ) {
+				break;
+			}
+			if ( file_info.uncompressed_size > 0 ) {
+				fs_headerLongs[fs_numHeaderLongs++] = LittleLong( file_info.crc );
+			}
+			hash = HashFileName( filename_inzip );
+			buildBuffer[i].name = filename_inzip;
+			buildBuffer[i].name.ToLower();
+			buildBuffer[i].name.BackSlashesToSlashes();
+			// store the file position in the zip
+			unzGetCurrentFileInfoPosition( uf, &buildBuffer[i].pos );
+			// add the file to the hash
+			buildBuffer[i].next = pack->hashTable[hash];
+			pack->hashTable[hash] = &buildBuffer[i];
+			// go to the next file in the zip
+			unzGoToNextFile(uf);
+		}
+
+		pack->checksum = MD4_BlockChecksum( fs_headerLongs, 4 * fs_numHeaderLongs );
+		pack->checksum = LittleLong( pack->checksum );
+
+		Mem_Free( fs_headerLongs );
+
+		// check if this is a binary pak
+		pack->binary = BINARY_NO;
+		confHash = HashFileName( BINARY_CONFIG );
+		for ( pakFile = pack->hashTable[confHash]; pakFile; pakFile = pakFile->next ) {
+			if ( !FilenameCompare( pakFile->name, BINARY_CONFIG ) ) {
+				pack->binary = BINARY_YES;
+				pack->binaryOSMask = ParseBinaryConfig( pack, pakFile );
+				break;
+			}
 		}
-		hash = HashFileName( filename_inzip );
-		buildBuffer[i].name = filename_inzip;
-		buildBuffer[i].name.ToLower();
-		buildBuffer[i].name.BackSlashesToSlashes();
-		// store the file position in the zip
-		unzGetCurrentFileInfoPosition( uf, &buildBuffer[i].pos );
-		// add the file to the hash
-		buildBuffer[i].next = pack->hashTable[hash];
-		pack->hashTable[hash] = &buildBuffer[i];
-		// go to the next file in the zip
-		unzGoToNextFile(uf);
+
+		pakIndexChanged = true;
 	}
 
 	// check if this is an addon pak
@@ -1216,12 +1353,232 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 		}
 	}
 
-	pack->checksum = MD4_BlockChecksum( fs_headerLongs, 4 * fs_numHeaderLongs );
-	pack->checksum = LittleLong( pack->checksum );
+	return pack;
+}
+
+/*
+=================
+ReadIndexString
 
-	Mem_Free( fs_headerLongs );
+Bounds checked idFile::ReadString for the pak index, which may be truncated.
+=================
+*/
+static bool ReadIndexString( idFile *f, idStr &string ) {
+	int len;
 
-	return pack;
+	if ( f->ReadInt( len ) != sizeof( len ) || len < 0 || len > f->Length() - f->Tell() ) {
+		return false;
+	}
+	string.Fill( ' ', len );
+	return ( f->Read( &string[ 0 ], len ) == len );
+}
+
+/*
+=================
+idFileSystemLocal::LoadPakIndex
+
+Maps the pak index written by the last startup. For each pak it holds the size
+and modification time the pak had, the checksum, the binary.conf contents and
+the file names and positions of the central directory.
+=================
+*/
+void idFileSystemLocal::LoadPakIndex( void ) {
+	idStr	path;
+	int		id, version, numPaks;
+
+	FreePakIndex();
+
+	if ( !fs_pakIndex.GetBool() || !fs_savepath.GetString()[0] ) {
+		return;
+	}
+
+	path = BuildOSPath( fs_savepath.GetString(), "", PAK_INDEX_FILE );
+
+	try {
+		pakIndexMapping = new boost::interprocess::file_mapping( path.c_str(), boost::interprocess::read_only );
+		pakIndexRegion = new boost::interprocess::mapped_region( *pakIndexMapping, boost::interprocess::read_only );
+	} catch ( const boost::interprocess::interprocess_exception & ) {
+		// no index yet
+		FreePakIndex();
+		return;
+	}
+
+	pakIndexFile = new idFile_Memory( PAK_INDEX_FILE, (const char *)pakIndexRegion->get_address(), pakIndexRegion->get_size() );
+
+	pakIndexFile->ReadInt( id );
+	pakIndexFile->ReadInt( version );
+	pakIndexFile->ReadInt( numPaks );
+	if ( id != PAK_INDEX_ID || version != PAK_INDEX_VERSION || numPaks < 0 ) {
+		FreePakIndex();
+		return;
+	}
+
+	for ( int i = 0; i < numPaks; i++ ) {
+		pakIndexEntry_t entry;
+		int binary;
+
+		if ( !ReadIndexString( pakIndexFile, entry.pakFilename ) ) {
+			break;
+		}
+		pakIndexFile->ReadInt( entry.length );
+		pakIndexFile->ReadInt( entry.timestamp );
+		pakIndexFile->ReadInt( entry.checksum );
+		pakIndexFile->ReadInt( binary );
+		pakIndexFile->ReadInt( entry.binaryOSMask );
+		pakIndexFile->ReadInt( entry.numfiles );
+		entry.binary = binary ? BINARY_YES : BINARY_NO;
+		entry.filesOffset = pakIndexFile->Tell();
+		entry.used = false;
+
+		// skip the file list
+		bool valid = ( entry.numfiles >= 0 );
+		for ( int j = 0; j < entry.numfiles && valid; j++ ) {
+			idStr name;
+			int pos;
+			valid = ( ReadIndexString( pakIndexFile, name ) && pakIndexFile->ReadInt( pos ) == sizeof( pos ) );
+		}
+		if ( !valid ) {
+			break;
+		}
+
+		pakIndexHash.Add( pakIndexHash.GenerateKey( entry.pakFilename, false ), pakIndex.Append( entry ) );
+	}
+}
+
+/*
+=================
+idFileSystemLocal::ReadPakFromIndex
+
+Fills in the file list and checksums of a pak from the pak index if the pak
+didn't change since the index was written.
+=================
+*/
+bool idFileSystemLocal::ReadPakFromIndex( pack_t *pak, const char *zipfile ) {
+	int i;
+
+	if ( !pakIndexFile ) {
+		return false;
+	}
+
+	for ( i = pakIndexHash.First( pakIndexHash.GenerateKey( zipfile, false ) ); i != -1; i = pakIndexHash.Next( i ) ) {
+		if ( pakIndex[i].pakFilename.Icmp( zipfile ) == 0 ) {
+			break;
+		}
+	}
+	if ( i == -1 ) {
+		return false;
+	}
+
+	pakIndexEntry_t &entry = pakIndex[i];
+	if ( entry.length != pak->length || entry.timestamp != (int)pak->timestamp || entry.numfiles != pak->numfiles ) {
+		return false;
+	}
+
+	pakIndexFile->Seek( entry.filesOffset, FS_SEEK_SET );
+	for ( int j = 0; j < entry.numfiles; j++ ) {
+		fileInPack_t *pakFile = &pak->buildBuffer[j];
+		int pos;
+
+		ReadIndexString( pakIndexFile, pakFile->name );
+		pakIndexFile->ReadInt( pos );
+		pakFile->pos = pos;
+
+		// add the file to the hash
+		const long hash = HashFileName( pakFile->name );
+		pakFile->next = pak->hashTable[hash];
+		pak->hashTable[hash] = pakFile;
+	}
+
+	pak->checksum = entry.checksum;
+	pak->binary = entry.binary;
+	pak->binaryOSMask = entry.binaryOSMask;
+	entry.used = true;
+
+	return true;
+}
+
+/*
+=================
+idFileSystemLocal::WritePakIndex
+
+Writes the index of all loaded paks if one of them wasn't in the old index,
+or if paks were removed.
+=================
+*/
+void idFileSystemLocal::WritePakIndex( void ) {
+	searchpath_t *	loop;
+	searchpath_t *	sp;
+	idList<pack_t *> paks;
+
+	if ( !fs_pakIndex.GetBool() || !fs_savepath.GetString()[0] ) {
+		return;
+	}
+
+	for ( loop = searchPaths; loop; loop == searchPaths ? loop = addonPaks : loop = NULL ) {
+		for ( sp = loop; sp; sp = sp->next ) {
+			if ( sp->pack ) {
+				paks.Append( sp->pack );
+			}
+		}
+	}
+
+	if ( !pakIndexChanged ) {
+		int numUsed = 0;
+		for ( int i = 0; i < pakIndex.Num(); i++ ) {
+			numUsed += pakIndex[i].used;
+		}
+		if ( numUsed == pakIndex.Num() && numUsed == paks.Num() ) {
+			return;
+		}
+	}
+
+	// the old index can't be written while it is mapped
+	FreePakIndex();
+
+	idFile *f = OpenExplicitFileWrite( BuildOSPath( fs_savepath.GetString(), "", PAK_INDEX_FILE ) );
+	if ( !f ) {
+		common->Warning( "Couldn't write %s", PAK_INDEX_FILE );
+		return;
+	}
+
+	f->WriteInt( PAK_INDEX_ID );
+	f->WriteInt( PAK_INDEX_VERSION );
+	f->WriteInt( paks.Num() );
+	for ( int i = 0; i < paks.Num(); i++ ) {
+		const pack_t *pak = paks[i];
+
+		f->WriteString( pak->pakFilename );
+		f->WriteInt( pak->length );
+		f->WriteInt( (int)pak->timestamp );
+		f->WriteInt( pak->checksum );
+		f->WriteInt( pak->binary == BINARY_YES );
+		f->WriteInt( pak->binaryOSMask );
+		f->WriteInt( pak->numfiles );
+		for ( int j = 0; j < pak->numfiles; j++ ) {
+			f->WriteString( pak->buildBuffer[j].name );
+			f->WriteInt( (int)pak->buildBuffer[j].pos );
+		}
+	}
+
+	CloseFile( f );
+
+	pakIndexChanged = false;
+}
+
+/*
+=================
+idFileSystemLocal::FreePakIndex
+=================
+*/
+void idFileSystemLocal::FreePakIndex( void ) {
+	delete pakIndexFile;
+	pakIndexFile = NULL;
+	delete pakIndexRegion;
+	pakIndexRegion = NULL;
+	delete pakIndexMapping;
+	pakIndexMapping = NULL;
+	pakIndex.Clear();
+	pakIndexHash.Clear();
 }
 
 /*
@@ -2046,6 +2403,9 @@ void idFileSystemLocal::Startup( void ) {
 		common->Printf( "restarting filesystem with %d addon pak file(s) to include\n", addonChecksums.Num() );
 	}
 
+	// file lists of the paks that didn't change since the last startup
+	LoadPakIndex();
+
     AddGameDirectory( fs_basepath.GetString(), "" ); // always add the basepath
 
     // fs_mod override
@@ -2171,6 +2531,9 @@ void idFileSystemLocal::Startup( void ) {
 	cmdSystem->AddCommand( "touchFile", TouchFile_f, CMD_FL_SYSTEM, "touches a file" );
 	cmdSystem->AddCommand( "touchFileList", TouchFileList_f, CMD_FL_SYSTEM, "touches a list of files" );
 
+	WritePakIndex();
+	FreePakIndex();
+
 	// print the current search paths
 	Path_f( idCmdArgs() );
 
@@ -2185,48 +2548,20 @@ idFileSystemLocal::UpdateGamePakChecksums
 */
 bool idFileSystemLocal::UpdateGamePakChecksums( void ) {
 	searchpath_t	*search;
-	fileInPack_t	*pakFile;
-	int				confHash;
-	idFile			*confFile;
-	char			*buf;
-	idLexer			*lexConf;
-	idToken			token;
-	int				id;
-
-	confHash = HashFileName( BINARY_CONFIG );
 
+	// the binary.conf files were parsed by LoadZipFile or come from the pak index
 	memset( gamePakForOS, 0, sizeof( gamePakForOS ) );
 	for ( search = searchPaths; search; search = search->next ) {
-		if ( !search->pack ) {
+		if ( !search->pack || search->pack->binary != BINARY_YES ) {
 			continue;
 		}
 
-		search->pack->binary = BINARY_NO;
-		for ( pakFile = search->pack->hashTable[confHash]; pakFile; pakFile = pakFile->next ) {
-			if ( !FilenameCompare( pakFile->name, BINARY_CONFIG ) ) {
-				search->pack->binary = BINARY_YES;
-				confFile = ReadFileFromZip( search->pack, pakFile, BINARY_CONFIG );
-
-				buf = new char[ confFile->Length() + 1 ];
-				confFile->Read( (void *)buf, confFile->Length() );
-				buf[ confFile->Length() ] = '\0';
-				lexConf = new idLexer( buf, confFile->Length(), confFile->GetFullPath() );
-
-				while ( lexConf->ReadToken( &token ) ) {
-					if ( token.IsNumeric() ) {
-						id = atoi( token );
-						if ( id < MAX_GAME_OS && !gamePakForOS[ id ] ) {
-							if ( fs_debug.GetBool() ) {
-								common->Printf( "Adding game pak checksum for OS %d: %s 0x%x\n", id, confFile->GetFullPath(), search->pack->checksum );
-							}
- 							gamePakForOS[ id ] = search->pack->checksum;
-						}
-					}
+		for ( int id = 0; id < MAX_GAME_OS; id++ ) {
+			if ( ( search->pack->binaryOSMask & ( 1 << id ) ) && !gamePakForOS[ id ] ) {
+				if ( fs_debug.GetBool() ) {
+					common->Printf( "Adding game pak checksum for OS %d: %s/%s 0x%x\n", id, search->pack->pakFilename.c_str(), BINARY_CONFIG, search->pack->checksum );
 				}
-
-				CloseFile( confFile );
-				delete lexConf;
-				delete[] buf;
+				gamePakForOS[ id ] = search->pack->checksum;
 			}
 		}
 	}
@@ -2440,6 +2775,7 @@ void idFileSystemLocal::Shutdown( bool reloading ) {
 
 			if ( sp->pack ) {
 				unzClose( sp->pack->handle );
+				delete sp->pack->mapping;
 				delete [] sp->pack->buildBuffer;
 				if ( sp->pack->addon_info ) {
 					sp->pack->addon_info->mapDecls.DeleteContents( true );
@@ -2568,11 +2904,54 @@ idFile_InZip * idFileSystemLocal::ReadFileFromZip( pack_t *pak, fileInPack_t *pa
 		file->zipFilePos = pakFile->pos;
 		file->fileSize = zfi->cur_file_info.uncompressed_size;
         file->fileLastMod = Sys_DosToUnixTime(zfi->cur_file_info.dosDate);
+
+		// remember where the data is, so stored files can be mapped
+		if ( zfi->pfile_in_zip_read ) {
+			file->pak = pak;
+			file->dataPos = zfi->pfile_in_zip_read->pos_in_zipfile + zfi->byte_before_the_zipfile;
+			file->stored = ( zfi->cur_file_info.compression_method == 0 && ( zfi->cur_file_info.flag & 1 ) == 0 );
+		}
 	}
 
 	return file;
 }
 
+/*
+===========
+idFileSystemLocal::MapStoredFile
+
+Maps the data of a file that is stored without compression, plus the byte after it.
+The mapping is copy on write, so the trailing 0 ReadFile guarantees can be written
+and callers may modify the buffer like a normal ReadFile buffer. That byte is always
+inside the pak, the local headers or the central directory follow the file data.
+Returns NULL if the pak can't be mapped, the caller reads the file normally then.
+===========
+*/
+byte * idFileSystemLocal::MapStoredFile( idFile_InZip *file ) {
+	pack_t *pak = file->pak;
+	mappedFile_t mapped;
+
+	try {
+		if ( pak->mapping == NULL ) {
+			pak->mapping = new boost::interprocess::file_mapping( pak->pakFilename.c_str(), boost::interprocess::read_only );
+		}
+		mapped.region = new boost::interprocess::mapped_region( *pak->mapping, boost::interprocess::copy_on_write, file->dataPos, file->fileSize + 1 );
+	} catch ( const boost::interprocess::interprocess_exception &e ) {
+		common->DWarning( "Couldn't map %s: %s", file->fullPath.c_str(), e.what() );
+		return NULL;
+	}
+
+	byte *buf = (byte *)mapped.region->get_address();
+
+	// guarantee that it will have a trailing 0 for string operations
+	buf[file->fileSize] = 0;
+
+	mapped.buffer = buf;
+	mappedFiles.Append( mapped );
+
+	return buf;
+}
+
 /*
 ===========
 idFileSystemLocal::OpenFileReadFlags
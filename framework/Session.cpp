@@ -24,6 +24,9 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "Session_local.h"
 
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
 idCVar	idSessionLocal::com_showAngles( "com_showAngles", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
 idCVar	idSessionLocal::com_minTics( "com_minTics", "1", CVAR_SYSTEM, "" );
 idCVar	idSessionLocal::com_showTics( "com_showTics", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
@@ -36,6 +39,7 @@ idCVar	idSessionLocal::com_aviDemoHeight( "com_aviDemoHeight", "256", CVAR_SYSTE
 idCVar	idSessionLocal::com_aviDemoTics( "com_aviDemoTics", "2", CVAR_SYSTEM | CVAR_INTEGER, "", 1, 60 );
 idCVar	idSessionLocal::com_wipeSeconds( "com_wipeSeconds", "1", CVAR_SYSTEM, "" );
 idCVar	idSessionLocal::com_guid( "com_guid", "", CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_ROM, "" );
+idCVar	idSessionLocal::com_asyncAutosave( "com_asyncAutosave", "1", CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_BOOL, "compress and write autosaves, quicksaves and console saves on a background thread while the game keeps running" );
 
 idSessionLocal		sessLocal;
 idSession			*session = &sessLocal;
@@ -46,6 +50,166 @@ const int PREVIEW_Y = 31;
 const int PREVIEW_WIDTH = 398;
 const int PREVIEW_HEIGHT = 298;
 
+/*
+===============================================================================
+
+	Background save
+
+	The savegame is serialized into memory on the main thread. The game leaves
+	its cache uncompressed, the worker thread has it compressed and appended by
+	idGame::FinishSaveGame and then writes the files, so play continues right
+	away. The worker uses plain stdio on paths resolved beforehand since the
+	file system is not thread safe. The result is picked up on the main thread
+	by idSessionLocal::FinishAsyncSave.
+
+===============================================================================
+*/
+
+class idAsyncSave {
+public:
+					idAsyncSave( void );
+					~idAsyncSave( void );
+
+					// starts writing gameData and descData to their OS paths
+	void			Start( void );
+					// true if the worker thread is finished
+	bool			IsDone( void );
+					// blocks until the worker thread is finished
+	void			Wait( void );
+
+	idStr			saveName;
+	idFile_Memory	gameData;				// savegame header and game state
+	idFile_Memory	descData;				// description file contents
+	idStr			gameOSPath;
+	idStr			gameTempOSPath;
+	idStr			descOSPath;
+	idStr			descTempOSPath;
+	int				serializeMsec;			// time spent on the main thread
+	int				writeMsec;				// time spent on the worker thread
+	char			report[MAX_STRING_CHARS];	// compression timings from the game
+	char			error[MAX_STRING_CHARS];	// empty if the save was written
+
+private:
+	boost::thread *	thread;
+	boost::mutex	mutex;
+	bool			done;
+
+	void			Run( void );
+	bool			WriteOSFile( const char *OSPath, const char *tempOSPath, const char *data, int length );
+};
+
+/*
+===============
+idAsyncSave::idAsyncSave
+===============
+*/
+idAsyncSave::idAsyncSave( void ) : gameData( "asyncSave" ), descData( "asyncSaveDesc" ) {
+	serializeMsec = 0;
+	writeMsec = 0;
+	report[0] = '\0';
+	error[0] = '\0';
+	thread = NULL;
+	done = false;
+}
+
+/*
+===============
+idAsyncSave::~idAsyncSave
+===============
+*/
+idAsyncSave::~idAsyncSave( void ) {
+	Wait();
+	delete thread;
+}
+
+/*
+===============
+idAsyncSave::Start
+===============
+*/
+void idAsyncSave::Start( void ) {
+	assert( thread == NULL );
+	thread = new boost::thread( boost::bind( &idAsyncSave::Run, this ) );
+}
+
+/*
+===============
+idAsyncSave::IsDone
+===============
+*/
+bool idAsyncSave::IsDone( void ) {
+	boost::mutex::scoped_lock lock( mutex );
+	return done;
+}
+
+/*
+===============
+idAsyncSave::Wait
+===============
+*/
+void idAsyncSave::Wait( void ) {
+	if ( thread != NULL && thread->joinable() ) {
+		thread->join();
+	}
+}
+
+/*
+===============
+idAsyncSave::WriteOSFile
+
+Writes to a temporary file first so a failed write doesn't destroy the previous autosave.
+===============
+*/
+bool idAsyncSave::WriteOSFile( const char *OSPath, const char *tempOSPath, const char *data, int length ) {
+	FILE *f = fopen( tempOSPath, "wb" );
+	if ( f == NULL ) {
+		idStr::snPrintf( error, sizeof( error ), "Failed to open save file '%s'", tempOSPath );
+		return false;
+	}
+
+	bool written = ( length == 0 || fwrite( data, length, 1, f ) == 1 );
+	written = ( fclose( f ) == 0 ) && written;
+	if ( !written ) {
+		idStr::snPrintf( error, sizeof( error ), "Failed to write save file '%s'", tempOSPath );
+		remove( tempOSPath );
+		return false;
+	}
+
+	// replace the previous file in one step, it stays intact if this fails
+#ifdef _WIN32
+	if ( !MoveFileEx( tempOSPath, OSPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) ) {
+#else
+	if ( rename( tempOSPath, OSPath ) != 0 ) {
+#endif
+		idStr::snPrintf( error, sizeof( error ), "Failed to rename '%s' to '%s'", tempOSPath, OSPath );
+		return false;
+	}
+	return true;
+}
+
+/*
+===============
+idAsyncSave::Run
+===============
+*/
+void idAsyncSave::Run( void ) {
+	int startTime = Sys_Milliseconds();
+
+	// the game appends its compressed state, the description is written last so
+	// the save doesn't show up in the menu before it is complete
+	if ( !game->FinishSaveGame( report, sizeof( report ) ) ) {
+		idStr::Copynz( error, report, sizeof( error ) );
+		report[0] = '\0';
+	} else if ( WriteOSFile( gameOSPath, gameTempOSPath, gameData.GetDataPtr(), gameData.Length() ) ) {
+		WriteOSFile( descOSPath, descTempOSPath, descData.GetDataPtr(), descData.Length() );
+	}
+
+	writeMsec = Sys_Milliseconds() - startTime;
+
+	boost::mutex::scoped_lock lock( mutex );
+	done = true;
+}
+
 void RandomizeStack( void ) {
 	// attempt to force uninitialized stack memory bugs
 	int		bytes = 4000000;
@@ -265,6 +429,7 @@ idSessionLocal::idSessionLocal() {
 	guiInGame = guiMainMenu = guiRestartMenu = guiLoading = guiActive = guiTest = guiMsg = guiMsgRestore = NULL;	
 
 	menuSoundWorld = NULL;
+	asyncSave = NULL;
 	
 	Clear();
 }
@@ -275,6 +440,7 @@ idSessionLocal::~idSessionLocal
 ===============
 */
 idSessionLocal::~idSessionLocal() {
+	delete asyncSave;
 }
 
 /*
@@ -287,6 +453,9 @@ called on errors and game exits
 void idSessionLocal::Stop() {
 	ClearWipe();
 
+	// a pending autosave has to be on disk before the game goes away
+	FinishAsyncSave( true );
+
 	// clear mapSpawned and demo playing flags
 	UnloadMap();
 
@@ -1603,6 +1772,19 @@ void LoadGame_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+===============
+AutoSaveGame_f
+===============
+*/
+void AutoSaveGame_f( const idCmdArgs &args ) {
+	if ( !sessLocal.mapSpawned ) {
+		common->Printf( "Not playing a game.\n" );
+		return;
+	}
+	sessLocal.SaveGame( sessLocal.GetAutoSaveName( sessLocal.mapSpawnData.serverInfo.GetString( "si_map" ) ), true, true );
+}
+
 /*
 ===============
 SaveGame_f
@@ -1611,11 +1793,12 @@ SaveGame_f
 void SaveGame_f( const idCmdArgs &args ) {
 	if ( args.Argc() < 2 || idStr::Icmp( args.Argv(1), "quick" ) == 0 ) {
 		idStr saveName = common->Translate( "#str_07178" );
-		if ( sessLocal.SaveGame( saveName ) ) {
+		if ( sessLocal.SaveGame( saveName, false, true ) ) {
 			common->Printf( "%s\n", saveName.c_str() );
 		}
 	} else {
-		if ( sessLocal.SaveGame( args.Argv(1) ) ) {
+		// this includes the final save at mission end, which the game issues as a command
+		if ( sessLocal.SaveGame( args.Argv(1), false, true ) ) {
 			common->Printf( "Saved %s\n", args.Argv(1) );
 		}
 	}
@@ -1682,7 +1865,7 @@ void idSessionLocal::ScrubSaveGameFileName( idStr &saveFileName ) const {
 idSessionLocal::SaveGame
 ===============
 */
-bool idSessionLocal::SaveGame( const char *saveName, bool autosave ) {
+bool idSessionLocal::SaveGame( const char *saveName, bool autosave, bool background ) {
 #ifdef	ID_DEDICATED
 	common->Printf( "Dedicated servers cannot save games.\n" );
 	return false;
@@ -1690,6 +1873,9 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave ) {
 	int i;
 	idStr gameFile, previewFile, descriptionFile, mapName;
 
+	// only one save can be in flight
+	FinishAsyncSave( true );
+
 	if ( !mapSpawned ) {
 		common->Printf( "Not playing a game.\n" );
 		return false;
@@ -1733,8 +1919,17 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave ) {
 	descriptionFile = gameFile;
 	descriptionFile.SetFileExtension( ".txt" );
 
-	// Open savegame file
-	idFile *fileOut = fileSystem->OpenFileWrite( gameFile );
+	// Open savegame file, background saves are serialized into memory and compressed and written on a thread
+	idAsyncSave *async = NULL;
+	idFile *fileOut;
+	if ( background && com_asyncAutosave.GetBool() ) {
+		async = new idAsyncSave;
+		async->saveName = saveName;
+		async->serializeMsec = Sys_Milliseconds();
+		fileOut = &async->gameData;
+	} else {
+		fileOut = fileSystem->OpenFileWrite( gameFile );
+	}
 	if ( fileOut == NULL ) {
 		common->Warning( "Failed to open save file '%s'", gameFile.c_str() );
 		if ( pauseWorld ) {
@@ -1765,10 +1960,12 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave ) {
 	}
 
 	// let the game save its state
-	game->SaveGame( fileOut );
+	game->SaveGame( fileOut, async != NULL );
 
 	// close the sava game file
-	fileSystem->CloseFile( fileOut );
+	if ( async == NULL ) {
+		fileSystem->CloseFile( fileOut );
+	}
 
 	// Write screenshot
 	if ( !autosave ) {
@@ -1780,7 +1977,7 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave ) {
 
 	// Write description, which is just a text file with
 	// the unclean save name on line 1, map name on line 2, screenshot on line 3
-	idFile *fileDesc = fileSystem->OpenFileWrite( descriptionFile );
+	idFile *fileDesc = ( async != NULL ) ? &async->descData : fileSystem->OpenFileWrite( descriptionFile );
 	if ( fileDesc == NULL ) {
 		common->Warning( "Failed to open description file '%s'", descriptionFile.c_str() );
 		if ( pauseWorld ) {
@@ -1811,7 +2008,20 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave ) {
 		fileDesc->Printf( "\"\"\n" );
 	}
 
-	fileSystem->CloseFile( fileDesc );
+	if ( async != NULL ) {
+		// resolve the paths the same way OpenFileWrite does, the worker can't use the file system
+		async->gameOSPath = fileSystem->RelativePathToOSPath( gameFile, "fs_modSavePath" );
+		async->gameTempOSPath = async->gameOSPath + ".tmp";
+		async->descOSPath = fileSystem->RelativePathToOSPath( descriptionFile, "fs_modSavePath" );
+		async->descTempOSPath = async->descOSPath + ".tmp";
+		fileSystem->CreateOSPath( async->gameOSPath );
+
+		async->serializeMsec = Sys_Milliseconds() - async->serializeMsec;
+		async->Start();
+		asyncSave = async;
+	} else {
+		fileSystem->CloseFile( fileDesc );
+	}
 
 	if ( pauseWorld ) {
 		soundSystem->SetPlayingSoundWorld( pauseWorld );
@@ -1825,6 +2035,49 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave ) {
 #endif
 }
 
+/*
+===============
+idSessionLocal::FinishAsyncSave
+
+Reports and releases a background save once it is written. If wait is
+false and the save is still being written this does nothing.
+===============
+*/
+void idSessionLocal::FinishAsyncSave( bool wait ) {
+	if ( asyncSave == NULL ) {
+		return;
+	}
+
+	if ( wait ) {
+		asyncSave->Wait();
+	} else if ( !asyncSave->IsDone() ) {
+		return;
+	}
+
+	// detach it first, the message box below runs frames
+	idAsyncSave *async = asyncSave;
+	asyncSave = NULL;
+
+	// the save directory changed behind the file system's back
+	fileSystem->ClearDirCache();
+
+	if ( async->error[0] != '\0' ) {
+		common->Warning( "%s", async->error );
+		if ( !wait && mapSpawned ) {
+			// "Unable to save"
+			MessageBox( MSG_OK, async->error, common->Translate( "#str_02013" ), true );
+		}
+	} else {
+		if ( async->report[0] != '\0' ) {
+			common->Printf( "%s\n", async->report );
+		}
+		common->Printf( "Savegame '%s' written (%d msec serializing, %d msec compressing and writing in the background)\n",
+			async->saveName.c_str(), async->serializeMsec, async->writeMsec );
+	}
+
+	delete async;
+}
+
 /*
 ===============
 idSessionLocal::LoadGame
@@ -1838,6 +2091,9 @@ bool idSessionLocal::LoadGame( const char *saveName ) {
 	int i;
 	idStr in, loadFile, saveMap, gamename;
 
+	// the save being loaded may still be in flight
+	FinishAsyncSave( true );
+
 	if ( IsMultiplayer() ) {
 		common->Printf( "Can't load during net play.\n" );
 		return false;
@@ -2305,6 +2561,9 @@ void idSessionLocal::Frame() {
 		soundSystem->AsyncUpdate( Sys_Milliseconds() );
 	}
 
+	// report a background autosave that finished writing
+	FinishAsyncSave( false );
+
 	// Editors that completely take over the game
 	if ( com_editorActive && ( com_editors & ( EDITOR_RADIANT | EDITOR_GUI ) ) ) {
 		return;
@@ -2640,6 +2899,7 @@ void idSessionLocal::Init() {
 
 #ifndef	ID_DEDICATED
 	cmdSystem->AddCommand( "saveGame", SaveGame_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "saves a game" );
+	cmdSystem->AddCommand( "autoSaveGame", AutoSaveGame_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "autosaves the game, see com_asyncAutosave" );
 	cmdSystem->AddCommand( "loadGame", LoadGame_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "loads a game", idCmdSystem::ArgCompletion_SaveGame );
 #endif
 
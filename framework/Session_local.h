@@ -134,7 +134,8 @@ public:
 	idStr				GetAutoSaveName( const char *mapName ) const;
 
 	bool				LoadGame(const char *saveName);
-	bool				SaveGame(const char *saveName, bool autosave = false);
+	bool				SaveGame(const char *saveName, bool autosave = false, bool background = false);
+	void				FinishAsyncSave( bool wait );
 
 	//=====================================
 
@@ -150,6 +151,7 @@ public:
 	static idCVar		com_aviDemoTics;
 	static idCVar		com_wipeSeconds;
 	static idCVar		com_guid;
+	static idCVar		com_asyncAutosave;
 
 	static idCVar		gui_configServerRate;
 
@@ -194,6 +196,8 @@ public:
 	int					lastDemoTic;
 	bool				syncNextGameFrame;
 
+	class idAsyncSave *	asyncSave;			// save being compressed and written on a background thread
+
 
 	bool				aviCaptureMode;		// if true, screenshots will be taken and sound captured
 	idStr				aviDemoShortName;	// 
@@ -137,6 +137,9 @@ void idSessionLocal::GetSaveGameList( idStrList &fileList, idList<fileTIME_T> &f
 	int i;
 	idFileList *files;
 
+	// make sure a background autosave shows up complete
+	FinishAsyncSave( true );
+
 	// NOTE: no fs_mod for savegames -- fan mission name stored in fs_currentfm
 	idStr game = cvarSystem->GetCVarString( "fs_currentfm" );
 	if( game.Length() ) {
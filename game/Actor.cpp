@@ -2187,18 +2187,12 @@ bool idActor::CanSee( idEntity *ent, bool useFov ) const
 			return true;
 		}
 
-		idVec3 origin;
-		idMat3 viewaxis;
-		actor->GetViewPos(origin, viewaxis);
-
-		const idVec3 &gravityDir = GetPhysics()->GetGravityNormal();
-		idVec3 dir = (viewaxis[0] - gravityDir * ( gravityDir * viewaxis[0] )).Cross(gravityDir);
-			
-		float dist = 8;
+		idVec3 leftShoulder, rightShoulder;
+		GetShoulderTestPoints(actor, entityOrigin, leftShoulder, rightShoulder);
 
-		if (!gameLocal.clip.TracePoint(result, eye, entityOrigin + (entityEyePos - entityOrigin)*0.7f + dir * dist, MASK_OPAQUE, this) 
+		if (!gameLocal.clip.TracePoint(result, eye, leftShoulder, MASK_OPAQUE, this) 
 			|| gameLocal.GetTraceEntity(result) == actor
-			|| !gameLocal.clip.TracePoint(result, eye, entityOrigin + (entityEyePos - entityOrigin)*0.7f - dir * dist, MASK_OPAQUE, this) // grayman #3525 - was tracing to same shoulder twice 
+			|| !gameLocal.clip.TracePoint(result, eye, rightShoulder, MASK_OPAQUE, this) // grayman #3525 - was tracing to same shoulder twice 
 			|| gameLocal.GetTraceEntity(result) == actor)
 		{
 			// Eye to shoulders traces succeeded
@@ -2263,6 +2257,27 @@ bool idActor::CanSee( idEntity *ent, bool useFov ) const
 	return false;
 }
 
+/*
+=====================
+idActor::GetShoulderTestPoints
+=====================
+*/
+void idActor::GetShoulderTestPoints( idActor *actor, const idVec3 &entityOrigin, idVec3 &left, idVec3 &right ) const
+{
+	idVec3 origin;
+	idMat3 viewaxis;
+	actor->GetViewPos(origin, viewaxis);
+
+	const idVec3 &gravityDir = GetPhysics()->GetGravityNormal();
+	idVec3 dir = (viewaxis[0] - gravityDir * ( gravityDir * viewaxis[0] )).Cross(gravityDir);
+
+	float dist = 8;
+	idVec3 neck = entityOrigin + (actor->GetEyePosition() - entityOrigin)*0.7f;
+
+	left = neck + dir * dist;
+	right = neck - dir * dist;
+}
+
 /*
 =====================
 idActor::PointVisible
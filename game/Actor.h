@@ -487,6 +487,11 @@ public:
 	 *         blocked, the entity is considered hidden and the method returns FALSE.
 	 */
 	virtual bool			CanSee( idEntity *ent, bool useFOV ) const;
+	/**
+	 * Returns the two points left and right of the other actor's head that CanSee()
+	 * traces to when neither the eyes nor the origin of that actor are visible.
+	 */
+	void					GetShoulderTestPoints( idActor *actor, const idVec3 &entityOrigin, idVec3 &left, idVec3 &right ) const;
 	bool					PointVisible( const idVec3 &point ) const;
 	virtual void			GetAIAimTargets( const idVec3 &lastSightPos, idVec3 &headPos, idVec3 &chestPos );
 
@@ -112,7 +112,12 @@ public:
 	virtual bool				InitFromSaveGame( const char *mapName, idRenderWorld *renderWorld, idSoundWorld *soundWorld, idFile *saveGameFile ) = 0;
 
 	// Saves the current game state, the session may have written some data to the file already.
-	virtual void				SaveGame( idFile *saveGameFile ) = 0;
+	// With deferCompression the compressed game state is only appended by FinishSaveGame.
+	virtual void				SaveGame( idFile *saveGameFile, bool deferCompression = false ) = 0;
+
+	// Compresses and appends the game state a deferred SaveGame left out. Safe to call from another
+	// thread while the game runs. Fills in a report for the console, or the error and returns false.
+	virtual bool				FinishSaveGame( char *report, int reportSize ) = 0;
 
 	// Shut down the current map.
 	virtual void				MapShutdown( void ) = 0;
@@ -84,6 +84,9 @@ idCVar *					idCVar::staticVars = NULL;
 
 idCVar com_forceGenericSIMD( "com_forceGenericSIMD", "0", CVAR_BOOL|CVAR_SYSTEM, "force generic platform independent SIMD" );
 
+// worker threads of the game job pool, the engine pool already has one for each core
+const int MAX_GAME_JOB_THREADS = 2;
+
 #endif
 
 idRenderWorld *				gameRenderWorld = NULL;		// all drawing is done to this world
@@ -230,7 +233,8 @@ idGameLocal::idGameLocal() :
 	briefingVideoInfoLoaded(false),
 	curBriefingVideoPart(-1),
 	m_MissionResult(MISSION_NOTEVENSTARTED),
-	m_HighestSRId(0)
+	m_HighestSRId(0),
+	pendingSaveCache(NULL)
 {
 	Clear();
 }
@@ -436,6 +440,10 @@ void idGameLocal::Init( void ) {
 	// initialize processor specific SIMD
 	idSIMD::InitProcessor( "game", com_forceGenericSIMD.GetBool() );
 
+	// the game has its own job pool next to the engine's, it only helps out the game
+	// thread so keep it small instead of starting a second thread for every core
+	jobPool.Init( cvarSystem->GetCVarInteger( "com_jobThreads" ), MAX_GAME_JOB_THREADS );
+
 #endif
 
 	Printf( "--------- Initializing Game ----------\n" );
@@ -693,6 +701,9 @@ void idGameLocal::Shutdown( void ) {
 	aasList.DeleteContents( true );
 	aasNames.Clear();
 
+	delete pendingSaveCache;
+	pendingSaveCache = NULL;
+
 	idAI::FreeObstacleAvoidanceNodes();
 
 	// shutdown the model exporter
@@ -729,6 +740,9 @@ void idGameLocal::Shutdown( void ) {
 	// shut down the animation manager
 	animationLib.Shutdown();
 
+	// free the per-frame scratch memory
+	frameAllocator.Shutdown();
+
 	Printf( "--------------------------------------\n" );
 
 #ifdef GAME_DLL
@@ -736,6 +750,9 @@ void idGameLocal::Shutdown( void ) {
 	// remove auto-completion function pointers pointing into this DLL
 	cvarSystem->RemoveFlaggedAutoCompletion( CVAR_GAME );
 
+	// stop the worker threads of the game job pool
+	jobPool.Shutdown();
+
 	// enable leak test
 	Mem_EnableLeakTest( "game" );
 
@@ -753,10 +770,10 @@ save the current player state, level name, and level state
 the session may have written some data to the file already
 ============
 */
-void idGameLocal::SaveGame( idFile *f ) {
+void idGameLocal::SaveGame( idFile *f, bool deferCompression ) {
 	int i;
 
-	idSaveGame savegame( f );
+	idSaveGame savegame( f, deferCompression );
 
 	if (g_flushSave.GetBool( ) == true ) { 
 		// force flushing with each write... for tracking down
@@ -1068,13 +1085,41 @@ void idGameLocal::SaveGame( idFile *f ) {
 	// greebo: Close the savegame, this will invoke a recursive Save on all registered objects
 	savegame.Close();
 
-	// save all accumulated cache to file
-	savegame.FinalizeCache();
+	if ( deferCompression ) {
+		// the session compresses and appends the cache on its save thread
+		delete pendingSaveCache;
+		pendingSaveCache = savegame.DetachCache();
+	} else {
+		// save all accumulated cache to file
+		savegame.FinalizeCache();
+	}
 
 	// Send a message to the HUD
 	GetLocalPlayer()->SendHUDMessage("#str_02916");	// "Game Saved"
 }
 
+/*
+===========
+idGameLocal::FinishSaveGame
+
+called by the session's save thread, the session doesn't start another save before this returns
+============
+*/
+bool idGameLocal::FinishSaveGame( char *report, int reportSize ) {
+	idSaveGameCache *cache = pendingSaveCache;
+	pendingSaveCache = NULL;
+
+	report[0] = '\0';
+	if ( cache == NULL ) {
+		// the savegame is not compressed, it is complete already
+		return true;
+	}
+
+	bool finished = cache->Finish( report, reportSize );
+	delete cache;
+	return finished;
+}
+
 /*
 ===========
 idGameLocal::GetPersistentPlayerInfo
@@ -3151,6 +3196,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			// sort the active entity list
 			SortActiveEntityList();
 
+			// TDM: Batch the line of sight traces of the AI looking for the player
+			RunAIPerception();
+
 			timer_think.Clear();
 			timer_think.Start();
 
@@ -3328,6 +3376,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 
 	g_Global.m_Frame = 0;
 
+	// release the scratch memory used during this frame
+	frameAllocator.Reset( g_frameAllocPoison.GetBool() );
+
 	return ret;
 }
 
@@ -7161,6 +7212,34 @@ CStimResponsePtr idGameLocal::FindStimResponse(int uniqueId)
 	return CStimResponsePtr();
 }
 
+void idGameLocal::RunAIPerception( void )
+{
+	if ( !cv_ai_opt_parallel_perception.GetBool() )
+	{
+		return;
+	}
+
+	idPlayer* player = GetLocalPlayer();
+	if ( ( player == NULL ) || player->fl.notarget || ( player->health <= 0 ) )
+	{
+		return;
+	}
+
+	idList<idAI*> ais;
+	for ( idEntity* ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
+	{
+		if ( ent->IsType(idAI::Type) && static_cast<idAI*>(ent)->WantsPlayerPerception(player) )
+		{
+			ais.Append( static_cast<idAI*>(ent) );
+		}
+	}
+
+	if ( ais.Num() > 0 )
+	{
+		idAI::UpdatePlayerPerception( ais.Ptr(), ais.Num(), player );
+	}
+}
+
 void idGameLocal::ProcessStimResponse(unsigned long ticks)
 {
 	if (cv_sr_disable.GetBool())
@@ -7172,6 +7251,13 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 	srTimer.Clear();
 	srTimer.Start();
 
+	// Per stim type timing, the last slot collects the user defined types
+	const int numTimedTypes = ST_BLIND + 2;
+	idTimer srTypeTimer[numTimedTypes];
+	int srTypeCount[numTimedTypes];
+	memset(srTypeCount, 0, sizeof(srTypeCount));
+	const bool timeTypes = cv_sr_timing.GetBool();
+
 	// Check the timed stims first.
 	for (int i = 0; i < m_StimTimer.Num(); i++)
 	{
@@ -7287,6 +7373,12 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 			{
 				int numResponses = 0;
 
+				int timedType = (stim->m_StimTypeId >= 0 && stim->m_StimTypeId <= ST_BLIND) ? stim->m_StimTypeId : numTimedTypes - 1;
+				if (timeTypes)
+				{
+					srTypeTimer[timedType].Start();
+				}
+
 				// Check if we have fixed bounds to work with (sr_bounds_mins & maxs set)
 				if (stim->m_Bounds.GetVolume() > 0) {
 					bounds = idBounds(stim->m_Bounds[0] + origin, stim->m_Bounds[1] + origin);
@@ -7323,8 +7415,8 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 				}
 				else 
 				{
-					// Radius based stims
-					n = clip.EntitiesTouchingBounds(bounds, CONTENTS_RESPONSE, srEntities, MAX_GENTITIES);
+					// Radius based stims, only the clip models with CONTENTS_RESPONSE are searched
+					n = clip.ResponseEntitiesTouchingBounds(bounds, srEntities, MAX_GENTITIES);
 					//DM_LOG(LC_STIM_RESPONSE, LT_INFO)LOGSTRING("Entities touching bounds: %d\r", n);
 				}
 				
@@ -7345,12 +7437,32 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 
 				// The stim has fired, let it do any post-firing activity it may have
 				stim->PostFired(numResponses);
+
+				if (timeTypes)
+				{
+					srTypeTimer[timedType].Stop();
+					srTypeCount[timedType]++;
+				}
 			}
 		}
 	}
 
 	srTimer.Stop();
 	DM_LOG(LC_STIM_RESPONSE, LT_INFO)LOGSTRING("Processing S/R took %lf\r", srTimer.Milliseconds());
+
+	if (timeTypes)
+	{
+		Printf("S/R: %.3f ms total\n", srTimer.Milliseconds());
+
+		for (int i = 0; i < numTimedTypes; i++)
+		{
+			if (srTypeCount[i] == 0) continue;
+
+			const char* typeName = (i < numTimedTypes - 1) ? cStimType[i] : "user defined";
+			Printf("  %-20s %3d stims %.3f ms\n", typeName, srTypeCount[i], srTypeTimer[i].Milliseconds());
+			DM_LOG(LC_STIM_RESPONSE, LT_INFO)LOGSTRING("%s: %d stims took %lf\r", typeName, srTypeCount[i], srTypeTimer[i].Milliseconds());
+		}
+	}
 }
 
 /*
@@ -705,7 +705,8 @@ public:
 	virtual void			SetPersistentPlayerInfo( int clientNum, const idDict &playerInfo );
 	virtual void			InitFromNewMap( const char *mapName, idRenderWorld *renderWorld, idSoundWorld *soundWorld, bool isServer, bool isClient, int randSeed );
 	virtual bool			InitFromSaveGame( const char *mapName, idRenderWorld *renderWorld, idSoundWorld *soundWorld, idFile *saveGameFile );
-	virtual void			SaveGame( idFile *saveGameFile );
+	virtual void			SaveGame( idFile *saveGameFile, bool deferCompression = false );
+	virtual bool			FinishSaveGame( char *report, int reportSize );
 	virtual void			MapShutdown( void );
 	virtual void			CacheDictionaryMedia( const idDict *dict );
 	virtual void			SpawnPlayer( int clientNum );
@@ -948,6 +949,12 @@ public:
 	 */
 	void					ProcessStimResponse(unsigned long ticks);
 
+	/**
+	 * Takes the player visibility snapshot of all AI that look for the player this frame,
+	 * see idAI::UpdatePlayerPerception. Called right before the entities think.
+	 */
+	void					RunAIPerception( void );
+
 	/**
 	 * greebo: Traverses the entities and tries to find the Stim/Response with the given ID.
 	 * This is expensive, so don't call this during map runtime, only in between maps.
@@ -1070,6 +1077,9 @@ private:
 	// how many arguments do we expect for the current command (m_GUICommandStack[0]):
 	int							m_GUICommandArgs;
 
+	// the cache of a deferred SaveGame until the session calls FinishSaveGame
+	idSaveGameCache *			pendingSaveCache;
+
 	void					Clear( void );
 							// returns true if the entity shouldn't be spawned at all in this game type or difficulty level
 	bool					InhibitEntitySpawn( idDict &spawnArgs );
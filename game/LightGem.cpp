@@ -25,6 +25,17 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "LightGem.h"
 #include "Grabber.h"
 
+#ifdef ID_SSE2_INTRINSICS
+#include <emmintrin.h>
+#endif
+
+// Triangle (0..3) of each pixel in the lightgem render, see AnalyzeRenderImage
+static byte lgTriangleMask[DARKMOD_LG_RENDER_WIDTH * DARKMOD_LG_RENDER_WIDTH];
+
+// Per triangle channel weights for every byte of the render, zero outside of the triangle
+static ALIGN16( short lgTriangleWeights[DARKMOD_LG_MAX_IMAGESPLIT][DARKMOD_LG_IMAGE_BYTES] );
+static bool lgTriangleMasksValid = false;
+
 // Temporary profiling related macros
 
 //#define ENABLE_PROFILING
@@ -65,6 +76,8 @@ public:																											\
 //----------------------------------------------------
 LightGem::LightGem()
 {
+	InitTriangleMasks();
+
 	// our image buffer will be X*Y*Number of channels (RGB)*Size of internal storage type
 	// this allocation will be destroyed in the destructor
 	m_LightgemImgBuffer = (unsigned char*)malloc( (DARKMOD_LG_RENDER_WIDTH * DARKMOD_LG_RENDER_WIDTH * DARKMOD_LG_BPP) * sizeof(ILuint) );
@@ -277,6 +290,8 @@ float LightGem::Calculate(idPlayer *player)
 	float fRetVal = 0.0f;
 	const int k = cv_lg_hud.GetInteger() - 1;
 	static const int nRenderPasses = cv_lg_renderpasses.GetInteger();
+	const bool async = cv_lg_async.GetBool();
+	idTimer timerRender, timerCapture, timerAnalyze;
 
 	renderSystem->CropRenderSize(DARKMOD_LG_RENDER_WIDTH, DARKMOD_LG_RENDER_WIDTH, true, true);
 
@@ -288,7 +303,10 @@ float LightGem::Calculate(idPlayer *player)
 			continue;
 		}
 
-		m_LightgemShotValue[i] = 0.0f;
+		// with asynchronous read back the value stays until the next render of this pass arrives
+		if ( !async ) {
+			m_LightgemShotValue[i] = 0.0f;
+		}
 
 		// Render up and down alternately 
 		m_Lightgem_rv.viewaxis.TransposeSelf();
@@ -303,15 +321,29 @@ float LightGem::Calculate(idPlayer *player)
 			// 45 degree, thus the square shape.
 			PROFILE_BLOCK_START	( LightGem_Calculate_ForLoop_RenderScene );
 
+			timerRender.Start();
 			gameRenderWorld->SetRenderView(&m_Lightgem_rv); // most likely not needed
 			gameRenderWorld->RenderScene(&m_Lightgem_rv);
+			timerRender.Stop();
 
 			PROFILE_BLOCK_END	( LightGem_Calculate_ForLoop_RenderScene );
 
 			PROFILE_BLOCK_START	( LightGem_Calculate_ForLoop_CaptureRenderToBuffer );
 			DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("Rendering to lightgem render buffer\n");
 
-			renderSystem->CaptureRenderToBuffer(m_LightgemImgBuffer);
+			timerCapture.Start();
+			if ( async ) {
+				// each render pass has its own capture stream, the buffer receives the previous
+				// render of this pass. Keep the old value until the first render arrives.
+				const bool captured = renderSystem->CaptureRenderToBufferAsync(m_LightgemImgBuffer, i);
+				timerCapture.Stop();
+				if ( !captured ) {
+					continue;
+				}
+			} else {
+				renderSystem->CaptureRenderToBuffer(m_LightgemImgBuffer);
+				timerCapture.Stop();
+			}
 			PROFILE_BLOCK_END	( LightGem_Calculate_ForLoop_CaptureRenderToBuffer );
 
 #if 0
@@ -328,12 +360,15 @@ float LightGem::Calculate(idPlayer *player)
 #endif
 
 			PROFILE_BLOCK_START	( LightGem_Calculate_ForLoop_AnalyzeRenderImage );
+			timerAnalyze.Start();
 			AnalyzeRenderImage();
+			timerAnalyze.Stop();
 			PROFILE_BLOCK_END	( LightGem_Calculate_ForLoop_AnalyzeRenderImage );
 
 			PROFILE_BLOCK_START	( LightGem_Calculate_ForLoop_Cleanup );
 
 			// Check which of the images has the brightest value, and this is what we will use.
+			m_LightgemShotValue[i] = 0.0f;
 			for (int l = 0; l < DARKMOD_LG_MAX_IMAGESPLIT; l++) {
 				if (m_fColVal[l] > m_LightgemShotValue[i]) {
 					m_LightgemShotValue[i] = m_fColVal[l];
@@ -346,6 +381,11 @@ float LightGem::Calculate(idPlayer *player)
 
 	renderSystem->UnCrop();
 
+	if ( cv_lg_timing.GetBool() ) {
+		gameLocal.Printf( "lightgem %s: render %.3f ms, read back %.3f ms, analyze %.3f ms\n", async ? "async" : "sync",
+			timerRender.Milliseconds(), timerCapture.Milliseconds(), timerAnalyze.Milliseconds() );
+	}
+
 	PROFILE_BLOCK_START	( LightGem_Calculate_UnSetup );
 
 	// and switch back our normal render definition - player model and head are returned
@@ -384,35 +424,28 @@ float LightGem::Calculate(idPlayer *player)
 	return fRetVal;
 }
 
-void LightGem::AnalyzeRenderImage()
+void LightGem::InitTriangleMasks()
 {
-	const unsigned char *buffer = m_LightgemImgBuffer;
-	
-	// The lightgem will simply blink if the renderbuffer doesn't work.
-	if ( buffer == NULL ) {
-		DM_LOG(LC_SYSTEM, LT_ERROR)LOGSTRING("Unable to read image from lightgem render-buffer\r");
-
-		for ( int i = 0; i < DARKMOD_LG_MAX_IMAGESPLIT; i++ ) {
-			m_fColVal[i] = (gameLocal.time % 1024 ) > 512;
-		}
-
+	if ( lgTriangleMasksValid ) {
 		return;
 	}
-	
+
 	/* 	Split up the image into the 4 triangles
 
 		 \11/	0 - east of lightgem render
 		3 \/ 0	1 - north of lg
 		3 /\ 0	2 - south of lg
 		 /22\	3 - west of lg
-	
-		Note : Serp - This is a simplification of the early version which used two nested loops
 	*/
 
-	int in = 0;
+	const short channelWeights[DARKMOD_LG_BPP] = { DARKMOD_LG_RED_WEIGHT, DARKMOD_LG_GREEN_WEIGHT, DARKMOD_LG_BLUE_WEIGHT };
 
+	memset( lgTriangleWeights, 0, sizeof( lgTriangleWeights ) );
+
+	int pixel = 0;
 	for ( int x = 0; x < DARKMOD_LG_RENDER_WIDTH; x++ ) {
-		for ( int y = 0; y < DARKMOD_LG_RENDER_WIDTH; y++, buffer += DARKMOD_LG_BPP ) { // increment the buffer pos
+		for ( int y = 0; y < DARKMOD_LG_RENDER_WIDTH; y++, pixel++ ) {
+			int in;
 			if ( y <= x && x + y >= (DARKMOD_LG_RENDER_WIDTH -1) ) {
 				in = 0;
 			} else if ( y < x ) {
@@ -423,18 +456,93 @@ void LightGem::AnalyzeRenderImage()
 				in = 3;
 			}
 
-			// The order is RGB. NOTE: Serp - I have moved the scale into the rgb multiplier
-			// this is to move the calculation into the precompiler (could move to .h directly)
-			m_fColVal[in] += (buffer[0] * (DARKMOD_LG_RED  * DARKMOD_LG_SCALE) +
-							  buffer[1] * (DARKMOD_LG_GREEN* DARKMOD_LG_SCALE) +
-							  buffer[2] * (DARKMOD_LG_BLUE * DARKMOD_LG_SCALE));
+			lgTriangleMask[pixel] = in;
+			for ( int c = 0; c < DARKMOD_LG_BPP; c++ ) {
+				lgTriangleWeights[in][pixel * DARKMOD_LG_BPP + c] = channelWeights[c];
+			}
+		}
+	}
+
+	lgTriangleMasksValid = true;
+}
+
+#ifdef ID_SSE2_INTRINSICS
+
+/*
+================
+LG_SumTrianglesSSE2
+
+Weighted luminance sums of the 4 triangles, 16 bytes of the render at a time.
+================
+*/
+ID_SSE2_FUNC static void LG_SumTrianglesSSE2( const unsigned char *buffer, int sums[DARKMOD_LG_MAX_IMAGESPLIT] )
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc0 = zero;
+	__m128i acc1 = zero;
+	__m128i acc2 = zero;
+	__m128i acc3 = zero;
+
+	for ( int i = 0; i < DARKMOD_LG_IMAGE_BYTES; i += 16 ) {
+		const __m128i pixels = _mm_loadu_si128( (const __m128i *)( buffer + i ) );
+		const __m128i lo = _mm_unpacklo_epi8( pixels, zero );
+		const __m128i hi = _mm_unpackhi_epi8( pixels, zero );
+
+		acc0 = _mm_add_epi32( acc0, _mm_add_epi32( _mm_madd_epi16( lo, _mm_load_si128( (const __m128i *)( lgTriangleWeights[0] + i ) ) ),
+												   _mm_madd_epi16( hi, _mm_load_si128( (const __m128i *)( lgTriangleWeights[0] + i + 8 ) ) ) ) );
+		acc1 = _mm_add_epi32( acc1, _mm_add_epi32( _mm_madd_epi16( lo, _mm_load_si128( (const __m128i *)( lgTriangleWeights[1] + i ) ) ),
+												   _mm_madd_epi16( hi, _mm_load_si128( (const __m128i *)( lgTriangleWeights[1] + i + 8 ) ) ) ) );
+		acc2 = _mm_add_epi32( acc2, _mm_add_epi32( _mm_madd_epi16( lo, _mm_load_si128( (const __m128i *)( lgTriangleWeights[2] + i ) ) ),
+												   _mm_madd_epi16( hi, _mm_load_si128( (const __m128i *)( lgTriangleWeights[2] + i + 8 ) ) ) ) );
+		acc3 = _mm_add_epi32( acc3, _mm_add_epi32( _mm_madd_epi16( lo, _mm_load_si128( (const __m128i *)( lgTriangleWeights[3] + i ) ) ),
+												   _mm_madd_epi16( hi, _mm_load_si128( (const __m128i *)( lgTriangleWeights[3] + i + 8 ) ) ) ) );
+	}
+
+	// transpose so that each lane holds the total of one triangle
+	const __m128i t0 = _mm_add_epi32( _mm_unpacklo_epi32( acc0, acc1 ), _mm_unpackhi_epi32( acc0, acc1 ) );
+	const __m128i t1 = _mm_add_epi32( _mm_unpacklo_epi32( acc2, acc3 ), _mm_unpackhi_epi32( acc2, acc3 ) );
+	const __m128i total = _mm_add_epi32( _mm_unpacklo_epi64( t0, t1 ), _mm_unpackhi_epi64( t0, t1 ) );
+
+	_mm_storeu_si128( (__m128i *)sums, total );
+}
+
+#endif
+
+void LightGem::AnalyzeRenderImage()
+{
+	const unsigned char *buffer = m_LightgemImgBuffer;
+	
+	// The lightgem will simply blink if the renderbuffer doesn't work.
+	if ( buffer == NULL ) {
+		DM_LOG(LC_SYSTEM, LT_ERROR)LOGSTRING("Unable to read image from lightgem render-buffer\r");
+
+		for ( int i = 0; i < DARKMOD_LG_MAX_IMAGESPLIT; i++ ) {
+			m_fColVal[i] = (gameLocal.time % 1024 ) > 512;
+		}
+
+		return;
+	}
+
+	// Sum up the weighted luminance of each of the 4 triangles, the triangle of each pixel
+	// is looked up in the masks built by InitTriangleMasks.
+	int sums[DARKMOD_LG_MAX_IMAGESPLIT];
+
+#ifdef ID_SSE2_INTRINSICS
+	if ( SIMD_HasSSE2() ) {
+		LG_SumTrianglesSSE2( buffer, sums );
+	} else
+#endif
+	{
+		sums[0] = sums[1] = sums[2] = sums[3] = 0;
+		for ( int i = 0; i < DARKMOD_LG_RENDER_WIDTH * DARKMOD_LG_RENDER_WIDTH; i++, buffer += DARKMOD_LG_BPP ) {
+			// The order is RGB
+			sums[lgTriangleMask[i]] += buffer[0] * DARKMOD_LG_RED_WEIGHT + buffer[1] * DARKMOD_LG_GREEN_WEIGHT + buffer[2] * DARKMOD_LG_BLUE_WEIGHT;
 		}
 	}
 
 	// Calculate the average for each value
-	// Could be moved to the return
-	m_fColVal[0] *= DARKMOD_LG_TRIRATIO;
-	m_fColVal[1] *= DARKMOD_LG_TRIRATIO;
-	m_fColVal[2] *= DARKMOD_LG_TRIRATIO;
-	m_fColVal[3] *= DARKMOD_LG_TRIRATIO;
+	const float scale = DARKMOD_LG_SCALE * DARKMOD_LG_TRIRATIO / DARKMOD_LG_WEIGHT_SCALE;
+	for ( int i = 0; i < DARKMOD_LG_MAX_IMAGESPLIT; i++ ) {
+		m_fColVal[i] = sums[i] * scale;
+	}
 }
@@ -49,6 +49,14 @@
 #define DARKMOD_LG_SCALE					(1.0f/255.0f)			// scaling factor for grayscale value
 #define DARKMOD_LG_TRIRATIO					(1.0f/((DARKMOD_LG_RENDER_WIDTH*DARKMOD_LG_RENDER_WIDTH)/4.0f))
 
+// The image analysis sums the luminance in fixed point, these are the channel factors above scaled
+// by DARKMOD_LG_WEIGHT_SCALE. The sum of a whole image still fits into 32 bits.
+#define DARKMOD_LG_WEIGHT_SCALE				4096
+#define DARKMOD_LG_RED_WEIGHT				1225
+#define DARKMOD_LG_GREEN_WEIGHT				2404
+#define DARKMOD_LG_BLUE_WEIGHT				467
+#define DARKMOD_LG_IMAGE_BYTES				(DARKMOD_LG_RENDER_WIDTH*DARKMOD_LG_RENDER_WIDTH*DARKMOD_LG_BPP)
+
 //----------------------------------
 // Class Declarations.
 //----------------------------------
@@ -99,6 +107,9 @@ public:
 
 private:
 	void AnalyzeRenderImage	( );
+
+	// Builds the per pixel triangle masks used by AnalyzeRenderImage
+	static void InitTriangleMasks( );
 };
 
 #endif // __LIGHTGEM_H__
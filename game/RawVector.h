@@ -44,6 +44,11 @@ public:
 		m_Size = newSize;
 	}
 
+	inline void reserve(int newCapacity)
+	{
+		if (newCapacity > m_Capacity) reallocate(newCapacity);
+	}
+
 	//note: does not free memory!
 	void clear();
 
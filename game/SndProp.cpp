@@ -439,7 +439,7 @@ void CsndProp::Propagate
 	
 	idBounds	envBounds(origin);
 	idAI				*testAI;
-	idList<idEntity *>	validTypeEnts, validEnts;
+	idList<idEntity *, idListFrameAllocator>	validTypeEnts, validEnts;
 	SPopArea			*pPopArea;
 
 	idTimer timer_Prop;
@@ -842,8 +842,8 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin)
 	int					//popIndex(-1),
 		floods(1), nodes(0), area, LocalPort;
 	float				tempDist(0), tempAtt(1), tempLoss(0), AddedDist(0);
-	idList<SExpQue>		NextAreas; // expansion queue
-	idList<SExpQue>		AddedAreas; // temp storage for next expansion queue
+	idList<SExpQue, idListFrameAllocator>		NextAreas; // expansion queue
+	idList<SExpQue, idListFrameAllocator>		AddedAreas; // temp storage for next expansion queue
 	SExpQue				tempQEntry;
 	SPortEvent			*pPortEv; // pointer to portal event data
 	SPopArea			*pPopArea; // pointer to populated area data
@@ -934,7 +934,7 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin)
 
 		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Expansion loop, iteration %d\r", floods);
 
-		AddedAreas.Clear();
+		AddedAreas.SetNum( 0, false );
 
 		for(int j=0; j < NextAreas.Num(); j++)
 		{
@@ -1049,8 +1049,8 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin)
 			m_EventAreas[area].bVisited = true;
 		} // end area flood loop
 
-		// create the next expansion queue
-		NextAreas = AddedAreas;
+		// create the next expansion queue, the old queue is reused for the added areas
+		NextAreas.Swap( AddedAreas );
 
 	} // end main loop
 
@@ -1067,7 +1067,7 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 	idVec3 testLoc;
 	SPortEvent *pPortEv;
 	SPopArea *pPopArea;
-	idList<idVec3> showPoints;
+	idList<idVec3, idListFrameAllocator> showPoints;
 	
 	int initArea = gameRenderWorld->PointInArea( origin );
 
@@ -1396,8 +1396,8 @@ Quit:
 
 void CsndProp::DetailedMin( idAI* AI, SSprParms *propParms, SPortEvent *pPortEv, int AIArea, float volInit )
 {
-	idList<idVec3>		pathPoints; // pathpoints[0] = closest path point to the TARGET
-	idList<SPortEvent*> PortPtrs; // pointers to the portals along the path
+	idList<idVec3, idListFrameAllocator>		pathPoints; // pathpoints[0] = closest path point to the TARGET
+	idList<SPortEvent*, idListFrameAllocator> PortPtrs; // pointers to the portals along the path
 	idVec3				point, p1, p2, AIpos;
 	int					floods, curArea;
 	float				tempAtt, tempDist, totAtt, totDist, totLoss;
@@ -1514,7 +1514,7 @@ Quit:
 	return;
 }
 
-void CsndProp::DrawLines(idList<idVec3>& pointlist)
+void CsndProp::DrawLines(idList<idVec3, idListFrameAllocator>& pointlist)
 {
 	for (int i = 0; i < (pointlist.Num() - 1); i++)
 	{
@@ -1544,8 +1544,8 @@ bool CsndProp::ExpandWaveFast( float volInit, idVec3 origin, float MaxDist, int
 	int					//popIndex(-1),
 		floods(1), nodes(0), area, LocalPort, FloodLimit;
 	float				tempDist(0), tempAtt(1), AddedDist(0);
-	idList<SExpQue>		NextAreas; // expansion queue
-	idList<SExpQue>		AddedAreas; // temp storage for next expansion queue
+	idList<SExpQue, idListFrameAllocator>		NextAreas; // expansion queue
+	idList<SExpQue, idListFrameAllocator>		AddedAreas; // temp storage for next expansion queue
 	SExpQue				tempQEntry;
 	SPortEvent			*pPortEv; // pointer to portal event data
 	SPopArea			*pPopArea; // pointer to populated area data
@@ -1633,7 +1633,7 @@ bool CsndProp::ExpandWaveFast( float volInit, idVec3 origin, float MaxDist, int
 
 		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Expansion loop, iteration %d\r", floods);
 
-		AddedAreas.Clear();
+		AddedAreas.SetNum( 0, false );
 
 		for(int j=0; j < NextAreas.Num(); j++)
 		{
@@ -1739,8 +1739,8 @@ bool CsndProp::ExpandWaveFast( float volInit, idVec3 origin, float MaxDist, int
 
 		} // end area flood loop
 
-		// create the next expansion queue
-		NextAreas = AddedAreas;
+		// create the next expansion queue, the old queue is reused for the added areas
+		NextAreas.Swap( AddedAreas );
 
 	} // end main loop
 
@@ -51,6 +51,16 @@ idAASLocal::idAASLocal( void )
 {
 	elevatorSystem = new eas::tdmEAS(this);
 	file = NULL;
+	changedAreas = NULL;
+	numChangedAreas = 0;
+	precomputedTravelFlags = 0;
+	precomputedClusterOffset = NULL;
+	numPrecomputedAreaTimes = 0;
+	precomputedAreaTravelTimes = NULL;
+	precomputedAreaReachabilities = NULL;
+	precomputedPortalAreas = NULL;
+	precomputedPortalTravelTimes = NULL;
+	precomputedPortalReachabilities = NULL;
 }
 
 /*
@@ -91,6 +101,10 @@ bool idAASLocal::Init( const idStr &mapName, const unsigned int mapFileCRC ) {
 		mapName.ExtractFileExtension(name);
 
 		SetupRouting();
+
+		if ( aas_precomputeRoutingCache.GetBool() ) {
+			PrecomputeRoutingCache();
+		}
 	}
 	return true;
 }
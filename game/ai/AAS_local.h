@@ -198,6 +198,18 @@ private:	// routing data
 	mutable idRoutingCache *	cacheListEnd;			// end of list with cache sorted from oldest to newest
 	mutable int					totalCacheMemory;		// total cache memory used
 	idList<idRoutingObstacle *>	obstacleList;			// list with obstacles
+	byte *						changedAreas;			// for each area 1 if DisableArea or EnableArea toggled its TFL_INVALID flag
+	int							numChangedAreas;		// number of areas whose TFL_INVALID flag differs from the .aas file
+
+private:	// precomputed routing cache, only valid while no areas are disabled and there are no obstacles
+	int							precomputedTravelFlags;	// travel flags the cache was computed for, 0 if there is no precomputed cache
+	int *						precomputedClusterOffset;	// for each cluster the offset of its area caches
+	int							numPrecomputedAreaTimes;	// number of precomputed area travel times
+	unsigned short *			precomputedAreaTravelTimes;	// all area caches, numReachableAreas * numReachableAreas per cluster
+	byte *						precomputedAreaReachabilities;
+	byte *						precomputedPortalAreas;	// for each area 1 if the portal cache towards the area was precomputed
+	unsigned short *			precomputedPortalTravelTimes;	// numPortals travel times for each area
+	byte *						precomputedPortalReachabilities;
 
 	// greebo: This is TDM's EAS "Elevator Awareness System" :)
 	eas::tdmEAS*				elevatorSystem;
@@ -220,12 +232,25 @@ private:	// routing
 	void						DeleteOldestCache( void ) const;
 	idReachability *			GetAreaReachability( int areaNum, int reachabilityNum ) const;
 	int							ClusterAreaNum( int clusterNum, int areaNum ) const;
-	void						UpdateAreaRoutingCache( idRoutingCache *areaCache ) const;
+	void						UpdateAreaRoutingCache( idRoutingCache *areaCache, idRoutingUpdate *updates ) const;
 	idRoutingCache *			GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
-	void						UpdatePortalRoutingCache( idRoutingCache *portalCache ) const;
+	void						UpdatePortalRoutingCache( idRoutingCache *portalCache, idRoutingUpdate *updates, bool precomputedAreaCache ) const;
 	idRoutingCache *			GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
 	void						RemoveRoutingCacheUsingArea( int areaNum );
 
+private:	// precomputed routing cache
+	void						PrecomputeRoutingCache( void );
+	void						FreePrecomputedRoutingCache( void );
+	bool						LoadPrecomputedRoutingCache( const char *fileName );
+	void						WritePrecomputedRoutingCache( const char *fileName ) const;
+	bool						IsRestorableCache( const idRoutingCache *cache ) const;
+	bool						RestoreAreaRoutingCache( idRoutingCache *areaCache ) const;
+	bool						RestorePortalRoutingCache( idRoutingCache *portalCache ) const;
+	int							PrecomputedAreaCacheOffset( int clusterNum, int areaNum ) const;
+	static void					PrecomputeAreaCacheJob( void *data, int index );
+	static void					PrecomputePortalCacheJob( void *data, int index );
+	void						ToggleAreaChanged( int areaNum );
+
 public:
 	void						DisableArea( int areaNum );
 	void						EnableArea( int areaNum );
@@ -35,6 +35,13 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #define MAX_ROUTING_CACHE_MEMORY	(2*1024*1024)
 
+// the precomputed routing cache is built for the travel flags AI use by default
+#define PRECOMPUTED_TRAVEL_FLAGS	(TFL_WALK|TFL_AIR|TFL_DOOR)
+
+#define ROUTINGCACHE_FILEID			"DewmRouting"
+#define ROUTINGCACHE_FILEEXT		"route"
+#define ROUTINGCACHE_VERSION		1
+
 #define LEDGE_TRAVELTIME_PANALTY	250
 
 /*
@@ -250,8 +257,21 @@ void idAASLocal::SetupRoutingCache( void ) {
 	// greebo: For each area in the map, allocate a traveltime integer and initialise them to 0
 	goalAreaTravelTimes = (unsigned short *) Mem_ClearedAlloc( file->GetNumAreas() * sizeof(unsigned short) );
 
+	// the .aas file itself may mark areas invalid, only count the areas toggled at runtime
+	changedAreas = (byte *) Mem_ClearedAlloc( file->GetNumAreas() * sizeof(byte) );
+
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+	numChangedAreas = 0;
+
+	precomputedTravelFlags = 0;
+	precomputedClusterOffset = NULL;
+	numPrecomputedAreaTimes = 0;
+	precomputedAreaTravelTimes = NULL;
+	precomputedAreaReachabilities = NULL;
+	precomputedPortalAreas = NULL;
+	precomputedPortalTravelTimes = NULL;
+	precomputedPortalReachabilities = NULL;
 }
 
 /*
@@ -304,6 +324,8 @@ void idAASLocal::ShutdownRoutingCache( void ) {
 
 	DeletePortalCache();
 
+	FreePrecomputedRoutingCache();
+
 	Mem_Free( areaCacheIndex );
 	areaCacheIndex = NULL;
 	areaCacheIndexSize = 0;
@@ -316,6 +338,9 @@ void idAASLocal::ShutdownRoutingCache( void ) {
 	portalUpdate = NULL;
 	Mem_Free( goalAreaTravelTimes );
 	goalAreaTravelTimes = NULL;
+	Mem_Free( changedAreas );
+	changedAreas = NULL;
+	numChangedAreas = 0;
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
@@ -370,6 +395,12 @@ void idAASLocal::RoutingStats( void ) const {
 	gameLocal.Printf( "%6d area travel times (%d KB)\n", numAreaTravelTimes, ( numAreaTravelTimes * sizeof( unsigned short ) ) >> 10 );
 	gameLocal.Printf( "%6d area cache entries (%d KB)\n", areaCacheIndexSize, ( areaCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
 	gameLocal.Printf( "%6d portal cache entries (%d KB)\n", portalCacheIndexSize, ( portalCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
+	if ( precomputedTravelFlags ) {
+		int precomputedMemory = numPrecomputedAreaTimes * ( sizeof( unsigned short ) + sizeof( byte ) ) +
+								file->GetNumAreas() * ( 1 + file->GetNumPortals() * ( sizeof( unsigned short ) + sizeof( byte ) ) );
+		gameLocal.Printf( "%6d precomputed area travel times (%d KB), %s\n", numPrecomputedAreaTimes, precomputedMemory >> 10,
+			IsRestorableCache( NULL ) ? "in use" : "not used while areas are disabled" );
+	}
 }
 
 /*
@@ -393,6 +424,19 @@ void idAASLocal::RemoveRoutingCacheUsingArea( int areaNum ) {
 	DeletePortalCache();
 }
 
+/*
+============
+idAASLocal::ToggleAreaChanged
+
+  keeps count of the areas whose TFL_INVALID flag differs from the .aas file, enabling an area
+  the file marks invalid changes the routing just as much as disabling a valid one
+============
+*/
+void idAASLocal::ToggleAreaChanged( int areaNum ) {
+	changedAreas[areaNum] ^= 1;
+	numChangedAreas += changedAreas[areaNum] ? 1 : -1;
+}
+
 /*
 ============
 idAASLocal::DisableArea
@@ -406,6 +450,7 @@ void idAASLocal::DisableArea( int areaNum ) {
 	}
 
 	file->SetAreaTravelFlag( areaNum, TFL_INVALID );
+	ToggleAreaChanged( areaNum );
 
 	RemoveRoutingCacheUsingArea( areaNum );
 }
@@ -423,6 +468,7 @@ void idAASLocal::EnableArea( int areaNum ) {
 	}
 
 	file->RemoveAreaTravelFlag( areaNum, TFL_INVALID );
+	ToggleAreaChanged( areaNum );
 
 	RemoveRoutingCacheUsingArea( areaNum );
 }
@@ -693,6 +739,8 @@ void idAASLocal::UnlinkCache( idRoutingCache *cache ) const {
 /*
 ============
 idAASLocal::DeleteOldestCache
+
+  prefers cache that can be restored from the precomputed cache
 ============
 */
 void idAASLocal::DeleteOldestCache( void ) const {
@@ -700,8 +748,19 @@ void idAASLocal::DeleteOldestCache( void ) const {
 
 	assert( cacheListStart );
 
-	// unlink the oldest cache
-	cache = cacheListStart;
+	cache = NULL;
+	if ( IsRestorableCache( NULL ) ) {
+		for ( cache = cacheListStart; cache; cache = cache->time_next ) {
+			if ( IsRestorableCache( cache ) ) {
+				break;
+			}
+		}
+	}
+	if ( !cache ) {
+		cache = cacheListStart;
+	}
+
+	// unlink the cache
 	UnlinkCache( cache );
 
 	// unlink the oldest cache from the area or portal cache index
@@ -760,7 +819,7 @@ ID_INLINE int idAASLocal::ClusterAreaNum( int clusterNum, int areaNum ) const {
 idAASLocal::UpdateAreaRoutingCache
 ============
 */
-void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
+void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache, idRoutingUpdate *updates ) const {
 	// number of reachability areas within this cluster
 	int numReachableAreas = file->GetCluster(areaCache->cluster).numReachableAreas;
 
@@ -778,7 +837,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 	memset( startAreaTravelTimes, 0, sizeof( startAreaTravelTimes ) );
 
 	// initialize first update
-	idRoutingUpdate* curUpdate = &areaUpdate[clusterAreaNum];
+	idRoutingUpdate* curUpdate = &updates[clusterAreaNum];
 
 	curUpdate->areaNum = areaCache->areaNum;
 	curUpdate->areaTravelTimes = startAreaTravelTimes;
@@ -844,7 +903,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 
 				areaCache->travelTimes[clusterAreaNum] = t;
 				areaCache->reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
-				idRoutingUpdate* nextUpdate = &areaUpdate[clusterAreaNum];
+				idRoutingUpdate* nextUpdate = &updates[clusterAreaNum];
 				nextUpdate->areaNum = nextAreaNum;
 				nextUpdate->tmpTravelTime = t;
 				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
@@ -907,7 +966,9 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 			clusterCache->prev = cache;
 		}
 		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
-		UpdateAreaRoutingCache( cache );
+		if ( !RestoreAreaRoutingCache( cache ) ) {
+			UpdateAreaRoutingCache( cache, areaUpdate );
+		}
 	}
 	LinkCache( cache );
 	return cache;
@@ -916,17 +977,21 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 /*
 ============
 idAASLocal::UpdatePortalRoutingCache
+
+  with precomputedAreaCache set the area cache is read from the precomputed
+  cache instead of being created, so this can run on several threads
 ============
 */
-void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
+void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache, idRoutingUpdate *updates, bool precomputedAreaCache ) const {
 	int i, portalNum, clusterAreaNum;
 	unsigned short t;
 	const aasPortal_t *portal;
 	const aasCluster_t *cluster;
-	idRoutingCache *cache;
+	const unsigned short *cacheTravelTimes;
+	const byte *cacheReachabilities;
 	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
 
-	curUpdate = &portalUpdate[ file->GetNumPortals() ];
+	curUpdate = &updates[ file->GetNumPortals() ];
 	curUpdate->cluster = portalCache->cluster;
 	curUpdate->areaNum = portalCache->areaNum;
 	curUpdate->tmpTravelTime = portalCache->startTravelTime;
@@ -953,7 +1018,18 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 		curUpdate->isInList = false;
 
 		cluster = &file->GetCluster( curUpdate->cluster );
-		cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+		if ( precomputedAreaCache ) {
+			int offset = PrecomputedAreaCacheOffset( curUpdate->cluster, curUpdate->areaNum );
+			if ( offset < 0 ) {
+				continue;
+			}
+			cacheTravelTimes = precomputedAreaTravelTimes + offset;
+			cacheReachabilities = precomputedAreaReachabilities + offset;
+		} else {
+			idRoutingCache *cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+			cacheTravelTimes = cache->travelTimes;
+			cacheReachabilities = cache->reachabilities;
+		}
 
 		// take all portals of the cluster
 		for ( i = 0; i < cluster->numPortals; i++ ) {
@@ -977,7 +1053,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 				continue;
 			}
 
-			t = cache->travelTimes[clusterAreaNum];
+			t = cacheTravelTimes[clusterAreaNum];
 			if ( t == 0 )
 			{
 				continue;
@@ -988,8 +1064,8 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 			if ( !portalCache->travelTimes[portalNum] || ( t < portalCache->travelTimes[portalNum] ) )
 			{
 				portalCache->travelTimes[portalNum] = t;
-				portalCache->reachabilities[portalNum] = cache->reachabilities[clusterAreaNum];
-				nextUpdate = &portalUpdate[portalNum];
+				portalCache->reachabilities[portalNum] = cacheReachabilities[clusterAreaNum];
+				nextUpdate = &updates[portalNum];
 				if ( portal->clusters[0] == curUpdate->cluster ) {
 					nextUpdate->cluster = portal->clusters[1];
 				}
@@ -1046,12 +1122,398 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 			portalCacheIndex[areaNum]->prev = cache;
 		}
 		portalCacheIndex[areaNum] = cache;
-		UpdatePortalRoutingCache( cache );
+		if ( !RestorePortalRoutingCache( cache ) ) {
+			UpdatePortalRoutingCache( cache, portalUpdate, false );
+		}
 	}
 	LinkCache( cache );
 	return cache;
 }
 
+/*
+============
+idAASLocal::PrecomputedAreaCacheOffset
+
+  returns the offset of an area cache in the precomputed cache, -1 if the area is not a reachable area of the cluster
+============
+*/
+int idAASLocal::PrecomputedAreaCacheOffset( int clusterNum, int areaNum ) const {
+	int numReachableAreas = file->GetCluster( clusterNum ).numReachableAreas;
+	int clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
+	if ( clusterAreaNum >= numReachableAreas ) {
+		return -1;
+	}
+	return precomputedClusterOffset[clusterNum] + clusterAreaNum * numReachableAreas;
+}
+
+/*
+============
+idAASLocal::IsRestorableCache
+
+  the precomputed cache is only valid while the routing state is the one of the
+  .aas file, without a cache this returns if the precomputed cache can be used at all
+============
+*/
+bool idAASLocal::IsRestorableCache( const idRoutingCache *cache ) const {
+	if ( !precomputedTravelFlags || numChangedAreas > 0 || obstacleList.Num() > 0 ) {
+		return false;
+	}
+	if ( !cache ) {
+		return true;
+	}
+	if ( cache->travelFlags != precomputedTravelFlags ) {
+		return false;
+	}
+	if ( cache->type == CACHETYPE_PORTAL ) {
+		return precomputedPortalAreas[cache->areaNum] != 0;
+	}
+	return true;
+}
+
+/*
+============
+idAASLocal::RestoreAreaRoutingCache
+============
+*/
+bool idAASLocal::RestoreAreaRoutingCache( idRoutingCache *areaCache ) const {
+	if ( !IsRestorableCache( areaCache ) ) {
+		return false;
+	}
+	int offset = PrecomputedAreaCacheOffset( areaCache->cluster, areaCache->areaNum );
+	if ( offset < 0 ) {
+		return false;
+	}
+	memcpy( areaCache->travelTimes, precomputedAreaTravelTimes + offset, areaCache->size * sizeof( areaCache->travelTimes[0] ) );
+	memcpy( areaCache->reachabilities, precomputedAreaReachabilities + offset, areaCache->size * sizeof( areaCache->reachabilities[0] ) );
+	return true;
+}
+
+/*
+============
+idAASLocal::RestorePortalRoutingCache
+============
+*/
+bool idAASLocal::RestorePortalRoutingCache( idRoutingCache *portalCache ) const {
+	if ( !IsRestorableCache( portalCache ) ) {
+		return false;
+	}
+	// the portal cache towards a portal area is precomputed for the front cluster of the portal
+	int clusterNum = file->GetArea( portalCache->areaNum ).cluster;
+	if ( clusterNum < 0 ) {
+		clusterNum = file->GetPortal( -clusterNum ).clusters[0];
+	}
+	if ( portalCache->cluster != clusterNum ) {
+		return false;
+	}
+	int offset = portalCache->areaNum * portalCache->size;
+	memcpy( portalCache->travelTimes, precomputedPortalTravelTimes + offset, portalCache->size * sizeof( portalCache->travelTimes[0] ) );
+	memcpy( portalCache->reachabilities, precomputedPortalReachabilities + offset, portalCache->size * sizeof( portalCache->reachabilities[0] ) );
+	return true;
+}
+
+typedef struct routingCacheJob_s {
+	const idAASLocal *		aas;
+	int						clusterNum;			// cluster of an area cache job
+	const int *				areaNums;			// area to compute the cache for, for area cache jobs indexed by cluster area number
+	int						numAreas;
+	idRoutingCache *		cache;				// scratch cache of the job
+	idRoutingUpdate *		updates;			// scratch update memory of the job
+} routingCacheJob_t;
+
+/*
+============
+idAASLocal::PrecomputeAreaCacheJob
+============
+*/
+void idAASLocal::PrecomputeAreaCacheJob( void *data, int index ) {
+	routingCacheJob_t &job = static_cast<routingCacheJob_t *>( data )[index];
+	const idAASLocal *aas = job.aas;
+	idRoutingCache *cache = job.cache;
+
+	for ( int i = 0; i < job.numAreas; i++ ) {
+		if ( !job.areaNums[i] ) {
+			continue;
+		}
+		cache->areaNum = job.areaNums[i];
+		memset( cache->travelTimes, 0, cache->size * sizeof( cache->travelTimes[0] ) );
+		memset( cache->reachabilities, 0, cache->size * sizeof( cache->reachabilities[0] ) );
+
+		aas->UpdateAreaRoutingCache( cache, job.updates );
+
+		int offset = aas->precomputedClusterOffset[job.clusterNum] + i * cache->size;
+		memcpy( aas->precomputedAreaTravelTimes + offset, cache->travelTimes, cache->size * sizeof( cache->travelTimes[0] ) );
+		memcpy( aas->precomputedAreaReachabilities + offset, cache->reachabilities, cache->size * sizeof( cache->reachabilities[0] ) );
+	}
+}
+
+/*
+============
+idAASLocal::PrecomputePortalCacheJob
+============
+*/
+void idAASLocal::PrecomputePortalCacheJob( void *data, int index ) {
+	routingCacheJob_t &job = static_cast<routingCacheJob_t *>( data )[index];
+	const idAASLocal *aas = job.aas;
+	idRoutingCache *cache = job.cache;
+
+	for ( int i = 0; i < job.numAreas; i++ ) {
+		int areaNum = job.areaNums[i];
+		int clusterNum = aas->file->GetArea( areaNum ).cluster;
+		if ( clusterNum < 0 ) {
+			clusterNum = aas->file->GetPortal( -clusterNum ).clusters[0];
+		}
+		cache->cluster = clusterNum;
+		cache->areaNum = areaNum;
+		memset( cache->travelTimes, 0, cache->size * sizeof( cache->travelTimes[0] ) );
+		memset( cache->reachabilities, 0, cache->size * sizeof( cache->reachabilities[0] ) );
+
+		aas->UpdatePortalRoutingCache( cache, job.updates, true );
+
+		int offset = areaNum * cache->size;
+		memcpy( aas->precomputedPortalTravelTimes + offset, cache->travelTimes, cache->size * sizeof( cache->travelTimes[0] ) );
+		memcpy( aas->precomputedPortalReachabilities + offset, cache->reachabilities, cache->size * sizeof( cache->reachabilities[0] ) );
+	}
+}
+
+/*
+============
+idAASLocal::PrecomputeRoutingCache
+
+  Computes the area and portal cache for the default AI travel flags on the job pool,
+  or loads them from the file next to the .aas file if it was written for the same map.
+  Cache that is evicted or deleted later on is restored from here as long as the
+  routing state did not change.
+============
+*/
+void idAASLocal::PrecomputeRoutingCache( void ) {
+	int i, side, clusterNum, clusterAreaNum, numJobs, areasPerJob;
+	idTimer timer;
+	idList<int> clusterFirstSlot;
+	idList<int> clusterAreas;
+	idList<int> goalAreas;
+	idList<routingCacheJob_t> jobs;
+
+	timer.Start();
+
+	FreePrecomputedRoutingCache();
+
+	const int numAreas = file->GetNumAreas();
+	const int numPortals = file->GetNumPortals();
+	const int numClusters = file->GetNumClusters();
+
+	// each cluster has an area cache for each of its reachable areas
+	precomputedClusterOffset = (int *) Mem_Alloc( numClusters * sizeof( int ) );
+	clusterFirstSlot.SetNum( numClusters );
+	numPrecomputedAreaTimes = 0;
+	int numSlots = 0;
+	for ( i = 0; i < numClusters; i++ ) {
+		int numReachableAreas = file->GetCluster( i ).numReachableAreas;
+		precomputedClusterOffset[i] = numPrecomputedAreaTimes;
+		numPrecomputedAreaTimes += numReachableAreas * numReachableAreas;
+		clusterFirstSlot[i] = numSlots;
+		numSlots += numReachableAreas;
+	}
+	precomputedAreaTravelTimes = (unsigned short *) Mem_ClearedAlloc( numPrecomputedAreaTimes * sizeof( unsigned short ) );
+	precomputedAreaReachabilities = (byte *) Mem_ClearedAlloc( numPrecomputedAreaTimes * sizeof( byte ) );
+
+	// each reachable area has a portal cache towards it
+	precomputedPortalAreas = (byte *) Mem_ClearedAlloc( numAreas * sizeof( byte ) );
+	precomputedPortalTravelTimes = (unsigned short *) Mem_ClearedAlloc( numAreas * numPortals * sizeof( unsigned short ) );
+	precomputedPortalReachabilities = (byte *) Mem_ClearedAlloc( numAreas * numPortals * sizeof( byte ) );
+
+	// find the area for each cluster area number, portal areas are part of both their clusters
+	clusterAreas.AssureSize( numSlots, 0 );
+	for ( i = 1; i < numAreas; i++ ) {
+		clusterNum = file->GetArea( i ).cluster;
+		if ( clusterNum > 0 ) {
+			clusterAreaNum = file->GetArea( i ).clusterAreaNum;
+			if ( clusterAreaNum < file->GetCluster( clusterNum ).numReachableAreas ) {
+				clusterAreas[clusterFirstSlot[clusterNum] + clusterAreaNum] = i;
+				precomputedPortalAreas[i] = 1;
+				goalAreas.Append( i );
+			}
+		} else {
+			const aasPortal_t &portal = file->GetPortal( -clusterNum );
+			for ( side = 0; side < 2; side++ ) {
+				clusterAreaNum = portal.clusterAreaNum[side];
+				if ( clusterAreaNum < file->GetCluster( portal.clusters[side] ).numReachableAreas ) {
+					clusterAreas[clusterFirstSlot[portal.clusters[side]] + clusterAreaNum] = i;
+				}
+			}
+			if ( portal.clusterAreaNum[0] < file->GetCluster( portal.clusters[0] ).numReachableAreas ) {
+				precomputedPortalAreas[i] = 1;
+				goalAreas.Append( i );
+			}
+		}
+	}
+
+	precomputedTravelFlags = PRECOMPUTED_TRAVEL_FLAGS;
+
+	idStr cacheName = va( "%s.%s", file->GetName(), ROUTINGCACHE_FILEEXT );
+	if ( LoadPrecomputedRoutingCache( cacheName ) ) {
+		timer.Stop();
+		gameLocal.Printf( "loaded routing cache %s in %d msec\n", cacheName.c_str(), (int)timer.Milliseconds() );
+		return;
+	}
+
+	// area cache, one job per cluster
+	for ( i = 0; i < numClusters; i++ ) {
+		int numReachableAreas = file->GetCluster( i ).numReachableAreas;
+		if ( numReachableAreas <= 0 ) {
+			continue;
+		}
+		routingCacheJob_t &job = jobs.Alloc();
+		job.aas = this;
+		job.clusterNum = i;
+		job.areaNums = clusterAreas.Ptr() + clusterFirstSlot[i];
+		job.numAreas = numReachableAreas;
+		job.cache = new idRoutingCache( numReachableAreas );
+		job.cache->type = CACHETYPE_AREA;
+		job.cache->cluster = i;
+		job.cache->startTravelTime = 1;
+		job.cache->travelFlags = precomputedTravelFlags;
+		job.updates = (idRoutingUpdate *) Mem_ClearedAlloc( numReachableAreas * sizeof( idRoutingUpdate ) );
+	}
+
+	jobPool.ParallelFor( PrecomputeAreaCacheJob, jobs.Ptr(), jobs.Num() );
+
+	for ( i = 0; i < jobs.Num(); i++ ) {
+		delete jobs[i].cache;
+		Mem_Free( jobs[i].updates );
+	}
+	jobs.Clear();
+
+	// portal cache, the goal areas are split over a few jobs per thread
+	numJobs = Min( goalAreas.Num(), ( jobPool.GetNumThreads() + 1 ) * 4 );
+	areasPerJob = numJobs > 0 ? ( goalAreas.Num() + numJobs - 1 ) / numJobs : 0;
+	for ( i = 0; i < goalAreas.Num(); i += areasPerJob ) {
+		routingCacheJob_t &job = jobs.Alloc();
+		job.aas = this;
+		job.clusterNum = 0;
+		job.areaNums = goalAreas.Ptr() + i;
+		job.numAreas = Min( areasPerJob, goalAreas.Num() - i );
+		job.cache = new idRoutingCache( numPortals );
+		job.cache->type = CACHETYPE_PORTAL;
+		job.cache->startTravelTime = 1;
+		job.cache->travelFlags = precomputedTravelFlags;
+		job.updates = (idRoutingUpdate *) Mem_ClearedAlloc( ( numPortals + 1 ) * sizeof( idRoutingUpdate ) );
+	}
+
+	jobPool.ParallelFor( PrecomputePortalCacheJob, jobs.Ptr(), jobs.Num() );
+
+	for ( i = 0; i < jobs.Num(); i++ ) {
+		delete jobs[i].cache;
+		Mem_Free( jobs[i].updates );
+	}
+	jobs.Clear();
+
+	WritePrecomputedRoutingCache( cacheName );
+
+	timer.Stop();
+	gameLocal.Printf( "precomputed routing cache for %d areas in %d msec\n", goalAreas.Num(), (int)timer.Milliseconds() );
+}
+
+/*
+============
+idAASLocal::FreePrecomputedRoutingCache
+============
+*/
+void idAASLocal::FreePrecomputedRoutingCache( void ) {
+	Mem_Free( precomputedClusterOffset );
+	precomputedClusterOffset = NULL;
+	Mem_Free( precomputedAreaTravelTimes );
+	precomputedAreaTravelTimes = NULL;
+	Mem_Free( precomputedAreaReachabilities );
+	precomputedAreaReachabilities = NULL;
+	Mem_Free( precomputedPortalAreas );
+	precomputedPortalAreas = NULL;
+	Mem_Free( precomputedPortalTravelTimes );
+	precomputedPortalTravelTimes = NULL;
+	Mem_Free( precomputedPortalReachabilities );
+	precomputedPortalReachabilities = NULL;
+	numPrecomputedAreaTimes = 0;
+	precomputedTravelFlags = 0;
+}
+
+/*
+============
+idAASLocal::LoadPrecomputedRoutingCache
+
+  the file is only used if it was written for the same .aas file
+============
+*/
+bool idAASLocal::LoadPrecomputedRoutingCache( const char *fileName ) {
+	idStr fileId;
+	int version, numAreas, numPortals, numClusters, travelFlags, numAreaTimes;
+	unsigned int crc;
+
+	idFile *f = fileSystem->OpenFileRead( fileName );
+	if ( !f ) {
+		return false;
+	}
+
+	f->ReadString( fileId );
+	f->ReadInt( version );
+	f->ReadUnsignedInt( crc );
+	f->ReadInt( numAreas );
+	f->ReadInt( numPortals );
+	f->ReadInt( numClusters );
+	f->ReadInt( travelFlags );
+	f->ReadInt( numAreaTimes );
+
+	if ( fileId != ROUTINGCACHE_FILEID || version != ROUTINGCACHE_VERSION || crc != file->GetCRC() ||
+			numAreas != file->GetNumAreas() || numPortals != file->GetNumPortals() || numClusters != file->GetNumClusters() ||
+			travelFlags != precomputedTravelFlags || numAreaTimes != numPrecomputedAreaTimes ) {
+		gameLocal.Printf( "routing cache %s is out of date\n", fileName );
+		fileSystem->CloseFile( f );
+		return false;
+	}
+
+	// stored in native byte order, the file is only a local cache of the .aas file
+	int portalTimes = numAreas * numPortals;
+	bool ok = f->Read( precomputedAreaTravelTimes, numAreaTimes * sizeof( unsigned short ) ) == numAreaTimes * (int)sizeof( unsigned short ) &&
+			f->Read( precomputedAreaReachabilities, numAreaTimes * sizeof( byte ) ) == numAreaTimes * (int)sizeof( byte ) &&
+			f->Read( precomputedPortalTravelTimes, portalTimes * sizeof( unsigned short ) ) == portalTimes * (int)sizeof( unsigned short ) &&
+			f->Read( precomputedPortalReachabilities, portalTimes * sizeof( byte ) ) == portalTimes * (int)sizeof( byte );
+
+	fileSystem->CloseFile( f );
+
+	if ( !ok ) {
+		gameLocal.Warning( "routing cache %s is truncated", fileName );
+	}
+	return ok;
+}
+
+/*
+============
+idAASLocal::WritePrecomputedRoutingCache
+============
+*/
+void idAASLocal::WritePrecomputedRoutingCache( const char *fileName ) const {
+	idFile *f = fileSystem->OpenFileWrite( fileName );
+	if ( !f ) {
+		gameLocal.Warning( "couldn't write routing cache %s", fileName );
+		return;
+	}
+
+	f->WriteString( ROUTINGCACHE_FILEID );
+	f->WriteInt( ROUTINGCACHE_VERSION );
+	f->WriteUnsignedInt( file->GetCRC() );
+	f->WriteInt( file->GetNumAreas() );
+	f->WriteInt( file->GetNumPortals() );
+	f->WriteInt( file->GetNumClusters() );
+	f->WriteInt( precomputedTravelFlags );
+	f->WriteInt( numPrecomputedAreaTimes );
+
+	int portalTimes = file->GetNumAreas() * file->GetNumPortals();
+	f->Write( precomputedAreaTravelTimes, numPrecomputedAreaTimes * sizeof( unsigned short ) );
+	f->Write( precomputedAreaReachabilities, numPrecomputedAreaTimes * sizeof( byte ) );
+	f->Write( precomputedPortalTravelTimes, portalTimes * sizeof( unsigned short ) );
+	f->Write( precomputedPortalReachabilities, portalTimes * sizeof( byte ) );
+
+	fileSystem->CloseFile( f );
+}
+
 /*
 ============
 idAASLocal::RouteToGoalArea
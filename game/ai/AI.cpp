@@ -64,6 +64,7 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 const int AUD_ALERT_DELAY_MIN =  500; // grayman #3356 - min amount of time delay (ms) before processing an audio alert
 const int AUD_ALERT_DELAY_MAX = 1500; // grayman #3356 - max amount of time delay (ms) before processing an audio alert
+const int MAX_TARGET_POINTS = 16; // max points per CanSeeTargetPoints() call
 
 //TODO: Move these to AI def:
 
@@ -419,6 +420,8 @@ idAI::idAI()
 	aiNode.SetOwner(this);
 
 	aas					= NULL;
+	m_perceptionFrame	= -1;
+	m_perceptionCanSeePlayer = false;
 	travelFlags			= TFL_WALK|TFL_AIR|TFL_DOOR;
 	lastAreaReevaluationTime = -1;
 	maxAreaReevaluationInterval = 2000; // msec
@@ -4587,7 +4590,7 @@ bool idAI::CanSee( idEntity *ent, bool useFOV ) const
 	START_SCOPED_TIMING(aiCanSeeTimer, scopedCanSeeTimer);
 
 	// Test if it is occluded, and use field of vision in the check (true as second parameter)
-	bool cansee = idActor::CanSee( ent, useFOV );
+	bool cansee = CanSeeUnoccluded( ent, useFOV );
 
 	// Also consider lighting and visual acuity of AI
 	if (cansee)
@@ -4610,7 +4613,7 @@ This method can ignore lighting conditions and/or field of vision.
 bool idAI::CanSeeExt( idEntity *ent, const bool useFOV, const bool useLighting ) const
 {
 	// Test if it is occluded
-	bool cansee = idActor::CanSee( ent, useFOV );
+	bool cansee = CanSeeUnoccluded( ent, useFOV );
 
 	if (cansee && useLighting)
 	{
@@ -4621,6 +4624,106 @@ bool idAI::CanSeeExt( idEntity *ent, const bool useFOV, const bool useLighting )
 	return cansee;
 }
 
+bool idAI::CanSeeUnoccluded( idEntity *ent, bool useFOV ) const
+{
+	if ( ( m_perceptionFrame == gameLocal.framenum ) && ( ent == gameLocal.GetLocalPlayer() ) )
+	{
+		// The traces have already been done in the perception pass
+		if ( useFOV && !CheckFOV( ent->GetPhysics()->GetOrigin() ) )
+		{
+			return false;
+		}
+
+		return m_perceptionCanSeePlayer;
+	}
+
+	return idActor::CanSee( ent, useFOV );
+}
+
+/*
+=====================
+idAI::WantsPlayerPerception
+
+Mirrors the early outs of PerformVisualScan(), so the perception pass only traces
+for AI that are actually going to look for the player this frame.
+=====================
+*/
+bool idAI::WantsPlayerPerception( idActor* player )
+{
+	if ( cv_ai_opt_nothink.GetBool() || !( thinkFlags & TH_THINK ) || !ThinkingIsAllowed() )
+	{
+		return false;
+	}
+
+	if ( ( health <= 0 ) || IsKnockedOut() || m_bIgnoreAlerts )
+	{
+		return false;
+	}
+
+	if ( ( GetAcuity("vis") <= 0 ) || !gameLocal.InPlayerPVS(this) )
+	{
+		return false;
+	}
+
+	return ( CheckFOV(player->GetEyePosition()) || CheckFOV(player->GetPhysics()->GetOrigin()) );
+}
+
+/*
+=====================
+idAI::UpdatePlayerPerception
+
+The world part of the traces runs on the job pool, the clip models of the entities are
+tested afterwards in the order of the given list. The snapshot is taken before any AI
+thinks, so the result does not depend on which AI happened to think first.
+=====================
+*/
+void idAI::UpdatePlayerPerception( idAI** ais, int numAIs, idActor* player )
+{
+	const int numPoints = 4; // eyes, origin and both shoulders, like idActor::CanSee()
+	idList<clipTrace_t> traces;
+	idVec3 points[numPoints];
+
+	const idVec3& playerOrigin = player->GetPhysics()->GetOrigin();
+	points[0] = player->GetEyePosition();
+	points[1] = playerOrigin;
+
+	traces.SetNum( numAIs * numPoints );
+
+	for ( int i = 0 ; i < numAIs ; i++ )
+	{
+		idAI* ai = ais[i];
+		idVec3 eye = ai->GetEyePosition();
+
+		ai->GetShoulderTestPoints( player, playerOrigin, points[2], points[3] );
+
+		for ( int j = 0 ; j < numPoints ; j++ )
+		{
+			clipTrace_t& trace = traces[i * numPoints + j];
+			trace.start = eye;
+			trace.end = points[j];
+			trace.bounds.Clear();
+			trace.contentMask = MASK_OPAQUE;
+			trace.passEntity = ai;
+		}
+	}
+
+	gameLocal.clip.TraceBatch( traces.Ptr(), traces.Num() );
+
+	for ( int i = 0 ; i < numAIs ; i++ )
+	{
+		bool canSee = false;
+
+		for ( int j = 0 ; j < numPoints && !canSee ; j++ )
+		{
+			const trace_t& result = traces[i * numPoints + j].result;
+			canSee = ( result.fraction >= 1.0f ) || ( gameLocal.GetTraceEntity(result) == player );
+		}
+
+		ais[i]->m_perceptionFrame = gameLocal.framenum;
+		ais[i]->m_perceptionCanSeePlayer = canSee;
+	}
+}
+
 // grayman #2859 - Can the AI see a point belonging to a target (not necessarily its origin)?
 
 bool idAI::CanSeeTargetPoint( idVec3 point, idEntity* target , bool checkLighting ) const // grayman #2959
@@ -4662,6 +4765,86 @@ bool idAI::CanSeeTargetPoint( idVec3 point, idEntity* target , bool checkLightin
 	return true;
 }
 
+int idAI::CanSeeTargetPoints( const idVec3* points, int numPoints, idEntity* target, bool checkLighting ) const
+{
+	clipTrace_t traces[MAX_TARGET_POINTS];
+	int pointIndex[MAX_TARGET_POINTS];
+	int numTraces = 0;
+
+	assert( numPoints <= MAX_TARGET_POINTS );
+
+	// a batch this small would be traced inline anyway, so stop at the first visible point
+
+	if ( numPoints < TRACE_BATCH_MIN_TRACES_PER_JOB )
+	{
+		for ( int i = 0 ; i < numPoints ; i++ )
+		{
+			if ( CanSeeTargetPoint( points[i], target, checkLighting ) )
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	// Check FOV, only points inside it need a visibility trace
+
+	idVec3 eye(GetEyePosition()); // eye position of the AI
+
+	for ( int i = 0 ; i < numPoints ; i++ )
+	{
+		if ( !CheckFOV( points[i] ) )
+		{
+			continue;
+		}
+
+		// Trace from eye to point, ignoring self
+
+		clipTrace_t &trace = traces[numTraces];
+		trace.start = eye;
+		trace.end = points[i];
+		trace.bounds.Clear();
+		trace.contentMask = MASK_OPAQUE;
+		trace.passEntity = this;
+		pointIndex[numTraces++] = i;
+	}
+
+	gameLocal.clip.TraceBatch( traces, numTraces );
+
+	for ( int i = 0 ; i < numTraces ; i++ )
+	{
+		const idVec3 &point = points[pointIndex[i]];
+
+		// Check visibility
+
+		if ( traces[i].result.fraction < 1.0 )
+		{
+			if ( gameLocal.GetTraceEntity(traces[i].result) != target )
+			{
+				continue;
+			}
+		}
+
+		// Check lighting?
+
+		if ( checkLighting )
+		{
+			idVec3 topPoint = point - (physicsObj.GetGravityNormal() * 32.0);
+			float maxDistanceToObserve = GetMaximumObservationDistanceForPoints(point, topPoint);
+			idVec3 ownOrigin = physicsObj.GetOrigin();
+
+			if ( ( ( point - ownOrigin).LengthSqr() ) >= Square(maxDistanceToObserve) ) // grayman #2866
+			{
+				continue;
+			}
+		}
+
+		return pointIndex[i];
+	}
+
+	return -1;
+}
+
 /*
 =====================
 The Dark Mod
@@ -983,6 +983,14 @@ public: // greebo: Made these public for now, I didn't want to write an accessor
 	**/
 	idVec3					m_LastSight;
 
+	/**
+	* Player visibility snapshot taken by UpdatePlayerPerception() before the entities think.
+	* m_perceptionFrame is the gameLocal.framenum it was taken in, m_perceptionCanSeePlayer
+	* the occlusion test without FOV or lighting. Only valid for one frame, so not saved.
+	**/
+	int						m_perceptionFrame;
+	bool					m_perceptionCanSeePlayer;
+
 	/**
 	* The entity that last issued a tactile alert
 	**/
@@ -1588,6 +1596,18 @@ public: // greebo: Made these public for now, I didn't want to write an accessor
 	*/
 	virtual bool			CanSeeExt ( idEntity* ent, const bool useFOV, const bool useLighting ) const;
 
+	/**
+	* True if this AI is going to look for the player this frame. Used to pick the AI
+	* for the perception pass in idGameLocal::RunAIPerception().
+	*/
+	bool					WantsPlayerPerception( idActor* player );
+
+	/**
+	* Runs the line of sight traces CanSee() does against the player for all given AI in
+	* a single trace batch and stores the results in their perception snapshot.
+	*/
+	static void				UpdatePlayerPerception( idAI** ais, int numAIs, idActor* player );
+
 	/**
 	* This tests if a position is visible.  it can optionally use lighting and fov.
 	*/
@@ -1597,6 +1617,20 @@ public: // greebo: Made these public for now, I didn't want to write an accessor
 
 	bool					CanSeeTargetPoint( idVec3 point, idEntity* target , bool checkLighting) const; // grayman #2859 & #2959
 
+	/**
+	* Batched CanSeeTargetPoint, the line of sight traces for all points go through a
+	* single trace batch. Returns the index of the first visible point or -1.
+	*/
+	int						CanSeeTargetPoints( const idVec3* points, int numPoints, idEntity* target, bool checkLighting ) const;
+
+protected:
+	/**
+	* idActor::CanSee, but answered from the perception snapshot if there is one for this frame.
+	*/
+	bool					CanSeeUnoccluded( idEntity* ent, bool useFOV ) const;
+
+public:
+
 	idVec3					CanSeeRope( idEntity *ent ) const; // grayman #2872
 
 	float					GetReachTolerance(); // grayman #3029
@@ -34,6 +34,8 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "Intersection.h"
 #include "TimerManager.h"
 
+#define LAS_MAX_LIGHT_PATHS 3 // test points traced per light
+
 
 //----------------------------------------------------------------------------
 
@@ -248,13 +250,67 @@ bool darkModLAS::traceLightPath( idVec3 from, idVec3 to, idEntity* ignore, idLig
 {
 	trace_t trace;
 
+	gameLocal.clip.TracePoint( trace, from, to, CONTENTS_OPAQUE, ignore );
+	return continueLightPath( trace, from, to, light );
+}
+
+//----------------------------------------------------------------------------
+
+// Returns the first path that reaches the light, which gives the same answer
+// as calling traceLightPath() on each in turn. A few paths are traced one by
+// one so the rest can be skipped, otherwise the first trace of every path goes
+// through a single trace batch.
+
+int darkModLAS::traceLightPaths( const idVec3* from, int numPaths, idVec3 to, idEntity* ignore, idLight* light )
+{
+	clipTrace_t traces[LAS_MAX_LIGHT_PATHS];
+
+	assert( numPaths <= LAS_MAX_LIGHT_PATHS );
+
+	if ( numPaths < TRACE_BATCH_MIN_TRACES_PER_JOB )
+	{
+		for ( int i = 0 ; i < numPaths ; i++ )
+		{
+			if ( traceLightPath( from[i], to, ignore, light ) )
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	for ( int i = 0 ; i < numPaths ; i++ )
+	{
+		traces[i].start = from[i];
+		traces[i].end = to;
+		traces[i].bounds.Clear();
+		traces[i].contentMask = CONTENTS_OPAQUE;
+		traces[i].passEntity = ignore;
+	}
+
+	gameLocal.clip.TraceBatch( traces, numPaths );
+
+	for ( int i = 0 ; i < numPaths ; i++ )
+	{
+		if ( continueLightPath( traces[i].result, from[i], to, light ) )
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+//----------------------------------------------------------------------------
+
+bool darkModLAS::continueLightPath( trace_t& trace, idVec3 from, idVec3 to, idLight* light )
+{
 	bool results = false; // didn't complete the path
 
 	// grayman #3584 - if this light has a lightholder, find the bind chain
 
 	while ( true )
 	{
-		gameLocal.clip.TracePoint( trace, from, to, CONTENTS_OPAQUE, ignore );
 		if ( cv_las_showtraces.GetBool() )
 		{
 			gameRenderWorld->DebugArrow(
@@ -298,10 +354,10 @@ bool darkModLAS::traceLightPath( idVec3 from, idVec3 to, idEntity* ignore, idLig
 			}
 		}
 
-		// Continue the trace from the struck point
+		// Continue the trace from the struck point, ignoring the entity we struck
 
 		from = trace.endpos;
-		ignore = entHit; // ignore the entity we struck
+		gameLocal.clip.TracePoint( trace, from, to, CONTENTS_OPAQUE, entHit );
 	}
 
 	return results;
@@ -487,19 +543,15 @@ void darkModLAS::accumulateEffectOfLightsInArea
 				// also applies to the candle holding the flame.
 
 				bool lightReaches;
+				idVec3 paths[LAS_MAX_LIGHT_PATHS];
 
 				if ( inter == INTERSECT_NONE ) // the line segment is entirely inside the light volume
 				{
 					p3 = (testPoint1 + testPoint2)/2.0f;
-					lightReaches = traceLightPath( testPoint1, vLight, p_ignoredEntity, light );
-					if ( !lightReaches )
-					{
-						lightReaches = traceLightPath( testPoint2, vLight, p_ignoredEntity, light );
-						if ( !lightReaches )
-						{
-							lightReaches = traceLightPath( p3, vLight, p_ignoredEntity, light );
-						}
-					}
+					paths[0] = testPoint1;
+					paths[1] = testPoint2;
+					paths[2] = p3;
+					lightReaches = ( traceLightPaths( paths, 3, vLight, p_ignoredEntity, light ) >= 0 );
 					p_illumination = p3;
 				}
 				else if ( ( inter == INTERSECT_PARTIAL ) && ( inside[0] || inside[1] ) ) // one line end inside, one outside
@@ -516,20 +568,12 @@ void darkModLAS::accumulateEffectOfLightsInArea
 
 					p2 = vResult[0]; // the single point of intersection
 					p3 = (p1 + p2)/2.0f;
-					lightReaches = traceLightPath( p1, vLight, p_ignoredEntity, light );
-					if ( lightReaches )
-					{
-						p_illumination = p1;
-					}
-					else
-					{
-						p_illumination = p3;
-						lightReaches = traceLightPath( p2, vLight, p_ignoredEntity, light );
-						if ( !lightReaches )
-						{
-							lightReaches = traceLightPath( p3, vLight, p_ignoredEntity, light );
-						}
-					}
+					paths[0] = p1;
+					paths[1] = p2;
+					paths[2] = p3;
+					int reached = traceLightPaths( paths, 3, vLight, p_ignoredEntity, light );
+					lightReaches = ( reached >= 0 );
+					p_illumination = ( reached == 0 ) ? p1 : p3;
 				}
 				else if ( inter == INTERSECT_PARTIAL ) // both line ends outside, line touches volume at one intersection point
 				{
@@ -544,15 +588,10 @@ void darkModLAS::accumulateEffectOfLightsInArea
 					p2 = vResult[1]; // the second point of intersection
 					p3 = (p1 + p2)/2.0f;
 					p_illumination = p3;
-					lightReaches = traceLightPath( p1, vLight, p_ignoredEntity, light );
-					if ( !lightReaches )
-					{
-						lightReaches = traceLightPath( p2, vLight, p_ignoredEntity, light );
-						if ( !lightReaches )
-						{
-							lightReaches = traceLightPath( p3, vLight, p_ignoredEntity, light );
-						}
-					}
+					paths[0] = p1;
+					paths[1] = p2;
+					paths[2] = p3;
+					lightReaches = ( traceLightPaths( paths, 3, vLight, p_ignoredEntity, light ) >= 0 );
 				}
 				
 				b_excludeLight = !lightReaches;
@@ -94,6 +94,15 @@ protected:
 
    bool traceLightPath( idVec3 to, idVec3 from, idEntity* ignore, idLight* light); // grayman #2853 // grayman #3584
 
+   /*!
+   * Traces the light path from each of the given points in one trace batch.
+   * @return the index of the first point the light reaches, -1 if none
+   */ 
+   int traceLightPaths( const idVec3* from, int numPaths, idVec3 to, idEntity* ignore, idLight* light );
+
+   // follows a light path from its first trace on through non-shadow-casting entities
+   bool continueLightPath( trace_t& trace, idVec3 from, idVec3 to, idLight* light );
+
    /*!
    * This method is used to add up all the light intensities contributed from
    * a specific region apon the line between the two test points.
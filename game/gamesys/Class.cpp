@@ -48,6 +48,73 @@ static idTypeInfo				*typelist = NULL;
 static idHierarchy<idTypeInfo>	classHierarchy;
 static int						eventCallbackMemory	= 0;
 
+#if CPU_EASYARGS
+
+/*
+================
+Event thunks
+
+All event arguments are passed as ints with CPU_EASYARGS, so a handler can be
+called through a thunk that only depends on the number of arguments.
+idClass::Init picks the thunk of every event def once at startup.
+================
+*/
+typedef void ( *eventThunk_t )( idClass *obj, eventCallback_t callback, const int *data );
+
+typedef void ( idClass::*eventCallback_1_t )( const int );
+typedef void ( idClass::*eventCallback_2_t )( const int, const int );
+typedef void ( idClass::*eventCallback_3_t )( const int, const int, const int );
+typedef void ( idClass::*eventCallback_4_t )( const int, const int, const int, const int );
+typedef void ( idClass::*eventCallback_5_t )( const int, const int, const int, const int, const int );
+typedef void ( idClass::*eventCallback_6_t )( const int, const int, const int, const int, const int, const int );
+typedef void ( idClass::*eventCallback_7_t )( const int, const int, const int, const int, const int, const int, const int );
+typedef void ( idClass::*eventCallback_8_t )( const int, const int, const int, const int, const int, const int, const int, const int );
+
+static void EventThunk_0( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*callback )();
+}
+
+static void EventThunk_1( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*( eventCallback_1_t )callback )( data[ 0 ] );
+}
+
+static void EventThunk_2( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*( eventCallback_2_t )callback )( data[ 0 ], data[ 1 ] );
+}
+
+static void EventThunk_3( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*( eventCallback_3_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ] );
+}
+
+static void EventThunk_4( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*( eventCallback_4_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ] );
+}
+
+static void EventThunk_5( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*( eventCallback_5_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ] );
+}
+
+static void EventThunk_6( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*( eventCallback_6_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ] );
+}
+
+static void EventThunk_7( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*( eventCallback_7_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ], data[ 6 ] );
+}
+
+static void EventThunk_8( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*( eventCallback_8_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ], data[ 6 ], data[ 7 ] );
+}
+
+static const eventThunk_t eventThunksByNumArgs[ D_EVENT_MAXARGS + 1 ] = {
+	EventThunk_0, EventThunk_1, EventThunk_2, EventThunk_3, EventThunk_4, EventThunk_5, EventThunk_6, EventThunk_7, EventThunk_8
+};
+
+// indexed by event number
+static eventThunk_t				eventThunks[ MAX_EVENTS ];
+
+#endif
+
 /*
 ================
 idTypeInfo::idClassType()
@@ -389,6 +456,15 @@ void idClass::Init( void ) {
 		c->Init();
 	}
 
+#if CPU_EASYARGS
+	assert( D_EVENT_MAXARGS == 8 );
+
+	// pick the thunk that calls the handlers of each event
+	for( num = 0; num < idEventDef::NumEventCommands(); num++ ) {
+		eventThunks[ num ] = eventThunksByNumArgs[ idEventDef::GetEventCommand( num )->GetNumArgs() ];
+	}
+#endif
+
 	// number the types according to the class hierarchy so we can quickly determine if a class
 	// is a subclass of another
 	num = 0;
@@ -825,17 +901,15 @@ idClass::ProcessEventArgs
 ================
 */
 bool idClass::ProcessEventArgs( const idEventDef *ev, int numargs, ... ) {
-	idTypeInfo	*c;
-	int			num;
+	eventCallback_t	callback;
 	int			data[ D_EVENT_MAXARGS ];
 	va_list		args;
 	
 	assert( ev );
 	assert( idEvent::initialized );
 
-	c = GetType();
-	num = ev->GetEventNum();
-	if ( !c->eventMap[ num ] ) {
+	callback = GetEventCallback( ev );
+	if ( !callback ) {
 		// we don't respond to this event, so ignore it
 		return false;
 	}
@@ -844,7 +918,7 @@ bool idClass::ProcessEventArgs( const idEventDef *ev, int numargs, ... ) {
 	idEvent::CopyArgs( ev, numargs, args, data );
 	va_end( args );
 
-	ProcessEventArgPtr( ev, data );
+	CallEventCallback( ev, callback, data );
 
 	return true;
 }
@@ -936,26 +1010,35 @@ idClass::ProcessEventArgPtr
 ================
 */
 bool idClass::ProcessEventArgPtr( const idEventDef *ev, int *data ) {
-	idTypeInfo	*c;
-	int			num;
 	eventCallback_t	callback;
 
 	assert( ev );
 	assert( idEvent::initialized );
 
-	if ( g_debugTriggers.GetBool() && ( ev == &EV_Activate ) && IsType( idEntity::Type ) ) {
-		const idEntity *ent = *reinterpret_cast<idEntity **>( data );
-		gameLocal.Printf( "%d: '%s' activated by '%s'\n", gameLocal.framenum, static_cast<idEntity *>( this )->GetName(), ent ? ent->GetName() : "NULL" );
-	}
-
-	c = GetType();
-	num = ev->GetEventNum();
-	if ( !c->eventMap[ num ] ) {
+	callback = GetEventCallback( ev );
+	if ( !callback ) {
 		// we don't respond to this event, so ignore it
 		return false;
 	}
 
-	callback = c->eventMap[ num ];
+	CallEventCallback( ev, callback, data );
+
+	return true;
+}
+
+/*
+================
+idClass::CallEventCallback
+
+Calls the handler of an event with the arguments already converted into data.
+callback must be the one GetEventCallback returns for ev.
+================
+*/
+void idClass::CallEventCallback( const idEventDef *ev, eventCallback_t callback, int *data ) {
+	if ( g_debugTriggers.GetBool() && ( ev == &EV_Activate ) && IsType( idEntity::Type ) ) {
+		const idEntity *ent = *reinterpret_cast<idEntity **>( data );
+		gameLocal.Printf( "%d: '%s' activated by '%s'\n", gameLocal.framenum, static_cast<idEntity *>( this )->GetName(), ent ? ent->GetName() : "NULL" );
+	}
 
 #if !CPU_EASYARGS
 
@@ -981,61 +1064,9 @@ http://developer.apple.com/documentation/DeveloperTools/Conceptual/MachORuntime/
 
 #else
 
-	assert( D_EVENT_MAXARGS == 8 );
-
-	switch( ev->GetNumArgs() ) {
-	case 0 :
-		( this->*callback )();
-		break;
-
-	case 1 :
-		typedef void ( idClass::*eventCallback_1_t )( const int );
-		( this->*( eventCallback_1_t )callback )( data[ 0 ] );
-		break;
-
-	case 2 :
-		typedef void ( idClass::*eventCallback_2_t )( const int, const int );
-		( this->*( eventCallback_2_t )callback )( data[ 0 ], data[ 1 ] );
-		break;
-
-	case 3 :
-		typedef void ( idClass::*eventCallback_3_t )( const int, const int, const int );
-		( this->*( eventCallback_3_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ] );
-		break;
-
-	case 4 :
-		typedef void ( idClass::*eventCallback_4_t )( const int, const int, const int, const int );
-		( this->*( eventCallback_4_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ] );
-		break;
-
-	case 5 :
-		typedef void ( idClass::*eventCallback_5_t )( const int, const int, const int, const int, const int );
-		( this->*( eventCallback_5_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ] );
-		break;
-
-	case 6 :
-		typedef void ( idClass::*eventCallback_6_t )( const int, const int, const int, const int, const int, const int );
-		( this->*( eventCallback_6_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ] );
-		break;
-
-	case 7 :
-		typedef void ( idClass::*eventCallback_7_t )( const int, const int, const int, const int, const int, const int, const int );
-		( this->*( eventCallback_7_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ], data[ 6 ] );
-		break;
-
-	case 8 :
-		typedef void ( idClass::*eventCallback_8_t )( const int, const int, const int, const int, const int, const int, const int, const int );
-		( this->*( eventCallback_8_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ], data[ 6 ], data[ 7 ] );
-		break;
-
-	default:
-		gameLocal.Warning( "Invalid formatspec on event '%s'", ev->GetName() );
-		break;
-	}
+	eventThunks[ ev->GetEventNum() ]( this, callback, data );
 
 #endif
-
-	return true;
 }
 
 /*
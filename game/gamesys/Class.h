@@ -229,6 +229,10 @@ public:
 	bool						ProcessEvent( const idEventDef *ev, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6, idEventArg arg7, idEventArg arg8 );
 
 	bool						ProcessEventArgPtr( const idEventDef *ev, int *data );
+								// NULL if we don't respond to ev
+	eventCallback_t				GetEventCallback( const idEventDef *ev ) const;
+								// calls the handler found with GetEventCallback directly, data holds the converted arguments
+	void						CallEventCallback( const idEventDef *ev, eventCallback_t callback, int *data );
 	void						CancelEvents( const idEventDef *ev );
 
 	void						Event_Remove( void );
@@ -252,6 +256,9 @@ private:
 
 	void						Event_SafeRemove( void );
 
+	friend class idEvent;
+	idLinkList<idEvent>			pendingEvents;		// events scheduled for this object
+
 	static bool					initialized;
 	static idList<idTypeInfo *>	types;
 	static idList<idTypeInfo *>	typenums;
@@ -352,4 +359,14 @@ ID_INLINE bool idClass::RespondsTo( const idEventDef &ev ) const {
 	return c->RespondsTo( ev );
 }
 
+/*
+================
+idClass::GetEventCallback
+================
+*/
+ID_INLINE eventCallback_t idClass::GetEventCallback( const idEventDef *ev ) const {
+	assert( idEvent::initialized );
+	return GetType()->eventMap[ ev->GetEventNum() ];
+}
+
 #endif /* !__SYS_CLASS_H__ */
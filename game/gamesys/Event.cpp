@@ -35,6 +35,7 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "../Game_local.h"
 
 #define MAX_EVENTSPERFRAME			8192
+#define EVENT_BLOCK_SIZE			1024		// events added to the pool when it runs out
 //#define CREATE_EVENT_CODE
 
 /***********************************************************************
@@ -241,13 +242,34 @@ const idEventDef *idEventDef::FindEvent( const char *name ) {
 ***********************************************************************/
 
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
+static idList<idEvent *> EventQueue;			// binary min-heap ordered by FiresBefore()
+static idList<idEvent *> EventBlocks;			// blocks added after EventPool ran out
+static unsigned int EventSequence;
 static idEvent EventPool[ MAX_EVENTS ];
 
 bool idEvent::initialized = false;
 
 idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
 
+const idEventDef EV_EventQueueTest( "<eventQueueTest>", EventArgs(), EV_RETURNS_VOID, "internal" );
+
+/*
+================
+idEvent::idEvent()
+================
+*/
+idEvent::idEvent() {
+	eventdef	= NULL;
+	data		= NULL;
+	time		= 0;
+	object		= NULL;
+	typeinfo	= NULL;
+	heapIndex	= -1;
+	sequence	= 0;
+	eventNode.SetOwner( this );
+	objectNode.SetOwner( this );
+}
+
 /*
 ================
 idEvent::~idEvent()
@@ -257,6 +279,116 @@ idEvent::~idEvent() {
 	Free();
 }
 
+/*
+================
+idEvent::GetFreeEvent
+================
+*/
+idEvent *idEvent::GetFreeEvent( void ) {
+	idEvent *ev;
+
+	if ( FreeEvents.IsListEmpty() ) {
+		// grow the pool instead of failing, script heavy maps can have a lot of pending events
+		idEvent *block = new idEvent[ EVENT_BLOCK_SIZE ];
+		EventBlocks.Append( block );
+		for( int i = 0; i < EVENT_BLOCK_SIZE; i++ ) {
+			block[ i ].Free();
+		}
+		gameLocal.DPrintf( "idEvent: grew the event pool to %d events\n", MAX_EVENTS + EventBlocks.Num() * EVENT_BLOCK_SIZE );
+	}
+
+	ev = FreeEvents.Next();
+	ev->eventNode.Remove();
+	return ev;
+}
+
+/*
+================
+idEvent::FiresBefore
+
+Events fire in order of their time, events with the same time in the order they were scheduled.
+================
+*/
+ID_INLINE bool idEvent::FiresBefore( const idEvent *a, const idEvent *b ) {
+	if ( a->time != b->time ) {
+		return ( a->time < b->time );
+	}
+	return ( static_cast<int>( a->sequence - b->sequence ) < 0 );
+}
+
+/*
+================
+idEvent::HeapMoveUp
+================
+*/
+void idEvent::HeapMoveUp( int index ) {
+	idEvent *event = EventQueue[ index ];
+
+	while( index > 0 ) {
+		int parent = ( index - 1 ) >> 1;
+		if ( !FiresBefore( event, EventQueue[ parent ] ) ) {
+			break;
+		}
+		EventQueue[ index ] = EventQueue[ parent ];
+		EventQueue[ index ]->heapIndex = index;
+		index = parent;
+	}
+
+	EventQueue[ index ] = event;
+	event->heapIndex = index;
+}
+
+/*
+================
+idEvent::HeapMoveDown
+================
+*/
+void idEvent::HeapMoveDown( int index ) {
+	idEvent *event = EventQueue[ index ];
+	int num = EventQueue.Num();
+
+	while( 1 ) {
+		int child = index * 2 + 1;
+		if ( child >= num ) {
+			break;
+		}
+		if ( child + 1 < num && FiresBefore( EventQueue[ child + 1 ], EventQueue[ child ] ) ) {
+			child++;
+		}
+		if ( !FiresBefore( EventQueue[ child ], event ) ) {
+			break;
+		}
+		EventQueue[ index ] = EventQueue[ child ];
+		EventQueue[ index ]->heapIndex = index;
+		index = child;
+	}
+
+	EventQueue[ index ] = event;
+	event->heapIndex = index;
+}
+
+/*
+================
+idEvent::HeapRemove
+================
+*/
+void idEvent::HeapRemove( idEvent *event ) {
+	int index = event->heapIndex;
+	idEvent *last = EventQueue[ EventQueue.Num() - 1 ];
+
+	assert( index >= 0 && EventQueue[ index ] == event );
+
+	EventQueue.SetNum( EventQueue.Num() - 1, false );
+	event->heapIndex = -1;
+
+	if ( last != event ) {
+		EventQueue[ index ] = last;
+		last->heapIndex = index;
+		HeapMoveUp( index );
+		HeapMoveDown( last->heapIndex );
+	}
+}
+
 /*
 ================
 idEvent::Alloc
@@ -271,12 +403,7 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 	int			i;
 	const char	*materialName;
 
-	if ( FreeEvents.IsListEmpty() ) {
-		gameLocal.Error( "idEvent::Alloc : No more free events" );
-	}
-
-	ev = FreeEvents.Next();
-	ev->eventNode.Remove();
+	ev = GetFreeEvent();
 
 	ev->eventdef = evdef;
 
@@ -392,6 +519,11 @@ void idEvent::Free( void ) {
 		data = NULL;
 	}
 
+	if ( heapIndex >= 0 ) {
+		HeapRemove( this );
+	}
+	objectNode.Remove();
+
 	eventdef	= NULL;
 	time		= 0;
 	object		= NULL;
@@ -407,13 +539,15 @@ idEvent::Schedule
 ================
 */
 void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
-	idEvent *event;
-
 	assert( initialized );
 	if ( !initialized ) {
 		return;
 	}
 
+	if ( heapIndex >= 0 ) {
+		HeapRemove( this );
+	}
+
 	object = obj;
 	typeinfo = type;
 
@@ -422,16 +556,13 @@ void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
 
 	eventNode.Remove();
 
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) ) {
-		event = event->eventNode.Next();
-	}
+	// fires after all events scheduled earlier for the same time
+	sequence = EventSequence++;
 
-	if ( event ) {
-		eventNode.InsertBefore( event->eventNode );
-	} else {
-		eventNode.AddToEnd( EventQueue );
-	}
+	EventQueue.Append( this );
+	HeapMoveUp( EventQueue.Num() - 1 );
+
+	objectNode.AddToEnd( obj->pendingEvents );
 }
 
 /*
@@ -447,12 +578,10 @@ void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				event->Free();
-			}
+	for( event = obj->pendingEvents.Next(); event != NULL; event = next ) {
+		next = event->objectNode.Next();
+		if ( !evdef || ( evdef == event->eventdef ) ) {
+			event->Free();
 		}
 	}
 }
@@ -469,14 +598,23 @@ void idEvent::ClearEventList( void ) {
 	// initialize lists
 	//
 	FreeEvents.Clear();
-	EventQueue.Clear();
+	EventQueue.SetNum( 0, false );
+	EventQueue.SetGranularity( 1024 );
+	EventSequence = 0;
    
 	// 
 	// add the events to the free list
 	//
 	for( i = 0; i < MAX_EVENTS; i++ ) {
+		EventPool[ i ].heapIndex = -1;
 		EventPool[ i ].Free();
 	}
+	for( i = 0; i < EventBlocks.Num(); i++ ) {
+		for( int j = 0; j < EVENT_BLOCK_SIZE; j++ ) {
+			EventBlocks[ i ][ j ].heapIndex = -1;
+			EventBlocks[ i ][ j ].Free();
+		}
+	}
 }
 
 /*
@@ -498,8 +636,8 @@ void idEvent::ServiceEvents( void ) {
 	const char  *materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() ) {
-		event = EventQueue.Next();
+	while( EventQueue.Num() > 0 ) {
+		event = EventQueue[ 0 ];
 		assert( event );
 
 		if ( event->time > gameLocal.time ) {
@@ -552,9 +690,10 @@ void idEvent::ServiceEvents( void ) {
 			}
 		}
 
-		// the event is removed from its list so that if then object
-		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		// the event is removed from the queue and the object so that if
+		// the object is deleted, the event won't be freed twice
+		HeapRemove( event );
+		event->objectNode.Remove();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -626,6 +765,11 @@ void idEvent::Shutdown( void ) {
 	}
 
 	ClearEventList();
+
+	for( int i = 0; i < EventBlocks.Num(); i++ ) {
+		delete[] EventBlocks[ i ];
+	}
+	EventBlocks.Clear();
 	
 	eventDataAllocator.Shutdown();
 
@@ -633,24 +777,42 @@ void idEvent::Shutdown( void ) {
 	initialized = false;
 }
 
+/*
+================
+idEvent::CompareFiringOrder
+================
+*/
+int idEvent::CompareFiringOrder( idEvent * const *a, idEvent * const *b ) {
+	if ( *a == *b ) {
+		return 0;
+	}
+	return FiresBefore( *a, *b ) ? -1 : 1;
+}
+
 /*
 ================
 idEvent::Save
+
+The events are written in firing order, the same layout as when the queue was a sorted list.
 ================
 */
 void idEvent::Save( idSaveGame *savefile ) {
 	char *str;
-	int i;
+	int i, n;
 	size_t size;
 	idEvent	*event;
 	byte *dataPtr;
 	bool validTrace;
 	const char	*format;
+	idList<idEvent *> sorted;
+
+	sorted = EventQueue;
+	sorted.Sort( CompareFiringOrder );
 
-	savefile->WriteInt( EventQueue.Num() );
+	savefile->WriteInt( sorted.Num() );
 
-	event = EventQueue.Next();
-	while( event != NULL ) {
+	for( n = 0; n < sorted.Num(); n++ ) {
+		event = sorted[ n ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
@@ -694,7 +856,6 @@ void idEvent::Save( idSaveGame *savefile ) {
 			}
 		}
 		assert( size == event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 }
 
@@ -714,13 +875,7 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( num );
 
 	for ( i = 0; i < num; i++ ) {
-		if ( FreeEvents.IsListEmpty() ) {
-			gameLocal.Error( "idEvent::Restore : No more free events" );
-		}
-
-		event = FreeEvents.Next();
-		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
+		event = GetFreeEvent();
 
 		savefile->ReadInt( event->time );
 
@@ -740,6 +895,14 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 		savefile->ReadObject( event->object );
 
+		// the events were saved in firing order, so the restore order is the scheduling order
+		event->sequence = EventSequence++;
+		EventQueue.Append( event );
+		HeapMoveUp( EventQueue.Num() - 1 );
+		if ( event->object ) {
+			event->objectNode.AddToEnd( event->object->pendingEvents );
+		}
+
 		// read the args
 		savefile->ReadInt( argsize );
 		if ( argsize != (int)event->eventdef->GetArgSize() ) {
@@ -841,6 +1004,69 @@ void idEvent::SaveTrace( idSaveGame *savefile, const trace_t &trace ) {
 
 
 
+/*
+================
+idEvent::TestEventQueue_f
+
+Schedules 100k events spread over the entities of the map, then cancels
+them again entity by entity and prints the time both took.
+================
+*/
+void idEvent::TestEventQueue_f( const idCmdArgs &args ) {
+	const int	numEvents = 100000;
+	int			i, numQueued;
+	bool		heapValid;
+	idRandom	random( 0 );
+	idTimer		scheduleTimer, cancelTimer;
+	idList<idClass *> objects;
+
+	if ( !initialized || !gameLocal.GetLocalPlayer() ) {
+		gameLocal.Printf( "No map loaded.\n" );
+		return;
+	}
+
+	for( i = 0; i < MAX_GENTITIES; i++ ) {
+		if ( gameLocal.entities[ i ] ) {
+			objects.Append( gameLocal.entities[ i ] );
+		}
+	}
+
+	numQueued = EventQueue.Num();
+
+	scheduleTimer.Start();
+	for( i = 0; i < numEvents; i++ ) {
+		idClass *obj = objects[ i % objects.Num() ];
+		idEvent *event = GetFreeEvent();
+		event->eventdef = &EV_EventQueueTest;
+		event->data = NULL;
+		event->Schedule( obj, obj->GetType(), 1 + random.RandomInt( 100000 ) );
+	}
+	scheduleTimer.Stop();
+
+	heapValid = true;
+	for( i = 1; i < EventQueue.Num(); i++ ) {
+		if ( FiresBefore( EventQueue[ i ], EventQueue[ ( i - 1 ) >> 1 ] ) ) {
+			heapValid = false;
+		}
+	}
+
+	cancelTimer.Start();
+	for( i = 0; i < objects.Num(); i++ ) {
+		CancelEvents( objects[ i ], &EV_EventQueueTest );
+	}
+	cancelTimer.Stop();
+
+	gameLocal.Printf( "%d events on %d entities, %d events were already queued\n", numEvents, objects.Num(), numQueued );
+	gameLocal.Printf( "schedule: %6.2f ms\n", scheduleTimer.Milliseconds() );
+	gameLocal.Printf( "cancel:   %6.2f ms\n", cancelTimer.Milliseconds() );
+	if ( !heapValid ) {
+		gameLocal.Warning( "event queue heap order is broken" );
+	}
+	if ( EventQueue.Num() != numQueued ) {
+		gameLocal.Warning( "%d test events were not cancelled", EventQueue.Num() - numQueued );
+	}
+}
+
 #ifdef CREATE_EVENT_CODE
 /*
 ================
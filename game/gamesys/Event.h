@@ -115,14 +115,24 @@ private:
 	idClass						*object;
 	const idTypeInfo			*typeinfo;
 
-	idLinkList<idEvent>			eventNode;
+	idLinkList<idEvent>			eventNode;			// node in the free list
+	idLinkList<idEvent>			objectNode;			// node in the pending events of the object
+	int							heapIndex;			// index in the event queue heap, -1 if not scheduled
+	unsigned int				sequence;			// scheduling order, events with the same time fire in this order
 
 	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
 
+	static idEvent *			GetFreeEvent( void );
+	static bool					FiresBefore( const idEvent *a, const idEvent *b );
+	static void					HeapMoveUp( int index );
+	static void					HeapMoveDown( int index );
+	static void					HeapRemove( idEvent *event );
+	static int					CompareFiringOrder( idEvent * const *a, idEvent * const *b );
 
 public:
 	static bool					initialized;
 
+								idEvent();
 								~idEvent();
 
 	static idEvent				*Alloc( const idEventDef *evdef, int numargs, va_list args );
@@ -144,7 +154,8 @@ public:
 
 	static void					SaveTrace( idSaveGame *savefile, const trace_t &trace );
 	static void					RestoreTrace( idRestoreGame *savefile, trace_t &trace );
-	
+
+	static void					TestEventQueue_f( const class idCmdArgs &args );
 };
 
 /*
@@ -63,24 +63,193 @@ The caching mechanism works in the following way. On game saving, there are two
 		//	gameSoundWorld->WriteToSaveGame( file ) - closed source
 		//	WriteBuildNumber() and WriteCodeRevision() - vital, should not be compressed
 		This data is written directly to the file.
+Whenever the cache grows beyond SAVEGAME_CHUNK_SIZE it is handed to the job pool as a chunk
+and compressed on a worker thread while the remaining objects are saved.
 After all the data has been passed to idSaveGame, FinalizeCache must be called.
-Depending on the settings it may compress the cache. Then it is finally dumped to idFile.
+It compresses the last chunk, waits for all chunks and dumps them to idFile.
+A background save defers the compression instead: DetachCache hands the raw chunks to an
+idSaveGameCache, which compresses and dumps them on the session's save thread.
 After that the last 4 bytes are written to the file - offset to cache start from the end of file.
 The final file layout is then:
 	1. Doom3 header (level info, we cannot change it)
 	2. Special data (including version numbers)
-	3. Cache image, maybe compressed (consists of ordinary data)
+	3. Cache image (consists of ordinary data):
+		SAVEGAME_CACHE_CHUNKED, number of chunks,
+		compressed and uncompressed size of each chunk,
+		compressed chunks
 	4. Offset from EOF to cache image (is negative)
+The special data is written straight to the file in between, so the compressed chunks can
+only be written once the whole game is saved.
 Restoring works almost the same way, but the cache must be retrieved at the very beginning.
 The InitializeCache must be called before any ordinary data is read from the file.
-It uses fseek to get offset to cache image, then reads it, probably decompresses it.
+It uses fseek to get offset to cache image, then reads it and decompresses the chunks in parallel.
+Old savegames store the cache as a single compressed block which is still understood.
 Afterwards it fseeks to the file position on the moment of call.
 Then all the Read* happens which reads ordinary data from cache and special data from file.
 */
 
-idSaveGame::idSaveGame( idFile *savefile ) {
+// marks a chunked cache image, the old single block image starts with its positive size
+static const int SAVEGAME_CACHE_CHUNKED = -1;
+
+struct saveGameChunk_t {
+	CRawVector				raw;			// uncompressed data, freed once compressed
+	CRawVector				zipped;
+	int						rawSize;
+	int						error;			// zlib result
+	double					msec;			// time spent compressing
+};
+
+typedef struct {
+	const char *			zipped;
+	int						zipSize;
+	char *					raw;
+	int						rawSize;
+	int						error;			// zlib result
+} restoreGameChunk_t;
 
+/*
+================
+SaveGame_CompressChunk
+
+Runs on the job pool, must not touch anything but the chunk.
+================
+*/
+static void SaveGame_CompressChunk( void *data, int index ) {
+	saveGameChunk_t *chunk = (saveGameChunk_t *)data;
+	idTimer timer;
+
+	timer.Start();
+
+	uLongf zipSize = compressBound( chunk->rawSize );
+	chunk->zipped.resize( zipSize );
+	chunk->error = compress( (Bytef *)&chunk->zipped[0], &zipSize, (const Bytef *)&chunk->raw[0], chunk->rawSize );
+	chunk->zipped.resize( zipSize );
+
+	// give back the uncompressed memory right away
+	CRawVector empty;
+	std::swap( chunk->raw, empty );
+
+	timer.Stop();
+	chunk->msec = timer.Milliseconds();
+}
+
+/*
+================
+RestoreGame_DecompressChunk
+================
+*/
+static void RestoreGame_DecompressChunk( void *data, int index ) {
+	restoreGameChunk_t *chunk = (restoreGameChunk_t *)data + index;
+
+	uLongf rawSize = chunk->rawSize;
+	chunk->error = uncompress( (Bytef *)chunk->raw, &rawSize, (const Bytef *)chunk->zipped, chunk->zipSize );
+	if ( chunk->error == Z_OK && rawSize != (uLongf)chunk->rawSize ) {
+		chunk->error = Z_DATA_ERROR;
+	}
+}
+
+/*
+================
+SaveGame_WriteCacheImage
+
+Writes the chunk table, the compressed chunks and the offset from EOF to the cache image.
+Returns the zlib error of the first chunk that failed to compress, nothing is written then.
+================
+*/
+static int SaveGame_WriteCacheImage( idFile *file, const idList<saveGameChunk_t *> &chunks, int &rawSize, int &zipSize, double &compressMsec ) {
+	int i;
+
+	for (i = 0; i < chunks.Num(); i++) {
+		if (chunks[i]->error != Z_OK)
+			return chunks[i]->error;
+	}
+
+	int offset = sizeof(int);
+	rawSize = zipSize = 0;
+	compressMsec = 0.0;
+
+	//write chunk table
+	file->WriteInt(SAVEGAME_CACHE_CHUNKED);		offset += sizeof(int);
+	file->WriteInt(chunks.Num());				offset += sizeof(int);
+	for (i = 0; i < chunks.Num(); i++) {
+		const saveGameChunk_t *chunk = chunks[i];
+		file->WriteInt(chunk->zipped.size());	offset += sizeof(int);
+		file->WriteInt(chunk->rawSize);			offset += sizeof(int);
+	}
+	//write compressed data
+	for (i = 0; i < chunks.Num(); i++) {
+		const saveGameChunk_t *chunk = chunks[i];
+		if (chunk->zipped.size() > 0)
+			file->Write(&chunk->zipped[0], chunk->zipped.size());
+		offset += chunk->zipped.size();
+		rawSize += chunk->rawSize;
+		zipSize += chunk->zipped.size();
+		compressMsec += chunk->msec;
+	}
+	//write offset from EOF to cache start
+	file->WriteInt(-offset);
+
+	return Z_OK;
+}
+
+/*
+================
+idSaveGameCache::idSaveGameCache
+================
+*/
+idSaveGameCache::idSaveGameCache( idFile *savefile, double serializeMsec ) {
 	file = savefile;
+	this->serializeMsec = serializeMsec;
+}
+
+/*
+================
+idSaveGameCache::~idSaveGameCache
+================
+*/
+idSaveGameCache::~idSaveGameCache() {
+	chunks.DeleteContents( true );
+}
+
+/*
+================
+idSaveGameCache::Finish
+
+Runs on the session's save thread while the game goes on, so it must not touch anything but
+the chunks and the file, which the session doesn't use until the thread is done.
+The chunks are compressed one after another since the job pool belongs to the game thread.
+================
+*/
+bool idSaveGameCache::Finish( char *report, int reportSize ) {
+	idTimer writeTimer;
+	int i, rawSize, zipSize;
+	double compressMsec;
+
+	for (i = 0; i < chunks.Num(); i++) {
+		SaveGame_CompressChunk( chunks[i], 0 );
+	}
+
+	writeTimer.Start();
+	int error = SaveGame_WriteCacheImage( file, chunks, rawSize, zipSize, compressMsec );
+	writeTimer.Stop();
+
+	if ( error != Z_OK ) {
+		idStr::snPrintf( report, reportSize, "idSaveGameCache::Finish: compress failed with code %d", error );
+		return false;
+	}
+
+	idStr::snPrintf( report, reportSize, "Savegame: serialized %d KB in %.0f msec, compressed to %d KB in %d chunks in %.0f msec in the background, written in %.0f msec",
+		rawSize >> 10, serializeMsec, zipSize >> 10, chunks.Num(), compressMsec, writeTimer.Milliseconds() );
+
+	chunks.DeleteContents( true );
+	return true;
+}
+
+idSaveGame::idSaveGame( idFile *savefile, bool deferCompression ) {
+
+	file = savefile;
+	this->deferCompression = deferCompression;
+	isCompressed = false;
 
 	// Put NULL at the start of the list so we can skip over it.
 	objects.Clear();
@@ -91,6 +260,11 @@ idSaveGame::~idSaveGame() {
 	if ( objects.Num() ) {
 		Close();
 	}
+	if ( chunks.Num() ) {
+		// saving was aborted, the workers may still be compressing
+		jobPool.Wait();
+		chunks.DeleteContents( true );
+	}
 }
 
 void idSaveGame::Close( void ) {
@@ -114,34 +288,71 @@ void idSaveGame::Close( void ) {
 #endif
 }
 
+void idSaveGame::FlushCacheChunk( void ) {
+	saveGameChunk_t *chunk = new saveGameChunk_t;
+	std::swap( chunk->raw, cache );
+	chunk->rawSize = chunk->raw.size();
+	chunk->error = Z_OK;
+	chunk->msec = 0.0;
+	chunks.Append( chunk );
+
+	if ( !deferCompression ) {
+		jobPool.AddJob( SaveGame_CompressChunk, chunk );
+	}
+
+	// the next chunk will grow to the same size
+	cache.reserve( SAVEGAME_CHUNK_SIZE + SAVEGAME_CHUNK_SIZE / 4 );
+}
+
 void idSaveGame::FinalizeCache( void ) {
 	if (!isCompressed) return;
-		
-	int offset = sizeof(int);
 
-	//resize destination buffer
-	CRawVector zipped;
-	int zipsize = compressBound(cache.size());
-	zipped.resize(zipsize);
+	assert( !deferCompression );
+	serializeTimer.Stop();
 
-	//compress the cache
-	int err = compress((Bytef *)&zipped[0], (uLongf*)&zipsize,
-		(const Bytef *)&cache[0], cache.size());
-	if (err != Z_OK)
-		gameLocal.Error("idSaveGame::FinalizeCache: compress failed with code %d", err);
-	zipped.resize(zipsize);
+	idTimer waitTimer, writeTimer;
+	int rawSize, zipSize;
+	double compressMsec;
 
-	//write compressed size and uncompressed size
-	file->WriteInt(zipped.size());				offset += sizeof(int);
-	file->WriteInt(cache.size());				offset += sizeof(int);
-	//write compressed data
-	file->Write(&zipped[0], zipped.size());		offset += zipped.size();
-	//write offset from EOF to cache start
-	file->WriteInt(-offset);
+	//compress the rest and wait for the workers
+	if (cache.size() > 0 || chunks.Num() == 0)
+		FlushCacheChunk();
+	waitTimer.Start();
+	jobPool.Wait();
+	waitTimer.Stop();
+
+	writeTimer.Start();
+	int error = SaveGame_WriteCacheImage( file, chunks, rawSize, zipSize, compressMsec );
+	if (error != Z_OK)
+		gameLocal.Error("idSaveGame::FinalizeCache: compress failed with code %d", error);
+	writeTimer.Stop();
+
+	gameLocal.Printf( "Savegame: serialized %d KB in %.0f msec, compressed to %d KB in %d chunks in %.0f msec (%.0f msec waited), written in %.0f msec\n",
+		rawSize >> 10, serializeTimer.Milliseconds(), zipSize >> 10, chunks.Num(), compressMsec, waitTimer.Milliseconds(), writeTimer.Milliseconds() );
 
+	chunks.DeleteContents( true );
 	cache.clear();
 }
 
+idSaveGameCache *idSaveGame::DetachCache( void ) {
+	if (!isCompressed) return NULL;
+
+	assert( deferCompression );
+	serializeTimer.Stop();
+
+	if (cache.size() > 0 || chunks.Num() == 0)
+		FlushCacheChunk();
+
+	idSaveGameCache *detached = new idSaveGameCache( file, serializeTimer.Milliseconds() );
+	detached->chunks = chunks;
+	chunks.Clear();
+
+	CRawVector empty;
+	std::swap( cache, empty );
+
+	return detached;
+}
+
 void idSaveGame::WriteObjectList( void ) {
 	int i;
 
@@ -173,6 +384,8 @@ void idSaveGame::Write( const void *buffer, int len ) {
 		int sz = cache.size();
 		cache.resize(sz + len);
 		memcpy(&cache[sz], buffer, len);
+		if (cache.size() >= SAVEGAME_CHUNK_SIZE)
+			FlushCacheChunk();
 	}
 	else
 		file->Write(buffer, len);
@@ -551,6 +764,11 @@ void idSaveGame::WriteHeader()
 	file->WriteInt(RevisionTracker::Instance().GetHighestRevision());
 	isCompressed = cv_savegame_compress.GetBool();
 	file->WriteBool(isCompressed);
+
+	serializeTimer.Clear();
+	serializeTimer.Start();
+	if (isCompressed)
+		cache.reserve(SAVEGAME_CHUNK_SIZE + SAVEGAME_CHUNK_SIZE / 4);
 }
 
 /***********************************************************************
@@ -582,9 +800,17 @@ void idRestoreGame::InitializeCache() {
 		Error( "idRestoreGame::InitializeCache: bad cache offset (%d)", offset);
 	file->Seek(offset, FS_SEEK_CUR);
 
-	//read compressed cache size
-	int zipSize = -1;
+	//read compressed cache size or the chunked cache marker
+	int zipSize = 0;
 	file->ReadInt(zipSize);
+	if (zipSize == SAVEGAME_CACHE_CHUNKED) {
+		ReadChunkedCache();
+		cachePointer = 0;
+		file->Seek(position, FS_SEEK_SET);
+		restoreTimer.Clear();
+		restoreTimer.Start();
+		return;
+	}
 	if (zipSize <= 0)
 		Error("idRestoreGame::InitializeCache: bad compressed cache size (%d)", zipSize);
 
@@ -613,6 +839,60 @@ void idRestoreGame::InitializeCache() {
 	cachePointer = 0;
 	//return file pointer
 	file->Seek(position, FS_SEEK_SET);
+
+	restoreTimer.Clear();
+	restoreTimer.Start();
+}
+
+void idRestoreGame::ReadChunkedCache() {
+	idTimer readTimer, decompressTimer;
+	int i, numChunks = -1, cacheSize = 0, zipSize = 0;
+
+	readTimer.Start();
+
+	//read chunk table
+	file->ReadInt(numChunks);
+	if (numChunks < 0)
+		Error("idRestoreGame::InitializeCache: bad number of cache chunks (%d)", numChunks);
+	idList<restoreGameChunk_t> chunks;
+	chunks.SetNum(numChunks);
+	for (i = 0; i < numChunks; i++) {
+		restoreGameChunk_t &chunk = chunks[i];
+		file->ReadInt(chunk.zipSize);
+		file->ReadInt(chunk.rawSize);
+		if (chunk.zipSize <= 0 || chunk.rawSize < 0)
+			Error("idRestoreGame::InitializeCache: bad size of cache chunk %d (%d, %d)", i, chunk.zipSize, chunk.rawSize);
+		zipSize += chunk.zipSize;
+		cacheSize += chunk.rawSize;
+	}
+
+	//read compressed data
+	CRawVector zipped;
+	zipped.resize(zipSize);
+	if (zipSize > 0 && file->Read(&zipped[0], zipSize) != zipSize)
+		Error("idRestoreGame::InitializeCache: cache image is truncated");
+	readTimer.Stop();
+
+	//decompress all chunks in parallel
+	decompressTimer.Start();
+	cache.resize(cacheSize);
+	int zipOffset = 0, rawOffset = 0;
+	for (i = 0; i < numChunks; i++) {
+		chunks[i].zipped = &zipped[zipOffset];
+		chunks[i].raw = &cache[rawOffset];
+		chunks[i].error = Z_OK;
+		zipOffset += chunks[i].zipSize;
+		rawOffset += chunks[i].rawSize;
+	}
+	jobPool.ParallelFor(RestoreGame_DecompressChunk, chunks.Ptr(), numChunks);
+	for (i = 0; i < numChunks; i++) {
+		if (chunks[i].error != Z_OK)
+			Error("idRestoreGame::InitializeCache: uncompress of chunk %d failed with code %d", i, chunks[i].error);
+	}
+	decompressTimer.Stop();
+
+	gameLocal.Printf( "Savegame: read %d KB in %.0f msec, decompressed %d chunks to %d KB in %.0f msec\n",
+		zipSize >> 10, readTimer.Milliseconds(), numChunks, cacheSize >> 10, decompressTimer.Milliseconds() );
 }
 
 void idRestoreGame::CreateObjects( void ) {
@@ -662,6 +942,11 @@ void idRestoreGame::RestoreObjects( void ) {
 		}
 	}
 
+	if ( isCompressed ) {
+		restoreTimer.Stop();
+		gameLocal.Printf( "Savegame: restored %d objects in %.0f msec\n", objects.Num() - 1, restoreTimer.Milliseconds() );
+	}
+
 #ifdef ID_DEBUG_MEMORY
 	idStr gameState = file->GetName();
 	gameState.StripFileExtension();
@@ -1151,6 +1436,8 @@ void idSaveGame::Write##name_type (const cpp_type value)					\
 		cache.resize(sz + sizeof(cpp_type));								\
 		cpp_type *value_ptr = (cpp_type*)&cache[sz];						\
 		*value_ptr = Little##conv_type (value);								\
+		if (cache.size() >= SAVEGAME_CHUNK_SIZE)							\
+			FlushCacheChunk();												\
 	}																		\
 	else																	\
 		file->Write##name_type(value);										\
@@ -34,6 +34,12 @@ Save game related helper classes.
 
 const int INITIAL_RELEASE_BUILD_NUMBER = 1262;
 
+// the compressed cache is split into chunks of about this size that are
+// compressed on the job pool while saving goes on
+const int SAVEGAME_CHUNK_SIZE = 256 * 1024;
+
+struct saveGameChunk_t;
+
 class idDeclSkin;
 class idDeclParticle;
 class idDeclFX;
@@ -49,9 +55,30 @@ typedef struct trace_s trace_t;
 class idTraceModel;
 class idClipModel;
 
+// The uncompressed cache of a savegame whose compression is left to another thread,
+// see idSaveGame::DetachCache.
+class idSaveGameCache {
+public:
+							idSaveGameCache( idFile *savefile, double serializeMsec );
+							~idSaveGameCache();
+
+							// compresses the chunks and appends the cache image to the file, safe on any thread
+							// fills in the timings or the error message and returns false on error
+	bool					Finish( char *report, int reportSize );
+
+private:
+	friend class idSaveGame;
+
+	idFile *				file;
+	idList<saveGameChunk_t *> chunks;
+	double					serializeMsec;
+};
+
 class idSaveGame {
 public:
-							idSaveGame( idFile *savefile );
+							// with deferCompression the chunks are not compressed on the job pool,
+							// they must be taken with DetachCache instead of calling FinalizeCache
+							idSaveGame( idFile *savefile, bool deferCompression = false );
 							~idSaveGame();
 
 	void					Close( void );
@@ -114,15 +141,22 @@ public:
 	// Dump the contents of cache buffer to file
 	void					FinalizeCache();
 
+	// Hands the cache over uncompressed, returns NULL if the savegame is not compressed
+	idSaveGameCache *		DetachCache( void );
+
 private:
 	idFile *				file;
 
 	idList<const idClass *>	objects;
 
 	bool					isCompressed;
+	bool					deferCompression;
 	CRawVector				cache;
+	idList<saveGameChunk_t *> chunks;			// filled cache chunks, compressed in the background
+	idTimer					serializeTimer;
 
 	void					CallSave_r( const idTypeInfo *cls, const idClass *obj );
+	void					FlushCacheChunk( void );
 };
 
 class idRestoreGame {
@@ -205,8 +239,10 @@ private:
 	bool					isCompressed;
 	CRawVector				cache;
 	int						cachePointer;
+	idTimer					restoreTimer;
 
 	void					CallRestore_r( const idTypeInfo *cls, idClass *obj );
+	void					ReadChunkedCache( void );
 };
 
 #endif /* !__SAVEGAME_H__*/
@@ -75,6 +75,111 @@ void Cmd_PrintAIRelations_f( const idCmdArgs &args )
 	return;
 }
 
+/*
+==================
+Cmd_AIPerceptionTest_f
+
+Stress test for the AI perception pass. Optionally spawns a grid of AI in front of
+the player, then times the serial player visibility test of all AI in the map
+against the batched perception pass and checks that both agree.
+==================
+*/
+void Cmd_AIPerceptionTest_f( const idCmdArgs &args ) 
+{
+	const int numIterations = 20;
+	const float spacing = 64.0f;
+
+	idPlayer* player = gameLocal.GetLocalPlayer();
+	if ( ( player == NULL ) || !gameLocal.CheatsOk( false ) )
+	{
+		return;
+	}
+
+	int spawnCount = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 0;
+	const char* className = ( args.Argc() > 2 ) ? args.Argv( 2 ) : "atdm:ai_builder_guard";
+
+	if ( spawnCount > 0 )
+	{
+		// spawn the AI on a square grid in front of the player
+		int rowSize = static_cast<int>( idMath::Ceil( idMath::Sqrt( static_cast<float>( spawnCount ) ) ) );
+		float yaw = player->viewAngles.yaw;
+		idMat3 axis = idAngles( 0, yaw, 0 ).ToMat3();
+		idVec3 start = player->GetPhysics()->GetOrigin() + axis[0] * 128.0f + idVec3( 0, 0, 1 );
+
+		for ( int i = 0 ; i < spawnCount ; i++ )
+		{
+			idDict dict;
+			idVec3 org = start + axis[0] * ( ( i / rowSize ) * spacing ) + axis[1] * ( ( i % rowSize - rowSize / 2 ) * spacing );
+
+			dict.Set( "classname", className );
+			dict.Set( "angle", va( "%f", yaw + 180 ) );
+			dict.Set( "origin", org.ToString() );
+			gameLocal.SpawnEntityDef( dict );
+		}
+	}
+
+	idList<idAI*> ais;
+	for ( int i = 0 ; i < MAX_GENTITIES ; i++ )
+	{
+		idEntity* ent = gameLocal.entities[i];
+		if ( ( ent != NULL ) && ent->IsType( idAI::Type ) && ( ent->health > 0 ) )
+		{
+			ais.Append( static_cast<idAI*>( ent ) );
+		}
+	}
+
+	if ( ais.Num() == 0 )
+	{
+		gameLocal.Printf( "No living AI in the map.\n" );
+		return;
+	}
+
+	idList<bool> serialResults;
+	serialResults.SetNum( ais.Num() );
+
+	idTimer serialTimer;
+	for ( int n = 0 ; n < numIterations ; n++ )
+	{
+		serialTimer.Start();
+		for ( int i = 0 ; i < ais.Num() ; i++ )
+		{
+			serialResults[i] = ais[i]->idActor::CanSee( player, false );
+		}
+		serialTimer.Stop();
+	}
+
+	idTimer batchTimer;
+	for ( int n = 0 ; n < numIterations ; n++ )
+	{
+		batchTimer.Start();
+		idAI::UpdatePlayerPerception( ais.Ptr(), ais.Num(), player );
+		batchTimer.Stop();
+	}
+
+	int numVisible = 0;
+	int numMismatches = 0;
+	for ( int i = 0 ; i < ais.Num() ; i++ )
+	{
+		if ( ais[i]->m_perceptionCanSeePlayer != serialResults[i] )
+		{
+			gameLocal.Printf( "mismatch on '%s': serial %d, batched %d\n", ais[i]->name.c_str(), serialResults[i], ais[i]->m_perceptionCanSeePlayer );
+			numMismatches++;
+		}
+		if ( serialResults[i] )
+		{
+			numVisible++;
+		}
+
+		// don't let the think of the next frame use the test snapshot
+		ais[i]->m_perceptionFrame = -1;
+	}
+
+	gameLocal.Printf( "%d AI, %d see the player, %d worker threads\n", ais.Num(), numVisible, jobPool.GetNumThreads() );
+	gameLocal.Printf( "serial:  %6.3f ms per pass\n", serialTimer.Milliseconds() / numIterations );
+	gameLocal.Printf( "batched: %6.3f ms per pass\n", batchTimer.Milliseconds() / numIterations );
+	gameLocal.Printf( "%d mismatches\n", numMismatches );
+}
+
 /**
  * greebo: This is a helper command, used by the restart.gui
  */
@@ -613,6 +718,81 @@ void Cmd_Script_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+===================
+Cmd_ScriptBenchmark_f
+
+Compiles a loop of float math, branches, vector math and function calls and
+times running it with and without fused statements.
+===================
+*/
+void Cmd_ScriptBenchmark_f( const idCmdArgs &args ) {
+	idStr			text;
+	idStr			funcname;
+	static int		funccount = 0;
+	int				iterations;
+	int				pass;
+	idThread *		thread;
+	const function_t *func;
+	idTimer			timer;
+	bool			fuse;
+
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	// stay below the runaway loop limit of the interpreter
+	iterations = 50000;
+	if ( args.Argc() > 1 ) {
+		iterations = idMath::ClampInt( 1, 100000, atoi( args.Argv( 1 ) ) );
+	}
+
+	sprintf( funcname, "scriptBenchmark_%d", funccount++ );
+	sprintf( text,
+		"float %s_half( float x ) { return x * 0.5; }\n"
+		"void %s() {\n"
+		"	float i, sum;\n"
+		"	vector v;\n"
+		"	sum = 0;\n"
+		"	v = '0 0 0';\n"
+		"	for( i = 0; i < %d; i++ ) {\n"
+		"		sum = sum + i * 2;\n"
+		"		if ( sum >= 1000 ) {\n"
+		"			sum = sum - 1000;\n"
+		"		}\n"
+		"		v = v + '1 2 3' * 0.5;\n"
+		"		sum = sum + %s_half( i );\n"
+		"	}\n"
+		"}\n", funcname.c_str(), funcname.c_str(), iterations, funcname.c_str() );
+
+	if ( !gameLocal.program.CompileText( "scriptBenchmark", text, true ) ) {
+		return;
+	}
+	func = gameLocal.program.FindFunction( funcname );
+	if ( !func ) {
+		return;
+	}
+
+	fuse = g_scriptFuseStatements.GetBool();
+	for ( pass = 0; pass < 2; pass++ ) {
+		g_scriptFuseStatements.SetBool( pass == 0 );
+
+		thread = new idThread( func );
+		thread->ManualDelete();
+		thread->ManualControl();
+
+		timer.Clear();
+		timer.Start();
+		thread->Execute();
+		timer.Stop();
+
+		delete thread;
+
+		gameLocal.Printf( "%s: %d iterations in %6.2f ms, %.3f usec per iteration\n", ( pass == 0 ) ? "fused  " : "unfused", iterations, timer.Milliseconds(), timer.Milliseconds() * 1000.0 / iterations );
+	}
+	g_scriptFuseStatements.SetBool( fuse );
+}
+
 /*
 ==================
 KillEntities
@@ -3694,11 +3874,13 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "prevFrame",				idTestModel::TestModelPrevFrame_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"shows previous animation frame on test model" );
 	cmdSystem->AddCommand( "testBlend",				idTestModel::TestBlend_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"tests animation blending" );
 	cmdSystem->AddCommand( "reloadScript",			Cmd_ReloadScript_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads scripts" );
+	cmdSystem->AddCommand( "testEventQueue",		idEvent::TestEventQueue_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"schedules and cancels 100k events to time the event queue" );
 
 	cmdSystem->AddCommand( "tdm_updateCookedMathData",	Cmd_updateCookedMathData_f,		CMD_FL_RENDERER,	"Updates lookup textures" );
 	cmdSystem->AddCommand( "tdm_lod_bias_changed",		Cmd_LODBiasChanged_f,			CMD_FL_RENDERER,	"Updates entity visibility according to tdm_lod_bias." );
 
 	cmdSystem->AddCommand( "script",				Cmd_Script_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"executes a line of script" );
+	cmdSystem->AddCommand( "scriptBenchmark",		Cmd_ScriptBenchmark_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"times the script interpreter with and without fused statements, optionally takes the number of loop iterations" );
 	cmdSystem->AddCommand( "listCollisionModels",	Cmd_ListCollisionModels_f,	CMD_FL_GAME,				"lists collision models" );
 	cmdSystem->AddCommand( "collisionModelInfo",	Cmd_CollisionModelInfo_f,	CMD_FL_GAME,				"shows collision model info" );
 	cmdSystem->AddCommand( "reexportmodels",		Cmd_ReexportModels_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"reexports models", ArgCompletion_DefFile );
@@ -3720,6 +3902,7 @@ void idGameLocal::InitConsoleCommands( void ) {
 
 	cmdSystem->AddCommand( "tdm_spr_testIO",		Cmd_TestSndIO_f,			CMD_FL_GAME,				"test soundprop file IO (needs a .spr file)" );
 	cmdSystem->AddCommand( "tdm_ai_rel_print",		Cmd_PrintAIRelations_f,		CMD_FL_GAME,				"print the relationship matrix determining relations between AI teams." );
+	cmdSystem->AddCommand( "tdm_ai_perception_test",	Cmd_AIPerceptionTest_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"times the serial player visibility checks of all AI against the batched perception pass. Usage: tdm_ai_perception_test [number of AI to spawn, e.g. 128] [classname]" );
 
 	cmdSystem->AddCommand( "tdm_attach_offset",		Cmd_AttachmentOffset_f,		CMD_FL_GAME,				"Set the vector offset (x y z) for an attachment on an AI you are looking at.  Usage: tdm_attach_offset <attachment index> <x> <y> <z>" );
 	cmdSystem->AddCommand( "tdm_attach_rot",		Cmd_AttachmentRot_f,		CMD_FL_GAME,				"Set the rotation (pitch yaw roll) for an attachment on an AI you are looking at.  Usage: tdm_attach_rot <atachment index> <pitch> <yaw> <roll>  (NOTE: Rotation is applied before translation, angles are relative to the joint orientation)" );
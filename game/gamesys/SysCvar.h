@@ -74,6 +74,7 @@ extern idCVar cv_ai_opt_novisualstim;
 extern idCVar cv_ai_opt_nolipsync;
 extern idCVar cv_ai_opt_nopresent;
 extern idCVar cv_ai_opt_noobstacleavoidance;
+extern idCVar cv_ai_opt_parallel_perception;
 extern idCVar cv_ai_hiding_spot_max_light_quotient;
 extern idCVar cv_ai_max_hiding_spot_tests_per_frame;
 extern idCVar cv_ai_debug_anims;
@@ -117,6 +118,7 @@ extern idCVar cv_tdm_difficulty;
 
 extern idCVar cv_sr_disable;
 extern idCVar cv_sr_show;
+extern idCVar cv_sr_timing;
 
 extern idCVar cv_sndprop_disable;
 extern idCVar cv_spr_debug;
@@ -306,6 +308,8 @@ extern idCVar cv_lg_model;
 extern idCVar cv_lg_adjust;
 extern idCVar cv_lg_split;
 extern idCVar cv_lg_path;
+extern idCVar cv_lg_async;
+extern idCVar cv_lg_timing;
 extern idCVar cv_lg_crouch_modifier;
 extern idCVar cv_lg_image_width;
 extern idCVar cv_lg_screen_width;
@@ -408,6 +412,8 @@ extern idCVar	g_doubleVision;
 extern idCVar	g_muzzleFlash;
 
 extern idCVar	g_disasm;
+extern idCVar	g_scriptCache;
+extern idCVar	g_scriptFuseStatements;
 extern idCVar	g_debugBounds;
 extern idCVar	g_debugAnim;
 extern idCVar	g_debugMove;
@@ -435,6 +441,7 @@ extern idCVar	g_showActiveEntities;
 extern idCVar	g_showEnemies;
 
 extern idCVar	g_frametime;
+extern idCVar	g_frameAllocPoison;
 extern idCVar	g_timeentities;
 
 extern idCVar	g_timeModifier;
@@ -595,6 +602,7 @@ extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
 extern idCVar	aas_showPushIntoArea;
+extern idCVar	aas_precomputeRoutingCache;
 
 extern idCVar	net_clientPredictGUI;
 
@@ -27,6 +27,11 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #define	MAX_SECTOR_DEPTH				12
 #define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
 
+// clip models with CONTENTS_RESPONSE are linked into a second, coarser tree so
+// the stim/response system only walks responders instead of every clip model
+#define	MAX_RESPONSE_SECTOR_DEPTH		8
+#define MAX_RESPONSE_SECTORS			((1<<(MAX_RESPONSE_SECTOR_DEPTH+1))-1)
+
 typedef struct clipSector_s {
 	int						axis;		// -1 = leaf node
 	float					dist;
@@ -285,6 +290,7 @@ void idClipModel::Init( void ) {
 	renderModelHandle = -1;
 	traceModelIndex = -1;
 	clipLinks = NULL;
+	responseLinks = NULL;
 	touchCount = -1;
 }
 
@@ -351,6 +357,7 @@ idClipModel::idClipModel( const idClipModel *model ) {
 	}
 	renderModelHandle = model->renderModelHandle;
 	clipLinks = NULL;
+	responseLinks = NULL;
 	touchCount = -1;
 }
 
@@ -428,6 +435,7 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 	// the render model will be set when the clip model is linked, so do not restore it
 	renderModelHandle = -1;
 	clipLinks = NULL;
+	responseLinks = NULL;
 	touchCount = -1;
 
 	if ( linked ) {
@@ -484,14 +492,14 @@ void idClipModel::GetMassProperties( const float density, float &mass, idVec3 &c
 
 /*
 ===============
-idClipModel::Unlink
+UnlinkSectors
 ===============
 */
-void idClipModel::Unlink( void ) {
+static void UnlinkSectors( clipLink_t *&links ) {
 	clipLink_t *link;
 
-	for ( link = clipLinks; link; link = clipLinks ) {
-		clipLinks = link->nextLink;
+	for ( link = links; link; link = links ) {
+		links = link->nextLink;
 		if ( link->prevInSector ) {
 			link->prevInSector->nextInSector = link->nextInSector;
 		} else {
@@ -504,12 +512,43 @@ void idClipModel::Unlink( void ) {
 	}
 }
 
+/*
+===============
+idClipModel::Unlink
+===============
+*/
+void idClipModel::Unlink( void ) {
+	UnlinkSectors( clipLinks );
+	UnlinkSectors( responseLinks );
+}
+
+/*
+===============
+idClipModel::SetContents
+
+Keeps the clip model in the response sectors in sync with CONTENTS_RESPONSE
+===============
+*/
+void idClipModel::SetContents( int newContents ) {
+	bool responseChanged = ( ( contents ^ newContents ) & CONTENTS_RESPONSE ) != 0;
+
+	contents = newContents;
+
+	if ( responseChanged && clipLinks ) {
+		if ( contents & CONTENTS_RESPONSE ) {
+			Link_r( gameLocal.clip.responseSectors, responseLinks );
+		} else {
+			UnlinkSectors( responseLinks );
+		}
+	}
+}
+
 /*
 ===============
 idClipModel::Link_r
 ===============
 */
-void idClipModel::Link_r( struct clipSector_s *node ) {
+void idClipModel::Link_r( struct clipSector_s *node, struct clipLink_s *&links ) {
 	clipLink_t *link;
 
 	while( node->axis != -1 ) {
@@ -518,7 +557,7 @@ void idClipModel::Link_r( struct clipSector_s *node ) {
 		} else if ( absBounds[1][node->axis] < node->dist ) {
 			node = node->children[1];
 		} else {
-			Link_r( node->children[0] );
+			Link_r( node->children[0], links );
 			node = node->children[1];
 		}
 	}
@@ -532,8 +571,8 @@ void idClipModel::Link_r( struct clipSector_s *node ) {
 		node->clipLinks->prevInSector = link;
 	}
 	node->clipLinks = link;
-	link->nextLink = clipLinks;
-	clipLinks = link;
+	link->nextLink = links;
+	links = link;
 }
 
 /*
@@ -571,7 +610,11 @@ void idClipModel::Link( idClip &clp ) {
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
-	Link_r( clp.clipSectors );
+	Link_r( clp.clipSectors, clipLinks );
+
+	if ( contents & CONTENTS_RESPONSE ) {
+		Link_r( clp.responseSectors, responseLinks );
+	}
 }
 
 /*
@@ -621,6 +664,8 @@ idClip::idClip
 idClip::idClip( void ) {
 	numClipSectors = 0;
 	clipSectors = NULL;
+	numResponseSectors = 0;
+	responseSectors = NULL;
 	worldBounds.Zero();
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
@@ -632,16 +677,16 @@ idClip::CreateClipSectors_r
 Builds a uniformly subdivided tree for the given world size
 ===============
 */
-clipSector_t *idClip::CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector ) {
+clipSector_t *idClip::CreateClipSectors_r( clipSector_t *sectors, int &numSectors, const int depth, const int maxDepth, const idBounds &bounds, idVec3 &maxSector ) {
 	int				i;
 	clipSector_t	*anode;
 	idVec3			size;
 	idBounds		front, back;
 
-	anode = &clipSectors[idClip::numClipSectors];
-	idClip::numClipSectors++;
+	anode = &sectors[numSectors];
+	numSectors++;
 
-	if ( depth == MAX_SECTOR_DEPTH ) {
+	if ( depth == maxDepth ) {
 		anode->axis = -1;
 		anode->children[0] = anode->children[1] = NULL;
 
@@ -669,8 +714,8 @@ clipSector_t *idClip::CreateClipSectors_r( const int depth, const idBounds &boun
 	
 	front[0][anode->axis] = back[1][anode->axis] = anode->dist;
 	
-	anode->children[0] = CreateClipSectors_r( depth+1, front, maxSector );
-	anode->children[1] = CreateClipSectors_r( depth+1, back, maxSector );
+	anode->children[0] = CreateClipSectors_r( sectors, numSectors, depth+1, maxDepth, front, maxSector );
+	anode->children[1] = CreateClipSectors_r( sectors, numSectors, depth+1, maxDepth, back, maxSector );
 
 	return anode;
 }
@@ -682,18 +727,22 @@ idClip::Init
 */
 void idClip::Init( void ) {
 	cmHandle_t h;
-	idVec3 size, maxSector = vec3_origin;
+	idVec3 size, maxSector = vec3_origin, maxResponseSector = vec3_origin;
 
 	// clear clip sectors
 	clipSectors = new clipSector_t[MAX_SECTORS];
 	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
 	numClipSectors = 0;
+	responseSectors = new clipSector_t[MAX_RESPONSE_SECTORS];
+	memset( responseSectors, 0, MAX_RESPONSE_SECTORS * sizeof( clipSector_t ) );
+	numResponseSectors = 0;
 	touchCount = -1;
 	// get world map bounds
 	h = collisionModelManager->LoadModel( "worldMap", false );
 	collisionModelManager->GetModelBounds( h, worldBounds );
 	// create world sectors
-	CreateClipSectors_r( 0, worldBounds, maxSector );
+	CreateClipSectors_r( clipSectors, numClipSectors, 0, MAX_SECTOR_DEPTH, worldBounds, maxSector );
+	CreateClipSectors_r( responseSectors, numResponseSectors, 0, MAX_RESPONSE_SECTOR_DEPTH, worldBounds, maxResponseSector );
 
 	size = worldBounds[1] - worldBounds[0];
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
@@ -714,6 +763,8 @@ idClip::Shutdown
 void idClip::Shutdown( void ) {
 	delete[] clipSectors;
 	clipSectors = NULL;
+	delete[] responseSectors;
+	responseSectors = NULL;
 
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
@@ -801,6 +852,15 @@ idClip::ClipModelsTouchingBounds
 ================
 */
 int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
+	return ClipModelsTouchingBounds( clipSectors, bounds, contentMask, clipModelList, maxCount );
+}
+
+/*
+================
+idClip::ClipModelsTouchingBounds
+================
+*/
+int idClip::ClipModelsTouchingBounds( const struct clipSector_s *sectors, const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
 	listParms_t parms;
 
 	if (	bounds[0][0] > bounds[1][0] ||
@@ -819,7 +879,7 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	parms.maxCount = maxCount;
 
 	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+	ClipModelsTouchingBounds_r( sectors, parms );
 
 	return parms.count;
 }
@@ -830,10 +890,32 @@ idClip::EntitiesTouchingBounds
 ================
 */
 int idClip::EntitiesTouchingBounds( const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const {
+	return EntitiesTouchingBounds( clipSectors, bounds, contentMask, entityList, maxCount );
+}
+
+/*
+================
+idClip::ResponseEntitiesTouchingBounds
+
+Only walks the response sectors, which hold nothing but clip models with
+CONTENTS_RESPONSE, so the cost depends on the number of nearby responders
+instead of the number of nearby clip models.
+================
+*/
+int idClip::ResponseEntitiesTouchingBounds( const idBounds &bounds, idEntity **entityList, int maxCount ) const {
+	return EntitiesTouchingBounds( responseSectors, bounds, CONTENTS_RESPONSE, entityList, maxCount );
+}
+
+/*
+================
+idClip::EntitiesTouchingBounds
+================
+*/
+int idClip::EntitiesTouchingBounds( const struct clipSector_s *sectors, const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const {
 	idClipModel *clipModelList[MAX_GENTITIES];
 	int i, j, count, entCount;
 
-	count = idClip::ClipModelsTouchingBounds( bounds, contentMask, clipModelList, MAX_GENTITIES );
+	count = idClip::ClipModelsTouchingBounds( sectors, bounds, contentMask, clipModelList, MAX_GENTITIES );
 	entCount = 0;
 	for ( i = 0; i < count; i++ ) {
 		// entity could already be in the list because an entity can use multiple clip models
@@ -957,11 +1039,13 @@ const idTraceModel *idClip::TraceModelForClipModel( const idClipModel *mdl ) con
 
 /*
 ============
-idClip::TestHugeTranslation
+HugeTranslation
+
+Blocks a trace model translation that is too long for the collision model manager.
 ============
 */
-ID_INLINE bool TestHugeTranslation( trace_t &results, const idClipModel *mdl, const idVec3 &start, const idVec3 &end, const idMat3 &trmAxis ) {
-	if ( mdl != NULL && ( end - start ).LengthSqr() > Square( CM_MAX_TRACE_DIST ) ) {
+ID_INLINE bool HugeTranslation( trace_t &results, const idVec3 &start, const idVec3 &end, const idMat3 &trmAxis ) {
+	if ( ( end - start ).LengthSqr() > Square( CM_MAX_TRACE_DIST ) ) {
 //		assert( 0 );
 
 		results.fraction = 0.0f;
@@ -970,7 +1054,18 @@ ID_INLINE bool TestHugeTranslation( trace_t &results, const idClipModel *mdl, co
 		memset( &results.c, 0, sizeof( results.c ) );
 		results.c.point = start;
 		results.c.entityNum = ENTITYNUM_WORLD;
+		return true;
+	}
+	return false;
+}
 
+/*
+============
+idClip::TestHugeTranslation
+============
+*/
+ID_INLINE bool TestHugeTranslation( trace_t &results, const idClipModel *mdl, const idVec3 &start, const idVec3 &end, const idMat3 &trmAxis ) {
+	if ( mdl != NULL && HugeTranslation( results, start, end, trmAxis ) ) {
 		if ( mdl->GetEntity() ) {
 			gameLocal.Printf( "huge translation for clip model %d on entity %d '%s'\n", mdl->GetId(), mdl->GetEntity()->entityNumber, mdl->GetEntity()->GetName() );
 		} else {
@@ -1049,11 +1144,6 @@ idClip::Translation
 */
 bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &end,
 						const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity ) {
-	int i, num;
-	idClipModel *touch, *clipModelList[MAX_GENTITIES];
-	idBounds traceBounds;
-	float radius;
-	trace_t trace;
 	const idTraceModel *trm;
 
 	if ( TestHugeTranslation( results, mdl, start, end, trmAxis ) ) {
@@ -1077,6 +1167,26 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 		results.endAxis = trmAxis;
 	}
 
+	TranslationClipModels( results, start, end, trm, trmAxis, contentMask, passEntity );
+
+	return ( results.fraction < 1.0f );
+}
+
+/*
+============
+idClip::TranslationClipModels
+
+Clips the translation against the clip models of all entities, results holds the world trace.
+============
+*/
+void idClip::TranslationClipModels( trace_t &results, const idVec3 &start, const idVec3 &end,
+						const idTraceModel *trm, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity ) {
+	int i, num;
+	idClipModel *touch, *clipModelList[MAX_GENTITIES];
+	idBounds traceBounds;
+	float radius;
+	trace_t trace;
+
 	if ( !trm ) {
 		traceBounds.FromPointTranslation( start, results.endpos - start );
 		radius = 0.0f;
@@ -1112,8 +1222,128 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 			}
 		}
 	}
+}
 
-	return ( results.fraction < 1.0f );
+typedef struct clipTraceWork_s {
+	const idTraceModel *	trm;				// NULL for a point trace
+	bool					done;				// result is final
+	bool					testWorld;			// the world model is traced by the jobs
+} clipTraceWork_t;
+
+typedef struct clipTraceBatch_s {
+	clipTrace_t *			traces;
+	clipTraceWork_t *		work;
+	int						numTraces;
+	int						numJobs;
+} clipTraceBatch_t;
+
+/*
+============
+idClip::TraceBatchWorldJob
+
+Traces a range of the batch against the world model. The collision model
+manager keeps the per trace state in a context of the calling thread, so
+these can run on any thread.
+============
+*/
+void idClip::TraceBatchWorldJob( void *data, int index ) {
+	clipTraceBatch_t *batch = static_cast<clipTraceBatch_t *>( data );
+	int first = batch->numTraces * index / batch->numJobs;
+	int last = batch->numTraces * ( index + 1 ) / batch->numJobs;
+
+	for ( int i = first; i < last; i++ ) {
+		if ( !batch->work[i].testWorld ) {
+			continue;
+		}
+		clipTrace_t &trace = batch->traces[i];
+		collisionModelManager->Translation( &trace.result, trace.start, trace.end, batch->work[i].trm, mat3_identity,
+											trace.contentMask, 0, vec3_origin, mat3_default );
+	}
+}
+
+/*
+============
+idClip::TraceBatch
+
+The world traces of large batches run on the job pool, the entity clip
+models are tested afterwards on the calling thread in the original order.
+Must only be called from the game thread.
+============
+*/
+void idClip::TraceBatch( clipTrace_t *traces, const int numTraces ) {
+	int i, numBounds;
+	idList<clipTraceWork_t> work;
+	idList<idTraceModel> boundsModels;
+	clipTraceBatch_t batch;
+
+	if ( numTraces <= 0 ) {
+		return;
+	}
+
+	numBounds = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		if ( !traces[i].bounds.IsCleared() ) {
+			numBounds++;
+		}
+	}
+	boundsModels.SetNum( numBounds );
+	work.SetNum( numTraces );
+
+	numBounds = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		clipTrace_t &trace = traces[i];
+		clipTraceWork_t &w = work[i];
+
+		if ( trace.bounds.IsCleared() ) {
+			w.trm = NULL;
+		} else {
+			boundsModels[numBounds] = idTraceModel( trace.bounds );
+			w.trm = &boundsModels[numBounds++];
+		}
+
+		w.done = false;
+		if ( w.trm && HugeTranslation( trace.result, trace.start, trace.end, mat3_identity ) ) {
+			gameLocal.Printf( "huge translation for batched bounds trace\n" );
+			w.done = true;
+		}
+		w.testWorld = !w.done && ( !trace.passEntity || trace.passEntity->entityNumber != ENTITYNUM_WORLD );
+	}
+
+	batch.traces = traces;
+	batch.work = work.Ptr();
+	batch.numTraces = numTraces;
+	batch.numJobs = Min( numTraces / TRACE_BATCH_MIN_TRACES_PER_JOB, ( jobPool.GetNumThreads() + 1 ) * 2 );
+	if ( batch.numJobs > 1 && jobPool.GetNumThreads() > 0 ) {
+		jobPool.ParallelFor( TraceBatchWorldJob, &batch, batch.numJobs );
+	} else {
+		// not worth waking up the workers
+		batch.numJobs = 1;
+		TraceBatchWorldJob( &batch, 0 );
+	}
+
+	for ( i = 0; i < numTraces; i++ ) {
+		clipTrace_t &trace = traces[i];
+		clipTraceWork_t &w = work[i];
+
+		if ( w.done ) {
+			continue;
+		}
+
+		if ( w.testWorld ) {
+			idClip::numTranslations++;
+			trace.result.c.entityNum = trace.result.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+			if ( trace.result.fraction == 0.0f ) {
+				continue;		// blocked immediately by the world
+			}
+		} else {
+			memset( &trace.result, 0, sizeof( trace.result ) );
+			trace.result.fraction = 1.0f;
+			trace.result.endpos = trace.end;
+			trace.result.endAxis = mat3_identity;
+		}
+
+		TranslationClipModels( trace.result, trace.start, trace.end, w.trm, mat3_identity, trace.contentMask, trace.passEntity );
+	}
 }
 
 /*
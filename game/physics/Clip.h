@@ -125,10 +125,11 @@ private:
 	int						renderModelHandle;		// render model def handle
 
 	struct clipLink_s *		clipLinks;				// links into sectors
+	struct clipLink_s *		responseLinks;			// links into response sectors, only with CONTENTS_RESPONSE
 	int						touchCount;
 
 	void					Init( void );			// initialize
-	void					Link_r( struct clipSector_s *node );
+	void					Link_r( struct clipSector_s *node, struct clipLink_s *&links );
 
 	static int				AllocTraceModel( const idTraceModel &trm );
 	static void				FreeTraceModel( const int traceModelIndex );
@@ -176,10 +177,6 @@ ID_INLINE const idMaterial * idClipModel::GetMaterial( void ) const {
 	return material;
 }
 
-ID_INLINE void idClipModel::SetContents( int newContents ) {
-	contents = newContents;
-}
-
 ID_INLINE int idClipModel::GetContents( void ) const {
 	return contents;
 }
@@ -258,6 +255,20 @@ ID_INLINE const idTraceModel *idClipModel::GetTraceModel( void ) const {
 //
 //===============================================================
 
+// world traces per job of idClip::TraceBatch, smaller batches are traced inline
+// and callers with fewer traces are better off stopping at the first useful one
+#define TRACE_BATCH_MIN_TRACES_PER_JOB	8
+
+// a single trace request for idClip::TraceBatch
+typedef struct clipTrace_s {
+	idVec3					start;
+	idVec3					end;
+	idBounds				bounds;				// cleared bounds for a point trace
+	int						contentMask;
+	const idEntity *		passEntity;
+	trace_t					result;				// filled in by TraceBatch
+} clipTrace_t;
+
 class idClip {
 
 	friend class idClipModel;
@@ -285,6 +296,9 @@ public:
 								int contentMask, const idEntity *passEntity );
 	bool					TraceBounds( trace_t &results, const idVec3 &start, const idVec3 &end, const idBounds &bounds,
 								int contentMask, const idEntity *passEntity );
+							// runs a set of point/bounds traces, the traces against the world model of large batches are
+							// spread over the job pool, the results are the same as calling TracePoint/TraceBounds for each trace
+	void					TraceBatch( clipTrace_t *traces, const int numTraces );
 
 	// clip versus a specific model
 	void					TranslationModel( trace_t &results, const idVec3 &start, const idVec3 &end,
@@ -310,6 +324,8 @@ public:
 	// get entities/clip models within or touching the given bounds
 	int						EntitiesTouchingBounds( const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const;
 	int						ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const;
+							// same as EntitiesTouchingBounds with CONTENTS_RESPONSE but only walks the responders
+	int						ResponseEntitiesTouchingBounds( const idBounds &bounds, idEntity **entityList, int maxCount ) const;
 
 	const idBounds &		GetWorldBounds( void ) const;
 	idClipModel *			DefaultClipModel( void );
@@ -322,6 +338,8 @@ public:
 private:
 	int						numClipSectors;
 	struct clipSector_s *	clipSectors;
+	int						numResponseSectors;
+	struct clipSector_s *	responseSectors;		// coarser sectors with only the CONTENTS_RESPONSE clip models
 	idBounds				worldBounds;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
@@ -335,11 +353,16 @@ private:
 	int						numContacts;
 
 private:
-	struct clipSector_s *	CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector );
+	struct clipSector_s *	CreateClipSectors_r( struct clipSector_s *sectors, int &numSectors, const int depth, const int maxDepth, const idBounds &bounds, idVec3 &maxSector );
 	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
+	int						ClipModelsTouchingBounds( const struct clipSector_s *sectors, const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const;
+	int						EntitiesTouchingBounds( const struct clipSector_s *sectors, const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const;
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
+	void					TranslationClipModels( trace_t &results, const idVec3 &start, const idVec3 &end,
+								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity );
+	static void				TraceBatchWorldJob( void *data, int index );
 };
 
 
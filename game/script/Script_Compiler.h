@@ -185,7 +185,20 @@ enum {
 	OP_BREAK,			// placeholder op.  not used in final code
 	OP_CONTINUE,		// placeholder op.  not used in final code
 
-	NUM_OPCODES
+	NUM_OPCODES,
+
+	// statement pairs fused into one op by idProgram::DecodeStatements, never emitted by the compiler
+	OP_FUSED_LT_IFNOT = NUM_OPCODES,
+	OP_FUSED_LE_IFNOT,
+	OP_FUSED_GT_IFNOT,
+	OP_FUSED_GE_IFNOT,
+	OP_FUSED_EQ_F_IFNOT,
+	OP_FUSED_NE_F_IFNOT,
+	OP_FUSED_ADD_F_STORE_F,
+	OP_FUSED_SUB_F_STORE_F,
+	OP_FUSED_MUL_F_STORE_F,
+
+	NUM_DECODED_OPCODES
 };
 
 class idCompiler {
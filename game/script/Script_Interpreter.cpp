@@ -702,6 +702,7 @@ void idInterpreter::CallEvent( const function_t *func, int argsize ) {
 	int					data[ D_EVENT_MAXARGS ];
 	const idEventDef	*evdef;
 	const char			*format;
+	eventCallback_t		callback;
 
 	if ( !func ) {
 		Error( "NULL function" );
@@ -713,8 +714,9 @@ void idInterpreter::CallEvent( const function_t *func, int argsize ) {
 	start = localstackUsed - argsize;
 	var.intPtr = ( int * )&localstack[ start ];
 	eventEntity = GetEntity( *var.entityNumberPtr );
+	callback = eventEntity ? eventEntity->GetEventCallback( evdef ) : NULL;
 
-	if ( !eventEntity || !eventEntity->RespondsTo( *evdef ) ) {
+	if ( !callback ) {
 		if ( eventEntity && developer.GetBool() ) {
 			// give a warning in developer mode
 			Warning( "Function '%s' not supported on entity '%s'", evdef->GetName(), eventEntity->name.c_str() );
@@ -803,8 +805,9 @@ void idInterpreter::CallEvent( const function_t *func, int argsize ) {
 		pos += func->parmSize[ j++ ];
 	}
 
+	// call the handler straight away, we already know it responds
 	popParms = argsize;
-	eventEntity->ProcessEventArgPtr( evdef, data );
+	eventEntity->CallEventCallback( evdef, callback, data );
 
 	if ( !multiFrameEvent ) {
 		if ( popParms ) {
@@ -873,6 +876,7 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 	int					data[ D_EVENT_MAXARGS ];
 	const idEventDef	*evdef;
 	const char			*format;
+	eventCallback_t		callback;
 
 	if ( !func ) {
 		Error( "NULL function" );
@@ -934,7 +938,10 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 	}
 
 	popParms = argsize;
-	thread->ProcessEventArgPtr( evdef, data );
+	callback = thread->GetEventCallback( evdef );
+	if ( callback ) {
+		thread->CallEventCallback( evdef, callback, data );
+	}
 	if ( popParms ) {
 		PopParms( popParms );
 	}
@@ -944,14 +951,36 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 /*
 ====================
 idInterpreter::Execute
+
+Runs the decoded statements of gameLocal.program.  With gcc every op jumps
+straight to the next one through a table of label addresses, other compilers
+go through the switch.  Ops that call out of the interpreter continue at
+checkState, since they can end the thread or cause the program to be decoded
+again.
 ====================
 */
+#ifdef __GNUC__
+#define ID_SCRIPT_THREADED_DISPATCH
+#endif
+
+#ifdef ID_SCRIPT_THREADED_DISPATCH
+#define SCRIPT_OP( op )			op_##op:
+#define SCRIPT_BAD_OP			op_bad:
+#define SCRIPT_NEXT()			do { instructionPointer++; if ( !--runaway ) { Error( "runaway loop error" ); } ins = &code[ instructionPointer ]; goto *dispatchTable[ ins->op ]; } while( 0 )
+#else
+#define SCRIPT_OP( op )			case op:
+#define SCRIPT_BAD_OP			default:
+#define SCRIPT_NEXT()			continue
+#endif
+#define SCRIPT_NEXT_CHECKED()	goto checkState
+
 bool idInterpreter::Execute( void ) {
 	varEval_t	var_a;
 	varEval_t	var_b;
 	varEval_t	var_c;
 	varEval_t	var;
-	statement_t	*st;
+	const scriptInstruction_t *code;
+	const scriptInstruction_t *ins;
 	int 		runaway;
 	idThread	*newThread;
 	float		floatVal;
@@ -977,21 +1006,169 @@ bool idInterpreter::Execute( void ) {
 	}
 #endif
 
+#ifdef ID_SCRIPT_THREADED_DISPATCH
+	static void *dispatchTable[ NUM_DECODED_OPCODES ];
+	static bool dispatchTableInitialized = false;
+
+	if ( !dispatchTableInitialized ) {
+		for ( int i = 0; i < NUM_DECODED_OPCODES; i++ ) {
+			dispatchTable[ i ] = &&op_bad;
+		}
+		dispatchTable[ OP_RETURN ] = &&op_OP_RETURN;
+		dispatchTable[ OP_THREAD ] = &&op_OP_THREAD;
+		dispatchTable[ OP_OBJTHREAD ] = &&op_OP_OBJTHREAD;
+		dispatchTable[ OP_CALL ] = &&op_OP_CALL;
+		dispatchTable[ OP_EVENTCALL ] = &&op_OP_EVENTCALL;
+		dispatchTable[ OP_OBJECTCALL ] = &&op_OP_OBJECTCALL;
+		dispatchTable[ OP_SYSCALL ] = &&op_OP_SYSCALL;
+		dispatchTable[ OP_IFNOT ] = &&op_OP_IFNOT;
+		dispatchTable[ OP_IF ] = &&op_OP_IF;
+		dispatchTable[ OP_GOTO ] = &&op_OP_GOTO;
+		dispatchTable[ OP_ADD_F ] = &&op_OP_ADD_F;
+		dispatchTable[ OP_ADD_V ] = &&op_OP_ADD_V;
+		dispatchTable[ OP_ADD_S ] = &&op_OP_ADD_S;
+		dispatchTable[ OP_ADD_FS ] = &&op_OP_ADD_FS;
+		dispatchTable[ OP_ADD_SF ] = &&op_OP_ADD_SF;
+		dispatchTable[ OP_ADD_VS ] = &&op_OP_ADD_VS;
+		dispatchTable[ OP_ADD_SV ] = &&op_OP_ADD_SV;
+		dispatchTable[ OP_SUB_F ] = &&op_OP_SUB_F;
+		dispatchTable[ OP_SUB_V ] = &&op_OP_SUB_V;
+		dispatchTable[ OP_MUL_F ] = &&op_OP_MUL_F;
+		dispatchTable[ OP_MUL_V ] = &&op_OP_MUL_V;
+		dispatchTable[ OP_MUL_FV ] = &&op_OP_MUL_FV;
+		dispatchTable[ OP_MUL_VF ] = &&op_OP_MUL_VF;
+		dispatchTable[ OP_DIV_F ] = &&op_OP_DIV_F;
+		dispatchTable[ OP_MOD_F ] = &&op_OP_MOD_F;
+		dispatchTable[ OP_BITAND ] = &&op_OP_BITAND;
+		dispatchTable[ OP_BITOR ] = &&op_OP_BITOR;
+		dispatchTable[ OP_GE ] = &&op_OP_GE;
+		dispatchTable[ OP_LE ] = &&op_OP_LE;
+		dispatchTable[ OP_GT ] = &&op_OP_GT;
+		dispatchTable[ OP_LT ] = &&op_OP_LT;
+		dispatchTable[ OP_AND ] = &&op_OP_AND;
+		dispatchTable[ OP_AND_BOOLF ] = &&op_OP_AND_BOOLF;
+		dispatchTable[ OP_AND_FBOOL ] = &&op_OP_AND_FBOOL;
+		dispatchTable[ OP_AND_BOOLBOOL ] = &&op_OP_AND_BOOLBOOL;
+		dispatchTable[ OP_OR ] = &&op_OP_OR;
+		dispatchTable[ OP_OR_BOOLF ] = &&op_OP_OR_BOOLF;
+		dispatchTable[ OP_OR_FBOOL ] = &&op_OP_OR_FBOOL;
+		dispatchTable[ OP_OR_BOOLBOOL ] = &&op_OP_OR_BOOLBOOL;
+		dispatchTable[ OP_NOT_BOOL ] = &&op_OP_NOT_BOOL;
+		dispatchTable[ OP_NOT_F ] = &&op_OP_NOT_F;
+		dispatchTable[ OP_NOT_V ] = &&op_OP_NOT_V;
+		dispatchTable[ OP_NOT_S ] = &&op_OP_NOT_S;
+		dispatchTable[ OP_NOT_ENT ] = &&op_OP_NOT_ENT;
+		dispatchTable[ OP_NEG_F ] = &&op_OP_NEG_F;
+		dispatchTable[ OP_NEG_V ] = &&op_OP_NEG_V;
+		dispatchTable[ OP_INT_F ] = &&op_OP_INT_F;
+		dispatchTable[ OP_EQ_F ] = &&op_OP_EQ_F;
+		dispatchTable[ OP_EQ_V ] = &&op_OP_EQ_V;
+		dispatchTable[ OP_EQ_S ] = &&op_OP_EQ_S;
+		dispatchTable[ OP_EQ_E ] = &&op_OP_EQ_E;
+		dispatchTable[ OP_EQ_EO ] = &&op_OP_EQ_EO;
+		dispatchTable[ OP_EQ_OE ] = &&op_OP_EQ_OE;
+		dispatchTable[ OP_EQ_OO ] = &&op_OP_EQ_OO;
+		dispatchTable[ OP_NE_F ] = &&op_OP_NE_F;
+		dispatchTable[ OP_NE_V ] = &&op_OP_NE_V;
+		dispatchTable[ OP_NE_S ] = &&op_OP_NE_S;
+		dispatchTable[ OP_NE_E ] = &&op_OP_NE_E;
+		dispatchTable[ OP_NE_EO ] = &&op_OP_NE_EO;
+		dispatchTable[ OP_NE_OE ] = &&op_OP_NE_OE;
+		dispatchTable[ OP_NE_OO ] = &&op_OP_NE_OO;
+		dispatchTable[ OP_UADD_F ] = &&op_OP_UADD_F;
+		dispatchTable[ OP_UADD_V ] = &&op_OP_UADD_V;
+		dispatchTable[ OP_USUB_F ] = &&op_OP_USUB_F;
+		dispatchTable[ OP_USUB_V ] = &&op_OP_USUB_V;
+		dispatchTable[ OP_UMUL_F ] = &&op_OP_UMUL_F;
+		dispatchTable[ OP_UMUL_V ] = &&op_OP_UMUL_V;
+		dispatchTable[ OP_UDIV_F ] = &&op_OP_UDIV_F;
+		dispatchTable[ OP_UDIV_V ] = &&op_OP_UDIV_V;
+		dispatchTable[ OP_UMOD_F ] = &&op_OP_UMOD_F;
+		dispatchTable[ OP_UOR_F ] = &&op_OP_UOR_F;
+		dispatchTable[ OP_UAND_F ] = &&op_OP_UAND_F;
+		dispatchTable[ OP_UINC_F ] = &&op_OP_UINC_F;
+		dispatchTable[ OP_UINCP_F ] = &&op_OP_UINCP_F;
+		dispatchTable[ OP_UDEC_F ] = &&op_OP_UDEC_F;
+		dispatchTable[ OP_UDECP_F ] = &&op_OP_UDECP_F;
+		dispatchTable[ OP_COMP_F ] = &&op_OP_COMP_F;
+		dispatchTable[ OP_STORE_F ] = &&op_OP_STORE_F;
+		dispatchTable[ OP_STORE_ENT ] = &&op_OP_STORE_ENT;
+		dispatchTable[ OP_STORE_BOOL ] = &&op_OP_STORE_BOOL;
+		dispatchTable[ OP_STORE_OBJENT ] = &&op_OP_STORE_OBJENT;
+		dispatchTable[ OP_STORE_OBJ ] = &&op_OP_STORE_OBJ;
+		dispatchTable[ OP_STORE_ENTOBJ ] = &&op_OP_STORE_ENTOBJ;
+		dispatchTable[ OP_STORE_S ] = &&op_OP_STORE_S;
+		dispatchTable[ OP_STORE_V ] = &&op_OP_STORE_V;
+		dispatchTable[ OP_STORE_FTOS ] = &&op_OP_STORE_FTOS;
+		dispatchTable[ OP_STORE_BTOS ] = &&op_OP_STORE_BTOS;
+		dispatchTable[ OP_STORE_VTOS ] = &&op_OP_STORE_VTOS;
+		dispatchTable[ OP_STORE_FTOBOOL ] = &&op_OP_STORE_FTOBOOL;
+		dispatchTable[ OP_STORE_BOOLTOF ] = &&op_OP_STORE_BOOLTOF;
+		dispatchTable[ OP_STOREP_F ] = &&op_OP_STOREP_F;
+		dispatchTable[ OP_STOREP_ENT ] = &&op_OP_STOREP_ENT;
+		dispatchTable[ OP_STOREP_FLD ] = &&op_OP_STOREP_FLD;
+		dispatchTable[ OP_STOREP_BOOL ] = &&op_OP_STOREP_BOOL;
+		dispatchTable[ OP_STOREP_S ] = &&op_OP_STOREP_S;
+		dispatchTable[ OP_STOREP_V ] = &&op_OP_STOREP_V;
+		dispatchTable[ OP_STOREP_FTOS ] = &&op_OP_STOREP_FTOS;
+		dispatchTable[ OP_STOREP_BTOS ] = &&op_OP_STOREP_BTOS;
+		dispatchTable[ OP_STOREP_VTOS ] = &&op_OP_STOREP_VTOS;
+		dispatchTable[ OP_STOREP_FTOBOOL ] = &&op_OP_STOREP_FTOBOOL;
+		dispatchTable[ OP_STOREP_BOOLTOF ] = &&op_OP_STOREP_BOOLTOF;
+		dispatchTable[ OP_STOREP_OBJ ] = &&op_OP_STOREP_OBJ;
+		dispatchTable[ OP_STOREP_OBJENT ] = &&op_OP_STOREP_OBJENT;
+		dispatchTable[ OP_ADDRESS ] = &&op_OP_ADDRESS;
+		dispatchTable[ OP_INDIRECT_F ] = &&op_OP_INDIRECT_F;
+		dispatchTable[ OP_INDIRECT_ENT ] = &&op_OP_INDIRECT_ENT;
+		dispatchTable[ OP_INDIRECT_BOOL ] = &&op_OP_INDIRECT_BOOL;
+		dispatchTable[ OP_INDIRECT_S ] = &&op_OP_INDIRECT_S;
+		dispatchTable[ OP_INDIRECT_V ] = &&op_OP_INDIRECT_V;
+		dispatchTable[ OP_INDIRECT_OBJ ] = &&op_OP_INDIRECT_OBJ;
+		dispatchTable[ OP_PUSH_F ] = &&op_OP_PUSH_F;
+		dispatchTable[ OP_PUSH_FTOS ] = &&op_OP_PUSH_FTOS;
+		dispatchTable[ OP_PUSH_BTOF ] = &&op_OP_PUSH_BTOF;
+		dispatchTable[ OP_PUSH_FTOB ] = &&op_OP_PUSH_FTOB;
+		dispatchTable[ OP_PUSH_VTOS ] = &&op_OP_PUSH_VTOS;
+		dispatchTable[ OP_PUSH_BTOS ] = &&op_OP_PUSH_BTOS;
+		dispatchTable[ OP_PUSH_ENT ] = &&op_OP_PUSH_ENT;
+		dispatchTable[ OP_PUSH_S ] = &&op_OP_PUSH_S;
+		dispatchTable[ OP_PUSH_V ] = &&op_OP_PUSH_V;
+		dispatchTable[ OP_PUSH_OBJ ] = &&op_OP_PUSH_OBJ;
+		dispatchTable[ OP_PUSH_OBJENT ] = &&op_OP_PUSH_OBJENT;
+		dispatchTable[ OP_BREAK ] = &&op_OP_BREAK;
+		dispatchTable[ OP_CONTINUE ] = &&op_OP_CONTINUE;
+		dispatchTable[ OP_FUSED_LT_IFNOT ] = &&op_OP_FUSED_LT_IFNOT;
+		dispatchTable[ OP_FUSED_LE_IFNOT ] = &&op_OP_FUSED_LE_IFNOT;
+		dispatchTable[ OP_FUSED_GT_IFNOT ] = &&op_OP_FUSED_GT_IFNOT;
+		dispatchTable[ OP_FUSED_GE_IFNOT ] = &&op_OP_FUSED_GE_IFNOT;
+		dispatchTable[ OP_FUSED_EQ_F_IFNOT ] = &&op_OP_FUSED_EQ_F_IFNOT;
+		dispatchTable[ OP_FUSED_NE_F_IFNOT ] = &&op_OP_FUSED_NE_F_IFNOT;
+		dispatchTable[ OP_FUSED_ADD_F_STORE_F ] = &&op_OP_FUSED_ADD_F_STORE_F;
+		dispatchTable[ OP_FUSED_SUB_F_STORE_F ] = &&op_OP_FUSED_SUB_F_STORE_F;
+		dispatchTable[ OP_FUSED_MUL_F_STORE_F ] = &&op_OP_FUSED_MUL_F_STORE_F;
+		dispatchTableInitialized = true;
+	}
+#endif
+
 	runaway = 5000000;
 
 	doneProcessing = false;
-	while( !doneProcessing && !threadDying ) {
+	code = gameLocal.program.GetDecodedStatements();
+	while( 1 ) {
+		// next statement
 		instructionPointer++;
-
 		if ( !--runaway ) {
 			Error( "runaway loop error" );
 		}
+		ins = &code[ instructionPointer ];
 
-		// next statement
-		st = &gameLocal.program.GetStatement( instructionPointer );
-
-		switch( st->op ) {
-		case OP_RETURN:
+#ifdef ID_SCRIPT_THREADED_DISPATCH
+		goto *dispatchTable[ ins->op ];
+		{
+#else
+		switch( ins->op ) {
+#endif
+		SCRIPT_OP( OP_RETURN )
 
 #ifdef PROFILE_SCRIPT
 			if (debug && functionTimers.size() > 0)
@@ -1006,7 +1183,7 @@ bool idInterpreter::Execute( void ) {
 			}
 #endif
 			// Actually leave the function
-			LeaveFunction( st->a );
+			LeaveFunction( gameLocal.program.GetStatement( instructionPointer ).a );
 
 #ifdef PROFILE_SCRIPT
 			// greebo: Maybe we have a timer of a previous function?
@@ -1017,23 +1194,23 @@ bool idInterpreter::Execute( void ) {
 				functionTimers.top().Start();
 			}
 #endif
-			break;
+			SCRIPT_NEXT_CHECKED();
 
-		case OP_THREAD:
-			newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+		SCRIPT_OP( OP_THREAD )
+			newThread = new idThread( this, ins->a.functionPtr, ins->b.argSize );
 			newThread->Start();
 
 			// return the thread number to the script
 			gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-			PopParms( st->b->value.argSize );
-			break;
+			PopParms( ins->b.argSize );
+			SCRIPT_NEXT_CHECKED();
 
-		case OP_OBJTHREAD:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_OBJTHREAD )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-				assert( st->c->value.argSize == func->parmTotal );
+				func = obj->GetTypeDef()->GetFunction( ins->b.virtualFunction );
+				assert( ins->c.argSize == func->parmTotal );
 				newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
 				newThread->Start();
 
@@ -1043,10 +1220,10 @@ bool idInterpreter::Execute( void ) {
 				// return a null thread to the script
 				gameLocal.program.ReturnFloat( 0.0f );
 			}
-			PopParms( st->c->value.argSize );
-			break;
+			PopParms( ins->c.argSize );
+			SCRIPT_NEXT_CHECKED();
 
-		case OP_CALL:
+		SCRIPT_OP( OP_CALL )
 
 #ifdef PROFILE_SCRIPT
 			if (debug && functionTimers.size() > 0)
@@ -1056,7 +1233,7 @@ bool idInterpreter::Execute( void ) {
 				//DM_LOG(LC_AI, LT_INFO)LOGSTRING("Stopping timer of %s at %lf msec.", currentFunction->Name(), functionTimers.top().Milliseconds());
 			}
 #endif
-			EnterFunction( st->a->value.functionPtr, false );
+			EnterFunction( ins->a.functionPtr, false );
 #ifdef PROFILE_SCRIPT
 			if (debug) {
 				// Add and start a new timer
@@ -1067,20 +1244,20 @@ bool idInterpreter::Execute( void ) {
 				//DM_LOG(LC_AI, LT_INFO)LOGSTRING("Starting new timer on entering function %s.", currentFunction->Name());
 			}
 #endif
-			break;
+			SCRIPT_NEXT_CHECKED();
 
-		case OP_EVENTCALL:
+		SCRIPT_OP( OP_EVENTCALL )
 #ifdef PROFILE_SCRIPT
 			//DM_LOG(LC_AI, LT_INFO)LOGSTRING("Calling script event.");
 #endif
-			CallEvent( st->a->value.functionPtr, st->b->value.argSize );
-			break;
+			CallEvent( ins->a.functionPtr, ins->b.argSize );
+			SCRIPT_NEXT_CHECKED();
 
-		case OP_OBJECTCALL:	
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_OBJECTCALL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
+				func = obj->GetTypeDef()->GetFunction( ins->b.virtualFunction );
 
 #ifdef PROFILE_SCRIPT
 				if (debug && functionTimers.size() > 0)
@@ -1113,121 +1290,121 @@ bool idInterpreter::Execute( void ) {
 				// return a 'safe' value
 				gameLocal.program.ReturnVector( vec3_zero );
 				gameLocal.program.ReturnString( "" );
-				PopParms( st->c->value.argSize );
+				PopParms( ins->c.argSize );
 			}
-			break;
+			SCRIPT_NEXT_CHECKED();
 
-		case OP_SYSCALL:
-			CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
-			break;
+		SCRIPT_OP( OP_SYSCALL )
+			CallSysEvent( ins->a.functionPtr, ins->b.argSize );
+			SCRIPT_NEXT_CHECKED();
 
-		case OP_IFNOT:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_IFNOT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			if ( *var_a.intPtr == 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+				NextInstruction( instructionPointer + ins->b.jumpOffset );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_IF:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_IF )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			if ( *var_a.intPtr != 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+				NextInstruction( instructionPointer + ins->b.jumpOffset );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_GOTO:
-			NextInstruction( instructionPointer + st->a->value.jumpOffset );
-			break;
+		SCRIPT_OP( OP_GOTO )
+			NextInstruction( instructionPointer + ins->a.jumpOffset );
+			SCRIPT_NEXT();
 
-		case OP_ADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_ADD_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_ADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_ADD_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-			break;
-
-		case OP_ADD_S:
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_FS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, FloatToString( *var_a.floatPtr ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_SF:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, FloatToString( *var_b.floatPtr ) );
-			break;
-
-		case OP_ADD_VS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, var_a.vectorPtr->ToString() );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_SV:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, var_b.vectorPtr->ToString() );
-			break;
-
-		case OP_SUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_ADD_S )
+			SetString( ins->c, ins->cOnStack, GetString( ins->a, ins->aOnStack ) );
+			AppendString( ins->c, ins->cOnStack, GetString( ins->b, ins->bOnStack ) );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_ADD_FS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			SetString( ins->c, ins->cOnStack, FloatToString( *var_a.floatPtr ) );
+			AppendString( ins->c, ins->cOnStack, GetString( ins->b, ins->bOnStack ) );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_ADD_SF )
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			SetString( ins->c, ins->cOnStack, GetString( ins->a, ins->aOnStack ) );
+			AppendString( ins->c, ins->cOnStack, FloatToString( *var_b.floatPtr ) );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_ADD_VS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			SetString( ins->c, ins->cOnStack, var_a.vectorPtr->ToString() );
+			AppendString( ins->c, ins->cOnStack, GetString( ins->b, ins->bOnStack ) );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_ADD_SV )
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			SetString( ins->c, ins->cOnStack, GetString( ins->a, ins->aOnStack ) );
+			AppendString( ins->c, ins->cOnStack, var_b.vectorPtr->ToString() );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_SUB_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_SUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_SUB_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_MUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_MUL_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_MUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_MUL_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_MUL_FV:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_MUL_FV )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_MUL_VF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_MUL_VF )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_DIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_DIV_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 
 			if ( *var_b.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1235,12 +1412,12 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_MOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable ( st->c );
+		SCRIPT_OP( OP_MOD_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 
 			if ( *var_b.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1248,252 +1425,252 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_BITAND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_BITAND )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_BITOR:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_BITOR )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_GE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_GE )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_LE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_LE )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_GT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_GT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_LT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_LT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_AND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_AND )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_AND_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_AND_BOOLF )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_AND_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_AND_FBOOL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_AND_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_AND_BOOLBOOL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_OR:	
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_OR )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_OR_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_OR_BOOLF )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_OR_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_OR_FBOOL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT();
 			
-		case OP_OR_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_OR_BOOLBOOL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT();
 			
-		case OP_NOT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NOT_BOOL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.intPtr == 0 );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_NOT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NOT_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_NOT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NOT_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_NOT_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
-			break;
+		SCRIPT_OP( OP_NOT_S )
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( strlen( GetString( ins->a, ins->aOnStack ) ) == 0 );
+			SCRIPT_NEXT();
 
-		case OP_NOT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NOT_ENT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_NEG_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NEG_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = -*var_a.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_NEG_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NEG_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.vectorPtr = -*var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_INT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INT_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_EQ_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_EQ_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_EQ_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_EQ_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
-			break;
-
-		case OP_EQ_S:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
-			break;
-
-		case OP_EQ_E:
-		case OP_EQ_EO:
-		case OP_EQ_OE:
-		case OP_EQ_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_EQ_S )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( idStr::Cmp( GetString( ins->a, ins->aOnStack ), GetString( ins->b, ins->bOnStack ) ) == 0 );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_EQ_E )
+		SCRIPT_OP( OP_EQ_EO )
+		SCRIPT_OP( OP_EQ_OE )
+		SCRIPT_OP( OP_EQ_OO )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_NE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NE_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_NE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NE_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
-			break;
-
-		case OP_NE_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
-			break;
-
-		case OP_NE_E:
-		case OP_NE_EO:
-		case OP_NE_OE:
-		case OP_NE_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_NE_S )
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( idStr::Cmp( GetString( ins->a, ins->aOnStack ), GetString( ins->b, ins->bOnStack ) ) != 0 );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_NE_E )
+		SCRIPT_OP( OP_NE_EO )
+		SCRIPT_OP( OP_NE_OE )
+		SCRIPT_OP( OP_NE_OO )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UADD_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.floatPtr += *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UADD_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.vectorPtr += *var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_USUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_USUB_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.floatPtr -= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_USUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_USUB_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.vectorPtr -= *var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UMUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UMUL_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.floatPtr *= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UMUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UMUL_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.vectorPtr *= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UDIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UDIV_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1501,11 +1678,11 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UDIV_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UDIV_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1513,11 +1690,11 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UMOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UMOD_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1525,241 +1702,241 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UOR_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UOR_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UAND_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UAND_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UINC_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_UINC_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			( *var_a.floatPtr )++;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UINCP_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_UINCP_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ ins->b.ptrOffset ];
 				( *var.floatPtr )++;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UDEC_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_UDEC_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			( *var_a.floatPtr )--;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_UDECP_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_UDECP_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ ins->b.ptrOffset ];
 				( *var.floatPtr )--;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_COMP_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_COMP_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STORE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.floatPtr = *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STORE_ENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_ENT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STORE_BOOL:	
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_BOOL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.intPtr = *var_a.intPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STORE_OBJENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_OBJENT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( !obj ) {
 				*var_b.entityNumberPtr = 0;
-			} else if ( !obj->GetTypeDef()->Inherits( st->b->TypeDef() ) ) {
-				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
+			} else if ( !obj->GetTypeDef()->Inherits( gameLocal.program.GetStatement( instructionPointer ).b->TypeDef() ) ) {
+				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), gameLocal.program.GetStatement( instructionPointer ).b->TypeDef()->Name() );
 				*var_b.entityNumberPtr = 0;
 			} else {
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STORE_OBJ:
-		case OP_STORE_ENTOBJ:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_OBJ )
+		SCRIPT_OP( OP_STORE_ENTOBJ )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STORE_S:
-			SetString( st->b, GetString( st->a ) );
-			break;
+		SCRIPT_OP( OP_STORE_S )
+			SetString( ins->b, ins->bOnStack, GetString( ins->a, ins->aOnStack ) );
+			SCRIPT_NEXT();
 
-		case OP_STORE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.vectorPtr = *var_a.vectorPtr;
-			break;
-
-		case OP_STORE_FTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, FloatToString( *var_a.floatPtr ) );
-			break;
-
-		case OP_STORE_BTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, *var_a.intPtr ? "true" : "false" );
-			break;
-
-		case OP_STORE_VTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, var_a.vectorPtr->ToString() );
-			break;
-
-		case OP_STORE_FTOBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_STORE_FTOS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			SetString( ins->b, ins->bOnStack, FloatToString( *var_a.floatPtr ) );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_STORE_BTOS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			SetString( ins->b, ins->bOnStack, *var_a.intPtr ? "true" : "false" );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_STORE_VTOS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			SetString( ins->b, ins->bOnStack, var_a.vectorPtr->ToString() );
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_STORE_FTOBOOL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( *var_a.floatPtr != 0.0f ) {
 				*var_b.intPtr = 1;
 			} else {
 				*var_b.intPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STORE_BOOLTOF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_BOOLTOF )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_F:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_F )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				*var_b.evalPtr->floatPtr = *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_ENT:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_ENT )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_FLD:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_FLD )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				*var_b.evalPtr->intPtr = *var_a.intPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_BOOL:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_BOOL )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				*var_b.evalPtr->intPtr = *var_a.intPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_S:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_S )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
+				idStr::Copynz( var_b.evalPtr->stringPtr, GetString( ins->a, ins->aOnStack ), MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_V:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_V )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->vectorPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 		
-		case OP_STOREP_FTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_FTOS )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_BTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_BTOS )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				if ( *var_a.floatPtr != 0.0f ) {
 					idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
 				} else {
 					idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
 				}
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_VTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_VTOS )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_FTOBOOL:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_FTOBOOL )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				if ( *var_a.floatPtr != 0.0f ) {
 					*var_b.evalPtr->intPtr = 1;
 				} else {
 					*var_b.evalPtr->intPtr = 0;
 				}
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_BOOLTOF:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_BOOLTOF )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_OBJ:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_OBJ )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_STOREP_OBJENT:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_OBJENT )
+			var_b = GetOperand( ins->b, ins->bOnStack );
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetOperand( ins->a, ins->aOnStack );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if ( !obj ) {
 					*var_b.evalPtr->entityNumberPtr = 0;
@@ -1767,164 +1944,270 @@ bool idInterpreter::Execute( void ) {
 				// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
 				// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
 				// comes from an entity
-				} else if ( !obj->GetTypeDef()->Inherits( st->c->TypeDef() ) ) {
-					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
+				} else if ( !obj->GetTypeDef()->Inherits( gameLocal.program.GetStatement( instructionPointer ).c->TypeDef() ) ) {
+					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), gameLocal.program.GetStatement( instructionPointer ).c->TypeDef()->Name() );
 					*var_b.evalPtr->entityNumberPtr = 0;
 				} else {
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_ADDRESS:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_ADDRESS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var_c.evalPtr->bytePtr = &obj->data[ ins->b.ptrOffset ];
 			} else {
 				var_c.evalPtr->bytePtr = NULL;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_INDIRECT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ ins->b.ptrOffset ];
 				*var_c.floatPtr = *var.floatPtr;
 			} else {
 				*var_c.floatPtr = 0.0f;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_INDIRECT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_ENT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ ins->b.ptrOffset ];
 				*var_c.entityNumberPtr = *var.entityNumberPtr;
 			} else {
 				*var_c.entityNumberPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_INDIRECT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_BOOL )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ ins->b.ptrOffset ];
 				*var_c.intPtr = *var.intPtr;
 			} else {
 				*var_c.intPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_INDIRECT_S:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_INDIRECT_S )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				SetString( st->c, var.stringPtr );
+				var.bytePtr = &obj->data[ ins->b.ptrOffset ];
+				SetString( ins->c, ins->cOnStack, var.stringPtr );
 			} else {
-				SetString( st->c, "" );
+				SetString( ins->c, ins->cOnStack, "" );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_INDIRECT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ ins->b.ptrOffset ];
 				*var_c.vectorPtr = *var.vectorPtr;
 			} else {
 				var_c.vectorPtr->Zero();
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_INDIRECT_OBJ:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_OBJ )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( !obj ) {
 				*var_c.entityNumberPtr = 0;
 			} else {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ ins->b.ptrOffset ];
 				*var_c.entityNumberPtr = *var.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			Push( *var_a.intPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_FTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_FTOS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			PushString( FloatToString( *var_a.floatPtr ) );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_BTOF:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_BTOF )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			floatVal = *var_a.intPtr;
 			Push( *reinterpret_cast<int *>( &floatVal ) );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_FTOB:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_FTOB )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			if ( *var_a.floatPtr != 0.0f ) {
 				Push( 1 );
 			} else {
 				Push( 0 );
 			}
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_VTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_VTOS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			PushString( var_a.vectorPtr->ToString() );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_BTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_BTOS )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			PushString( *var_a.intPtr ? "true" : "false" );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_ENT:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_ENT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_S:
-			PushString( GetString( st->a ) );
-			break;
+		SCRIPT_OP( OP_PUSH_S )
+			PushString( GetString( ins->a, ins->aOnStack ) );
+			SCRIPT_NEXT();
 
-		case OP_PUSH_V:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_V )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->x ) );
 			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->y ) );
 			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->z ) );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_OBJ:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_OBJ )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_PUSH_OBJENT:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_OBJENT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT();
 
-		case OP_BREAK:
-		case OP_CONTINUE:
-		default:
-			Error( "Bad opcode %i", st->op );
+
+		// fused statement pairs, see idProgram::DecodeStatements
+
+		SCRIPT_OP( OP_FUSED_LT_IFNOT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + ins[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_FUSED_LE_IFNOT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + ins[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_FUSED_GT_IFNOT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + ins[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_FUSED_GE_IFNOT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + ins[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_FUSED_EQ_F_IFNOT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + ins[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_FUSED_NE_F_IFNOT )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + ins[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_FUSED_ADD_F_STORE_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
+			instructionPointer++;
+			var_b = GetOperand( ins[ 1 ].b, ins[ 1 ].bOnStack );
+			*var_b.floatPtr = *var_c.floatPtr;
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_FUSED_SUB_F_STORE_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
+			instructionPointer++;
+			var_b = GetOperand( ins[ 1 ].b, ins[ 1 ].bOnStack );
+			*var_b.floatPtr = *var_c.floatPtr;
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_FUSED_MUL_F_STORE_F )
+			var_a = GetOperand( ins->a, ins->aOnStack );
+			var_b = GetOperand( ins->b, ins->bOnStack );
+			var_c = GetOperand( ins->c, ins->cOnStack );
+			*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
+			instructionPointer++;
+			var_b = GetOperand( ins[ 1 ].b, ins[ 1 ].bOnStack );
+			*var_b.floatPtr = *var_c.floatPtr;
+			SCRIPT_NEXT();
+
+		SCRIPT_OP( OP_BREAK )
+		SCRIPT_OP( OP_CONTINUE )
+		SCRIPT_BAD_OP
+			Error( "Bad opcode %i", ins->op );
+			SCRIPT_NEXT();
+		}
+
+checkState:
+		// calls and events can end the thread or change the program
+		if ( doneProcessing || threadDying ) {
 			break;
 		}
+		code = gameLocal.program.GetDecodedStatements();
 	}
 
 #ifdef PROFILE_SCRIPT
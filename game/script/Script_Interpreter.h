@@ -66,6 +66,10 @@ private:
 	void				SetString( idVarDef *def, const char *from );
 	const char			*GetString( idVarDef *def );
 	varEval_t			GetVariable( idVarDef *def );
+	void				AppendString( const varEval_t &operand, bool onStack, const char *from );
+	void				SetString( const varEval_t &operand, bool onStack, const char *from );
+	const char			*GetString( const varEval_t &operand, bool onStack );
+	varEval_t			GetOperand( const varEval_t &operand, bool onStack );
 	idEntity			*GetEntity( int entnum ) const;
 	idScriptObject		*GetScriptObject( int entnum ) const;
 	void				NextInstruction( int position );
@@ -239,6 +243,62 @@ ID_INLINE varEval_t idInterpreter::GetVariable( idVarDef *def ) {
 	}
 }
 
+/*
+====================
+idInterpreter::AppendString
+
+Same as above for operands of decoded instructions
+====================
+*/
+ID_INLINE void idInterpreter::AppendString( const varEval_t &operand, bool onStack, const char *from ) {
+	if ( onStack ) {
+		idStr::Append( ( char * )&localstack[ localstackBase + operand.stackOffset ], MAX_STRING_LEN, from );
+	} else {
+		idStr::Append( operand.stringPtr, MAX_STRING_LEN, from );
+	}
+}
+
+/*
+====================
+idInterpreter::SetString
+====================
+*/
+ID_INLINE void idInterpreter::SetString( const varEval_t &operand, bool onStack, const char *from ) {
+	if ( onStack ) {
+		idStr::Copynz( ( char * )&localstack[ localstackBase + operand.stackOffset ], from, MAX_STRING_LEN );
+	} else {
+		idStr::Copynz( operand.stringPtr, from, MAX_STRING_LEN );
+	}
+}
+
+/*
+====================
+idInterpreter::GetString
+====================
+*/
+ID_INLINE const char *idInterpreter::GetString( const varEval_t &operand, bool onStack ) {
+	if ( onStack ) {
+		return ( char * )&localstack[ localstackBase + operand.stackOffset ];
+	} else {
+		return operand.stringPtr;
+	}
+}
+
+/*
+====================
+idInterpreter::GetOperand
+====================
+*/
+ID_INLINE varEval_t idInterpreter::GetOperand( const varEval_t &operand, bool onStack ) {
+	if ( onStack ) {
+		varEval_t val;
+		val.intPtr = ( int * )&localstack[ localstackBase + operand.stackOffset ];
+		return val;
+	} else {
+		return operand;
+	}
+}
+
 /*
 ================
 idInterpreter::GetEntity
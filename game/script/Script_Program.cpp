@@ -1572,9 +1572,84 @@ statement_t *idProgram::AllocStatement( void ) {
 	if ( statements.Num() >= statements.Max() ) {
 		throw idCompileError( va( "Exceeded maximum allowed number of statements (%d)", statements.Max() ) );
 	}
+	decodedValid = false;
 	return statements.Alloc();
 }
 
+/*
+================
+DecodeOperand
+================
+*/
+static void DecodeOperand( const idVarDef *def, varEval_t &value, bool &onStack ) {
+	if ( def == NULL ) {
+		value.intPtr = NULL;
+		onStack = false;
+	} else {
+		value = def->value;
+		onStack = ( def->initialized == idVarDef::stackVariable );
+	}
+}
+
+/*
+================
+idProgram::DecodeStatements
+
+Builds the instruction stream the interpreter executes from the compiled
+statements.  With g_scriptFuseStatements set, a comparison directly followed
+by an ifnot on its result and a float operation directly followed by a store
+of its result are decoded as one fused op on the first statement.
+================
+*/
+void idProgram::DecodeStatements( void ) {
+	int i;
+
+	decodedValid = true;
+	decodedFused = g_scriptFuseStatements.GetBool();
+
+	decodedStatements.SetGranularity( 1024 );
+	decodedStatements.SetNum( statements.Num(), false );
+	for ( i = 0; i < statements.Num(); i++ ) {
+		const statement_t &st = statements[ i ];
+		scriptInstruction_t &ins = decodedStatements[ i ];
+
+		ins.op = st.op;
+		DecodeOperand( st.a, ins.a, ins.aOnStack );
+		DecodeOperand( st.b, ins.b, ins.bOnStack );
+		DecodeOperand( st.c, ins.c, ins.cOnStack );
+	}
+
+	if ( !decodedFused ) {
+		return;
+	}
+
+	for ( i = 0; i < statements.Num() - 1; i++ ) {
+		const statement_t &st = statements[ i ];
+		const statement_t &next = statements[ i + 1 ];
+
+		if ( next.a != st.c ) {
+			continue;
+		}
+
+		if ( next.op == OP_IFNOT ) {
+			switch( st.op ) {
+			case OP_LT:		decodedStatements[ i ].op = OP_FUSED_LT_IFNOT; break;
+			case OP_LE:		decodedStatements[ i ].op = OP_FUSED_LE_IFNOT; break;
+			case OP_GT:		decodedStatements[ i ].op = OP_FUSED_GT_IFNOT; break;
+			case OP_GE:		decodedStatements[ i ].op = OP_FUSED_GE_IFNOT; break;
+			case OP_EQ_F:	decodedStatements[ i ].op = OP_FUSED_EQ_F_IFNOT; break;
+			case OP_NE_F:	decodedStatements[ i ].op = OP_FUSED_NE_F_IFNOT; break;
+			}
+		} else if ( next.op == OP_STORE_F ) {
+			switch( st.op ) {
+			case OP_ADD_F:	decodedStatements[ i ].op = OP_FUSED_ADD_F_STORE_F; break;
+			case OP_SUB_F:	decodedStatements[ i ].op = OP_FUSED_SUB_F_STORE_F; break;
+			case OP_MUL_F:	decodedStatements[ i ].op = OP_FUSED_MUL_F_STORE_F; break;
+			}
+		}
+	}
+}
+
 /*
 ==============
 idProgram::BeginCompilation
@@ -1884,6 +1959,9 @@ void idProgram::FreeData( void ) {
 	fileList.Clear();
 	statements.Clear();
 	functions.Clear();
+	decodedStatements.Clear();
+	decodedValid = false;
+	decodedFused = false;
 
 	top_functions	= 0;
 	top_statements	= 0;
@@ -1954,6 +2032,671 @@ void idProgram::RegisterScriptEvents()
 	}
 }
 
+/***********************************************************************
+
+  Script cache
+
+  Compiling the default script takes a good part of the map load time, so
+  the compiled program (types, defs, functions, statements and the global
+  variables) is written to a binary cache next to it. Startup restores the
+  program from the cache as long as it was built from the same sources,
+  event definitions and opcode table. References between the objects are
+  stored as indexes, the builtin types and defs get negative indexes.
+
+  Bump SCRIPT_CACHE_VERSION whenever the compiler changes what it emits.
+
+***********************************************************************/
+
+#define SCRIPT_CACHE_FILEID			"SCB"
+#define SCRIPT_CACHE_VERSION		1
+#define SCRIPT_CACHE_EXT			"scb"
+
+static idTypeDef * const scriptCacheBuiltinTypes[] = {
+	&type_void, &type_scriptevent, &type_namespace, &type_string, &type_float, &type_vector, &type_entity, &type_field,
+	&type_function, &type_virtualfunction, &type_pointer, &type_object, &type_jumpoffset, &type_argsize, &type_boolean
+};
+
+static idVarDef * const scriptCacheBuiltinDefs[] = {
+	&def_void, &def_scriptevent, &def_namespace, &def_string, &def_float, &def_vector, &def_entity, &def_field,
+	&def_function, &def_virtualfunction, &def_pointer, &def_object, &def_jumpoffset, &def_argsize, &def_boolean
+};
+
+const int SCRIPT_CACHE_NUM_BUILTINS = sizeof( scriptCacheBuiltinTypes ) / sizeof( scriptCacheBuiltinTypes[ 0 ] );
+
+// how the value of a def is stored
+typedef enum {
+	SCB_VALUE_INT,				// stack offset, field offset, jump offset, argument size or virtual function index
+	SCB_VALUE_VARIABLE,			// offset in the global variables
+	SCB_VALUE_FUNCTION			// function index
+} scriptCacheValue_t;
+
+/*
+================
+ScriptCache_CodeChecksum
+
+Checksum of everything in the game code the compiled program depends on.
+================
+*/
+static unsigned long ScriptCache_CodeChecksum( void ) {
+	unsigned long crc;
+	int i;
+
+	CRC32_InitChecksum( crc );
+
+	// the script events are registered from the event definitions
+	for ( i = 0; i < idEventDef::NumEventCommands(); i++ ) {
+		const idEventDef *eventDef = idEventDef::GetEventCommand( i );
+		const char *name = eventDef->GetName() ? eventDef->GetName() : "";
+		const char *format = eventDef->GetArgFormat();
+		char returnType = eventDef->GetReturnType();
+
+		CRC32_UpdateChecksum( crc, name, strlen( name ) + 1 );
+		CRC32_UpdateChecksum( crc, format, strlen( format ) + 1 );
+		CRC32_UpdateChecksum( crc, &returnType, 1 );
+	}
+
+	// statements store opcode numbers
+	for ( i = 0; idCompiler::opcodes[ i ].name; i++ ) {
+		CRC32_UpdateChecksum( crc, idCompiler::opcodes[ i ].name, strlen( idCompiler::opcodes[ i ].name ) + 1 );
+		CRC32_UpdateChecksum( crc, idCompiler::opcodes[ i ].opname, strlen( idCompiler::opcodes[ i ].opname ) + 1 );
+	}
+
+	CRC32_FinishChecksum( crc );
+	return crc;
+}
+
+/*
+================
+ScriptCache_SourceChecksum
+================
+*/
+static bool ScriptCache_SourceChecksum( const char *name, int &length, unsigned long &crc ) {
+	void *buffer;
+
+	length = fileSystem->ReadFile( name, &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+	crc = CRC32_BlockChecksum( buffer, length );
+	fileSystem->FreeFile( buffer );
+	return true;
+}
+
+/*
+================
+ScriptCache_ListSources
+
+Files defining only macros never show up in the file list of the program,
+so every script that could be included is part of the cache key.
+================
+*/
+static void ScriptCache_ListSources( const char *defaultScript, idStrList &sources ) {
+	idFileList *files = fileSystem->ListFilesTree( "script", ".script" );
+	for ( int i = 0; i < files->GetNumFiles(); i++ ) {
+		sources.AddUnique( files->GetFile( i ) );
+	}
+	fileSystem->FreeFileList( files );
+
+	sources.AddUnique( defaultScript );
+}
+
+/*
+================
+idScriptCacheWriter
+
+Turns pointers into cache indexes.
+================
+*/
+class idScriptCacheWriter {
+public:
+							idScriptCacheWriter( const idList<idTypeDef *> &types, const idList<idVarDef *> &varDefs, const function_t *functions, int numFunctions );
+
+	int						TypeIndex( const idTypeDef *type );
+	int						DefIndex( const idVarDef *def );
+	int						FunctionIndex( const function_t *func );
+
+	bool					failed;
+
+private:
+	const idList<idTypeDef *> &types;
+	const idList<idVarDef *> &varDefs;
+	const function_t *		functions;
+	int						numFunctions;
+	idHashIndex				typeHash;
+
+	int						TypeKey( const idTypeDef *type ) const { return typeHash.GenerateKey( (int)( (intptr_t)type >> 4 ), 0 ); }
+};
+
+idScriptCacheWriter::idScriptCacheWriter( const idList<idTypeDef *> &types, const idList<idVarDef *> &varDefs, const function_t *functions, int numFunctions ) :
+	types( types ), varDefs( varDefs ), typeHash( 1024, types.Num() ) {
+	this->functions = functions;
+	this->numFunctions = numFunctions;
+	failed = false;
+	for ( int i = 0; i < types.Num(); i++ ) {
+		typeHash.Add( TypeKey( types[ i ] ), i );
+	}
+}
+
+int idScriptCacheWriter::TypeIndex( const idTypeDef *type ) {
+	if ( type == NULL ) {
+		return -1;
+	}
+	for ( int i = 0; i < SCRIPT_CACHE_NUM_BUILTINS; i++ ) {
+		if ( type == scriptCacheBuiltinTypes[ i ] ) {
+			return -2 - i;
+		}
+	}
+	for ( int i = typeHash.First( TypeKey( type ) ); i != -1; i = typeHash.Next( i ) ) {
+		if ( types[ i ] == type ) {
+			return i;
+		}
+	}
+	failed = true;
+	return -1;
+}
+
+int idScriptCacheWriter::DefIndex( const idVarDef *def ) {
+	if ( def == NULL ) {
+		return -1;
+	}
+	for ( int i = 0; i < SCRIPT_CACHE_NUM_BUILTINS; i++ ) {
+		if ( def == scriptCacheBuiltinDefs[ i ] ) {
+			return -2 - i;
+		}
+	}
+	if ( def->num >= 0 && def->num < varDefs.Num() && varDefs[ def->num ] == def ) {
+		return def->num;
+	}
+	failed = true;
+	return -1;
+}
+
+int idScriptCacheWriter::FunctionIndex( const function_t *func ) {
+	if ( func == NULL ) {
+		return -1;
+	}
+	if ( func >= functions && func < functions + numFunctions ) {
+		return func - functions;
+	}
+	failed = true;
+	return -1;
+}
+
+/*
+================
+idScriptCacheReader
+
+Turns cache indexes back into pointers.
+================
+*/
+class idScriptCacheReader {
+public:
+							idScriptCacheReader( idList<idTypeDef *> &types, idList<idVarDef *> &varDefs, function_t *functions, int numFunctions );
+
+	idTypeDef *				Type( int index );
+	idVarDef *				Def( int index );
+	function_t *			Function( int index );
+
+	bool					failed;
+
+private:
+	idList<idTypeDef *> &	types;
+	idList<idVarDef *> &	varDefs;
+	function_t *			functions;
+	int						numFunctions;
+};
+
+idScriptCacheReader::idScriptCacheReader( idList<idTypeDef *> &types, idList<idVarDef *> &varDefs, function_t *functions, int numFunctions ) :
+	types( types ), varDefs( varDefs ) {
+	this->functions = functions;
+	this->numFunctions = numFunctions;
+	failed = false;
+}
+
+idTypeDef *idScriptCacheReader::Type( int index ) {
+	if ( index >= 0 && index < types.Num() ) {
+		return types[ index ];
+	}
+	if ( index <= -2 && index > -2 - SCRIPT_CACHE_NUM_BUILTINS ) {
+		return scriptCacheBuiltinTypes[ -2 - index ];
+	}
+	failed |= ( index != -1 );
+	return NULL;
+}
+
+idVarDef *idScriptCacheReader::Def( int index ) {
+	if ( index >= 0 && index < varDefs.Num() ) {
+		return varDefs[ index ];
+	}
+	if ( index <= -2 && index > -2 - SCRIPT_CACHE_NUM_BUILTINS ) {
+		return scriptCacheBuiltinDefs[ -2 - index ];
+	}
+	failed |= ( index != -1 );
+	return NULL;
+}
+
+function_t *idScriptCacheReader::Function( int index ) {
+	if ( index >= 0 && index < numFunctions ) {
+		return &functions[ index ];
+	}
+	failed |= ( index != -1 );
+	return NULL;
+}
+
+/*
+================
+idProgram::WriteCache
+
+Writes the program as compiled by Startup to the script cache.
+================
+*/
+void idProgram::WriteCache( const char *defaultScript ) const {
+	int i, j;
+
+	idStr cacheName = defaultScript;
+	cacheName.SetFileExtension( SCRIPT_CACHE_EXT );
+
+	// key: every source file with its checksum
+	idStrList sources;
+	ScriptCache_ListSources( defaultScript, sources );
+	for ( i = 0; i < fileList.Num(); i++ ) {
+		sources.AddUnique( fileList[ i ] );
+	}
+
+	idFile_Memory header( cacheName );
+	header.Write( SCRIPT_CACHE_FILEID, 4 );
+	header.WriteInt( SCRIPT_CACHE_VERSION );
+	header.WriteInt( sizeof( void * ) );
+	header.WriteUnsignedInt( ScriptCache_CodeChecksum() );
+	header.WriteInt( sources.Num() );
+	for ( i = 0; i < sources.Num(); i++ ) {
+		int length;
+		unsigned long crc;
+		if ( !ScriptCache_SourceChecksum( sources[ i ], length, crc ) ) {
+			gameLocal.Warning( "Not writing %s, can't read %s", cacheName.c_str(), sources[ i ].c_str() );
+			return;
+		}
+		header.WriteString( sources[ i ] );
+		header.WriteInt( length );
+		header.WriteUnsignedInt( crc );
+	}
+
+	idScriptCacheWriter refs( types, varDefs, functions.Ptr(), functions.Num() );
+	idFile_Memory body( cacheName );
+
+	// global variables
+	body.WriteInt( numVariables );
+	body.Write( variables, numVariables );
+
+	body.WriteInt( fileList.Num() );
+	for ( i = 0; i < fileList.Num(); i++ ) {
+		body.WriteString( fileList[ i ] );
+	}
+
+	// everything that is referenced gets allocated before the references are read
+	body.WriteInt( types.Num() );
+	for ( i = 0; i < types.Num(); i++ ) {
+		body.WriteInt( types[ i ]->type );
+		body.WriteString( types[ i ]->name );
+		body.WriteInt( types[ i ]->size );
+	}
+	body.WriteInt( varDefs.Num() );
+	body.WriteInt( functions.Num() );
+
+	for ( i = 0; i < types.Num(); i++ ) {
+		const idTypeDef *type = types[ i ];
+		body.WriteInt( refs.TypeIndex( type->auxType ) );
+		body.WriteInt( type->parmTypes.Num() );
+		for ( j = 0; j < type->parmTypes.Num(); j++ ) {
+			body.WriteInt( refs.TypeIndex( type->parmTypes[ j ] ) );
+			body.WriteString( type->parmNames[ j ] );
+		}
+		body.WriteInt( type->functions.Num() );
+		for ( j = 0; j < type->functions.Num(); j++ ) {
+			body.WriteInt( refs.FunctionIndex( type->functions[ j ] ) );
+		}
+		body.WriteInt( refs.DefIndex( type->def ) );
+	}
+
+	for ( i = 0; i < varDefs.Num(); i++ ) {
+		const idVarDef *def = varDefs[ i ];
+		int kind = SCB_VALUE_INT;
+		int value = 0;
+
+		if ( def->initialized == idVarDef::stackVariable ) {
+			value = def->value.stackOffset;
+		} else if ( def->Type() == ev_jumpoffset ) {
+			value = def->value.jumpOffset;
+		} else if ( def->Type() == ev_argsize ) {
+			value = def->value.argSize;
+		} else if ( def->Type() == ev_virtualfunction ) {
+			value = def->value.virtualFunction;
+		} else if ( def->Type() == ev_function && ( def->value.functionPtr == NULL || ( def->value.functionPtr >= functions.Ptr() && def->value.functionPtr < functions.Ptr() + functions.Num() ) ) ) {
+			kind = SCB_VALUE_FUNCTION;
+			value = refs.FunctionIndex( def->value.functionPtr );
+		} else if ( def->scope != NULL && def->scope->TypeDef()->Inherits( &type_object ) ) {
+			value = def->value.ptrOffset;
+		} else {
+			kind = SCB_VALUE_VARIABLE;
+			value = def->value.bytePtr - variables;
+			if ( value < 0 || value > (int)numVariables ) {
+				refs.failed = true;
+			}
+		}
+
+		body.WriteString( def->Name() );
+		body.WriteInt( refs.TypeIndex( def->TypeDef() ) );
+		body.WriteInt( refs.DefIndex( def->scope ) );
+		body.WriteInt( def->numUsers );
+		body.WriteInt( def->initialized );
+		body.WriteInt( kind );
+		body.WriteInt( value );
+	}
+
+	for ( i = 0; i < functions.Num(); i++ ) {
+		const function_t &func = functions[ i ];
+		body.WriteString( func.Name() );
+		body.WriteString( func.eventdef ? func.eventdef->GetName() : "" );
+		body.WriteInt( refs.DefIndex( func.def ) );
+		body.WriteInt( refs.TypeIndex( func.type ) );
+		body.WriteInt( func.firstStatement );
+		body.WriteInt( func.numStatements );
+		body.WriteInt( func.parmTotal );
+		body.WriteInt( func.locals );
+		body.WriteInt( func.filenum );
+		body.WriteInt( func.parmSize.Num() );
+		for ( j = 0; j < func.parmSize.Num(); j++ ) {
+			body.WriteInt( func.parmSize[ j ] );
+		}
+	}
+
+	body.WriteInt( statements.Num() );
+	for ( i = 0; i < statements.Num(); i++ ) {
+		const statement_t &statement = statements[ i ];
+		body.WriteUnsignedShort( statement.op );
+		body.WriteInt( refs.DefIndex( statement.a ) );
+		body.WriteInt( refs.DefIndex( statement.b ) );
+		body.WriteInt( refs.DefIndex( statement.c ) );
+		body.WriteUnsignedShort( statement.linenumber );
+		body.WriteUnsignedShort( statement.file );
+	}
+
+	body.WriteInt( refs.DefIndex( returnDef ) );
+	body.WriteInt( refs.DefIndex( returnStringDef ) );
+	body.WriteInt( refs.DefIndex( sysDef ) );
+
+	if ( refs.failed ) {
+		gameLocal.Warning( "Not writing %s, the program has unexpected references", cacheName.c_str() );
+		return;
+	}
+
+	header.WriteInt( body.Length() );
+	header.WriteUnsignedInt( CRC32_BlockChecksum( body.GetDataPtr(), body.Length() ) );
+	header.Write( body.GetDataPtr(), body.Length() );
+
+	fileSystem->WriteFile( cacheName, header.GetDataPtr(), header.Length() );
+}
+
+/*
+================
+idProgram::ReadCache
+
+Returns false if the cache is out of date or damaged. The program may be
+partially restored in that case.
+================
+*/
+bool idProgram::ReadCache( idFile_Memory &file, const char *defaultScript ) {
+	int i, j, num, version, pointerSize, bodyLength;
+	unsigned int codeChecksum, bodyChecksum;
+	char id[ 4 ];
+
+	file.Read( id, sizeof( id ) );
+	file.ReadInt( version );
+	file.ReadInt( pointerSize );
+	file.ReadUnsignedInt( codeChecksum );
+	if ( memcmp( id, SCRIPT_CACHE_FILEID, sizeof( id ) ) != 0 || version != SCRIPT_CACHE_VERSION || pointerSize != sizeof( void * ) ) {
+		return false;
+	}
+	if ( codeChecksum != ScriptCache_CodeChecksum() ) {
+		gameLocal.DPrintf( "%s: event definitions changed\n", file.GetName() );
+		return false;
+	}
+
+	// the sources it was compiled from must be unchanged
+	idStrList cachedSources;
+	file.ReadInt( num );
+	if ( num <= 0 || num > 4096 ) {
+		return false;
+	}
+	for ( i = 0; i < num; i++ ) {
+		idStr &name = cachedSources.Alloc();
+		int cachedLength, length;
+		unsigned int cachedCrc;
+		unsigned long crc;
+
+		file.ReadString( name );
+		file.ReadInt( cachedLength );
+		file.ReadUnsignedInt( cachedCrc );
+		if ( !ScriptCache_SourceChecksum( name, length, crc ) || length != cachedLength || crc != cachedCrc ) {
+			gameLocal.DPrintf( "%s: %s changed\n", file.GetName(), name.c_str() );
+			return false;
+		}
+	}
+	idStrList sources;
+	ScriptCache_ListSources( defaultScript, sources );
+	for ( i = 0; i < sources.Num(); i++ ) {
+		if ( cachedSources.FindIndex( sources[ i ] ) < 0 ) {
+			gameLocal.DPrintf( "%s: %s was added\n", file.GetName(), sources[ i ].c_str() );
+			return false;
+		}
+	}
+
+	file.ReadInt( bodyLength );
+	file.ReadUnsignedInt( bodyChecksum );
+	if ( bodyLength != file.Length() - file.Tell() || CRC32_BlockChecksum( file.GetDataPtr() + file.Tell(), bodyLength ) != bodyChecksum ) {
+		gameLocal.Warning( "%s is damaged", file.GetName() );
+		return false;
+	}
+
+	FreeData();
+
+	// global variables
+	file.ReadInt( num );
+	if ( num < 0 || num > (int)sizeof( variables ) ) {
+		return false;
+	}
+	numVariables = num;
+	file.Read( variables, numVariables );
+
+	file.ReadInt( num );
+	for ( i = 0; i < num; i++ ) {
+		file.ReadString( fileList.Alloc() );
+	}
+
+	// allocate everything before resolving references
+	file.ReadInt( num );
+	for ( i = 0; i < num; i++ ) {
+		int etype, size;
+		idStr name;
+		file.ReadInt( etype );
+		file.ReadString( name );
+		file.ReadInt( size );
+		types.Append( new idTypeDef( (etype_t)etype, NULL, name, size, NULL ) );
+	}
+	file.ReadInt( num );
+	for ( i = 0; i < num; i++ ) {
+		idVarDef *def = new idVarDef();
+		def->num = varDefs.Append( def );
+	}
+	file.ReadInt( num );
+	if ( num < 0 || num > functions.Max() ) {
+		return false;
+	}
+	functions.SetNum( num );
+	for ( i = 0; i < num; i++ ) {
+		functions[ i ].Clear();
+	}
+
+	idScriptCacheReader refs( types, varDefs, functions.Ptr(), functions.Num() );
+
+	for ( i = 0; i < types.Num(); i++ ) {
+		idTypeDef *type = types[ i ];
+		int index;
+
+		file.ReadInt( index );
+		type->auxType = refs.Type( index );
+		file.ReadInt( num );
+		for ( j = 0; j < num && !refs.failed; j++ ) {
+			file.ReadInt( index );
+			type->parmTypes.Append( refs.Type( index ) );
+			file.ReadString( type->parmNames.Alloc() );
+		}
+		file.ReadInt( num );
+		for ( j = 0; j < num && !refs.failed; j++ ) {
+			file.ReadInt( index );
+			type->functions.Append( refs.Function( index ) );
+		}
+		file.ReadInt( index );
+		type->def = refs.Def( index );
+	}
+
+	for ( i = 0; i < varDefs.Num() && !refs.failed; i++ ) {
+		idVarDef *def = varDefs[ i ];
+		int typeIndex, scopeIndex, initialized, kind, value;
+		idStr name;
+
+		file.ReadString( name );
+		file.ReadInt( typeIndex );
+		file.ReadInt( scopeIndex );
+		file.ReadInt( def->numUsers );
+		file.ReadInt( initialized );
+		file.ReadInt( kind );
+		file.ReadInt( value );
+
+		// defs are added in the order they were allocated, so the name lists come out the same
+		AddDefToNameList( def, name );
+		def->SetTypeDef( refs.Type( typeIndex ) );
+		def->scope = refs.Def( scopeIndex );
+		def->initialized = (idVarDef::initialized_t)initialized;
+
+		switch( kind ) {
+		case SCB_VALUE_INT:
+			def->value.stackOffset = value;
+			break;
+		case SCB_VALUE_VARIABLE:
+			if ( value < 0 || value > (int)numVariables ) {
+				return false;
+			}
+			def->value.bytePtr = &variables[ value ];
+			break;
+		case SCB_VALUE_FUNCTION:
+			def->value.functionPtr = refs.Function( value );
+			break;
+		default:
+			return false;
+		}
+	}
+
+	for ( i = 0; i < functions.Num() && !refs.failed; i++ ) {
+		function_t &func = functions[ i ];
+		idStr name, eventName;
+		int defIndex, typeIndex;
+
+		file.ReadString( name );
+		func.SetName( name );
+		file.ReadString( eventName );
+		if ( eventName.Length() ) {
+			func.eventdef = idEventDef::FindEvent( eventName );
+			if ( func.eventdef == NULL ) {
+				return false;
+			}
+		}
+		file.ReadInt( defIndex );
+		func.def = refs.Def( defIndex );
+		file.ReadInt( typeIndex );
+		func.type = refs.Type( typeIndex );
+		file.ReadInt( func.firstStatement );
+		file.ReadInt( func.numStatements );
+		file.ReadInt( func.parmTotal );
+		file.ReadInt( func.locals );
+		file.ReadInt( func.filenum );
+		file.ReadInt( num );
+		func.parmSize.SetGranularity( 1 );
+		func.parmSize.SetNum( num );
+		for ( j = 0; j < num; j++ ) {
+			file.ReadInt( func.parmSize[ j ] );
+		}
+	}
+
+	file.ReadInt( num );
+	if ( num < 0 || num > statements.Max() ) {
+		return false;
+	}
+	statements.SetNum( num );
+	decodedValid = false;
+	for ( i = 0; i < num && !refs.failed; i++ ) {
+		statement_t &statement = statements[ i ];
+		int a, b, c;
+
+		file.ReadUnsignedShort( statement.op );
+		file.ReadInt( a );
+		file.ReadInt( b );
+		file.ReadInt( c );
+		file.ReadUnsignedShort( statement.linenumber );
+		file.ReadUnsignedShort( statement.file );
+		if ( statement.op >= NUM_OPCODES ) {
+			return false;
+		}
+		statement.a = refs.Def( a );
+		statement.b = refs.Def( b );
+		statement.c = refs.Def( c );
+	}
+
+	int returnIndex, returnStringIndex, sysIndex;
+	file.ReadInt( returnIndex );
+	file.ReadInt( returnStringIndex );
+	file.ReadInt( sysIndex );
+	returnDef = refs.Def( returnIndex );
+	returnStringDef = refs.Def( returnStringIndex );
+	sysDef = refs.Def( sysIndex );
+
+	return !refs.failed && returnDef != NULL && returnStringDef != NULL && file.Tell() == file.Length();
+}
+
+/*
+================
+idProgram::LoadCache
+
+Restores the program Startup would compile from the script cache.
+================
+*/
+bool idProgram::LoadCache( const char *defaultScript ) {
+	idStr cacheName = defaultScript;
+	cacheName.SetFileExtension( SCRIPT_CACHE_EXT );
+
+	void *buffer;
+	int length = fileSystem->ReadFile( cacheName, &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+
+	int startTime = Sys_Milliseconds();
+
+	idFile_Memory file( cacheName, (const char *)buffer, length );
+	bool loaded = ReadCache( file, defaultScript );
+	fileSystem->FreeFile( buffer );
+
+	if ( !loaded ) {
+		gameLocal.Printf( "%s is out of date, compiling scripts\n", cacheName.c_str() );
+		FreeData();
+		return false;
+	}
+
+	gameLocal.Printf( "Restored scripts from %s in %d msec: %d functions, %d statements, %d bytes of variables\n",
+		cacheName.c_str(), Sys_Milliseconds() - startTime, functions.Num(), statements.Num(), numVariables );
+	return true;
+}
+
 /*
 ================
 idProgram::Startup
@@ -1966,6 +2709,13 @@ void idProgram::Startup( const char *defaultScript )
 	// make sure all data is freed up
 	idThread::Restart();
 
+	// restore the compiled default script if its sources didn't change, disassembling needs the compiler
+	bool useCache = defaultScript && *defaultScript && g_scriptCache.GetBool() && !g_disasm.GetBool();
+	if ( useCache && LoadCache( defaultScript ) ) {
+		FinishCompilation();
+		return;
+	}
+
 	// get ready for loading scripts
 	BeginCompilation();
 
@@ -1978,6 +2728,10 @@ void idProgram::Startup( const char *defaultScript )
 	}
 
 	FinishCompilation();
+
+	if ( useCache ) {
+		WriteCache( defaultScript );
+	}
 }
 
 /*
@@ -2137,6 +2891,7 @@ void idProgram::Restart( void ) {
 	functions.SetNum( top_functions	);
 
 	statements.SetNum( top_statements );
+	decodedValid = false;
 	fileList.SetNum( top_files, false );
 	filename.Clear();
 	
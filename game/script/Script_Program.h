@@ -91,6 +91,8 @@ private:
 	idStrList					parmNames;
 	idList<const function_t *>	functions;
 
+	friend class idProgram;									// restores types from the script cache
+
 public:
 	idVarDef					*def;						// a def that points to this type
 
@@ -413,6 +415,28 @@ typedef struct statement_s {
 
 /***********************************************************************
 
+scriptInstruction_t
+
+Statements the way the interpreter executes them.  The operands hold the
+value of their def, so globals and constants are used without going through
+the idVarDef.  Operands that are stack variables hold their offset from the
+stack base.  Some common statement pairs are decoded into a single fused op,
+the second statement is still decoded on its own for jumps that land on it.
+
+***********************************************************************/
+
+typedef struct scriptInstruction_s {
+	unsigned short	op;
+	bool			aOnStack;
+	bool			bOnStack;
+	bool			cOnStack;
+	varEval_t		a;
+	varEval_t		b;
+	varEval_t		c;
+} scriptInstruction_t;
+
+/***********************************************************************
+
 idProgram
 
 Handles compiling and storage of script data.  Multiple idProgram objects
@@ -446,7 +470,12 @@ private:
 	int											top_defs;
 	int											top_files;
 
+	idList<scriptInstruction_t>					decodedStatements;
+	bool										decodedValid;		// cleared whenever statements change
+	bool										decodedFused;
+
 	void										CompileStats( void );
+	void										DecodeStatements( void );
 
 public:
 	idVarDef									*returnDef;
@@ -509,6 +538,7 @@ public:
 	statement_t									*AllocStatement( void );
 	statement_t									&GetStatement( int index );
 	int											NumStatements( void ) { return statements.Num(); }
+	const scriptInstruction_t					*GetDecodedStatements( void );
 
 	int 										GetReturnedInteger( void );
 
@@ -523,6 +553,11 @@ public:
 private:
 	// greebo: Registers all events declared by the static idEventDef variables
 	void										RegisterScriptEvents();
+
+	// binary cache of the compiled default script
+	bool										LoadCache( const char *defaultScript );
+	bool										ReadCache( idFile_Memory &file, const char *defaultScript );
+	void										WriteCache( const char *defaultScript ) const;
 };
 
 /*
@@ -534,6 +569,18 @@ ID_INLINE statement_t &idProgram::GetStatement( int index ) {
 	return statements[ index ];
 }
 
+/*
+================
+idProgram::GetDecodedStatements
+================
+*/
+ID_INLINE const scriptInstruction_t *idProgram::GetDecodedStatements( void ) {
+	if ( !decodedValid || decodedFused != g_scriptFuseStatements.GetBool() ) {
+		DecodeStatements();
+	}
+	return decodedStatements.Ptr();
+}
+
 /*
 ================
 idProgram::GetFunction
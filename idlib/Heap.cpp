@@ -20,6 +20,8 @@
 #include "precompiled.h"
 #pragma hdrstop
 
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
 
 
 #ifndef USE_LIBC_MALLOC
@@ -979,10 +981,313 @@ void idHeap::LargeFree( void *ptr) {
 
 #undef new
 
+//===============================================================
+//
+//	idSlabAllocator
+//
+//	Thread safe allocator for the small allocations that Mem_Alloc gets
+//	most of the time. Blocks come in a few size classes and are carved
+//	from 64kB chunks. Every thread keeps a magazine of free blocks per
+//	size class, so allocating and freeing only takes a lock when a
+//	magazine runs empty or full and half of it is exchanged with the
+//	global depot of the size class. Chunks are not given back until the
+//	allocator is destroyed.
+//
+//	Blocks have the same layout as idHeap small blocks: the size class
+//	and the allocation identifier are stored in the two bytes in front of
+//	the returned pointer, so Mem_Free can tell them apart.
+//
+//===============================================================
+
+#define SLAB_ALLOC				0xee			// allocation identifier, idHeap uses 0xaa-0xdd
+#define SLAB_INVALID_ALLOC		0xdd			// same as idHeap::INVALID_ALLOC
+#define SLAB_HEADER_SIZE		8				// keeps the blocks 8 byte aligned
+#define SLAB_CHUNK_SIZE			( 64 * 1024 )
+#define SLAB_MAGAZINE_SIZE		64
+#define SLAB_MAX_SIZE			256
+
+static const int slabClassSizes[MEM_NUM_SIZE_CLASSES] = { 8, 16, 24, 32, 48, 64, 96, 128, 192, 256 };
+
+typedef struct {
+	int						num;
+	void *					blocks[SLAB_MAGAZINE_SIZE];
+} slabMagazine_t;
+
+typedef struct slabThreadCache_s {
+	slabMagazine_t			magazines[MEM_NUM_SIZE_CLASSES];
+	int						allocs[MEM_NUM_SIZE_CLASSES];	// totals, only written by the owning thread
+	int						frees[MEM_NUM_SIZE_CLASSES];
+	bool					inUse;							// false once the thread exited, can be taken by a new thread
+	slabThreadCache_s *		next;
+} slabThreadCache_t;
+
+typedef struct {
+	boost::mutex			lock;
+	void *					freeList;						// linked through the first bytes of the blocks
+	byte *					chunkCur;						// uncarved rest of the last chunk
+	byte *					chunkEnd;
+	idList<byte *>			chunks;
+} slabDepot_t;
+
+class idSlabAllocator {
+public:
+							idSlabAllocator( void );
+							~idSlabAllocator( void );
+
+	void *					Allocate( const int bytes );
+	void					Free( void *p );
+	int						Msize( void *p ) const;
+
+							// totals of all threads, since the start
+	void					GetClassTotals( int allocs[MEM_NUM_SIZE_CLASSES], int frees[MEM_NUM_SIZE_CLASSES] );
+
+	static bool				IsSlabBlock( const void *p ) { return ( (const byte *)p )[-1] == SLAB_ALLOC; }
+
+private:
+	slabDepot_t				depots[MEM_NUM_SIZE_CLASSES];
+	byte					classForSize[SLAB_MAX_SIZE / 8 + 1];
+
+	boost::thread_specific_ptr<slabThreadCache_t> threadCache;
+	boost::mutex			cacheLock;
+	slabThreadCache_t *		caches;							// all thread caches, used and unused
+
+	slabThreadCache_t *		GetThreadCache( void );
+	void					Refill( int sizeClass, slabMagazine_t &mag );
+	void					Flush( int sizeClass, slabMagazine_t &mag, int count );
+	static void				ThreadExit( slabThreadCache_t *cache );
+};
+
+static idSlabAllocator *	mem_slab = NULL;
+
+/*
+================
+idSlabAllocator::idSlabAllocator
+================
+*/
+idSlabAllocator::idSlabAllocator( void ) : threadCache( &idSlabAllocator::ThreadExit ) {
+	int c = 0;
+	for ( int i = 0; i <= SLAB_MAX_SIZE / 8; i++ ) {
+		while ( slabClassSizes[c] < i * 8 ) {
+			c++;
+		}
+		classForSize[i] = c;
+	}
+	for ( int i = 0; i < MEM_NUM_SIZE_CLASSES; i++ ) {
+		depots[i].freeList = NULL;
+		depots[i].chunkCur = depots[i].chunkEnd = NULL;
+	}
+	caches = NULL;
+}
+
+/*
+================
+idSlabAllocator::~idSlabAllocator
+================
+*/
+idSlabAllocator::~idSlabAllocator( void ) {
+	// the calling thread's cache points into the chunks as well
+	threadCache.release();
+
+	for ( int i = 0; i < MEM_NUM_SIZE_CLASSES; i++ ) {
+		for ( int j = 0; j < depots[i].chunks.Num(); j++ ) {
+			free( depots[i].chunks[j] );
+		}
+	}
+	while ( caches ) {
+		slabThreadCache_t *next = caches->next;
+		free( caches );
+		caches = next;
+	}
+}
+
+/*
+================
+idSlabAllocator::GetThreadCache
+================
+*/
+slabThreadCache_t *idSlabAllocator::GetThreadCache( void ) {
+	slabThreadCache_t *cache = threadCache.get();
+	if ( cache ) {
+		return cache;
+	}
+
+	// reuse the cache of a thread that exited, so the statistics stay complete
+	{
+		boost::mutex::scoped_lock lock( cacheLock );
+		for ( cache = caches; cache; cache = cache->next ) {
+			if ( !cache->inUse ) {
+				break;
+			}
+		}
+		if ( !cache ) {
+			cache = (slabThreadCache_t *)calloc( 1, sizeof( *cache ) );
+			cache->next = caches;
+			caches = cache;
+		}
+		cache->inUse = true;
+	}
+
+	threadCache.reset( cache );
+	return cache;
+}
+
+/*
+================
+idSlabAllocator::ThreadExit
+
+Gives the blocks of an exiting thread back to the depots.
+================
+*/
+void idSlabAllocator::ThreadExit( slabThreadCache_t *cache ) {
+	if ( !mem_slab ) {
+		return;
+	}
+	for ( int i = 0; i < MEM_NUM_SIZE_CLASSES; i++ ) {
+		mem_slab->Flush( i, cache->magazines[i], cache->magazines[i].num );
+	}
+	boost::mutex::scoped_lock lock( mem_slab->cacheLock );
+	cache->inUse = false;
+}
+
+/*
+================
+idSlabAllocator::Refill
+
+Fills half of an empty magazine from the depot, carving new blocks if needed.
+================
+*/
+void idSlabAllocator::Refill( int sizeClass, slabMagazine_t &mag ) {
+	slabDepot_t &depot = depots[sizeClass];
+	const int stride = slabClassSizes[sizeClass] + SLAB_HEADER_SIZE;
+
+	boost::mutex::scoped_lock lock( depot.lock );
+
+	while ( mag.num < SLAB_MAGAZINE_SIZE / 2 ) {
+		if ( depot.freeList ) {
+			void *p = depot.freeList;
+			depot.freeList = *(void **)p;
+			mag.blocks[mag.num++] = p;
+			continue;
+		}
+		if ( depot.chunkCur + stride > depot.chunkEnd ) {
+			depot.chunkCur = (byte *)malloc( SLAB_CHUNK_SIZE );
+			if ( !depot.chunkCur ) {
+				idLib::common->FatalError( "idSlabAllocator: malloc failure for %i", SLAB_CHUNK_SIZE );
+			}
+			depot.chunkEnd = depot.chunkCur + SLAB_CHUNK_SIZE;
+			depot.chunks.Append( depot.chunkCur );
+		}
+		byte *p = depot.chunkCur + SLAB_HEADER_SIZE;
+		p[-2] = sizeClass;
+		p[-1] = SLAB_INVALID_ALLOC;
+		depot.chunkCur += stride;
+		mag.blocks[mag.num++] = p;
+	}
+}
+
+/*
+================
+idSlabAllocator::Flush
+
+Moves the last count blocks of a magazine to the depot.
+================
+*/
+void idSlabAllocator::Flush( int sizeClass, slabMagazine_t &mag, int count ) {
+	slabDepot_t &depot = depots[sizeClass];
+
+	boost::mutex::scoped_lock lock( depot.lock );
+
+	for ( int i = 0; i < count; i++ ) {
+		void *p = mag.blocks[--mag.num];
+		*(void **)p = depot.freeList;
+		depot.freeList = p;
+	}
+}
+
+/*
+================
+idSlabAllocator::Allocate
+================
+*/
+void *idSlabAllocator::Allocate( const int bytes ) {
+	assert( bytes > 0 && bytes <= SLAB_MAX_SIZE );
+
+	const int sizeClass = classForSize[( bytes + 7 ) >> 3];
+	slabThreadCache_t *cache = GetThreadCache();
+	slabMagazine_t &mag = cache->magazines[sizeClass];
+
+	if ( mag.num == 0 ) {
+		Refill( sizeClass, mag );
+	}
+	cache->allocs[sizeClass]++;
+
+	byte *p = (byte *)mag.blocks[--mag.num];
+	p[-1] = SLAB_ALLOC;
+	return p;
+}
+
+/*
+================
+idSlabAllocator::Free
+================
+*/
+void idSlabAllocator::Free( void *ptr ) {
+	byte *p = (byte *)ptr;
+	const int sizeClass = p[-2];
+
+	if ( sizeClass >= MEM_NUM_SIZE_CLASSES ) {
+		idLib::common->FatalError( "idSlabAllocator::Free: invalid memory block" );
+	}
+	p[-1] = SLAB_INVALID_ALLOC;
+
+	slabThreadCache_t *cache = GetThreadCache();
+	slabMagazine_t &mag = cache->magazines[sizeClass];
+
+	if ( mag.num == SLAB_MAGAZINE_SIZE ) {
+		Flush( sizeClass, mag, SLAB_MAGAZINE_SIZE / 2 );
+	}
+	cache->frees[sizeClass]++;
+
+	mag.blocks[mag.num++] = p;
+}
+
+/*
+================
+idSlabAllocator::Msize
+================
+*/
+int idSlabAllocator::Msize( void *p ) const {
+	return slabClassSizes[( (byte *)p )[-2]];
+}
+
+/*
+================
+idSlabAllocator::GetClassTotals
+
+The counters of other threads are read without a lock, the totals may be
+a few allocations behind.
+================
+*/
+void idSlabAllocator::GetClassTotals( int allocs[MEM_NUM_SIZE_CLASSES], int frees[MEM_NUM_SIZE_CLASSES] ) {
+	memset( allocs, 0, MEM_NUM_SIZE_CLASSES * sizeof( allocs[0] ) );
+	memset( frees, 0, MEM_NUM_SIZE_CLASSES * sizeof( frees[0] ) );
+
+	boost::mutex::scoped_lock lock( cacheLock );
+	for ( slabThreadCache_t *cache = caches; cache; cache = cache->next ) {
+		for ( int i = 0; i < MEM_NUM_SIZE_CLASSES; i++ ) {
+			allocs[i] += cache->allocs[i];
+			frees[i] += cache->frees[i];
+		}
+	}
+}
+
 static idHeap *			mem_heap = NULL;
+static boost::mutex *	mem_lock = NULL;		// idHeap is not thread safe, the small allocations don't go through it
 static memoryStats_t	mem_total_allocs = { 0, 0x0fffffff, -1, 0 };
 static memoryStats_t	mem_frame_allocs;
 static memoryStats_t	mem_frame_frees;
+static int				mem_slab_frame_allocs[MEM_NUM_SIZE_CLASSES];	// slab totals at the last Mem_ClearFrameStats
+static int				mem_slab_frame_frees[MEM_NUM_SIZE_CLASSES];
 
 /*
 ==================
@@ -994,6 +1299,29 @@ void Mem_ClearFrameStats( void ) {
 	mem_frame_allocs.minSize = mem_frame_frees.minSize = 0x0fffffff;
 	mem_frame_allocs.maxSize = mem_frame_frees.maxSize = -1;
 	mem_frame_allocs.totalSize = mem_frame_frees.totalSize = 0;
+
+	if ( mem_slab ) {
+		mem_slab->GetClassTotals( mem_slab_frame_allocs, mem_slab_frame_frees );
+	}
+}
+
+/*
+==================
+Mem_AddClassStats
+==================
+*/
+static void Mem_AddClassStats( memoryStats_t &stats, int num, int size ) {
+	if ( num <= 0 ) {
+		return;
+	}
+	stats.num += num;
+	stats.totalSize += num * size;
+	if ( size < stats.minSize ) {
+		stats.minSize = size;
+	}
+	if ( size > stats.maxSize ) {
+		stats.maxSize = size;
+	}
 }
 
 /*
@@ -1001,9 +1329,44 @@ void Mem_ClearFrameStats( void ) {
 Mem_GetFrameStats
 ==================
 */
-void Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees ) {
+void Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees, memoryStats_t *classAllocs, memoryStats_t *classFrees ) {
 	allocs = mem_frame_allocs;
 	frees = mem_frame_frees;
+
+	if ( !mem_slab ) {
+		for ( int i = 0; i < MEM_NUM_SIZE_CLASSES; i++ ) {
+			if ( classAllocs ) {
+				memset( &classAllocs[i], 0, sizeof( classAllocs[i] ) );
+			}
+			if ( classFrees ) {
+				memset( &classFrees[i], 0, sizeof( classFrees[i] ) );
+			}
+		}
+		return;
+	}
+
+	int slabAllocs[MEM_NUM_SIZE_CLASSES];
+	int slabFrees[MEM_NUM_SIZE_CLASSES];
+	mem_slab->GetClassTotals( slabAllocs, slabFrees );
+
+	for ( int i = 0; i < MEM_NUM_SIZE_CLASSES; i++ ) {
+		const int numAllocs = slabAllocs[i] - mem_slab_frame_allocs[i];
+		const int numFrees = slabFrees[i] - mem_slab_frame_frees[i];
+
+		Mem_AddClassStats( allocs, numAllocs, slabClassSizes[i] );
+		Mem_AddClassStats( frees, numFrees, slabClassSizes[i] );
+
+		if ( classAllocs ) {
+			classAllocs[i].num = numAllocs;
+			classAllocs[i].minSize = classAllocs[i].maxSize = slabClassSizes[i];
+			classAllocs[i].totalSize = numAllocs * slabClassSizes[i];
+		}
+		if ( classFrees ) {
+			classFrees[i].num = numFrees;
+			classFrees[i].minSize = classFrees[i].maxSize = slabClassSizes[i];
+			classFrees[i].totalSize = numFrees * slabClassSizes[i];
+		}
+	}
 }
 
 /*
@@ -1013,6 +1376,15 @@ Mem_GetStats
 */
 void Mem_GetStats( memoryStats_t &stats ) {
 	stats = mem_total_allocs;
+
+	if ( mem_slab ) {
+		int slabAllocs[MEM_NUM_SIZE_CLASSES];
+		int slabFrees[MEM_NUM_SIZE_CLASSES];
+		mem_slab->GetClassTotals( slabAllocs, slabFrees );
+		for ( int i = 0; i < MEM_NUM_SIZE_CLASSES; i++ ) {
+			Mem_AddClassStats( stats, slabAllocs[i] - slabFrees[i], slabClassSizes[i] );
+		}
+	}
 }
 
 /*
@@ -1070,6 +1442,10 @@ void *Mem_Alloc( const int size ) {
 #endif
 		return malloc( size );
 	}
+	if ( size <= SLAB_MAX_SIZE ) {
+		return mem_slab->Allocate( size );
+	}
+	boost::mutex::scoped_lock lock( *mem_lock );
 	void *mem = mem_heap->Allocate( size );
 	Mem_UpdateAllocStats( mem_heap->Msize( mem ) );
 	return mem;
@@ -1091,6 +1467,11 @@ void Mem_Free( void *ptr ) {
 		free( ptr );
 		return;
 	}
+	if ( idSlabAllocator::IsSlabBlock( ptr ) ) {
+		mem_slab->Free( ptr );
+		return;
+	}
+	boost::mutex::scoped_lock lock( *mem_lock );
 	Mem_UpdateFreeStats( mem_heap->Msize( ptr ) );
  	mem_heap->Free( ptr );
 }
@@ -1110,6 +1491,7 @@ void *Mem_Alloc16( const int size ) {
 #endif
 		return malloc( size );
 	}
+	// Allocate16 goes straight to malloc, no need for the lock
 	void *mem = mem_heap->Allocate16( size );
 	// make sure the memory is 16 byte aligned
 	assert( ( ((int)mem) & 15) == 0 );
@@ -1186,12 +1568,97 @@ Mem_DumpCompressed_f
 void Mem_DumpCompressed_f( const idCmdArgs &args ) {
 }
 
+/*
+==================
+Mem_TestAllocs
+
+A fixed pattern of small allocations and frees, one job of Mem_Test_f.
+==================
+*/
+#define MEM_TEST_BLOCKS		1024
+#define MEM_TEST_ROUNDS		256
+
+static void Mem_TestAllocs( void *data, int index ) {
+	const bool useHeap = *(bool *)data;
+	void *blocks[MEM_TEST_BLOCKS];
+	idRandom random( index );
+
+	memset( blocks, 0, sizeof( blocks ) );
+
+	for ( int r = 0; r < MEM_TEST_ROUNDS; r++ ) {
+		for ( int i = 0; i < MEM_TEST_BLOCKS; i++ ) {
+			const int size = 1 + random.RandomInt( SLAB_MAX_SIZE );
+			if ( useHeap ) {
+				// the way Mem_Alloc and Mem_Free used idHeap before
+				boost::mutex::scoped_lock lock( *mem_lock );
+				if ( blocks[i] ) {
+					Mem_UpdateFreeStats( mem_heap->Msize( blocks[i] ) );
+					mem_heap->Free( blocks[i] );
+				}
+				blocks[i] = mem_heap->Allocate( size );
+				Mem_UpdateAllocStats( mem_heap->Msize( blocks[i] ) );
+			} else {
+				Mem_Free( blocks[i] );
+				blocks[i] = Mem_Alloc( size );
+			}
+		}
+	}
+
+	for ( int i = 0; i < MEM_TEST_BLOCKS; i++ ) {
+		if ( useHeap ) {
+			boost::mutex::scoped_lock lock( *mem_lock );
+			Mem_UpdateFreeStats( mem_heap->Msize( blocks[i] ) );
+			mem_heap->Free( blocks[i] );
+		} else {
+			Mem_Free( blocks[i] );
+		}
+	}
+}
+
+/*
+==================
+Mem_Test_f
+
+Compares the slab allocator to idHeap for small allocations,
+on the calling thread and on all job pool threads at once.
+==================
+*/
+void Mem_Test_f( const idCmdArgs &args ) {
+	const int numJobs = jobPool.GetNumThreads() + 1;
+	const float numPairs = (float)MEM_TEST_ROUNDS * MEM_TEST_BLOCKS;
+	idTimer timer;
+
+	idLib::common->Printf( "%d alloc/free pairs of 1-%d bytes per thread\n", MEM_TEST_ROUNDS * MEM_TEST_BLOCKS, SLAB_MAX_SIZE );
+
+	for ( int i = 0; i < 2; i++ ) {
+		bool useHeap = ( i == 0 );
+
+		timer.Clear();
+		timer.Start();
+		Mem_TestAllocs( &useHeap, 0 );
+		timer.Stop();
+		const double single = timer.Milliseconds();
+
+		timer.Clear();
+		timer.Start();
+		jobPool.ParallelFor( Mem_TestAllocs, &useHeap, numJobs );
+		timer.Stop();
+		const double parallel = timer.Milliseconds();
+
+		idLib::common->Printf( "%-24s %7.1f msec (%5.1f ns per pair), %d threads: %7.1f msec (%5.1f ns per pair)\n",
+			useHeap ? "idHeap with lock:" : "idSlabAllocator:", single, single * 1000000.0 / numPairs,
+			numJobs, parallel, parallel * 1000000.0 / ( numPairs * numJobs ) );
+	}
+}
+
 /*
 ==================
 Mem_Init
 ==================
 */
 void Mem_Init( void ) {
+	mem_lock = new boost::mutex;
+	mem_slab = new idSlabAllocator;
 	mem_heap = new idHeap;
 	Mem_ClearFrameStats();
 }
@@ -1205,6 +1672,11 @@ void Mem_Shutdown( void ) {
 	idHeap *m = mem_heap;
 	mem_heap = NULL;
 	delete m;
+	idSlabAllocator *s = mem_slab;
+	mem_slab = NULL;
+	delete s;
+	delete mem_lock;
+	mem_lock = NULL;
 }
 
 /*
@@ -1572,6 +2044,8 @@ void *Mem_AllocDebugMemory( const int size, const char *fileName, const int line
 		return malloc( size );
 	}
 
+	boost::mutex::scoped_lock lock( *mem_lock );
+
 	if ( align16 ) {
 		p = mem_heap->Allocate16( size + sizeof( debugMemory_t ) );
 	}
@@ -1618,6 +2092,8 @@ void Mem_FreeDebugMemory( void *p, const char *fileName, const int lineNumber, c
 		return;
 	}
 
+	boost::mutex::scoped_lock lock( *mem_lock );
+
 	m = (debugMemory_t *) ( ( (byte *) p ) - sizeof( debugMemory_t ) );
 
 	if ( m->size < 0 ) {
@@ -1733,6 +2209,7 @@ Mem_Init
 ==================
 */
 void Mem_Init( void ) {
+	mem_lock = new boost::mutex;
 	mem_heap = new idHeap;
 }
 
@@ -1752,6 +2229,8 @@ void Mem_Shutdown( void ) {
 	idHeap *m = mem_heap;
 	mem_heap = NULL;
 	delete m;
+	delete mem_lock;
+	mem_lock = NULL;
 }
 
 /*
@@ -1763,4 +2242,148 @@ void Mem_EnableLeakTest( const char *name ) {
 	idStr::Copynz( mem_leakName, name, sizeof( mem_leakName ) );
 }
 
+/*
+==================
+Mem_Test_f
+==================
+*/
+void Mem_Test_f( const idCmdArgs &args ) {
+	idLib::common->Printf( "testHeap is not available with ID_DEBUG_MEMORY\n" );
+}
+
 #endif /* !ID_DEBUG_MEMORY */
+
+
+/*
+===============================================================================
+
+	Frame allocator
+
+===============================================================================
+*/
+
+#define FRAME_ALLOC_MIN_SIZE		( 256 * 1024 )
+#define FRAME_ALLOC_OVERFLOW_SIZE	( 64 * 1024 )
+
+idFrameAllocator	frameAllocator;
+
+/*
+================
+idFrameAllocator::idFrameAllocator
+================
+*/
+idFrameAllocator::idFrameAllocator( void ) {
+	arenaMemory = NULL;
+	arena = NULL;
+	size = 0;
+	used = 0;
+	peak = 0;
+	overflow = NULL;
+	overflowBytes = 0;
+	numOverflows = 0;
+}
+
+/*
+================
+idFrameAllocator::~idFrameAllocator
+================
+*/
+idFrameAllocator::~idFrameAllocator( void ) {
+	Shutdown();
+}
+
+/*
+================
+idFrameAllocator::Shutdown
+================
+*/
+void idFrameAllocator::Shutdown( void ) {
+	while( overflow ) {
+		overflowBlock_t *next = overflow->next;
+		free( overflow );
+		overflow = next;
+	}
+	if ( arenaMemory ) {
+		free( arenaMemory );
+	}
+	arenaMemory = NULL;
+	arena = NULL;
+	size = 0;
+	used = 0;
+	peak = 0;
+	overflowBytes = 0;
+}
+
+/*
+================
+idFrameAllocator::Alloc
+================
+*/
+void *idFrameAllocator::Alloc( const int bytes ) {
+	int alignedBytes = ( bytes + 15 ) & ~15;
+
+	if ( used + alignedBytes <= size ) {
+		void *ptr = arena + used;
+		used += alignedBytes;
+		return ptr;
+	}
+
+	// out of arena space, continue in the current overflow block or start a new one
+	if ( overflow == NULL || overflow->used + alignedBytes > overflow->size ) {
+		int blockSize = Max( alignedBytes, FRAME_ALLOC_OVERFLOW_SIZE );
+		overflowBlock_t *block = (overflowBlock_t *) malloc( sizeof( overflowBlock_t ) + blockSize + 15 );
+		block->next = overflow;
+		block->size = blockSize;
+		block->used = 0;
+		overflow = block;
+		numOverflows++;
+	}
+
+	unsigned char *data = (unsigned char *)( ( (size_t)( overflow + 1 ) + 15 ) & ~15 );
+	void *ptr = data + overflow->used;
+	overflow->used += alignedBytes;
+	overflowBytes += alignedBytes;
+	return ptr;
+}
+
+/*
+================
+idFrameAllocator::Reset
+================
+*/
+void idFrameAllocator::Reset( bool poison ) {
+	int total = used + overflowBytes;
+	if ( total > peak ) {
+		peak = total;
+	}
+
+	if ( poison && used ) {
+		memset( arena, FRAME_ALLOC_POISON, used );
+	}
+
+	while( overflow ) {
+		overflowBlock_t *next = overflow->next;
+		if ( poison ) {
+			memset( overflow + 1, FRAME_ALLOC_POISON, overflow->size );
+		}
+		free( overflow );
+		overflow = next;
+	}
+
+	// grow the arena so the peak fits without overflowing
+	if ( peak > size || arena == NULL ) {
+		int newSize = Max( FRAME_ALLOC_MIN_SIZE, ( peak + peak / 4 + FRAME_ALLOC_OVERFLOW_SIZE - 1 ) & ~( FRAME_ALLOC_OVERFLOW_SIZE - 1 ) );
+		if ( arenaMemory ) {
+			free( arenaMemory );
+		}
+		arenaMemory = malloc( newSize + 15 );
+		arena = (unsigned char *)( ( (size_t)arenaMemory + 15 ) & ~15 );
+		size = newSize;
+		if ( poison ) {
+			memset( arena, FRAME_ALLOC_POISON, size );
+		}
+	}
+
+	used = 0;
+	overflowBytes = 0;
+}
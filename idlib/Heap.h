@@ -44,15 +44,19 @@ typedef struct {
 	int		totalSize;
 } memoryStats_t;
 
+// allocations of up to 256 bytes are served by a thread safe slab allocator in these size classes
+const int	MEM_NUM_SIZE_CLASSES = 10;
 
 void		Mem_Init( void );
 void		Mem_Shutdown( void );
 void		Mem_EnableLeakTest( const char *name );
 void		Mem_ClearFrameStats( void );
-void		Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees );
+			// optionally also fills MEM_NUM_SIZE_CLASSES stats for the small allocations per size class
+void		Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees, memoryStats_t *classAllocs = NULL, memoryStats_t *classFrees = NULL );
 void		Mem_GetStats( memoryStats_t &stats );
 void		Mem_Dump_f( const class idCmdArgs &args );
 void		Mem_DumpCompressed_f( const class idCmdArgs &args );
+void		Mem_Test_f( const class idCmdArgs &args );
 void		Mem_AllocDefragBlock( void );
 
 
@@ -134,6 +138,65 @@ __inline void operator delete[]( void *p ) {
 #endif /* ID_DEBUG_MEMORY */
 
 
+/*
+===============================================================================
+
+	Frame allocator
+
+	Linear allocator for scratch memory that only lives during a single frame.
+	Allocations are 16 byte aligned and are never freed individually, all
+	memory is released at once by Reset(). When the arena runs out of space
+	overflow blocks are taken from the heap and the arena is grown on the
+	next Reset() to fit the peak usage.
+
+	Reset() can fill the released memory with a poison pattern to catch
+	dangling uses of frame memory.
+
+	The frame allocator is not thread safe. Each module (engine and game)
+	has its own frameAllocator since idLib is linked into both.
+
+===============================================================================
+*/
+
+#define FRAME_ALLOC_POISON			0xcd
+
+class idFrameAllocator {
+public:
+							idFrameAllocator( void );
+							~idFrameAllocator( void );
+
+	void					Shutdown( void );
+
+	void *					Alloc( const int bytes );
+							// releases all memory allocated since the last Reset(), optionally poisoning it
+	void					Reset( bool poison );
+
+	int						GetBytesUsed( void ) const { return used + overflowBytes; }
+	int						GetPeakBytes( void ) const { return peak; }
+	int						GetArenaSize( void ) const { return size; }
+	int						GetNumOverflows( void ) const { return numOverflows; }
+
+private:
+	typedef struct overflowBlock_s {
+		struct overflowBlock_s *	next;
+		int							size;
+		int							used;
+		int							pad;			// keeps the data 16 byte aligned
+	} overflowBlock_t;
+
+	void *					arenaMemory;		// unaligned allocation holding the arena
+	unsigned char *			arena;
+	int						size;
+	int						used;
+	int						peak;
+	overflowBlock_t *		overflow;
+	int						overflowBytes;
+	int						numOverflows;
+};
+
+extern idFrameAllocator		frameAllocator;
+
+
 /*
 ===============================================================================
 
@@ -0,0 +1,248 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+idJobPool	jobPool;
+
+typedef struct {
+	jobRun_t		run;
+	void *			data;
+	int				index;
+} job_t;
+
+class idJobPoolLocal {
+public:
+	boost::mutex				mutex;
+	boost::condition_variable	jobAvailable;		// signaled when jobs are added or the pool shuts down
+	boost::condition_variable	jobsDone;			// signaled when the last running job finished
+	boost::thread_group			threads;
+
+	idList<job_t>				jobs;
+	int							nextJob;			// index of the next job to hand out
+	int							runningJobs;		// jobs handed out but not finished yet
+	bool						shutdown;
+};
+
+/*
+================
+idJobPool::idJobPool
+================
+*/
+idJobPool::idJobPool( void ) {
+	local = NULL;
+	numThreads = 0;
+}
+
+/*
+================
+idJobPool::~idJobPool
+================
+*/
+idJobPool::~idJobPool( void ) {
+	Shutdown();
+}
+
+/*
+================
+idJobPool::Init
+================
+*/
+void idJobPool::Init( int threads, int maxThreads ) {
+	Shutdown();
+
+	if ( threads < 0 ) {
+		threads = (int)boost::thread::hardware_concurrency() - 1;
+	}
+	numThreads = idMath::ClampInt( 0, Min( maxThreads, MAX_JOB_THREADS ), threads );
+
+	local = new idJobPoolLocal;
+	local->jobs.SetGranularity( 256 );
+	local->nextJob = 0;
+	local->runningJobs = 0;
+	local->shutdown = false;
+
+	for ( int i = 0; i < numThreads; i++ ) {
+		local->threads.create_thread( boost::bind( &idJobPool::WorkerThread, this ) );
+	}
+}
+
+/*
+================
+idJobPool::Shutdown
+================
+*/
+void idJobPool::Shutdown( void ) {
+	if ( local == NULL ) {
+		return;
+	}
+
+	// finish whatever is still queued before the workers exit
+	Wait();
+
+	{
+		boost::mutex::scoped_lock lock( local->mutex );
+		local->shutdown = true;
+	}
+	local->jobAvailable.notify_all();
+	local->threads.join_all();
+
+	delete local;
+	local = NULL;
+	numThreads = 0;
+}
+
+/*
+================
+idJobPool::AddJob
+================
+*/
+void idJobPool::AddJob( jobRun_t run, void *data, int index ) {
+	if ( local == NULL ) {
+		// not initialized, run right away
+		run( data, index );
+		return;
+	}
+
+	job_t job;
+	job.run = run;
+	job.data = data;
+	job.index = index;
+	{
+		boost::mutex::scoped_lock lock( local->mutex );
+		local->jobs.Append( job );
+	}
+	local->jobAvailable.notify_one();
+}
+
+/*
+================
+idJobPool::AddJobs
+================
+*/
+void idJobPool::AddJobs( jobRun_t run, void *data, int count ) {
+	if ( local == NULL ) {
+		for ( int i = 0; i < count; i++ ) {
+			run( data, i );
+		}
+		return;
+	}
+
+	{
+		boost::mutex::scoped_lock lock( local->mutex );
+		for ( int i = 0; i < count; i++ ) {
+			job_t &job = local->jobs.Alloc();
+			job.run = run;
+			job.data = data;
+			job.index = i;
+		}
+	}
+	local->jobAvailable.notify_all();
+}
+
+/*
+================
+idJobPool::RunJobs
+
+Runs queued jobs until the queue is empty. Workers block waiting for new
+jobs, the thread in Wait() blocks until the running jobs are finished.
+================
+*/
+void idJobPool::RunJobs( bool worker ) {
+	boost::mutex::scoped_lock lock( local->mutex );
+
+	while( 1 ) {
+		if ( local->nextJob < local->jobs.Num() ) {
+			job_t job = local->jobs[ local->nextJob++ ];
+			local->runningJobs++;
+
+			lock.unlock();
+			job.run( job.data, job.index );
+			lock.lock();
+
+			local->runningJobs--;
+			if ( local->runningJobs == 0 && local->nextJob >= local->jobs.Num() ) {
+				local->jobs.SetNum( 0, false );
+				local->nextJob = 0;
+				local->jobsDone.notify_all();
+			}
+			continue;
+		}
+
+		if ( worker ) {
+			if ( local->shutdown ) {
+				return;
+			}
+			local->jobAvailable.wait( lock );
+		} else {
+			if ( local->runningJobs == 0 ) {
+				return;
+			}
+			local->jobsDone.wait( lock );
+		}
+	}
+}
+
+/*
+================
+idJobPool::WorkerThread
+================
+*/
+void idJobPool::WorkerThread( idJobPool *pool ) {
+	pool->RunJobs( true );
+}
+
+/*
+================
+idJobPool::Wait
+================
+*/
+void idJobPool::Wait( void ) {
+	if ( local == NULL ) {
+		return;
+	}
+	RunJobs( false );
+}
+
+/*
+================
+idJobPool::IsDone
+================
+*/
+bool idJobPool::IsDone( void ) {
+	if ( local == NULL ) {
+		return true;
+	}
+	boost::mutex::scoped_lock lock( local->mutex );
+	return ( local->runningJobs == 0 && local->nextJob >= local->jobs.Num() );
+}
+
+/*
+================
+idJobPool::ParallelFor
+================
+*/
+void idJobPool::ParallelFor( jobRun_t run, void *data, int count ) {
+	AddJobs( run, data, count );
+	Wait();
+}
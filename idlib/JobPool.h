@@ -0,0 +1,84 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#ifndef __JOBPOOL_H__
+#define __JOBPOOL_H__
+
+/*
+===============================================================================
+
+	Job pool
+
+	A fixed set of worker threads that run independent jobs. A job is a plain
+	function pointer with a data pointer and an index, so a loop can be split
+	over the workers without allocating anything per iteration.
+
+	The thread calling Wait() helps running the queued jobs, so a pool without
+	worker threads simply runs everything serially inside Wait().
+
+	Jobs are only submitted and waited on from a single thread. A job must
+	not add jobs to or wait on the pool it is running on, and it must not use
+	systems that are not thread safe (console prints, the file system, GL).
+
+	Each module (engine and game) has its own pool since idLib is linked
+	into both. The game pool is limited to a couple of threads so the two
+	pools don't start two threads for every core.
+
+===============================================================================
+*/
+
+typedef void (*jobRun_t)( void *data, int index );
+
+const int MAX_JOB_THREADS			= 16;
+
+class idJobPool {
+public:
+					idJobPool( void );
+					~idJobPool( void );
+
+					// numThreads < 0 picks one thread less than the number of cores, at most maxThreads
+	void			Init( int numThreads, int maxThreads = MAX_JOB_THREADS );
+	void			Shutdown( void );
+
+	bool			IsInitialized( void ) const { return local != NULL; }
+	int				GetNumThreads( void ) const { return numThreads; }
+
+					// queues a single job, it may start running before Wait() is called
+	void			AddJob( jobRun_t run, void *data, int index = 0 );
+					// queues count jobs with the indexes 0 to count - 1
+	void			AddJobs( jobRun_t run, void *data, int count );
+					// runs queued jobs on the calling thread as well and returns once all jobs are done
+	void			Wait( void );
+					// true if no jobs are queued or running
+	bool			IsDone( void );
+
+					// AddJobs() followed by Wait()
+	void			ParallelFor( jobRun_t run, void *data, int count );
+
+private:
+	class idJobPoolLocal *	local;
+	int				numThreads;
+
+	void			RunJobs( bool worker );
+	static void		WorkerThread( idJobPool *pool );
+};
+
+extern idJobPool	jobPool;
+
+#endif /* !__JOBPOOL_H__ */
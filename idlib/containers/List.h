@@ -31,6 +31,14 @@
 	List template
 	Does not allocate memory until the first item is added.
 
+	The allocator policy decides where the elements are stored. The default
+	idListNewAllocator uses new[] and delete[]. idListFrameAllocator takes
+	the elements from the frameAllocator, these lists must not outlive the
+	frame and should only hold plain data since no constructors or
+	destructors are called.
+
+	The default policy is set on the forward declaration in sys_public.h.
+
 ===============================================================================
 */
 
@@ -76,7 +84,33 @@ ID_INLINE void idSwap( type &a, type &b ) {
 	b = c;
 }
 
-template< class type >
+/*
+================
+idListNewAllocator
+================
+*/
+class idListNewAllocator {
+public:
+	template< class type >
+	static type *	Alloc( int num ) { return new type[ num ]; }
+	template< class type >
+	static void		Free( type *ptr, int num ) { delete[] ptr; }
+};
+
+/*
+================
+idListFrameAllocator
+================
+*/
+class idListFrameAllocator {
+public:
+	template< class type >
+	static type *	Alloc( int num ) { return (type *) frameAllocator.Alloc( num * sizeof( type ) ); }
+	template< class type >
+	static void		Free( type *ptr, int num ) {}
+};
+
+template< class type, class _allocator_ >
 class idList {
 public:
 
@@ -84,8 +118,8 @@ public:
 	typedef type	new_t( void );
 
 					idList( int newgranularity = 16 );
-					idList( const idList<type> &other );
-					~idList<type>( void );
+					idList( const idList<type, _allocator_> &other );
+					~idList( void );
 
 	void			Clear( void );										// clear the list
 	int				Num( void ) const;									// returns number of elements in list
@@ -97,7 +131,7 @@ public:
 	size_t			Size( void ) const;									// returns total size of allocated memory including size of list type
 	size_t			MemoryUsed( void ) const;							// returns size of the used elements in the list
 
-	idList<type> &	operator=( const idList<type> &other );
+	idList<type, _allocator_> &	operator=( const idList<type, _allocator_> &other );
 	const type &	operator[]( int index ) const;
 	type &			operator[]( int index );
 
@@ -113,7 +147,7 @@ public:
 	const type *	Ptr( void ) const;									// returns a pointer to the list
 	type &			Alloc( void );										// returns reference to a new data element at the end of the list
 	int				Append( const type & obj );							// append element
-	int				Append( const idList<type> &other );				// append list
+	int				Append( const idList<type, _allocator_> &other );				// append list
 	int				AddUnique( const type & obj );						// add unique element
 	int				Insert( const type & obj, int index = 0 );			// insert the element at the given index
 	int				FindIndex( const type & obj ) const;				// find the index for the given element
@@ -125,7 +159,7 @@ public:
 	bool			Remove( const type & obj );							// remove the element
 	void			Sort( cmp_t *compare = ( cmp_t * )&idListSortCompare<type> );
 	void			SortSubSection( int startIndex, int endIndex, cmp_t *compare = ( cmp_t * )&idListSortCompare<type> );
-	void			Swap( idList<type> &other );						// swap the contents of the lists
+	void			Swap( idList<type, _allocator_> &other );						// swap the contents of the lists
 	void			DeleteContents( bool clear );						// delete the contents of the list
 
 private:
@@ -140,8 +174,8 @@ private:
 idList<type>::idList( int )
 ================
 */
-template< class type >
-ID_INLINE idList<type>::idList( int newgranularity ) {
+template< class type, class _allocator_ >
+ID_INLINE idList<type, _allocator_>::idList( int newgranularity ) {
 	assert( newgranularity > 0 );
 
 	list		= NULL;
@@ -154,8 +188,8 @@ ID_INLINE idList<type>::idList( int newgranularity ) {
 idList<type>::idList( const idList<type> &other )
 ================
 */
-template< class type >
-ID_INLINE idList<type>::idList( const idList<type> &other ) {
+template< class type, class _allocator_ >
+ID_INLINE idList<type, _allocator_>::idList( const idList<type, _allocator_> &other ) {
 	list = NULL;
 	*this = other;
 }
@@ -165,8 +199,8 @@ ID_INLINE idList<type>::idList( const idList<type> &other ) {
 idList<type>::~idList<type>
 ================
 */
-template< class type >
-ID_INLINE idList<type>::~idList( void ) {
+template< class type, class _allocator_ >
+ID_INLINE idList<type, _allocator_>::~idList( void ) {
 	Clear();
 }
 
@@ -177,10 +211,10 @@ idList<type>::Clear
 Frees up the memory allocated by the list.  Assumes that type automatically handles freeing up memory.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Clear( void ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::Clear( void ) {
 	if ( list ) {
-		delete[] list;
+		_allocator_::Free( list, size );
 	}
 
 	list	= NULL;
@@ -200,8 +234,8 @@ the pointers are still valid when this function is called.  Function will set al
 list to NULL.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::DeleteContents( bool clear ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::DeleteContents( bool clear ) {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -223,8 +257,8 @@ idList<type>::Allocated
 return total memory allocated for the list in bytes, but doesn't take into account additional memory allocated by type
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::Allocated( void ) const {
+template< class type, class _allocator_ >
+ID_INLINE size_t idList<type, _allocator_>::Allocated( void ) const {
 	return size * sizeof( type );
 }
 
@@ -235,9 +269,9 @@ idList<type>::Size
 return total size of list in bytes, but doesn't take into account additional memory allocated by type
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::Size( void ) const {
-	return sizeof( idList<type> ) + Allocated();
+template< class type, class _allocator_ >
+ID_INLINE size_t idList<type, _allocator_>::Size( void ) const {
+	return sizeof( idList<type, _allocator_> ) + Allocated();
 }
 
 /*
@@ -245,8 +279,8 @@ ID_INLINE size_t idList<type>::Size( void ) const {
 idList<type>::MemoryUsed
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::MemoryUsed( void ) const {
+template< class type, class _allocator_ >
+ID_INLINE size_t idList<type, _allocator_>::MemoryUsed( void ) const {
 	return num * sizeof( *list );
 }
 
@@ -258,8 +292,8 @@ Returns the number of elements currently contained in the list.
 Note that this is NOT an indication of the memory allocated.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Num( void ) const {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::Num( void ) const {
 	return num;
 }
 
@@ -270,8 +304,8 @@ idList<type>::NumAllocated
 Returns the number of elements currently allocated for.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::NumAllocated( void ) const {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::NumAllocated( void ) const {
 	return size;
 }
 
@@ -282,8 +316,8 @@ idList<type>::SetNum
 Resize to the exact size specified irregardless of granularity
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SetNum( int newnum, bool resize ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::SetNum( int newnum, bool resize ) {
 	assert( newnum >= 0 );
 	if ( resize || newnum > size ) {
 		Resize( newnum );
@@ -298,8 +332,8 @@ idList<type>::SetGranularity
 Sets the base size of the array and resizes the array to match.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SetGranularity( int newgranularity ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::SetGranularity( int newgranularity ) {
 	int newsize;
 
 	assert( newgranularity > 0 );
@@ -322,8 +356,8 @@ idList<type>::GetGranularity
 Get the current granularity.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::GetGranularity( void ) const {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::GetGranularity( void ) const {
 	return granularity;
 }
 
@@ -334,8 +368,8 @@ idList<type>::Condense
 Resizes the array to exactly the number of elements it contains or frees up memory if empty.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Condense( void ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::Condense( void ) {
 	if ( list ) {
 		if ( num ) {
 			Resize( num );
@@ -353,9 +387,10 @@ Allocates memory for the amount of elements requested while keeping the contents
 Contents are copied using their = operator so that data is correnctly instantiated.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Resize( int newsize ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::Resize( int newsize ) {
 	type	*temp;
+	int		oldsize;
 	int		i;
 
 	assert( newsize >= 0 );
@@ -372,20 +407,21 @@ ID_INLINE void idList<type>::Resize( int newsize ) {
 	}
 
 	temp	= list;
+	oldsize	= size;
 	size	= newsize;
 	if ( size < num ) {
 		num = size;
 	}
 
 	// copy the old list into our new one
-	list = new type[ size ];
+	list = _allocator_::template Alloc<type>( size );
 	for( i = 0; i < num; i++ ) {
 		list[ i ] = temp[ i ];
 	}
 
 	// delete the old list if it exists
 	if ( temp ) {
-		delete[] temp;
+		_allocator_::Free( temp, oldsize );
 	}
 }
 
@@ -397,9 +433,10 @@ Allocates memory for the amount of elements requested while keeping the contents
 Contents are copied using their = operator so that data is correnctly instantiated.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Resize( int newsize, int newgranularity ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::Resize( int newsize, int newgranularity ) {
 	type	*temp;
+	int		oldsize;
 	int		i;
 
 	assert( newsize >= 0 );
@@ -414,20 +451,21 @@ ID_INLINE void idList<type>::Resize( int newsize, int newgranularity ) {
 	}
 
 	temp	= list;
+	oldsize	= size;
 	size	= newsize;
 	if ( size < num ) {
 		num = size;
 	}
 
 	// copy the old list into our new one
-	list = new type[ size ];
+	list = _allocator_::template Alloc<type>( size );
 	for( i = 0; i < num; i++ ) {
 		list[ i ] = temp[ i ];
 	}
 
 	// delete the old list if it exists
 	if ( temp ) {
-		delete[] temp;
+		_allocator_::Free( temp, oldsize );
 	}
 }
 
@@ -438,8 +476,8 @@ idList<type>::AssureSize
 Makes sure the list has at least the given number of elements.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSize( int newSize ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::AssureSize( int newSize ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -463,8 +501,8 @@ idList<type>::AssureSize
 Makes sure the list has at least the given number of elements and initialize any elements not yet initialized.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSize( int newSize, const type &initValue ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::AssureSize( int newSize, const type &initValue ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -496,8 +534,8 @@ NOTE: This function can only be called on lists containing pointers. Calling it
 on non-pointer lists will cause a compiler error.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSizeAlloc( int newSize, new_t *allocator ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::AssureSizeAlloc( int newSize, new_t *allocator ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -526,8 +564,8 @@ idList<type>::operator=
 Copies the contents and size attributes of another list.
 ================
 */
-template< class type >
-ID_INLINE idList<type> &idList<type>::operator=( const idList<type> &other ) {
+template< class type, class _allocator_ >
+ID_INLINE idList<type, _allocator_> &idList<type, _allocator_>::operator=( const idList<type, _allocator_> &other ) {
 	int	i;
 
 	Clear();
@@ -537,7 +575,7 @@ ID_INLINE idList<type> &idList<type>::operator=( const idList<type> &other ) {
 	granularity	= other.granularity;
 
 	if ( size ) {
-		list = new type[ size ];
+		list = _allocator_::template Alloc<type>( size );
 		for( i = 0; i < num; i++ ) {
 			list[ i ] = other.list[ i ];
 		}
@@ -554,8 +592,8 @@ Access operator.  Index must be within range or an assert will be issued in debu
 Release builds do no range checking.
 ================
 */
-template< class type >
-ID_INLINE const type &idList<type>::operator[]( int index ) const {
+template< class type, class _allocator_ >
+ID_INLINE const type &idList<type, _allocator_>::operator[]( int index ) const {
 	assert( index >= 0 );
 	assert( index < num );
 
@@ -570,8 +608,8 @@ Access operator.  Index must be within range or an assert will be issued in debu
 Release builds do no range checking.
 ================
 */
-template< class type >
-ID_INLINE type &idList<type>::operator[]( int index ) {
+template< class type, class _allocator_ >
+ID_INLINE type &idList<type, _allocator_>::operator[]( int index ) {
 	assert( index >= 0 );
 	assert( index < num );
 
@@ -589,8 +627,8 @@ Note: may return NULL if the list is empty.
 FIXME: Create an iterator template for this kind of thing.
 ================
 */
-template< class type >
-ID_INLINE type *idList<type>::Ptr( void ) {
+template< class type, class _allocator_ >
+ID_INLINE type *idList<type, _allocator_>::Ptr( void ) {
 	return list;
 }
 
@@ -605,8 +643,8 @@ Note: may return NULL if the list is empty.
 FIXME: Create an iterator template for this kind of thing.
 ================
 */
-template< class type >
-const ID_INLINE type *idList<type>::Ptr( void ) const {
+template< class type, class _allocator_ >
+const ID_INLINE type *idList<type, _allocator_>::Ptr( void ) const {
 	return list;
 }
 
@@ -617,8 +655,8 @@ idList<type>::Alloc
 Returns a reference to a new data element at the end of the list.
 ================
 */
-template< class type >
-ID_INLINE type &idList<type>::Alloc( void ) {
+template< class type, class _allocator_ >
+ID_INLINE type &idList<type, _allocator_>::Alloc( void ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -646,8 +684,8 @@ possible Resize() call, which will relocate the entire list. The reference
 to the "old" memory location will be invalid and crashes are ahead.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Append( type const & obj ) {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::Append( type const & obj ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -679,8 +717,8 @@ and inserts the supplied data into it.
 Returns the index of the new element.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Insert( type const & obj, int index ) {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::Insert( type const & obj, int index ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -718,8 +756,8 @@ adds the other list to this one
 Returns the size of the new combined list
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Append( const idList<type> &other ) {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::Append( const idList<type, _allocator_> &other ) {
 
 	// Tels: Old code, with quadratic (O(N*N) performance, it would call Resize
 	// 	 every so often, which is a O(N) copy operation.
@@ -761,8 +799,8 @@ idList<type>::AddUnique
 Adds the data to the list if it doesn't already exist.  Returns the index of the data in the list.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::AddUnique( type const & obj ) {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::AddUnique( type const & obj ) {
 	int index;
 
 	index = FindIndex( obj );
@@ -780,8 +818,8 @@ idList<type>::FindIndex
 Searches for the specified data in the list and returns it's index.  Returns -1 if the data is not found.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::FindIndex( type const & obj ) const {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::FindIndex( type const & obj ) const {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -801,8 +839,8 @@ idList<type>::Find
 Searches for the specified data in the list and returns it's address. Returns NULL if the data is not found.
 ================
 */
-template< class type >
-ID_INLINE type *idList<type>::Find( type const & obj ) const {
+template< class type, class _allocator_ >
+ID_INLINE type *idList<type, _allocator_>::Find( type const & obj ) const {
 	int i;
 
 	i = FindIndex( obj );
@@ -823,8 +861,8 @@ NOTE: This function can only be called on lists containing pointers. Calling it
 on non-pointer lists will cause a compiler error.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::FindNull( void ) const {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::FindNull( void ) const {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -847,8 +885,8 @@ Function will assert in debug builds if pointer is outside the bounds of the lis
 but remains silent in release builds.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::IndexOf( type const *objptr ) const {
+template< class type, class _allocator_ >
+ID_INLINE int idList<type, _allocator_>::IndexOf( type const *objptr ) const {
 	int index;
 
 	index = objptr - list;
@@ -868,8 +906,8 @@ The number of elements in the list is reduced by one.  Returns false if the inde
 Note that the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::RemoveIndex( int index ) {
+template< class type, class _allocator_ >
+ID_INLINE bool idList<type, _allocator_>::RemoveIndex( int index ) {
 	int i;
 
 	assert( list != NULL );
@@ -898,8 +936,8 @@ The number of elements in the list is reduced by one.  Returns false if the inde
 Note that the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::RemoveIndex( const int index, const bool keepSorted ) {
+template< class type, class _allocator_ >
+ID_INLINE bool idList<type, _allocator_>::RemoveIndex( const int index, const bool keepSorted ) {
 
 	assert( list != NULL );
 	assert( index >= 0 );
@@ -939,8 +977,8 @@ The number of elements in the list is reduced by one.  Returns false if the data
 the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::Remove( type const & obj ) {
+template< class type, class _allocator_ >
+ID_INLINE bool idList<type, _allocator_>::Remove( type const & obj ) {
 	int index;
 
 	index = FindIndex( obj );
@@ -959,8 +997,8 @@ Performs a qsort on the list using the supplied comparison function.  Note that
 list, so any pointers to data within the list may no longer be valid.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Sort( cmp_t *compare ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::Sort( cmp_t *compare ) {
 	if ( !list ) {
 		return;
 	}
@@ -977,8 +1015,8 @@ idList<type>::SortSubSection
 Sorts a subsection of the list.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SortSubSection( int startIndex, int endIndex, cmp_t *compare ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::SortSubSection( int startIndex, int endIndex, cmp_t *compare ) {
 	if ( !list ) {
 		return;
 	}
@@ -1004,8 +1042,8 @@ idList<type>::Swap
 Swaps the contents of two lists
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Swap( idList<type> &other ) {
+template< class type, class _allocator_ >
+ID_INLINE void idList<type, _allocator_>::Swap( idList<type, _allocator_> &other ) {
 	idSwap( num, other.num );
 	idSwap( size, other.size );
 	idSwap( granularity, other.granularity );
@@ -54,6 +54,22 @@ public:
 #define VPCALL
 #endif
 
+/*
+	A few hot loops outside of idSIMDProcessor use SSE2 intrinsics directly.
+	ID_SSE2_INTRINSICS is defined when the compiler can generate them, and
+	functions using them must be tagged ID_SSE2_FUNC so gcc accepts them
+	without -msse2. The code must still check SIMD_HasSSE2() at run time.
+*/
+#if defined( _MSC_VER ) && ( defined( _M_IX86 ) || defined( _M_X64 ) )
+	#define ID_SSE2_INTRINSICS
+	#define ID_SSE2_FUNC
+#elif defined( __GNUC__ ) && ( defined( __i386__ ) || defined( __x86_64__ ) ) && ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) )
+	#define ID_SSE2_INTRINSICS
+	#define ID_SSE2_FUNC __attribute__(( target( "sse2" ) ))
+#endif
+
+#define SIMD_HasSSE2()		( ( SIMDProcessor->cpuid & CPUID_SSE2 ) != 0 )
+
 class idVec2;
 class idVec3;
 class idVec4;
@@ -140,6 +140,18 @@ typedef enum {
 #define	MAX_IMAGE_NAME	256
 #define MIN_IMAGE_NAME  4
 
+const int MAX_IMAGE_LEVELS = 16;		// enough for a 32768 x 32768 image
+
+// the complete mip chain of a 2D image, built by idImage::PrepareImageLevels
+typedef struct {
+	int					numLevels;
+	byte *				data[MAX_IMAGE_LEVELS];
+	int					width[MAX_IMAGE_LEVELS];
+	int					height[MAX_IMAGE_LEVELS];
+	GLenum				internalFormat;
+	bool				isMonochrome;
+} imageLevels_t;
+
 class idImage {
 public:
 				idImage();
@@ -185,14 +197,17 @@ public:
 	// print a one line summary of the image
 	void		Print() const;
 
-	// check for changed timestamp on disk and reload if necessary
-	void		Reload( bool checkPrecompressed, bool force );
+	// check for changed timestamp on disk and reload if necessary,
+	// images from files are appended to deferredLoads instead if given
+	void		Reload( bool checkPrecompressed, bool force, idList<idImage *> *deferredLoads = NULL );
 
 	void		AddReference()				{ refCount++; };
 
 //==========================================================
 
 	void		GetDownsize( int &scaled_width, int &scaled_height ) const;
+	void		PrepareImageLevels( const byte *pic, int width, int height, imageLevels_t &levels ) const;
+	void		UploadImageLevels( imageLevels_t &levels );
 	void		MakeDefault();	// fill with a grid pattern
 	void		SetImageFilterAndRepeat() const;
 	bool		ShouldImageBePartialCached();
@@ -246,6 +261,11 @@ public:
 	int					uploadWidth, uploadHeight, uploadDepth;	// after power of two, downsample, and MAX_TEXTURE_SIZE
 	int					internalFormat;
 
+	// load timings of the last load for listImages timings, in milliseconds
+	float				decodeMsec;				// file decode, power of two resample and hashing
+	float				mipMsec;				// downsizing and mip map generation
+	float				uploadMsec;				// GL upload of all levels, or of the whole precompressed file
+
 	idImage 			*cacheUsagePrev, *cacheUsageNext;	// for dynamic cache purging of old images
 
 	idImage *			hashNext;				// for hash chains to speed lookup
@@ -279,6 +299,7 @@ ID_INLINE idImage::idImage() {
 	bindCount = 0;
 	uploadWidth = uploadHeight = uploadDepth = 0;
 	internalFormat = 0;
+	decodeMsec = mipMsec = uploadMsec = 0.0f;
 	cacheUsagePrev = cacheUsageNext = NULL;
 	hashNext = NULL;
 	isMonochrome = false;
@@ -316,6 +337,10 @@ public:
 	// The callback function should call one of the idImage::Generate* functions to fill in the data
 	idImage *			ImageFromFunction( const char *name, void (*generatorFunction)( idImage *image ));
 
+	// Loads the given images, decoding and mip mapping plain .tga and .jpg files
+	// on the job pool while the main thread reads files and uploads to GL.
+	void				ActuallyLoadImages( idImage **list, int num, bool checkForPrecompressed );
+
 	// called once a frame to allow any background loads that have been completed
 	// to turn into textures.
 	void				CompleteBackgroundImageLoads();
@@ -384,6 +409,7 @@ public:
 	static idCVar		image_downSizeBumpLimit;	// downsize bump limit
 	static idCVar		image_ignoreHighQuality;	// ignore high quality on materials
 	static idCVar		image_downSizeLimit;		// downsize diffuse limit
+	static idCVar		image_parallelLoad;			// decode and mip map images on the job pool
 
 	// built-in images
 	idImage *			defaultImage;
@@ -459,6 +485,7 @@ byte *R_ResampleTexture( const byte *in, int inwidth, int inheight,
 byte *R_MipMapWithAlphaSpecularity( const byte *in, int width, int height );
 byte *R_MipMap( const byte *in, int width, int height, bool preserveBorder );
 byte *R_MipMap3D( const byte *in, int width, int height, int depth, bool preserveBorder );
+void R_FreeImageLevels( imageLevels_t &levels );
 
 // these operate in-place on the provided pixels
 void R_SetBorderTexels( byte *inBase, int width, int height, const byte border[4] );
@@ -477,6 +504,16 @@ IMAGEFILES
 */
 
 void R_LoadImage( const char *name, byte **pic, int *width, int *height, ID_TIME_T *timestamp, bool makePowerOf2 );
+
+// R_LoadImage split up for parallel loading: the file is read on the main thread,
+// the decode functions don't touch the file system or the console and can run on
+// job pool workers. R_ReadImageFile returns false if the name isn't a plain .tga or
+// .jpg file, *buffer is NULL if the file couldn't be found; free it with Mem_Free.
+bool R_ReadImageFile( const char *name, byte **buffer, int *length, bool *isJPG, ID_TIME_T *timestamp );
+const char *R_DecodeTGA( const byte *buffer, int fileSize, byte **pic, int *width, int *height );
+int R_DecodeJPG( byte *buffer, int length, byte **pic, int *width, int *height );
+void R_ResampleToPowerOfTwo( byte **pic, int *width, int *height );
+
 // pic is in top to bottom raster format
 bool R_LoadCubeImages( const char *cname, cubeFiles_t extensions, byte *pic[6], int *size, ID_TIME_T *timestamp );
 
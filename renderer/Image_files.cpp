@@ -543,33 +543,21 @@ TARGA LOADING
 
 /*
 =============
-LoadTGA
+R_DecodeTGA
+
+Returns NULL on success, or the reason the file couldn't be decoded.
 =============
 */
-static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_TIME_T *timestamp ) {
-	int		columns, rows, numPixels, fileSize, numBytes;
+const char *R_DecodeTGA( const byte *buffer, int fileSize, byte **pic, int *width, int *height ) {
+	int		columns, rows, numPixels, numBytes;
 	byte	*pixbuf;
 	int		row, column;
-	byte	*buf_p;
-	byte	*buffer;
+	const byte	*buf_p;
 	TargaHeader	targa_header;
 	byte		*targa_rgba;
 
-	if ( !pic ) {
-		fileSystem->ReadFile( name, NULL, timestamp );
-		return;	// just getting timestamp
-	}
-
 	*pic = NULL;
 
-	//
-	// load the file
-	//
-	fileSize = fileSystem->ReadFile( name, (void **)&buffer, timestamp );
-	if ( !buffer ) {
-		return;
-	}
-
 	buf_p = buffer;
 
 	targa_header.id_length = *buf_p++;
@@ -593,24 +581,29 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 	targa_header.attributes = *buf_p++;
 
 	if ( targa_header.image_type != 2 && targa_header.image_type != 10 && targa_header.image_type != 3 ) {
-		common->Error( "LoadTGA( %s ): Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported\n", name );
+		return "Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported";
 	}
 
 	if ( targa_header.colormap_type != 0 ) {
-		common->Error( "LoadTGA( %s ): colormaps not supported\n", name );
+		return "colormaps not supported";
 	}
 
 	if ( ( targa_header.pixel_size != 32 && targa_header.pixel_size != 24 ) && targa_header.image_type != 3 ) {
-		common->Error( "LoadTGA( %s ): Only 32 or 24 bit images supported (no colormaps)\n", name );
+		return "Only 32 or 24 bit images supported (no colormaps)";
 	}
 
 	if ( targa_header.image_type == 2 || targa_header.image_type == 3 ) {
 		numBytes = targa_header.width * targa_header.height * ( targa_header.pixel_size >> 3 );
 		if ( numBytes > fileSize - 18 - targa_header.id_length ) {
-			common->Error( "LoadTGA( %s ): incomplete file\n", name );
+			return "incomplete file";
 		}
 	}
 
+	// checked up front, so there is no partially decoded image to clean up
+	if ( targa_header.pixel_size != 8 && targa_header.pixel_size != 24 && targa_header.pixel_size != 32 ) {
+		return "illegal pixel_size";
+	}
+
 	columns = targa_header.width;
 	rows = targa_header.height;
 	numPixels = columns * rows;
@@ -670,9 +663,6 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 					*pixbuf++ = blue;
 					*pixbuf++ = alphabyte;
 					break;
-				default:
-					common->Error( "LoadTGA( %s ): illegal pixel_size '%d'\n", name, targa_header.pixel_size );
-					break;
 				}
 			}
 		}
@@ -704,9 +694,6 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 								red = *buf_p++;
 								alphabyte = *buf_p++;
 								break;
-						default:
-							common->Error( "LoadTGA( %s ): illegal pixel_size '%d'\n", name, targa_header.pixel_size );
-							break;
 					}
 	
 					for( j = 0; j < packetSize; j++ ) {
@@ -749,9 +736,6 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 									*pixbuf++ = blue;
 									*pixbuf++ = alphabyte;
 									break;
-							default:
-								common->Error( "LoadTGA( %s ): illegal pixel_size '%d'\n", name, targa_header.pixel_size );
-								break;
 						}
 						column++;
 						if ( column == columns ) { // pixel packet run spans across rows
@@ -772,10 +756,43 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 	}
 
 	if ( (targa_header.attributes & (1<<5)) ) {			// image flp bit
-		R_VerticalFlip( *pic, *width, *height );
+		R_VerticalFlip( *pic, columns, rows );
+	}
+
+	return NULL;
+}
+
+/*
+=============
+LoadTGA
+=============
+*/
+static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_TIME_T *timestamp ) {
+	int		fileSize;
+	byte	*buffer;
+
+	if ( !pic ) {
+		fileSystem->ReadFile( name, NULL, timestamp );
+		return;	// just getting timestamp
+	}
+
+	*pic = NULL;
+
+	//
+	// load the file
+	//
+	fileSize = fileSystem->ReadFile( name, (void **)&buffer, timestamp );
+	if ( !buffer ) {
+		return;
 	}
 
+	const char *error = R_DecodeTGA( buffer, fileSize, pic, width, height );
+
 	fileSystem->FreeFile( buffer );
+
+	if ( error ) {
+		common->Error( "LoadTGA( %s ): %s\n", name, error );
+	}
 }
 
 /*
@@ -833,18 +850,19 @@ static void jpeg_mem_src (j_decompress_ptr cinfo, void* buffer, long nbytes)
 
 /*
 =============
-LoadJPG
+R_DecodeJPG
+
+JDC: because fill_input_buffer() blindly copies INPUT_BUF_SIZE bytes,
+the buffer must be padded with 4096 zero bytes past length or it may crash.
+
+Returns the number of color components in the file, which is expected to be 4.
 =============
 */
-static void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height, ID_TIME_T *timestamp ) {
+int R_DecodeJPG( byte *fbuffer, int len, byte **pic, int *width, int *height ) {
   /* This struct contains the JPEG decompression parameters and pointers to
    * working space (which is allocated as needed by the JPEG library).
    */
   struct jpeg_decompress_struct cinfo;
-  /* We use our private extension JPEG error handler.
-   * Note that this struct must live as long as the main JPEG parameter
-   * struct, to avoid dangling-pointer problems.
-   */
   /* This struct represents a JPEG error handler.  It is declared separately
    * because applications often want to supply a specialized error handler
    * (see the second half of this file for an example).  But here we just
@@ -857,47 +875,9 @@ static void LoadJPG( const char *filename, unsigned char **pic, int *width, int
   /* More stuff */
   JSAMPARRAY buffer;		/* Output row buffer */
   int row_stride;		/* physical row width in output buffer */
-  int		len;		/* Buffer length */
   unsigned char *out;
-  byte	*fbuffer;
   byte  *bbuf;
-
-  /* In this example we want to open the input file before doing anything else,
-   * so that the setjmp() error recovery below can assume the file is open.
-   * VERY IMPORTANT: use "b" option to fopen() if you are on a machine that
-   * requires it in order to read binary files.
-   */
-
-	// JDC: because fill_input_buffer() blindly copies INPUT_BUF_SIZE bytes,
-	// we need to make sure the file buffer is padded or it may crash
-  if ( pic ) {
-	*pic = NULL;		// until proven otherwise
-  }
-  {
-		idFile *f;
-
-		f = fileSystem->OpenFileRead( filename );
-		if ( !f ) {
-			return;
-		}
-		len = f->Length();
-		if ( timestamp ) {
-			*timestamp = f->Timestamp();
-		}
-		if ( !pic ) {
-			fileSystem->CloseFile( f );
-			return;	// just getting timestamp
-		}
-	  	if ( len == 0 ) {
-			fileSystem->CloseFile( f );
-			return;	// angua: image file is empty, just getting timestamp
-		}
-
-		fbuffer = (byte *)Mem_ClearedAlloc( len + 4096 );
-		f->Read( fbuffer, len );
-		fileSystem->CloseFile( f );
-  }
-
+  int components;
 
   /* Step 1: allocate and initialize JPEG decompression object */
 
@@ -945,11 +925,8 @@ static void LoadJPG( const char *filename, unsigned char **pic, int *width, int
    */ 
   /* JSAMPLEs per row in output buffer */
   row_stride = cinfo.output_width * cinfo.output_components;
+  components = cinfo.output_components;
 
-  if (cinfo.output_components!=4) {
-		common->DWarning( "JPG %s is unsupported color depth (%d)", 
-			filename, cinfo.output_components);
-  }
   out = (byte *)R_StaticAlloc(cinfo.output_width*cinfo.output_height*4);
 
   *pic = out;
@@ -997,18 +974,170 @@ static void LoadJPG( const char *filename, unsigned char **pic, int *width, int
   /* This is an important step since it will release a good deal of memory. */
   jpeg_destroy_decompress(&cinfo);
 
-  /* After finish_decompress, we can close the input file.
-   * Here we postpone it until after no more JPEG errors are possible,
-   * so as to simplify the setjmp error logic above.  (Actually, I don't
-   * think that jpeg_destroy can do an error exit, but why assume anything...)
-   */
-  Mem_Free( fbuffer );
-
   /* At this point you may want to check to see whether any corrupt-data
    * warnings occurred (test whether jerr.pub.num_warnings is nonzero).
    */
 
   /* And we're done! */
+  return components;
+}
+
+/*
+=============
+LoadJPG
+=============
+*/
+static void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height, ID_TIME_T *timestamp ) {
+	int		len;
+	byte	*fbuffer;
+
+	if ( pic ) {
+		*pic = NULL;		// until proven otherwise
+	}
+
+	idFile *f = fileSystem->OpenFileRead( filename );
+	if ( !f ) {
+		return;
+	}
+	len = f->Length();
+	if ( timestamp ) {
+		*timestamp = f->Timestamp();
+	}
+	if ( !pic ) {
+		fileSystem->CloseFile( f );
+		return;	// just getting timestamp
+	}
+	if ( len == 0 ) {
+		fileSystem->CloseFile( f );
+		return;	// angua: image file is empty, just getting timestamp
+	}
+
+	// JDC: because fill_input_buffer() blindly copies INPUT_BUF_SIZE bytes,
+	// we need to make sure the file buffer is padded or it may crash
+	fbuffer = (byte *)Mem_ClearedAlloc( len + 4096 );
+	f->Read( fbuffer, len );
+	fileSystem->CloseFile( f );
+
+	int components = R_DecodeJPG( fbuffer, len, pic, width, height );
+	if ( components != 4 ) {
+		common->DWarning( "JPG %s is unsupported color depth (%d)", filename, components );
+	}
+
+	Mem_Free( fbuffer );
+}
+
+/*
+=================
+R_ReadImageFile
+
+The file reading half of R_LoadImage for plain .tga and .jpg files, the rest
+is done by R_DecodeTGA / R_DecodeJPG and R_ResampleToPowerOfTwo.
+
+Returns false if the name is anything else, so the caller has to go through
+R_LoadImage. Returns true with *buffer == NULL if the file couldn't be found.
+The buffer is padded for R_DecodeJPG and must be freed with Mem_Free.
+=================
+*/
+bool R_ReadImageFile( const char *cname, byte **buffer, int *length, bool *isJPG, ID_TIME_T *timestamp ) {
+	idStr name = cname;
+	idStr ext;
+
+	*buffer = NULL;
+	*length = 0;
+	*isJPG = false;
+	if ( timestamp ) {
+		*timestamp = 0xFFFFFFFF;
+	}
+
+	name.DefaultFileExtension( ".tga" );
+	if ( name.Length() < 5 ) {
+		return false;
+	}
+
+	name.ToLower();
+	name.ExtractFileExtension( ext );
+
+	if ( ext == "tga" ) {
+		idFile *f = fileSystem->OpenFileRead( name );
+		if ( !f ) {
+			// try a jpg with the same name, like R_LoadImage
+			name.StripFileExtension();
+			name.DefaultFileExtension( ".jpg" );
+			f = fileSystem->OpenFileRead( name );
+			*isJPG = true;
+		}
+		if ( !f ) {
+			return true;
+		}
+		*length = f->Length();
+		if ( timestamp ) {
+			*timestamp = f->Timestamp();
+		}
+		if ( *length > 0 ) {
+			*buffer = (byte *)Mem_Alloc( *length + 4096 );
+			f->Read( *buffer, *length );
+			memset( *buffer + *length, 0, 4096 );
+		}
+		fileSystem->CloseFile( f );
+		return true;
+	}
+
+	if ( ext == "jpg" ) {
+		idFile *f = fileSystem->OpenFileRead( name );
+		*isJPG = true;
+		if ( !f ) {
+			return true;
+		}
+		*length = f->Length();
+		if ( timestamp ) {
+			*timestamp = f->Timestamp();
+		}
+		if ( *length > 0 ) {
+			*buffer = (byte *)Mem_Alloc( *length + 4096 );
+			f->Read( *buffer, *length );
+			memset( *buffer + *length, 0, 4096 );
+		}
+		fileSystem->CloseFile( f );
+		return true;
+	}
+
+	return false;
+}
+
+/*
+=================
+R_ResampleToPowerOfTwo
+
+Converts to exact power of 2 sizes, honoring image_roundDown.
+=================
+*/
+void R_ResampleToPowerOfTwo( byte **pic, int *width, int *height ) {
+	int		w, h;
+	int		scaled_width, scaled_height;
+	byte	*resampledBuffer;
+
+	w = *width;
+	h = *height;
+
+	for (scaled_width = 1 ; scaled_width < w ; scaled_width<<=1)
+		;
+	for (scaled_height = 1 ; scaled_height < h ; scaled_height<<=1)
+		;
+
+	if ( scaled_width != w || scaled_height != h ) {
+		if ( globalImages->image_roundDown.GetBool() && scaled_width > w ) {
+			scaled_width >>= 1;
+		}
+		if ( globalImages->image_roundDown.GetBool() && scaled_height > h ) {
+			scaled_height >>= 1;
+		}
+
+		resampledBuffer = R_ResampleTexture( *pic, w, h, scaled_width, scaled_height );
+		R_StaticFree( *pic );
+		*pic = resampledBuffer;
+		*width = scaled_width;
+		*height = scaled_height;
+	}
 }
 
 //===================================================================
@@ -1089,32 +1218,7 @@ void R_LoadImage( const char *cname, byte **pic, int *width, int *height, ID_TIM
 	// convert to exact power of 2 sizes
 	//
 	if ( pic && *pic && makePowerOf2 ) {
-		int		w, h;
-		int		scaled_width, scaled_height;
-		byte	*resampledBuffer;
-
-		w = *width;
-		h = *height;
-
-		for (scaled_width = 1 ; scaled_width < w ; scaled_width<<=1)
-			;
-		for (scaled_height = 1 ; scaled_height < h ; scaled_height<<=1)
-			;
-
-		if ( scaled_width != w || scaled_height != h ) {
-			if ( globalImages->image_roundDown.GetBool() && scaled_width > w ) {
-				scaled_width >>= 1;
-			}
-			if ( globalImages->image_roundDown.GetBool() && scaled_height > h ) {
-				scaled_height >>= 1;
-			}
-
-			resampledBuffer = R_ResampleTexture( *pic, w, h, scaled_width, scaled_height );
-			R_StaticFree( *pic );
-			*pic = resampledBuffer;
-			*width = scaled_width;
-			*height = scaled_height;
-		}
+		R_ResampleToPowerOfTwo( pic, width, height );
 	}
 }
 
@@ -70,6 +70,7 @@ idCVar idImageManager::image_downSizeSpecularLimit( "image_downSizeSpecularLimit
 idCVar idImageManager::image_downSizeBumpLimit( "image_downSizeBumpLimit", "128", CVAR_RENDERER | CVAR_ARCHIVE, "controls normal map downsample limit" );
 idCVar idImageManager::image_ignoreHighQuality( "image_ignoreHighQuality", "0", CVAR_RENDERER | CVAR_ARCHIVE, "ignore high quality setting on materials" );
 idCVar idImageManager::image_downSizeLimit( "image_downSizeLimit", "256", CVAR_RENDERER | CVAR_ARCHIVE, "controls diffuse map downsample limit" ); 
+idCVar idImageManager::image_parallelLoad( "image_parallelLoad", "1", CVAR_RENDERER | CVAR_BOOL, "decode and mip map .tga/.jpg images on the job pool threads" );
 // do this with a pointer, in case we want to make the actual manager
 // a private virtual subclass
 idImageManager	imageManager;
@@ -973,7 +974,7 @@ void idImageManager::ChangeTextureFilter( void ) {
 idImage::Reload
 ===============
 */
-void idImage::Reload( bool checkPrecompressed, bool force ) {
+void idImage::Reload( bool checkPrecompressed, bool force, idList<idImage *> *deferredLoads ) {
 
 	// always regenerate functional images
 	if ( generatorFunction ) {
@@ -998,6 +999,12 @@ void idImage::Reload( bool checkPrecompressed, bool force ) {
 
 	PurgeImage();
 
+	// let the caller load them all at once with idImageManager::ActuallyLoadImages
+	if ( deferredLoads ) {
+		deferredLoads->Append( this );
+		return;
+	}
+
 	// force no precompressed image check, which will cause it to be reloaded
 	// from source, and another precompressed file generated.
 	// Load is from the front end, so the back end must be synced
@@ -1037,9 +1044,25 @@ void R_ReloadImages_f( const idCmdArgs &args ) {
 		}
 	}
 
+	const int start = Sys_Milliseconds();
+	idList<idImage *> reloaded;
+
 	for ( int i = 0 ; i < globalImages->images.Num() ; i++ ) {
 		image = globalImages->images[ i ];
-		image->Reload( checkPrecompressed, all );
+		image->Reload( checkPrecompressed, all, &reloaded );
+	}
+
+	globalImages->ActuallyLoadImages( reloaded.Ptr(), reloaded.Num(), checkPrecompressed );
+
+	if ( reloaded.Num() ) {
+		float decodeMsec = 0.0f, mipMsec = 0.0f, uploadMsec = 0.0f;
+		for ( int i = 0 ; i < reloaded.Num() ; i++ ) {
+			decodeMsec += reloaded[ i ]->decodeMsec;
+			mipMsec += reloaded[ i ]->mipMsec;
+			uploadMsec += reloaded[ i ]->uploadMsec;
+		}
+		common->Printf( "%i images reloaded in %i msec (decode %.0f, mip %.0f, upload %.0f msec summed over all threads)\n",
+			reloaded.Num(), Sys_Milliseconds() - start, decodeMsec, mipMsec, uploadMsec );
 	}
 
 	if ( game ) {
@@ -1094,6 +1117,7 @@ void R_ListImages_f( const idCmdArgs &args ) {
 	bool	duplicated = false;
 	bool	byClassification = false;
 	bool	overSized = false;
+	bool	timings = false;
 
 	if ( args.Argc() == 1 ) {
 
@@ -1123,6 +1147,8 @@ void R_ListImages_f( const idCmdArgs &args ) {
 			byClassification = true;
 			sorted = true;
 			overSized = true;
+		} else if ( idStr::Icmp( args.Argv( 1 ), "timings" ) == 0 ) {
+			timings = true;
 		} else {
 			failed = true;
 		}
@@ -1131,7 +1157,26 @@ void R_ListImages_f( const idCmdArgs &args ) {
 	}
 
 	if ( failed ) {
-		common->Printf( "usage: listImages [ sorted | partial | unloaded | cached | uncached | tagged | duplicated | touched | classify | showOverSized ]\n" );
+		common->Printf( "usage: listImages [ sorted | partial | unloaded | cached | uncached | tagged | duplicated | touched | classify | showOverSized | timings ]\n" );
+		return;
+	}
+
+	if ( timings ) {
+		float decodeMsec = 0.0f, mipMsec = 0.0f, uploadMsec = 0.0f;
+
+		common->Printf( "\n      decode     mip  upload --name-------\n" );
+		for ( i = 0 ; i < globalImages->images.Num() ; i++ ) {
+			image = globalImages->images[ i ];
+			if ( image->texnum == idImage::TEXTURE_NOT_LOADED || image->generatorFunction ) {
+				continue;
+			}
+			common->Printf( "%4i: %7.2f %7.2f %7.2f %s\n", i, image->decodeMsec, image->mipMsec, image->uploadMsec, image->imgName.c_str() );
+			decodeMsec += image->decodeMsec;
+			mipMsec += image->mipMsec;
+			uploadMsec += image->uploadMsec;
+			count++;
+		}
+		common->Printf( " %i images, %.1f msec decode, %.1f msec mip, %.1f msec upload\n\n", count, decodeMsec, mipMsec, uploadMsec );
 		return;
 	}
 
@@ -1737,7 +1782,7 @@ void idImage::StartBackgroundImageLoad() {
 	}
 	bgl.file.position = 0;
 	bgl.file.length = bgl.f->Length();
-	if ( bgl.file.length < sizeof( ddsFileHeader_t ) ) {
+	if ( bgl.file.length < (int)sizeof( ddsFileHeader_t ) ) {
 		common->Warning( "idImageManager::StartBackgroundImageLoad: %s had a bad file length", imgName.c_str() );
 		return;
 	}
@@ -1958,6 +2003,184 @@ void idImageManager::BeginLevelLoad() {
 	}
 }
 
+typedef struct {
+	idImage *			image;
+	byte *				buffer;
+	int					length;
+	bool				isJPG;
+	ID_TIME_T			timestamp;
+
+	const char *		error;					// TGA decode error
+	int					components;				// JPG color components
+	int					imageHash;
+	imageLevels_t		levels;
+	float				decodeMsec;
+	float				mipMsec;
+} imageLoadJob_t;
+
+/*
+====================
+R_ImageLoadJob
+
+Decodes one image file read by idImageManager::ActuallyLoadImages
+and builds its mip chain. Runs on the job pool.
+====================
+*/
+static void R_ImageLoadJob( void *data, int index ) {
+	imageLoadJob_t &job = ( (imageLoadJob_t *)data )[ index ];
+	byte	*pic = NULL;
+	int		width, height;
+	idTimer	timer;
+
+	timer.Start();
+	if ( job.isJPG ) {
+		job.components = R_DecodeJPG( job.buffer, job.length, &pic, &width, &height );
+	} else {
+		job.error = R_DecodeTGA( job.buffer, job.length, &pic, &width, &height );
+	}
+	Mem_Free( job.buffer );
+	job.buffer = NULL;
+
+	if ( pic == NULL ) {
+		return;
+	}
+
+	// same as R_LoadImage, the upload makes it the default image
+	if ( width < 1 || height < 1 ) {
+		R_StaticFree( pic );
+		return;
+	}
+
+	R_ResampleToPowerOfTwo( &pic, &width, &height );
+	job.imageHash = MD4_BlockChecksum( pic, width * height * 4 );
+	timer.Stop();
+	job.decodeMsec = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	job.image->PrepareImageLevels( pic, width, height, job.levels );
+	timer.Stop();
+	job.mipMsec = timer.Milliseconds();
+
+	R_StaticFree( pic );
+}
+
+/*
+====================
+R_FinishImageLoadJob
+
+Uploads the result of R_ImageLoadJob, on the main thread.
+====================
+*/
+static void R_FinishImageLoadJob( imageLoadJob_t &job ) {
+	idImage *image = job.image;
+
+	if ( job.error ) {
+		common->Error( "LoadTGA( %s ): %s\n", image->imgName.c_str(), job.error );
+	}
+	if ( job.isJPG && job.levels.numLevels && job.components != 4 ) {
+		common->DWarning( "JPG %s is unsupported color depth (%d)", image->imgName.c_str(), job.components );
+	}
+
+	image->timestamp = job.timestamp;
+
+	if ( job.levels.numLevels == 0 ) {
+		common->Warning( "Couldn't load image: %s", image->imgName.c_str() );
+		image->MakeDefault();
+		return;
+	}
+
+	image->PurgeImage();
+	image->UploadImageLevels( job.levels );
+	image->decodeMsec = job.decodeMsec;
+	image->mipMsec = job.mipMsec;
+	image->imageHash = job.imageHash;
+	image->precompressedFile = false;
+
+	// write out the precompressed version of this file if needed
+	image->WritePrecompressedImage();
+}
+
+/*
+====================
+ActuallyLoadImages
+
+Same as calling idImage::ActuallyLoadImage on each image, but plain .tga and .jpg
+files are decoded and mip mapped on the job pool. The main thread reads the files
+in order, then uploads the finished images in order, a batch at a time to keep
+the memory for decoded images bounded. Everything else is loaded serially.
+====================
+*/
+void idImageManager::ActuallyLoadImages( idImage **list, int num, bool checkForPrecompressed ) {
+	// image_writeTGA writes files from the middle of the mip generation
+	if ( num < 2 || jobPool.GetNumThreads() == 0 || !glConfig.isInitialized || !image_parallelLoad.GetBool()
+			|| image_writeTGA.GetBool() || image_writeNormalTGA.GetBool() ) {
+		for ( int i = 0 ; i < num ; i++ ) {
+			list[i]->ActuallyLoadImage( checkForPrecompressed, false );
+		}
+		return;
+	}
+
+	const int batchSize = 2 * ( jobPool.GetNumThreads() + 1 );
+	imageLoadJob_t *jobs = (imageLoadJob_t *)Mem_Alloc( batchSize * sizeof( jobs[0] ) );
+	int numJobs = 0;
+	idTimer timer;
+
+	for ( int i = 0 ; i < num ; i++ ) {
+		idImage *image = list[i];
+
+		if ( image->generatorFunction || image->isPartialImage || image->cubeFiles != CF_2D || strchr( image->imgName.c_str(), '(' ) ) {
+			image->ActuallyLoadImage( checkForPrecompressed, false );
+			continue;
+		}
+
+		if ( checkForPrecompressed && image_usePrecompressedTextures.GetBool() ) {
+			timer.Clear();
+			timer.Start();
+			bool loaded = image->CheckPrecompressedImage( true );
+			timer.Stop();
+			if ( loaded ) {
+				image->decodeMsec = image->mipMsec = 0.0f;
+				image->uploadMsec = timer.Milliseconds();
+				continue;
+			}
+		}
+
+		imageLoadJob_t &job = jobs[numJobs];
+		memset( &job, 0, sizeof( job ) );
+		job.image = image;
+		if ( !R_ReadImageFile( image->imgName, &job.buffer, &job.length, &job.isJPG, &job.timestamp ) ) {
+			// not a plain .tga or .jpg, the precompressed image was already checked for
+			image->ActuallyLoadImage( false, false );
+			continue;
+		}
+		if ( job.buffer == NULL ) {
+			image->timestamp = job.timestamp;
+			common->Warning( "Couldn't load image: %s", image->imgName.c_str() );
+			image->MakeDefault();
+			continue;
+		}
+
+		jobPool.AddJob( R_ImageLoadJob, jobs, numJobs );
+		numJobs++;
+
+		if ( numJobs == batchSize ) {
+			jobPool.Wait();
+			for ( int j = 0 ; j < numJobs ; j++ ) {
+				R_FinishImageLoadJob( jobs[j] );
+			}
+			numJobs = 0;
+		}
+	}
+
+	jobPool.Wait();
+	for ( int j = 0 ; j < numJobs ; j++ ) {
+		R_FinishImageLoadJob( jobs[j] );
+	}
+
+	Mem_Free( jobs );
+}
+
 /*
 ====================
 EndLevelLoad
@@ -2002,6 +2225,7 @@ void idImageManager::EndLevelLoad() {
 	}
 
 	// load the ones we do need, if we are preloading
+	idList<idImage *> loadList;
 	for ( int i = 0 ; i < images.Num() ; i++ ) {
 		idImage	*image = images[ i ];
 		if ( image->generatorFunction ) {
@@ -2011,14 +2235,16 @@ void idImageManager::EndLevelLoad() {
 		if ( image->levelLoadReferenced && image->texnum == idImage::TEXTURE_NOT_LOADED && !image->partialImage ) {
 //			common->Printf( "Loading %s\n", image->imgName.c_str() );
 			loadCount++;
-			image->ActuallyLoadImage( true, false );
-
-			if ( ( loadCount & 15 ) == 0 ) {
-				session->PacifierUpdate();
-			}
+			loadList.Append( image );
 		}
 	}
 
+	// keep the pacifier going between batches
+	for ( int i = 0 ; i < loadList.Num() ; i += 64 ) {
+		ActuallyLoadImages( loadList.Ptr() + i, Min( 64, loadList.Num() - i ), true );
+		session->PacifierUpdate();
+	}
+
 	const int end = Sys_Milliseconds();
 	common->Printf( "%5i purged from previous\n", purgeCount );
 	common->Printf( "%5i kept from previous\n", keepCount );
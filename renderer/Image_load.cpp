@@ -491,10 +491,8 @@ There is no way to specify explicit mip map levels
 void idImage::GenerateImage( const byte *pic, int width, int height, 
 					   textureFilter_t filterParm, bool allowDownSizeParm, 
 					   textureRepeat_t repeatParm, textureDepth_t depthParm ) {
-	bool		preserveBorder;
-	byte		*scaledBuffer;
-	int			scaled_width, scaled_height;
-	byte		*shrunk;
+	imageLevels_t	levels;
+	idTimer			timer;
 
 	PurgeImage();
 
@@ -511,6 +509,32 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 		return;
 	}
 
+	timer.Start();
+	PrepareImageLevels( pic, width, height, levels );
+	timer.Stop();
+	mipMsec = timer.Milliseconds();
+
+	UploadImageLevels( levels );
+}
+
+/*
+================
+PrepareImageLevels
+
+The CPU side of GenerateImage: selects the internal format, downsizes to the
+upload size and builds the complete mip chain. Nothing here touches GL, so
+this can run on a job pool worker while the main thread uploads other images,
+as long as image_writeTGA / image_writeNormalTGA are off.
+================
+*/
+void idImage::PrepareImageLevels( const byte *pic, int width, int height, imageLevels_t &levels ) const {
+	bool		preserveBorder;
+	byte		*scaledBuffer;
+	int			scaled_width, scaled_height;
+	byte		*shrunk;
+
+	memset( &levels, 0, sizeof( levels ) );
+
 	// don't let mip mapping smear the texture into the clamped border
 	if ( repeat == TR_CLAMP_TO_ZERO ) {
 		preserveBorder = true;
@@ -531,11 +555,8 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 
 	scaledBuffer = NULL;
 
-	// generate the texture number
-	qglGenTextures( 1, &texnum );
-
 	// select proper internal format before we resample
-	internalFormat = SelectInternalFormat( &pic, 1, width, height, depth, &isMonochrome );
+	levels.internalFormat = SelectInternalFormat( &pic, 1, width, height, depth, &levels.isMonochrome );
 
 	// copy or resample data as appropriate for first MIP level
 	if ( ( scaled_width == width ) && ( scaled_height == height ) ) {
@@ -576,10 +597,6 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 		scaled_height = height;
 	}
 
-	uploadHeight = scaled_height;
-	uploadWidth = scaled_width;
-	type = TT_2D;
-
 	// zero the border if desired, allowing clamped projection textures
 	// even after picmip resampling or careless artists.
 	if ( repeat == TR_CLAMP_TO_ZERO ) {
@@ -638,33 +655,16 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 			scaledBuffer[ i ] = 0;
 		}
 	}
-	// upload the main image level
-	Bind();
 
+	levels.data[0] = scaledBuffer;
+	levels.width[0] = scaled_width;
+	levels.height[0] = scaled_height;
+	levels.numLevels = 1;
 
-	if ( internalFormat == GL_COLOR_INDEX8_EXT ) {
-		/*
-		if ( depth == TD_BUMP ) {
-			for ( int i = 0; i < scaled_width * scaled_height * 4; i += 4 ) {
-				scaledBuffer[ i ] = scaledBuffer[ i + 3 ];
-				scaledBuffer[ i + 3 ] = 0;
-			}
-		}
-		*/
-		UploadCompressedNormalMap( scaled_width, scaled_height, scaledBuffer, 0 );
-	} else {
-		qglTexImage2D( GL_TEXTURE_2D, 0, internalFormat, scaled_width, scaled_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, scaledBuffer );
-	}
-
-	// create and upload the mip map levels, which we do in all cases, even if we don't think they are needed
-	int		miplevel;
-
-	miplevel = 0;
-	while ( scaled_width > 1 || scaled_height > 1 ) {
+	// create the mip map levels, which we do in all cases, even if we don't think they are needed
+	while ( ( scaled_width > 1 || scaled_height > 1 ) && levels.numLevels < MAX_IMAGE_LEVELS ) {
 		// preserve the border after mip map unless repeating
-		shrunk = R_MipMap( scaledBuffer, scaled_width, scaled_height, preserveBorder );
-		R_StaticFree( scaledBuffer );
-		scaledBuffer = shrunk;
+		scaledBuffer = R_MipMap( scaledBuffer, scaled_width, scaled_height, preserveBorder );
 
 		scaled_width >>= 1;
 		scaled_height >>= 1;
@@ -674,28 +674,65 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 		if ( scaled_height < 1 ) {
 			scaled_height = 1;
 		}
-		miplevel++;
 
 		// this is a visualization tool that shades each mip map
 		// level with a different color so you can see the
 		// rasterizer's texture level selection algorithm
 		// Changing the color doesn't help with lumminance/alpha/intensity formats...
 		if ( depth == TD_DIFFUSE && globalImages->image_colorMipLevels.GetBool() ) {
-			R_BlendOverTexture( (byte *)scaledBuffer, scaled_width * scaled_height, mipBlendColors[miplevel] );
+			R_BlendOverTexture( (byte *)scaledBuffer, scaled_width * scaled_height, mipBlendColors[levels.numLevels] );
 		}
 
-		// upload the mip map
+		levels.data[levels.numLevels] = scaledBuffer;
+		levels.width[levels.numLevels] = scaled_width;
+		levels.height[levels.numLevels] = scaled_height;
+		levels.numLevels++;
+	}
+}
+
+/*
+================
+UploadImageLevels
+
+The GL side of GenerateImage, frees the level data.
+================
+*/
+void idImage::UploadImageLevels( imageLevels_t &levels ) {
+	idTimer		timer;
+
+	timer.Start();
+
+	uploadWidth = levels.width[0];
+	uploadHeight = levels.height[0];
+	type = TT_2D;
+	internalFormat = levels.internalFormat;
+	isMonochrome = levels.isMonochrome;
+
+	// generate the texture number
+	qglGenTextures( 1, &texnum );
+
+	// upload the main image level
+	Bind();
+
+	for ( int miplevel = 0 ; miplevel < levels.numLevels ; miplevel++ ) {
 		if ( internalFormat == GL_COLOR_INDEX8_EXT ) {
-			UploadCompressedNormalMap( scaled_width, scaled_height, scaledBuffer, miplevel );
+			/*
+			if ( depth == TD_BUMP ) {
+				for ( int i = 0; i < scaled_width * scaled_height * 4; i += 4 ) {
+					scaledBuffer[ i ] = scaledBuffer[ i + 3 ];
+					scaledBuffer[ i + 3 ] = 0;
+				}
+			}
+			*/
+			UploadCompressedNormalMap( levels.width[miplevel], levels.height[miplevel], levels.data[miplevel], miplevel );
 		} else {
-			qglTexImage2D( GL_TEXTURE_2D, miplevel, internalFormat, scaled_width, scaled_height, 
-				0, GL_RGBA, GL_UNSIGNED_BYTE, scaledBuffer );
+			qglTexImage2D( GL_TEXTURE_2D, miplevel, internalFormat, levels.width[miplevel], levels.height[miplevel], 
+				0, GL_RGBA, GL_UNSIGNED_BYTE, levels.data[miplevel] );
 		}
+		R_StaticFree( levels.data[miplevel] );
+		levels.data[miplevel] = NULL;
 	}
-
-	if ( scaledBuffer != 0 ) {
-		R_StaticFree( scaledBuffer );
-	}
+	levels.numLevels = 0;
 
 	SetImageFilterAndRepeat();
 
@@ -703,6 +740,22 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 #ifdef _DEBUG
 	GL_CheckErrors();
 #endif
+
+	timer.Stop();
+	uploadMsec = timer.Milliseconds();
+}
+
+/*
+================
+R_FreeImageLevels
+================
+*/
+void R_FreeImageLevels( imageLevels_t &levels ) {
+	for ( int i = 0 ; i < levels.numLevels ; i++ ) {
+		R_StaticFree( levels.data[i] );
+		levels.data[i] = NULL;
+	}
+	levels.numLevels = 0;
 }
 
 
@@ -1559,6 +1612,7 @@ On exit, the idImage will have a valid OpenGL texture number that can be bound
 void	idImage::ActuallyLoadImage( bool checkForPrecompressed, bool fromBackEnd ) {
 	int		width, height;
 	byte	*pic;
+	idTimer	timer;
 
 	// this is the ONLY place generatorFunction will ever be called
 	if ( generatorFunction ) {
@@ -1605,13 +1659,20 @@ void	idImage::ActuallyLoadImage( bool checkForPrecompressed, bool fromBackEnd )
 		// see if we have a pre-generated image file that is
 		// already image processed and compressed
 		if ( checkForPrecompressed && globalImages->image_usePrecompressedTextures.GetBool() ) {
-			if ( CheckPrecompressedImage( true ) ) {
+			timer.Start();
+			bool loaded = CheckPrecompressedImage( true );
+			timer.Stop();
+			if ( loaded ) {
 				// we got the precompressed image
+				decodeMsec = mipMsec = 0.0f;
+				uploadMsec = timer.Milliseconds();
 				return;
 			}
 			// fall through to load the normal image
 		}
 
+		timer.Clear();
+		timer.Start();
 		R_LoadImageProgram( imgName, &pic, &width, &height, &timestamp, &depth );
 
 		if ( pic == NULL ) {
@@ -1636,8 +1697,10 @@ void	idImage::ActuallyLoadImage( bool checkForPrecompressed, bool fromBackEnd )
 		// NOTE: takes about 10% of image load times (SD)
 		// may not be strictly necessary, but some code uses it, so let's leave it in
 		imageHash = MD4_BlockChecksum( pic, width * height * 4 );
+		timer.Stop();
 
 		GenerateImage( pic, width, height, filter, allowDownSize, repeat, depth );
+		decodeMsec = timer.Milliseconds();
 		timestamp = timestamp;
 		precompressedFile = false;
 
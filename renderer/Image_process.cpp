@@ -23,6 +23,45 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "tr_local.h"
 
+#ifdef ID_SSE2_INTRINSICS
+#include <emmintrin.h>
+#endif
+
+#ifdef ID_SSE2_INTRINSICS
+/*
+================
+R_ResampleRowSSE2
+
+One output row of R_ResampleTexture, four output texels at a time. The four
+source texels of each are gathered into the lanes and summed in 16 bits, so
+the result is bit identical to the C code. Only the first ( outwidth & ~3 )
+texels are written.
+================
+*/
+ID_SSE2_FUNC static void R_ResampleRowSSE2( const byte *inrow, const byte *inrow2, const unsigned int *p1, const unsigned int *p2, byte *out_p, int outwidth ) {
+	const __m128i zero = _mm_setzero_si128();
+	const int count = outwidth & ~3;
+
+	for ( int j = 0 ; j < count ; j += 4, out_p += 16 ) {
+		const __m128i a = _mm_set_epi32( *(const int *)( inrow + p1[j+3] ), *(const int *)( inrow + p1[j+2] ),
+										*(const int *)( inrow + p1[j+1] ), *(const int *)( inrow + p1[j+0] ) );
+		const __m128i b = _mm_set_epi32( *(const int *)( inrow + p2[j+3] ), *(const int *)( inrow + p2[j+2] ),
+										*(const int *)( inrow + p2[j+1] ), *(const int *)( inrow + p2[j+0] ) );
+		const __m128i c = _mm_set_epi32( *(const int *)( inrow2 + p1[j+3] ), *(const int *)( inrow2 + p1[j+2] ),
+										*(const int *)( inrow2 + p1[j+1] ), *(const int *)( inrow2 + p1[j+0] ) );
+		const __m128i d = _mm_set_epi32( *(const int *)( inrow2 + p2[j+3] ), *(const int *)( inrow2 + p2[j+2] ),
+										*(const int *)( inrow2 + p2[j+1] ), *(const int *)( inrow2 + p2[j+0] ) );
+
+		__m128i lo = _mm_add_epi16( _mm_unpacklo_epi8( a, zero ), _mm_unpacklo_epi8( b, zero ) );
+		__m128i hi = _mm_add_epi16( _mm_unpackhi_epi8( a, zero ), _mm_unpackhi_epi8( b, zero ) );
+		lo = _mm_add_epi16( lo, _mm_add_epi16( _mm_unpacklo_epi8( c, zero ), _mm_unpacklo_epi8( d, zero ) ) );
+		hi = _mm_add_epi16( hi, _mm_add_epi16( _mm_unpackhi_epi8( c, zero ), _mm_unpackhi_epi8( d, zero ) ) );
+
+		_mm_storeu_si128( (__m128i *)out_p, _mm_packus_epi16( _mm_srli_epi16( lo, 2 ), _mm_srli_epi16( hi, 2 ) ) );
+	}
+}
+#endif
+
 /*
 ================
 R_ResampleTexture
@@ -73,7 +112,14 @@ byte *R_ResampleTexture( const byte *in, int inwidth, int inheight,
 		inrow = in + 4 * inwidth * (int)( ( i + 0.25f ) * inheight / outheight );
 		inrow2 = in + 4 * inwidth * (int)( ( i + 0.75f ) * inheight / outheight );
 		frac = fracstep >> 1;
-		for (j=0 ; j<outwidth ; j++) {
+		j = 0;
+#ifdef ID_SSE2_INTRINSICS
+		if ( SIMD_HasSSE2() ) {
+			R_ResampleRowSSE2( inrow, inrow2, p1, p2, out_p, outwidth );
+			j = outwidth & ~3;
+		}
+#endif
+		for ( ; j<outwidth ; j++) {
 			pix1 = inrow + p1[j];
 			pix2 = inrow + p2[j];
 			pix3 = inrow2 + p1[j];
@@ -373,6 +419,47 @@ byte *R_MipMapWithAlphaSpecularity( const byte *in, int width, int height ) {
 	return out;
 }
 
+#ifdef ID_SSE2_INTRINSICS
+/*
+================
+R_MipMapBoxSSE2
+
+The 2x2 box filter of R_MipMap, four output texels at a time. The sums are
+done in 16 bits, so the result is bit identical to the C code. Only the first
+( outWidth & ~3 ) columns are written.
+================
+*/
+ID_SSE2_FUNC static void R_MipMapBoxSSE2( const byte *in, byte *out, int outWidth, int outHeight, int row ) {
+	const __m128i zero = _mm_setzero_si128();
+	const int blocks = outWidth >> 2;
+
+	for ( int i = 0 ; i < outHeight ; i++ ) {
+		const byte *in0 = in + i * row * 2;
+		const byte *in1 = in0 + row;
+		byte *out_p = out + i * outWidth * 4;
+
+		for ( int j = 0 ; j < blocks ; j++, in0 += 32, in1 += 32, out_p += 16 ) {
+			const __m128i a0 = _mm_loadu_si128( (const __m128i *)( in0 + 0 ) );
+			const __m128i a1 = _mm_loadu_si128( (const __m128i *)( in0 + 16 ) );
+			const __m128i b0 = _mm_loadu_si128( (const __m128i *)( in1 + 0 ) );
+			const __m128i b1 = _mm_loadu_si128( (const __m128i *)( in1 + 16 ) );
+
+			// vertical sums, each 16 bit lane holds one channel of one texel
+			const __m128i s0 = _mm_add_epi16( _mm_unpacklo_epi8( a0, zero ), _mm_unpacklo_epi8( b0, zero ) );
+			const __m128i s1 = _mm_add_epi16( _mm_unpackhi_epi8( a0, zero ), _mm_unpackhi_epi8( b0, zero ) );
+			const __m128i s2 = _mm_add_epi16( _mm_unpacklo_epi8( a1, zero ), _mm_unpacklo_epi8( b1, zero ) );
+			const __m128i s3 = _mm_add_epi16( _mm_unpackhi_epi8( a1, zero ), _mm_unpackhi_epi8( b1, zero ) );
+
+			// horizontal sums of the texel pairs
+			const __m128i h0 = _mm_add_epi16( _mm_unpacklo_epi64( s0, s1 ), _mm_unpackhi_epi64( s0, s1 ) );
+			const __m128i h1 = _mm_add_epi16( _mm_unpacklo_epi64( s2, s3 ), _mm_unpackhi_epi64( s2, s3 ) );
+
+			_mm_storeu_si128( (__m128i *)out_p, _mm_packus_epi16( _mm_srli_epi16( h0, 2 ), _mm_srli_epi16( h1, 2 ) ) );
+		}
+	}
+}
+#endif
+
 /*
 ================
 R_MipMap
@@ -441,6 +528,34 @@ byte *R_MipMap( const byte *in, int width, int height, bool preserveBorder ) {
 		return out;
 	}
 
+#ifdef ID_SSE2_INTRINSICS
+	if ( SIMD_HasSSE2() ) {
+		R_MipMapBoxSSE2( in, out, width, height, row );
+		j = width & ~3;
+		if ( j == width ) {
+			if ( preserveBorder ) {
+				R_SetBorderTexels( out, width, height, border );
+			}
+			return out;
+		}
+		// finish the columns the SSE2 loop left out
+		for ( i = 0 ; i < height ; i++ ) {
+			in_p = in + i * row * 2 + j * 8;
+			out_p = out + ( i * width + j ) * 4;
+			for ( int k = j ; k < width ; k++, out_p+=4, in_p+=8 ) {
+				out_p[0] = (in_p[0] + in_p[4] + in_p[row+0] + in_p[row+4])>>2;
+				out_p[1] = (in_p[1] + in_p[5] + in_p[row+1] + in_p[row+5])>>2;
+				out_p[2] = (in_p[2] + in_p[6] + in_p[row+2] + in_p[row+6])>>2;
+				out_p[3] = (in_p[3] + in_p[7] + in_p[row+3] + in_p[row+7])>>2;
+			}
+		}
+		if ( preserveBorder ) {
+			R_SetBorderTexels( out, width, height, border );
+		}
+		return out;
+	}
+#endif
+
 	for (i=0 ; i<height ; i++, in_p+=row) {
 		for (j=0 ; j<width ; j++, out_p+=4, in_p+=8) {
 			out_p[0] = (in_p[0] + in_p[4] + in_p[row+0] + in_p[row+4])>>2;
@@ -24,6 +24,10 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "tr_local.h"
 
+#ifdef ID_SSE2_INTRINSICS
+#include <emmintrin.h>
+#endif
+
 /*
 ===========================================================================
 
@@ -34,6 +38,59 @@ idInteraction implementation
 
 // FIXME: use private allocator for srfCullInfo_t
 
+#ifdef ID_SSE2_INTRINSICS
+/*
+================
+R_CalcTriFacingSSE2
+
+The facing test of R_CalcInteractionFacing for four triangles at a time. The
+planes are transposed so every lane holds one triangle, and the distance is
+summed in the order of the idSIMDProcessor::Dot of this platform, see
+R_SHADOW_SSE_DOT_ORDER. The last triangles are padded to a group of four so
+they get the same math.
+================
+*/
+ID_SSE2_FUNC static void R_CalcTriFacingSSE2( byte *facing, const idVec3 &origin, const idPlane *planes, int numFaces ) {
+	const __m128 ox = _mm_set1_ps( origin.x );
+	const __m128 oy = _mm_set1_ps( origin.y );
+	const __m128 oz = _mm_set1_ps( origin.z );
+	const __m128 zero = _mm_setzero_ps();
+	const int count = numFaces & ~3;
+	idPlane lastPlanes[4];
+	byte lastFacing[4];
+
+	for ( int i = 0; i < numFaces; i += 4 ) {
+		if ( i == count ) {
+			// copy the remaining planes so the loads stay inside the arrays
+			for ( int j = 0; j < 4; j++ ) {
+				lastPlanes[j] = ( i + j < numFaces ) ? planes[i+j] : idPlane( 0.0f, 0.0f, 0.0f, 0.0f );
+			}
+			R_CalcTriFacingSSE2( lastFacing, origin, lastPlanes, 4 );
+			memcpy( facing + i, lastFacing, numFaces - i );
+			break;
+		}
+
+		__m128 a = _mm_loadu_ps( planes[i+0].ToFloatPtr() );
+		__m128 b = _mm_loadu_ps( planes[i+1].ToFloatPtr() );
+		__m128 c = _mm_loadu_ps( planes[i+2].ToFloatPtr() );
+		__m128 d = _mm_loadu_ps( planes[i+3].ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( a, b, c, d );
+
+#ifdef R_SHADOW_SSE_DOT_ORDER
+		const __m128 dist = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( ox, a ), d ), _mm_mul_ps( oy, b ) ), _mm_mul_ps( oz, c ) );
+#else
+		const __m128 dist = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( ox, a ), _mm_mul_ps( oy, b ) ), _mm_mul_ps( oz, c ) ), d );
+#endif
+		const int bits = _mm_movemask_ps( _mm_cmpge_ps( dist, zero ) );
+
+		facing[i+0] = bits & 1;
+		facing[i+1] = ( bits >> 1 ) & 1;
+		facing[i+2] = ( bits >> 2 ) & 1;
+		facing[i+3] = ( bits >> 3 ) & 1;
+	}
+}
+#endif
+
 /*
 ================
 R_CalcInteractionFacing
@@ -62,6 +119,14 @@ void R_CalcInteractionFacing( const idRenderEntityLocal *ent, const srfTriangles
 
 	cullInfo.facing = (byte *) R_StaticAlloc( ( numFaces + 1 ) * sizeof( cullInfo.facing[0] ) );
 
+#ifdef ID_SSE2_INTRINSICS
+	if ( R_UseShadowSSE2() ) {
+		R_CalcTriFacingSSE2( cullInfo.facing, localLightOrigin, tri->facePlanes, numFaces );
+		cullInfo.facing[ numFaces ] = 1;	// for dangling edges to reference
+		return;
+	}
+#endif
+
 	// calculate back face culling
 	float *planeSide = (float *) _alloca16( numFaces * sizeof( float ) );
 
@@ -442,6 +507,9 @@ idInteraction::idInteraction( void ) {
 	dynamicModelFrameCount	= 0;
 	frustumState			= FRUSTUM_UNINITIALIZED;
 	frustumAreas			= NULL;
+	viewCullCount			= 0;
+	viewCulled				= false;
+	cacheEntry				= -1;
 }
 
 /*
@@ -470,6 +538,11 @@ idInteraction *idInteraction::AllocAndLink( idRenderEntityLocal *edef, idRenderL
 	interaction->frustumState = idInteraction::FRUSTUM_UNINITIALIZED;
 	interaction->frustumAreas = NULL;
 
+	interaction->viewCullCount = 0;
+	interaction->viewCulled = false;
+
+	interaction->cacheEntry = -1;
+
 	// link at the start of the entity's list
 	interaction->lightNext = ldef->firstInteraction;
 	interaction->lightPrev = NULL;
@@ -512,6 +585,12 @@ will be regenerated automatically
 */
 void idInteraction::FreeSurfaces( void ) {
 	if ( this->surfaces ) {
+		// the interaction cache only has the counts of the triangles it got from here
+		if ( this->cacheEntry != -1 && this->entityDef ) {
+			this->lightDef->world->interactionCache.SaveInteraction( this->cacheEntry, this );
+			this->cacheEntry = -1;
+		}
+
 		for ( int i = 0 ; i < this->numSurfaces ; i++ ) {
 			surfaceInteraction_t *sint = &this->surfaces[i];
 
@@ -799,6 +878,22 @@ bool idInteraction::CullInteractionByViewFrustum( const idFrustum &viewFrustum )
 	return false;
 }
 
+/*
+==================
+idInteraction::CullActiveInteraction
+
+The interactions that AddActiveInteraction culls against the view frustum.
+==================
+*/
+void idInteraction::CullActiveInteraction( void ) {
+	if ( !HasShadows() || entityDef->parms.hModel->IsStaticWorldModel() ) {
+		return;
+	}
+
+	viewCulled = CullInteractionByViewFrustum( tr.viewDef->viewFrustum );
+	viewCullCount = tr.viewCount;
+}
+
 /*
 ====================
 idInteraction::CreateInteraction
@@ -811,9 +906,10 @@ References tr.viewCount so lighting surfaces will only be created if the ambient
 otherwise it will be marked as deferred.
 
 The results of this are cached and valid until the light or entity change.
+cacheKey can pass in the interaction cache key if the caller has it already.
 ====================
 */
-void idInteraction::CreateInteraction( const idRenderModel *model ) {
+void idInteraction::CreateInteraction( const idRenderModel *model, const interactionCacheKey_t *cacheKey ) {
 	const idMaterial *	lightShader = lightDef->lightShader;
 	const idMaterial*	shader;
 	bool				interactionGenerated;
@@ -839,6 +935,21 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 		shadowGen = SG_STATIC;
 	}
 
+	// static interactions are taken from the interaction cache where possible,
+	// a new entry is filled in as the triangles are created
+	idInteractionCache *cache = &entityDef->world->interactionCache;
+	interactionCacheKey_t key;
+	cacheEntry = -1;
+	if ( cacheKey == NULL && CacheKey( model, key ) ) {
+		cacheKey = &key;
+	}
+	if ( cacheKey != NULL ) {
+		cacheEntry = cache->FindEntry( *cacheKey );
+		if ( cacheEntry == -1 ) {
+			cacheEntry = cache->AddEntry( *cacheKey, model );
+		}
+	}
+
 	//
 	// create slots for each of the model's surfaces
 	//
@@ -888,8 +999,14 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 
 		// generate a lighted surface and add it
 		if ( shader->ReceivesLighting() ) {
-			if ( tri->ambientViewCount == tr.viewCount ) {
+			if ( cacheEntry != -1 && cache->RestoreLightTris( cacheEntry, c, tri, &sint->lightTris ) ) {
+				// restoring is cheap enough to not defer it
+				tr.pc.c_cachedLightTris++;
+			} else if ( tri->ambientViewCount == tr.viewCount ) {
 				sint->lightTris = R_CreateLightTris( entityDef, tri, lightDef, shader, sint->cullInfo );
+				if ( cacheEntry != -1 ) {
+					cache->StoreLightTris( cacheEntry, c, tri, sint->lightTris );
+				}
 			} else {
 				// this will be calculated when sint->ambientTris is actually in view
 				sint->lightTris = LIGHT_TRIS_DEFERRED;
@@ -903,8 +1020,15 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 			// if the light has an optimized shadow volume, don't create shadows for any models that are part of the base areas
 			if ( lightDef->parms.prelightModel == NULL || !model->IsStaticWorldModel() || !r_useOptimizedShadows.GetBool() ) {
 
-				// this is the only place during gameplay (outside the utilities) that R_CreateShadowVolume() is called
-				sint->shadowTris = R_CreateShadowVolume( entityDef, tri, lightDef, shadowGen, sint->cullInfo );
+				if ( cacheEntry != -1 && cache->RestoreShadowTris( cacheEntry, c, tri, &sint->shadowTris ) ) {
+					tr.pc.c_cachedShadowVolumes++;
+				} else {
+					// this is the only place during gameplay (outside the utilities) that R_CreateShadowVolume() is called
+					sint->shadowTris = R_CreateShadowVolume( entityDef, tri, lightDef, shadowGen, sint->cullInfo );
+					if ( cacheEntry != -1 ) {
+						cache->StoreShadowTris( cacheEntry, c, tri, sint->shadowTris );
+					}
+				}
 				if ( sint->shadowTris ) {
 					if ( shader->Coverage() != MC_OPAQUE || ( !r_skipSuppress.GetBool() && entityDef->parms.suppressSurfaceInViewID ) ) {
 						// if any surface is a shadow-casting perforated or translucent surface, or the
@@ -930,6 +1054,104 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 	}
 }
 
+/*
+====================
+idInteraction::CacheKey
+
+Only the world geometry and lights that are still where the map put them
+are kept in the interaction cache. Anything else could change between runs
+and would only add entries that are never used again.
+
+The key covers everything the light and shadow triangles are created from,
+so a light that was moved in the map file or an edited material simply
+doesn't find its old entry.
+====================
+*/
+bool idInteraction::CacheKey( const idRenderModel *model, interactionCacheKey_t &key ) const {
+	int i;
+
+	if ( !r_useInteractionCache.GetBool() || !entityDef->world->interactionCache.IsActive() ) {
+		return false;
+	}
+	if ( !model->IsStaticWorldModel() || model != entityDef->parms.hModel || lightDef->lightHasMoved ) {
+		return false;
+	}
+
+	idFile_Memory data;
+
+	// the settings that change how the triangles are created
+	data.WriteBool( r_shadows.GetBool() );
+	data.WriteBool( r_useTurboShadow.GetBool() );
+	data.WriteBool( tr.backEndRendererHasVertexPrograms && r_useShadowVertexProgram.GetBool() );
+	data.WriteBool( r_lightAllBackFaces.GetBool() );
+	data.WriteBool( r_usePreciseTriangleInteractions.GetBool() );
+	data.WriteBool( r_useShadowProjectedCull.GetBool() );
+	data.WriteBool( R_UseShadowSSE2() );
+
+	// the entity
+	data.WriteString( model->Name() );
+	data.Write( entityDef->modelMatrix, sizeof( entityDef->modelMatrix ) );
+	data.WriteBool( entityDef->parms.noShadow );
+	data.WriteBool( entityDef->parms.noSelfShadow );
+	data.WriteString( entityDef->parms.customSkin ? entityDef->parms.customSkin->GetName() : "" );
+	data.WriteString( entityDef->parms.customShader ? entityDef->parms.customShader->GetName() : "" );
+	for ( i = 0; i < model->NumSurfaces(); i++ ) {
+		const modelSurface_t *surf = model->Surface( i );
+		const srfTriangles_t *tri = surf->geometry;
+		const idMaterial *shader = R_RemapShaderBySkin( surf->shader, entityDef->parms.customSkin, entityDef->parms.customShader );
+
+		data.WriteInt( tri ? tri->numVerts : 0 );
+		data.WriteInt( tri ? tri->numIndexes : 0 );
+		if ( tri ) {
+			data.Write( &tri->bounds, sizeof( tri->bounds ) );
+		}
+		data.WriteString( shader ? shader->GetName() : "" );
+		data.WriteBool( shader && shader->ReceivesLightingOnBackSides() );
+	}
+
+	// the light
+	data.WriteString( lightDef->lightShader->GetName() );
+	data.WriteBool( lightDef->lightShader->LightEffectsBackSides() );
+	data.WriteVec3( lightDef->globalLightOrigin );
+	data.Write( lightDef->frustum, sizeof( lightDef->frustum ) );
+	data.WriteInt( lightDef->numShadowFrustums );
+	for ( i = 0; i < lightDef->numShadowFrustums; i++ ) {
+		const shadowFrustum_t &frust = lightDef->shadowFrustums[i];
+		data.WriteInt( frust.numPlanes );
+		data.WriteBool( frust.makeClippedPlanes );
+		data.Write( frust.planes, frust.numPlanes * sizeof( frust.planes[0] ) );
+	}
+
+	key.md5 = MD5_BlockChecksum( data.GetDataPtr(), data.Length() );
+	key.crc = CRC32_BlockChecksum( data.GetDataPtr(), data.Length() );
+	return true;
+}
+
+/*
+====================
+idInteraction::CreateCachedInteraction
+
+Called for all interactions at map load, restoring the cached ones there
+avoids creating them when the player first walks into their area.
+====================
+*/
+void idInteraction::CreateCachedInteraction( void ) {
+	interactionCacheKey_t key;
+
+	if ( !IsDeferred() ) {
+		return;
+	}
+
+	const idRenderModel *model = entityDef->parms.hModel;
+	if ( model == NULL || model->NumSurfaces() <= 0 || !CacheKey( model, key ) ) {
+		return;
+	}
+
+	if ( entityDef->world->interactionCache.FindEntry( key ) != -1 ) {
+		CreateInteraction( model, &key );
+	}
+}
+
 /*
 ======================
 R_PotentiallyInsideInfiniteShadow
@@ -1042,7 +1264,17 @@ void idInteraction::AddActiveInteraction( void ) {
 		// try to cull the interaction
 		// this will also cull the case where the light origin is inside the
 		// view frustum and the entity bounds are outside the view frustum
-		if ( CullInteractionByViewFrustum( tr.viewDef->viewFrustum ) ) {
+		bool culled;
+		if ( viewCullCount == tr.viewCount ) {
+			// already done by CullActiveInteraction
+			culled = viewCulled;
+			if ( r_parallelAddModels.GetInteger() > 1 && culled != CullInteractionByViewFrustum( tr.viewDef->viewFrustum ) ) {
+				common->Printf( "parallel interaction cull mismatch on entity %i, light %i\n", entityDef->index, lightDef->index );
+			}
+		} else {
+			culled = CullInteractionByViewFrustum( tr.viewDef->viewFrustum );
+		}
+		if ( culled ) {
 			return;
 		}
 
@@ -1095,6 +1327,9 @@ void idInteraction::AddActiveInteraction( void ) {
 			// on a previous use that only needed the shadow
 			if ( sint->lightTris == LIGHT_TRIS_DEFERRED ) {
 				sint->lightTris = R_CreateLightTris( vEntity->entityDef, sint->ambientTris, vLight->lightDef, sint->shader, sint->cullInfo );
+				if ( cacheEntry != -1 ) {
+					lightDef->world->interactionCache.StoreLightTris( cacheEntry, i, sint->ambientTris, sint->lightTris );
+				}
 				R_FreeInteractionCullInfo( sint->cullInfo );
 			}
 
@@ -1299,3 +1534,153 @@ void R_ShowInteractionMemory_f( const idCmdArgs &args ) {
 	common->Printf( "%5i indexes %5i verts in %5i light tris\n", lightTriIndexes, lightTriVerts, lightTris );
 	common->Printf( "%5i indexes %5i verts in %5i shadow tris\n", shadowTriIndexes, shadowTriVerts, shadowTris );
 }
+
+typedef struct {
+	const idRenderEntityLocal *	entityDef;
+	const idRenderLightLocal *	lightDef;
+	const srfTriangles_t *		tri;
+} shadowBenchmarkSurf_t;
+
+/*
+===================
+R_SameShadowVolume
+===================
+*/
+static bool R_SameShadowVolume( const srfTriangles_t *a, const srfTriangles_t *b ) {
+	if ( a == NULL || b == NULL ) {
+		return ( a == b );
+	}
+	if ( a->numVerts != b->numVerts || a->numIndexes != b->numIndexes
+		|| a->numShadowIndexesNoCaps != b->numShadowIndexesNoCaps || a->numShadowIndexesNoFrontCaps != b->numShadowIndexesNoFrontCaps ) {
+		return false;
+	}
+	if ( memcmp( a->indexes, b->indexes, a->numIndexes * sizeof( a->indexes[0] ) ) != 0 ) {
+		return false;
+	}
+	if ( ( a->shadowVertexes == NULL ) != ( b->shadowVertexes == NULL ) ) {
+		return false;
+	}
+	if ( a->shadowVertexes != NULL && memcmp( a->shadowVertexes, b->shadowVertexes, a->numVerts * sizeof( a->shadowVertexes[0] ) ) != 0 ) {
+		return false;
+	}
+	return true;
+}
+
+/*
+===================
+R_ShadowBenchmark_f
+
+Renders the primary view once, then creates the shadow volumes of all the
+surfaces that cast shadows in that view again with the C and the SSE2 code,
+and checks that both give the same triangles.
+===================
+*/
+void R_ShadowBenchmark_f( const idCmdArgs &args ) {
+	idList<shadowBenchmarkSurf_t>	surfs;
+	idList<srfTriangles_t *>		reference;
+	renderView_t					view;
+	idTimer							timer;
+	int								i, j, iterations;
+
+	if ( !tr.primaryView || !tr.primaryWorld ) {
+		common->Printf( "No primaryView for benchmarking\n" );
+		return;
+	}
+
+	iterations = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 10;
+	if ( iterations < 1 ) {
+		iterations = 1;
+	}
+
+	// render the view so the interactions in it are up to date, every light
+	// and entity in the view or one of its subviews gets a newer viewCount
+	const int firstViewCount = tr.viewCount + 1;
+	view = tr.primaryRenderView;
+	renderSystem->BeginFrame( glConfig.vidWidth, glConfig.vidHeight );
+	tr.primaryWorld->RenderScene( &view );
+	renderSystem->EndFrame( NULL, NULL );
+
+	for ( i = 0; i < tr.primaryWorld->lightDefs.Num(); i++ ) {
+		const idRenderLightLocal *light = tr.primaryWorld->lightDefs[i];
+		if ( light == NULL || light->viewCount < firstViewCount ) {
+			continue;
+		}
+		for ( idInteraction *inter = light->firstInteraction; inter != NULL; inter = inter->lightNext ) {
+			if ( inter->IsDeferred() || inter->IsEmpty() || !inter->HasShadows() || inter->entityDef->viewCount < firstViewCount ) {
+				continue;
+			}
+			for ( j = 0; j < inter->numSurfaces; j++ ) {
+				const surfaceInteraction_t *sint = &inter->surfaces[j];
+				if ( sint->shadowTris == NULL || sint->ambientTris == NULL ) {
+					continue;
+				}
+				shadowBenchmarkSurf_t &surf = surfs.Alloc();
+				surf.entityDef = inter->entityDef;
+				surf.lightDef = light;
+				surf.tri = sint->ambientTris;
+			}
+		}
+	}
+
+	if ( !surfs.Num() ) {
+		common->Printf( "No shadow casting surfaces in view\n" );
+		return;
+	}
+
+	common->Printf( "%i shadow casting surfaces in view, %i iterations\n", surfs.Num(), iterations );
+
+	const bool oldSSE2 = r_useShadowSSE2.GetBool();
+	const shadowGen_t shadowGens[2] = { SG_DYNAMIC, SG_STATIC };
+	const char *shadowGenNames[2] = { "dynamic", "static" };
+
+	for ( int gen = 0; gen < 2; gen++ ) {
+		for ( int sse2 = 0; sse2 < 2; sse2++ ) {
+			if ( sse2 && !SIMD_HasSSE2() ) {
+				common->Printf( "%-8s SSE2: not supported by the CPU\n", shadowGenNames[gen] );
+				break;
+			}
+			r_useShadowSSE2.SetBool( sse2 != 0 );
+
+			int mismatches = 0;
+			timer.Clear();
+			for ( int iteration = 0; iteration < iterations; iteration++ ) {
+				for ( i = 0; i < surfs.Num(); i++ ) {
+					srfCullInfo_t cullInfo = srfCullInfo_t();
+
+					timer.Start();
+					srfTriangles_t *shadowTri = R_CreateShadowVolume( surfs[i].entityDef, surfs[i].tri, surfs[i].lightDef, shadowGens[gen], cullInfo );
+					timer.Stop();
+
+					R_FreeInteractionCullInfo( cullInfo );
+
+					// keep the first C results to check the SSE2 results against
+					if ( iteration == 0 && !sse2 ) {
+						reference.Append( shadowTri );
+						continue;
+					}
+					if ( iteration == 0 && !R_SameShadowVolume( reference[i], shadowTri ) ) {
+						mismatches++;
+					}
+					if ( shadowTri ) {
+						R_FreeStaticTriSurf( shadowTri );
+					}
+				}
+			}
+
+			common->Printf( "%-8s %s: %8.2f msec per pass", shadowGenNames[gen], sse2 ? "SSE2" : "   C", timer.Milliseconds() / iterations );
+			if ( sse2 ) {
+				common->Printf( ", %i surfaces differ from the C code", mismatches );
+			}
+			common->Printf( "\n" );
+		}
+
+		for ( i = 0; i < reference.Num(); i++ ) {
+			if ( reference[i] ) {
+				R_FreeStaticTriSurf( reference[i] );
+			}
+		}
+		reference.Clear();
+	}
+
+	r_useShadowSSE2.SetBool( oldSSE2 );
+}
@@ -80,6 +80,7 @@ typedef struct areaNumRef_s {
 
 class idRenderEntityLocal;
 class idRenderLightLocal;
+class idRenderWorldLocal;
 
 class idInteraction {
 public:
@@ -137,6 +138,15 @@ public:
 	// calls R_LinkLightSurf() for each one
 	void					AddActiveInteraction( void );
 
+	// does the view frustum culling of AddActiveInteraction for the current view ahead of
+	// time, only touches this interaction so it can run on the job pool
+	void					CullActiveInteraction( void );
+
+	// creates a deferred interaction right away if it is in the interaction cache
+	void					CreateCachedInteraction( void );
+
+	int						CacheEntry( void ) const { return cacheEntry; }
+
 private:
 	enum {
 		FRUSTUM_UNINITIALIZED,
@@ -149,9 +159,17 @@ private:
 
 	int						dynamicModelFrameCount;	// so we can tell if a callback model animated
 
+	int						viewCullCount;			// tr.viewCount of the view viewCulled is valid for
+	bool					viewCulled;				// result of CullActiveInteraction
+
+	int						cacheEntry;				// in the world's interaction cache, -1 if not cached
+
 private:
 	// actually create the interaction
-	void					CreateInteraction( const idRenderModel *model );
+	void					CreateInteraction( const idRenderModel *model, const struct interactionCacheKey_s *cacheKey = NULL );
+
+	// returns false if the interaction can't be kept in the interaction cache
+	bool					CacheKey( const idRenderModel *model, struct interactionCacheKey_s &key ) const;
 
 	// unlink from entity and light lists
 	void					Unlink( void );
@@ -166,10 +184,110 @@ private:
 };
 
 
+/*
+===============================================================================
+
+	Interaction cache
+
+	The light and shadow triangles of interactions between static world
+	models and lights that never moved are saved per map, so they don't have
+	to be generated again the next time the map is played. An interaction is
+	found by a checksum over everything its triangles are calculated from.
+	The whole cache is thrown away when the checksum of the .proc file
+	changes.
+
+	The triangles of a cached surface are only kept in the cache while
+	there is no interaction holding them, they are copied back when the
+	interaction is freed or the cache is written.
+
+===============================================================================
+*/
+
+#define INTERACTION_CACHE_NOT_CACHED	-1		// not calculated yet
+#define INTERACTION_CACHE_WHOLE_SURFACE	-2		// the light tris use all indexes of the ambient surface
+
+typedef struct interactionCacheKey_s {
+	unsigned int			md5;
+	unsigned int			crc;
+} interactionCacheKey_t;
+
+typedef struct {
+	int						numVerts;				// of the ambient surface
+	int						numIndexes;
+
+	int						numLightIndexes;		// 0 if there are no light tris
+	int						firstLightIndex;		// -1 while the light tris are in an interaction
+	idBounds				lightBounds;
+
+	int						numShadowIndexes;		// 0 if there is no shadow volume
+	int						firstShadowIndex;		// -1 while the shadow tris are in an interaction
+	int						numShadowVerts;
+	int						firstShadowVertex;		// -1 if the shadow volume has no shadowVertexes
+	int						numShadowIndexesNoFrontCaps;
+	int						numShadowIndexesNoCaps;
+	int						shadowCapPlaneBits;
+} interactionCacheSurface_t;
+
+typedef struct {
+	interactionCacheKey_t	key;
+	int						firstSurface;
+	int						numSurfaces;
+	bool					used;					// looked up or added this session, only these are written back
+} interactionCacheEntry_t;
+
+class idInteractionCache {
+public:
+							idInteractionCache( void );
+
+							// reads the cache of a map, the entries are dropped if the map checksum differs
+	void					Load( const char *mapName, unsigned int mapChecksum );
+							// writes the entries used this session if anything was added since the last write
+	void					Write( const idRenderWorldLocal *world );
+	void					Clear( void );
+							// frees the triangles that were restored and those of the entries not looked up
+	void					Compact( void );
+
+	bool					IsActive( void ) const { return active; }
+	int						NumEntries( void ) const { return entries.Num(); }
+
+							// returns -1 if there is no entry with this key
+	int						FindEntry( const interactionCacheKey_t &key );
+	int						AddEntry( const interactionCacheKey_t &key, const idRenderModel *model );
+
+							// return false if the triangles of the surface aren't cached
+	bool					RestoreLightTris( int entry, int surfNum, const srfTriangles_t *tri, srfTriangles_t **lightTris );
+	bool					RestoreShadowTris( int entry, int surfNum, const srfTriangles_t *tri, srfTriangles_t **shadowTris );
+
+							// only the counts are stored, the triangles stay in the interaction
+	void					StoreLightTris( int entry, int surfNum, const srfTriangles_t *tri, const srfTriangles_t *lightTris );
+	void					StoreShadowTris( int entry, int surfNum, const srfTriangles_t *tri, const srfTriangles_t *shadowTris );
+							// copies the triangles of the interaction before they are freed
+	void					SaveInteraction( int entry, const idInteraction *inter );
+
+private:
+	idStr					fileName;
+	unsigned int			mapChecksum;
+	bool					active;					// a map is loaded and r_useInteractionCache was set
+	bool					changed;
+
+	idList<interactionCacheEntry_t>		entries;
+	idList<interactionCacheSurface_t>	surfaces;
+	idList<glIndex_t>		indexes;
+	idList<shadowCache_t>	shadowVerts;
+	idHashIndex				hash;
+
+	// returns -1 if the entry doesn't match the surface
+	int						SurfaceIndex( int entry, int surfNum, const srfTriangles_t *tri ) const;
+	bool					ReadEntries( idFile *file );
+	void					PackSurface( interactionCacheSurface_t &surf, idList<glIndex_t> &outIndexes, idList<shadowCache_t> &outShadowVerts ) const;
+};
+
+
 void R_CalcInteractionFacing( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idRenderLightLocal *light, srfCullInfo_t &cullInfo );
 void R_CalcInteractionCullBits( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idRenderLightLocal *light, srfCullInfo_t &cullInfo );
 void R_FreeInteractionCullInfo( srfCullInfo_t &cullInfo );
 
 void R_ShowInteractionMemory_f( const idCmdArgs &args );
+void R_ShadowBenchmark_f( const idCmdArgs &args );
 
 #endif /* !__INTERACTION_H__ */
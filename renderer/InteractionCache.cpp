@@ -0,0 +1,636 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "tr_local.h"
+
+/*
+  The cache file of a map is next to its .proc file. The body holds the
+  used entries, their surfaces and one shared pool each for the indexes and
+  the shadow vertexes, which are read straight into the lists.
+
+  While the map runs the pools only hold the triangles that are not in an
+  interaction. A restored surface points at its interaction again, so
+  Compact drops the loaded triangles once the cached interactions are
+  created, and SaveInteraction copies them back when they are freed.
+
+  Bump INTERACTION_CACHE_VERSION whenever interactionCacheSurface_t or the
+  way the light and shadow triangles are created changes.
+*/
+#define INTERACTION_CACHE_EXT			"icache"
+#define INTERACTION_CACHE_FILEID		"ICH"
+#define INTERACTION_CACHE_VERSION		1
+
+/*
+===================
+idInteractionCache::idInteractionCache
+===================
+*/
+idInteractionCache::idInteractionCache( void ) {
+	mapChecksum = 0;
+	active = false;
+	changed = false;
+	surfaces.SetGranularity( 1024 );
+	indexes.SetGranularity( 65536 );
+	shadowVerts.SetGranularity( 16384 );
+}
+
+/*
+===================
+idInteractionCache::Clear
+===================
+*/
+void idInteractionCache::Clear( void ) {
+	fileName.Clear();
+	mapChecksum = 0;
+	active = false;
+	changed = false;
+	entries.Clear();
+	surfaces.Clear();
+	indexes.Clear();
+	shadowVerts.Clear();
+	hash.Free();
+}
+
+/*
+===================
+idInteractionCache::Load
+===================
+*/
+void idInteractionCache::Load( const char *mapName, unsigned int checksum ) {
+	void *		buffer;
+	int			length, version, bodyLength;
+	unsigned int fileMapChecksum, bodyChecksum;
+	char		id[4];
+
+	Clear();
+
+	if ( !r_useInteractionCache.GetBool() ) {
+		return;
+	}
+
+	fileName = mapName;
+	fileName.SetFileExtension( INTERACTION_CACHE_EXT );
+	mapChecksum = checksum;
+	active = true;
+
+	length = fileSystem->ReadFile( fileName, &buffer, NULL );
+	if ( length < 0 ) {
+		return;
+	}
+
+	idFile_Memory file( fileName, (const char *)buffer, length );
+
+	file.Read( id, sizeof( id ) );
+	file.ReadInt( version );
+	file.ReadUnsignedInt( fileMapChecksum );
+	file.ReadInt( bodyLength );
+	file.ReadUnsignedInt( bodyChecksum );
+	if ( memcmp( id, INTERACTION_CACHE_FILEID, sizeof( id ) ) != 0 || version != INTERACTION_CACHE_VERSION || fileMapChecksum != mapChecksum ) {
+		// the map was compiled again or the format changed, start over
+		fileSystem->FreeFile( buffer );
+		changed = true;
+		return;
+	}
+	if ( bodyLength != file.Length() - file.Tell() || CRC32_BlockChecksum( file.GetDataPtr() + file.Tell(), bodyLength ) != bodyChecksum
+			|| !ReadEntries( &file ) ) {
+		common->Warning( "%s is damaged", fileName.c_str() );
+		entries.Clear();
+		surfaces.Clear();
+		indexes.Clear();
+		shadowVerts.Clear();
+		hash.Free();
+		changed = true;
+	}
+
+	fileSystem->FreeFile( buffer );
+
+	common->Printf( "%i cached interactions in %s\n", entries.Num(), fileName.c_str() );
+}
+
+/*
+===================
+idInteractionCache::ReadEntries
+
+Returns false if any of the entries is out of range.
+===================
+*/
+bool idInteractionCache::ReadEntries( idFile *file ) {
+	int i, j, numEntries, numSurfaces, numIndexes, numShadowVerts;
+
+	file->ReadInt( numEntries );
+	file->ReadInt( numSurfaces );
+	file->ReadInt( numIndexes );
+	file->ReadInt( numShadowVerts );
+	if ( numEntries < 0 || numSurfaces < 0 || numIndexes < 0 || numShadowVerts < 0 ) {
+		return false;
+	}
+	if ( file->Length() - file->Tell() != numEntries * 4 * (int)sizeof( int ) + numSurfaces * (int)sizeof( interactionCacheSurface_t )
+			+ numIndexes * (int)sizeof( glIndex_t ) + numShadowVerts * (int)sizeof( shadowCache_t ) ) {
+		return false;
+	}
+
+	entries.SetNum( numEntries );
+	for ( i = 0; i < numEntries; i++ ) {
+		interactionCacheEntry_t &entry = entries[i];
+		file->ReadUnsignedInt( entry.key.md5 );
+		file->ReadUnsignedInt( entry.key.crc );
+		file->ReadInt( entry.firstSurface );
+		file->ReadInt( entry.numSurfaces );
+		entry.used = false;
+		if ( entry.firstSurface < 0 || entry.numSurfaces < 0 || entry.firstSurface + entry.numSurfaces > numSurfaces ) {
+			return false;
+		}
+		hash.Add( entry.key.md5, i );
+	}
+
+	surfaces.SetNum( numSurfaces );
+	file->Read( surfaces.Ptr(), numSurfaces * sizeof( surfaces[0] ) );
+	indexes.SetNum( numIndexes );
+	file->Read( indexes.Ptr(), numIndexes * sizeof( indexes[0] ) );
+	shadowVerts.SetNum( numShadowVerts );
+	file->Read( shadowVerts.Ptr(), numShadowVerts * sizeof( shadowVerts[0] ) );
+
+	// make sure a damaged file can't produce indexes outside the vertexes
+	for ( i = 0; i < numSurfaces; i++ ) {
+		const interactionCacheSurface_t &surf = surfaces[i];
+
+		if ( surf.numLightIndexes > 0 ) {
+			if ( surf.firstLightIndex < 0 || surf.firstLightIndex + surf.numLightIndexes > numIndexes ) {
+				return false;
+			}
+			for ( j = 0; j < surf.numLightIndexes; j++ ) {
+				if ( indexes[surf.firstLightIndex + j] < 0 || indexes[surf.firstLightIndex + j] >= surf.numVerts ) {
+					return false;
+				}
+			}
+		} else if ( surf.numLightIndexes < INTERACTION_CACHE_WHOLE_SURFACE ) {
+			return false;
+		}
+
+		if ( surf.numShadowIndexes > 0 ) {
+			if ( surf.firstShadowIndex < 0 || surf.firstShadowIndex + surf.numShadowIndexes > numIndexes ) {
+				return false;
+			}
+			if ( surf.numShadowIndexesNoCaps < 0 || surf.numShadowIndexesNoCaps > surf.numShadowIndexesNoFrontCaps
+					|| surf.numShadowIndexesNoFrontCaps > surf.numShadowIndexes
+					|| ( surf.shadowCapPlaneBits & ~( 63 | SHADOW_CAP_INFINITE ) ) != 0 ) {
+				return false;
+			}
+			if ( surf.firstShadowVertex != -1 && ( surf.firstShadowVertex < 0 || surf.firstShadowVertex + surf.numShadowVerts > numShadowVerts ) ) {
+				return false;
+			}
+			for ( j = 0; j < surf.numShadowIndexes; j++ ) {
+				if ( indexes[surf.firstShadowIndex + j] < 0 || indexes[surf.firstShadowIndex + j] >= surf.numShadowVerts ) {
+					return false;
+				}
+			}
+		} else if ( surf.numShadowIndexes < INTERACTION_CACHE_NOT_CACHED ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+===================
+idInteractionCache::Write
+
+Entries that were not looked up this session belong to lights or map
+geometry that changed, so they are dropped.
+===================
+*/
+void idInteractionCache::Write( const idRenderWorldLocal *world ) {
+	idList<interactionCacheSurface_t>	outSurfaces;
+	idList<glIndex_t>					outIndexes;
+	idList<shadowCache_t>				outShadowVerts;
+	int i, j, num;
+
+	if ( !active || !changed ) {
+		return;
+	}
+	changed = false;
+
+	// get the triangles of the interactions that are still around
+	for ( i = 0; i < world->lightDefs.Num(); i++ ) {
+		const idRenderLightLocal *ldef = world->lightDefs[i];
+		if ( !ldef ) {
+			continue;
+		}
+		for ( const idInteraction *inter = ldef->firstInteraction; inter != NULL; inter = inter->lightNext ) {
+			if ( inter->CacheEntry() != -1 && !inter->IsDeferred() ) {
+				SaveInteraction( inter->CacheEntry(), inter );
+			}
+		}
+	}
+
+	outSurfaces.SetGranularity( 1024 );
+	outIndexes.SetGranularity( 65536 );
+	outShadowVerts.SetGranularity( 16384 );
+
+	idFile_Memory entryData( fileName );
+
+	num = 0;
+	for ( i = 0; i < entries.Num(); i++ ) {
+		const interactionCacheEntry_t &entry = entries[i];
+		if ( !entry.used ) {
+			continue;
+		}
+		entryData.WriteUnsignedInt( entry.key.md5 );
+		entryData.WriteUnsignedInt( entry.key.crc );
+		entryData.WriteInt( outSurfaces.Num() );
+		entryData.WriteInt( entry.numSurfaces );
+		num++;
+
+		// pack the triangles of the used entries, anything that couldn't
+		// be saved from its interaction is created again next time
+		for ( j = 0; j < entry.numSurfaces; j++ ) {
+			interactionCacheSurface_t surf = surfaces[entry.firstSurface + j];
+
+			PackSurface( surf, outIndexes, outShadowVerts );
+			if ( surf.numLightIndexes > 0 && surf.firstLightIndex < 0 ) {
+				surf.numLightIndexes = INTERACTION_CACHE_NOT_CACHED;
+			}
+			if ( surf.numShadowIndexes > 0 && surf.firstShadowIndex < 0 ) {
+				surf.numShadowIndexes = INTERACTION_CACHE_NOT_CACHED;
+				surf.firstShadowVertex = -1;
+			}
+			outSurfaces.Append( surf );
+		}
+	}
+
+	idFile_Memory body( fileName );
+	body.WriteInt( num );
+	body.WriteInt( outSurfaces.Num() );
+	body.WriteInt( outIndexes.Num() );
+	body.WriteInt( outShadowVerts.Num() );
+	body.Write( entryData.GetDataPtr(), entryData.Length() );
+	body.Write( outSurfaces.Ptr(), outSurfaces.Num() * sizeof( outSurfaces[0] ) );
+	body.Write( outIndexes.Ptr(), outIndexes.Num() * sizeof( outIndexes[0] ) );
+	body.Write( outShadowVerts.Ptr(), outShadowVerts.Num() * sizeof( outShadowVerts[0] ) );
+
+	idFile *file = fileSystem->OpenFileWrite( fileName );
+	if ( !file ) {
+		common->Warning( "Couldn't write %s", fileName.c_str() );
+		return;
+	}
+	file->Write( INTERACTION_CACHE_FILEID, 4 );
+	file->WriteInt( INTERACTION_CACHE_VERSION );
+	file->WriteUnsignedInt( mapChecksum );
+	file->WriteInt( body.Length() );
+	file->WriteUnsignedInt( CRC32_BlockChecksum( body.GetDataPtr(), body.Length() ) );
+	file->Write( body.GetDataPtr(), body.Length() );
+	fileSystem->CloseFile( file );
+
+	common->Printf( "wrote %i cached interactions to %s\n", num, fileName.c_str() );
+}
+
+/*
+===================
+idInteractionCache::PackSurface
+
+Copies the triangles of the surface that are in the pools to the end of the
+given lists. Triangles that are in an interaction are left alone.
+===================
+*/
+void idInteractionCache::PackSurface( interactionCacheSurface_t &surf, idList<glIndex_t> &outIndexes, idList<shadowCache_t> &outShadowVerts ) const {
+	int n;
+
+	if ( surf.numLightIndexes > 0 && surf.firstLightIndex >= 0 ) {
+		n = outIndexes.Num();
+		outIndexes.SetNum( n + surf.numLightIndexes, false );
+		memcpy( outIndexes.Ptr() + n, indexes.Ptr() + surf.firstLightIndex, surf.numLightIndexes * sizeof( glIndex_t ) );
+		surf.firstLightIndex = n;
+	}
+	if ( surf.numShadowIndexes > 0 && surf.firstShadowIndex >= 0 ) {
+		n = outIndexes.Num();
+		outIndexes.SetNum( n + surf.numShadowIndexes, false );
+		memcpy( outIndexes.Ptr() + n, indexes.Ptr() + surf.firstShadowIndex, surf.numShadowIndexes * sizeof( glIndex_t ) );
+		surf.firstShadowIndex = n;
+
+		if ( surf.firstShadowVertex >= 0 ) {
+			n = outShadowVerts.Num();
+			outShadowVerts.SetNum( n + surf.numShadowVerts, false );
+			memcpy( outShadowVerts.Ptr() + n, shadowVerts.Ptr() + surf.firstShadowVertex, surf.numShadowVerts * sizeof( shadowCache_t ) );
+			surf.firstShadowVertex = n;
+		}
+	}
+}
+
+/*
+===================
+idInteractionCache::Compact
+
+Called after the cached interactions are created at map load. The restored
+triangles are in their interactions by then, and entries that weren't looked
+up won't be written, so only what is left in the pools is kept.
+===================
+*/
+void idInteractionCache::Compact( void ) {
+	idList<glIndex_t>		newIndexes;
+	idList<shadowCache_t>	newShadowVerts;
+
+	newIndexes.SetGranularity( 65536 );
+	newShadowVerts.SetGranularity( 16384 );
+
+	for ( int i = 0; i < entries.Num(); i++ ) {
+		const interactionCacheEntry_t &entry = entries[i];
+
+		for ( int j = 0; j < entry.numSurfaces; j++ ) {
+			interactionCacheSurface_t &surf = surfaces[entry.firstSurface + j];
+
+			if ( !entry.used ) {
+				surf.numLightIndexes = INTERACTION_CACHE_NOT_CACHED;
+				surf.numShadowIndexes = INTERACTION_CACHE_NOT_CACHED;
+				surf.firstShadowVertex = -1;
+				continue;
+			}
+			PackSurface( surf, newIndexes, newShadowVerts );
+		}
+	}
+
+	indexes.Swap( newIndexes );
+	shadowVerts.Swap( newShadowVerts );
+}
+
+/*
+===================
+idInteractionCache::FindEntry
+===================
+*/
+int idInteractionCache::FindEntry( const interactionCacheKey_t &key ) {
+	for ( int i = hash.First( key.md5 ); i != -1; i = hash.Next( i ) ) {
+		if ( entries[i].key.md5 == key.md5 && entries[i].key.crc == key.crc ) {
+			entries[i].used = true;
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+===================
+idInteractionCache::AddEntry
+
+The surfaces start out not cached, the triangles are stored as they are created.
+===================
+*/
+int idInteractionCache::AddEntry( const interactionCacheKey_t &key, const idRenderModel *model ) {
+	interactionCacheEntry_t entry;
+
+	entry.key = key;
+	entry.firstSurface = surfaces.Num();
+	entry.numSurfaces = model->NumSurfaces();
+	entry.used = true;
+
+	for ( int i = 0; i < entry.numSurfaces; i++ ) {
+		const srfTriangles_t *tri = model->Surface( i )->geometry;
+		interactionCacheSurface_t &surf = surfaces.Alloc();
+
+		surf = interactionCacheSurface_t();
+		surf.numVerts = tri ? tri->numVerts : 0;
+		surf.numIndexes = tri ? tri->numIndexes : 0;
+		surf.numLightIndexes = INTERACTION_CACHE_NOT_CACHED;
+		surf.numShadowIndexes = INTERACTION_CACHE_NOT_CACHED;
+		surf.firstShadowVertex = -1;
+	}
+
+	int index = entries.Append( entry );
+	hash.Add( key.md5, index );
+	changed = true;
+	return index;
+}
+
+/*
+===================
+idInteractionCache::SurfaceIndex
+===================
+*/
+int idInteractionCache::SurfaceIndex( int entry, int surfNum, const srfTriangles_t *tri ) const {
+	if ( entry < 0 || entry >= entries.Num() || surfNum < 0 || surfNum >= entries[entry].numSurfaces ) {
+		return -1;
+	}
+	int index = entries[entry].firstSurface + surfNum;
+	if ( surfaces[index].numVerts != tri->numVerts || surfaces[index].numIndexes != tri->numIndexes ) {
+		return -1;
+	}
+	return index;
+}
+
+/*
+===================
+idInteractionCache::RestoreLightTris
+
+Creates the same surface R_CreateLightTris would have.
+===================
+*/
+bool idInteractionCache::RestoreLightTris( int entry, int surfNum, const srfTriangles_t *tri, srfTriangles_t **lightTris ) {
+	int index = SurfaceIndex( entry, surfNum, tri );
+	if ( index < 0 || surfaces[index].numLightIndexes == INTERACTION_CACHE_NOT_CACHED ) {
+		return false;
+	}
+	interactionCacheSurface_t &surf = surfaces[index];
+
+	if ( surf.numLightIndexes > 0 && surf.firstLightIndex < 0 ) {
+		// another interaction with the same key holds them
+		return false;
+	}
+
+	if ( surf.numLightIndexes == 0 ) {
+		*lightTris = NULL;
+		return true;
+	}
+
+	srfTriangles_t *newTri = R_AllocStaticTriSurf();
+
+	newTri->ambientSurface = const_cast<srfTriangles_t *>(tri);
+	newTri->numVerts = tri->numVerts;
+	R_ReferenceStaticTriSurfVerts( newTri, tri );
+
+	if ( surf.numLightIndexes == INTERACTION_CACHE_WHOLE_SURFACE ) {
+		R_ReferenceStaticTriSurfIndexes( newTri, tri );
+		newTri->numIndexes = tri->numIndexes;
+	} else {
+		R_AllocStaticTriSurfIndexes( newTri, surf.numLightIndexes );
+		SIMDProcessor->Memcpy( newTri->indexes, indexes.Ptr() + surf.firstLightIndex, surf.numLightIndexes * sizeof( glIndex_t ) );
+		newTri->numIndexes = surf.numLightIndexes;
+		surf.firstLightIndex = -1;
+	}
+	newTri->bounds = surf.lightBounds;
+
+	*lightTris = newTri;
+	return true;
+}
+
+/*
+===================
+idInteractionCache::RestoreShadowTris
+
+Creates the same surface R_CreateShadowVolume would have.
+===================
+*/
+bool idInteractionCache::RestoreShadowTris( int entry, int surfNum, const srfTriangles_t *tri, srfTriangles_t **shadowTris ) {
+	int index = SurfaceIndex( entry, surfNum, tri );
+	if ( index < 0 || surfaces[index].numShadowIndexes == INTERACTION_CACHE_NOT_CACHED ) {
+		return false;
+	}
+	interactionCacheSurface_t &surf = surfaces[index];
+
+	if ( surf.numShadowIndexes > 0 && surf.firstShadowIndex < 0 ) {
+		return false;
+	}
+
+	if ( surf.numShadowIndexes == 0 ) {
+		*shadowTris = NULL;
+		return true;
+	}
+
+	srfTriangles_t *newTri = R_AllocStaticTriSurf();
+
+	newTri->bounds.Clear();
+	newTri->numVerts = surf.numShadowVerts;
+	if ( surf.firstShadowVertex >= 0 ) {
+		R_AllocStaticTriSurfShadowVerts( newTri, surf.numShadowVerts );
+		SIMDProcessor->Memcpy( newTri->shadowVertexes, shadowVerts.Ptr() + surf.firstShadowVertex, surf.numShadowVerts * sizeof( shadowCache_t ) );
+	}
+	R_AllocStaticTriSurfIndexes( newTri, surf.numShadowIndexes );
+	SIMDProcessor->Memcpy( newTri->indexes, indexes.Ptr() + surf.firstShadowIndex, surf.numShadowIndexes * sizeof( glIndex_t ) );
+	newTri->numIndexes = surf.numShadowIndexes;
+	newTri->numShadowIndexesNoFrontCaps = surf.numShadowIndexesNoFrontCaps;
+	newTri->numShadowIndexesNoCaps = surf.numShadowIndexesNoCaps;
+	newTri->shadowCapPlaneBits = surf.shadowCapPlaneBits;
+	surf.firstShadowIndex = -1;
+	surf.firstShadowVertex = -1;
+
+	*shadowTris = newTri;
+	return true;
+}
+
+/*
+===================
+idInteractionCache::StoreLightTris
+
+Also called when an interaction that shares the entry with another one
+created the triangles again.
+===================
+*/
+void idInteractionCache::StoreLightTris( int entry, int surfNum, const srfTriangles_t *tri, const srfTriangles_t *lightTris ) {
+	int index = SurfaceIndex( entry, surfNum, tri );
+	if ( index < 0 || ( surfaces[index].numLightIndexes > 0 && surfaces[index].firstLightIndex >= 0 ) ) {
+		return;
+	}
+	interactionCacheSurface_t &surf = surfaces[index];
+
+	if ( lightTris == NULL ) {
+		surf.numLightIndexes = 0;
+	} else if ( lightTris->indexes == tri->indexes ) {
+		surf.numLightIndexes = INTERACTION_CACHE_WHOLE_SURFACE;
+		surf.lightBounds = lightTris->bounds;
+	} else {
+		surf.firstLightIndex = -1;
+		surf.numLightIndexes = lightTris->numIndexes;
+		surf.lightBounds = lightTris->bounds;
+	}
+	changed = true;
+}
+
+/*
+===================
+idInteractionCache::StoreShadowTris
+
+Must be called before the shadow volume is changed for the surface material.
+===================
+*/
+void idInteractionCache::StoreShadowTris( int entry, int surfNum, const srfTriangles_t *tri, const srfTriangles_t *shadowTris ) {
+	int index = SurfaceIndex( entry, surfNum, tri );
+	if ( index < 0 || ( surfaces[index].numShadowIndexes > 0 && surfaces[index].firstShadowIndex >= 0 ) ) {
+		return;
+	}
+	interactionCacheSurface_t &surf = surfaces[index];
+
+	if ( shadowTris == NULL ) {
+		surf.numShadowIndexes = 0;
+	} else {
+		surf.firstShadowIndex = -1;
+		surf.numShadowIndexes = shadowTris->numIndexes;
+		surf.numShadowVerts = shadowTris->numVerts;
+		surf.firstShadowVertex = -1;
+		surf.numShadowIndexesNoFrontCaps = shadowTris->numShadowIndexesNoFrontCaps;
+		surf.numShadowIndexesNoCaps = shadowTris->numShadowIndexesNoCaps;
+		surf.shadowCapPlaneBits = shadowTris->shadowCapPlaneBits;
+	}
+	changed = true;
+}
+
+/*
+===================
+idInteractionCache::SaveInteraction
+
+Copies the triangles the entry only has the counts of into the pools, a
+surface that doesn't match its counts anymore is dropped from the entry.
+===================
+*/
+void idInteractionCache::SaveInteraction( int entry, const idInteraction *inter ) {
+	for ( int i = 0; i < inter->numSurfaces; i++ ) {
+		const surfaceInteraction_t *sint = &inter->surfaces[i];
+		if ( sint->ambientTris == NULL ) {
+			continue;
+		}
+		int index = SurfaceIndex( entry, i, sint->ambientTris );
+		if ( index < 0 ) {
+			continue;
+		}
+		interactionCacheSurface_t &surf = surfaces[index];
+
+		if ( surf.numLightIndexes > 0 && surf.firstLightIndex < 0 ) {
+			const srfTriangles_t *lightTris = sint->lightTris;
+			if ( lightTris != NULL && lightTris != LIGHT_TRIS_DEFERRED && lightTris->numIndexes == surf.numLightIndexes ) {
+				surf.firstLightIndex = indexes.Num();
+				indexes.SetNum( surf.firstLightIndex + lightTris->numIndexes, false );
+				memcpy( indexes.Ptr() + surf.firstLightIndex, lightTris->indexes, lightTris->numIndexes * sizeof( glIndex_t ) );
+			} else {
+				surf.numLightIndexes = INTERACTION_CACHE_NOT_CACHED;
+			}
+		}
+
+		if ( surf.numShadowIndexes > 0 && surf.firstShadowIndex < 0 ) {
+			const srfTriangles_t *shadowTris = sint->shadowTris;
+			if ( shadowTris != NULL && shadowTris->numIndexes == surf.numShadowIndexes && shadowTris->numVerts == surf.numShadowVerts ) {
+				surf.firstShadowIndex = indexes.Num();
+				indexes.SetNum( surf.firstShadowIndex + shadowTris->numIndexes, false );
+				memcpy( indexes.Ptr() + surf.firstShadowIndex, shadowTris->indexes, shadowTris->numIndexes * sizeof( glIndex_t ) );
+				if ( shadowTris->shadowVertexes ) {
+					surf.firstShadowVertex = shadowVerts.Num();
+					shadowVerts.SetNum( surf.firstShadowVertex + shadowTris->numVerts, false );
+					memcpy( shadowVerts.Ptr() + surf.firstShadowVertex, shadowTris->shadowVertexes, shadowTris->numVerts * sizeof( shadowCache_t ) );
+				} else {
+					surf.firstShadowVertex = -1;
+				}
+			} else {
+				surf.numShadowIndexes = INTERACTION_CACHE_NOT_CACHED;
+				surf.firstShadowVertex = -1;
+			}
+		}
+	}
+}
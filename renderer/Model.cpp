@@ -558,6 +558,76 @@ int idRenderModelStatic::NearestJoint( int surfaceNum, int a, int b, int c ) con
 //=====================================================================
 
 
+/*
+================
+R_AddDeformBounds
+
+Extends the bounds of a deformed surface so it doesn't cull incorrectly
+at screen edges.
+================
+*/
+static void R_AddDeformBounds( srfTriangles_t *tri, const idMaterial *shader ) {
+	// grayman #3278 - solution provided by Zbyl
+	// if the surface has a deformation, increase the bounds
+	switch ( shader->Deform() )
+	{
+	case DFRM_NONE:
+		break;
+	case DFRM_PARTICLE:
+	case DFRM_PARTICLE2:
+		{
+		// expand surface bounds to include any emitted particles
+		// Note that this is an approximation. True bounds could be
+		// calculated by simulating R_ParticleDeform().
+		const idDeclParticle *particleSystem = (idDeclParticle *)shader->GetDeformDecl();
+		tri->bounds.AddBounds(particleSystem->bounds);
+		}
+		break;
+	default:
+		{
+		// the amount here is somewhat arbitrary, designed to handle
+		// autosprites and flares, but could be done better with exact
+		// deformation information.
+		// Note that this doesn't handle deformations that are skinned in
+		// at run time...
+		idVec3 mid = ( tri->bounds[1] + tri->bounds[0] ) * 0.5f;
+		float  radius = ( tri->bounds[0] - mid ).Length();
+		radius += 20.0f;
+
+		tri->bounds[0][0] = mid[0] - radius;
+		tri->bounds[0][1] = mid[1] - radius;
+		tri->bounds[0][2] = mid[2] - radius;
+
+		tri->bounds[1][0] = mid[0] + radius;
+		tri->bounds[1][1] = mid[1] + radius;
+		tri->bounds[1][2] = mid[2] + radius;
+		}
+		break;
+
+/* previous method
+	// if the surface has a deformation, increase the bounds
+	// the amount here is somewhat arbitrary, designed to handle
+	// autosprites and flares, but could be done better with exact
+	// deformation information.
+	// Note that this doesn't handle deformations that are skinned in
+	// at run time...
+	if ( surf->shader->Deform() != DFRM_NONE ) {
+		srfTriangles_t	*tri = surf->geometry;
+		idVec3	mid = ( tri->bounds[1] + tri->bounds[0] ) * 0.5f;
+		float	radius = ( tri->bounds[0] - mid ).Length();
+		radius += 20.0f;
+
+		tri->bounds[0][0] = mid[0] - radius;
+		tri->bounds[0][1] = mid[1] - radius;
+		tri->bounds[0][2] = mid[2] - radius;
+
+		tri->bounds[1][0] = mid[0] + radius;
+		tri->bounds[1][1] = mid[1] + radius;
+		tri->bounds[1][2] = mid[2] + radius;
+ */
+	}
+}
+
 /*
 ================
 idRenderModelStatic::FinishSurfaces
@@ -689,73 +759,44 @@ void idRenderModelStatic::FinishSurfaces() {
 		{
 			modelSurface_t *surf = &surfaces[i];
 
-			// grayman #3278 - solution provided by Zbyl
-			// if the surface has a deformation, increase the bounds
-			switch ( surf->shader->Deform() )
-			{
-			case DFRM_NONE:
-				break;
-			case DFRM_PARTICLE:
-			case DFRM_PARTICLE2:
-				{
-				// expand surface bounds to include any emitted particles
-				// Note that this is an approximation. True bounds could be
-				// calculated by simulating R_ParticleDeform().
-				srfTriangles_t *tri = surf->geometry;
-				const idDeclParticle *particleSystem = (idDeclParticle *)surf->shader->GetDeformDecl();
-				tri->bounds.AddBounds(particleSystem->bounds);
-				}
-				break;
-			default:
-				{
-				// the amount here is somewhat arbitrary, designed to handle
-				// autosprites and flares, but could be done better with exact
-				// deformation information.
-				// Note that this doesn't handle deformations that are skinned in
-				// at run time...
-				srfTriangles_t *tri = surf->geometry;
-				idVec3 mid = ( tri->bounds[1] + tri->bounds[0] ) * 0.5f;
-				float  radius = ( tri->bounds[0] - mid ).Length();
-				radius += 20.0f;
-
-				tri->bounds[0][0] = mid[0] - radius;
-				tri->bounds[0][1] = mid[1] - radius;
-				tri->bounds[0][2] = mid[2] - radius;
-
-				tri->bounds[1][0] = mid[0] + radius;
-				tri->bounds[1][1] = mid[1] + radius;
-				tri->bounds[1][2] = mid[2] + radius;
-				}
-				break;
+			R_AddDeformBounds( surf->geometry, surf->shader );
 
-/* previous method
-			// if the surface has a deformation, increase the bounds
-			// the amount here is somewhat arbitrary, designed to handle
-			// autosprites and flares, but could be done better with exact
-			// deformation information.
-			// Note that this doesn't handle deformations that are skinned in
-			// at run time...
-			if ( surf->shader->Deform() != DFRM_NONE ) {
-				srfTriangles_t	*tri = surf->geometry;
-				idVec3	mid = ( tri->bounds[1] + tri->bounds[0] ) * 0.5f;
-				float	radius = ( tri->bounds[0] - mid ).Length();
-				radius += 20.0f;
-
-				tri->bounds[0][0] = mid[0] - radius;
-				tri->bounds[0][1] = mid[1] - radius;
-				tri->bounds[0][2] = mid[2] - radius;
-
-				tri->bounds[1][0] = mid[0] + radius;
-				tri->bounds[1][1] = mid[1] + radius;
-				tri->bounds[1][2] = mid[2] + radius;
- */
-			}
 			// add to the model bounds
 			bounds.AddBounds( surf->geometry->bounds );
 		}
 	}
 }
 
+/*
+================
+idRenderModelStatic::FinishCleanedSurfaces
+
+For surfaces that already went through FinishSurfaces before they were
+saved, like the ones in a binary .procb. The back sides and cleanup are
+part of the saved surfaces. The deform bounds depend on the particle decls,
+so they are calculated again from the vertexes.
+================
+*/
+void idRenderModelStatic::FinishCleanedSurfaces() {
+	purged = false;
+
+	if ( surfaces.Num() == 0 ) {
+		bounds.Zero();
+		return;
+	}
+
+	bounds.Clear();
+	for ( int i = 0 ; i < surfaces.Num() ; i++ ) {
+		modelSurface_t *surf = &surfaces[i];
+
+		if ( surf->shader->Deform() != DFRM_NONE ) {
+			R_BoundTriSurf( surf->geometry );
+			R_AddDeformBounds( surf->geometry, surf->shader );
+		}
+		bounds.AddBounds( surf->geometry->bounds );
+	}
+}
+
 /*
 =================
 idRenderModelStatic::ConvertASEToModelSurfaces
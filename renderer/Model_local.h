@@ -77,6 +77,7 @@ public:
 	virtual float				DepthHack() const;
 
 	void						MakeDefaultModel();
+	void						FinishCleanedSurfaces();
 	
 	bool						LoadASE( const char *fileName );
 	bool						LoadLWO( const char *fileName );
@@ -134,7 +135,10 @@ public:
 								~idMD5Mesh();
 
  	void						ParseMesh( idLexer &parser, int numJoints, const idJointMat *joints );
-	void						UpdateSurface( const struct renderEntity_s *ent, const idJointMat *joints, modelSurface_t *surf );
+	srfTriangles_t *			SetupSurface( modelSurface_t *surf, bool deriveTangents );
+	void						SkinSurface( srfTriangles_t *tri, const idJointMat *joints, float skinScale, bool deriveTangents );
+	// keeps the vertexes of a surface that was skinned with the same joints
+	void						ReuseSurface( modelSurface_t *surf );
 	idBounds					CalcBounds( const idJointMat *joints );
 	int							NearestJoint( int a, int b, int c ) const;
 	int							NumVerts( void ) const;
@@ -185,6 +189,14 @@ private:
 	void						ParseJoint( idLexer &parser, idMD5Joint *joint, idJointQuat *defaultPose );
 };
 
+// the snapshot of an md5 model instantiated for an entity, it remembers the joints
+// it was skinned with so an entity that didn't animate can keep the vertexes
+class idRenderModelMD5Instance : public idRenderModelStatic {
+public:
+	idList<idJointMat>			skinJoints;
+	float						skinScale;
+};
+
 /*
 ===============================================================================
 
@@ -262,11 +262,13 @@ void idMD5Mesh::TransformScaledVerts( idDrawVert *verts, const idJointMat *entJo
 
 /*
 ====================
-idMD5Mesh::UpdateSurface
+idMD5Mesh::SetupSurface
+
+Allocates the surface geometry for skinning, the vertexes are not touched yet
 ====================
 */
-void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf ) {
-	int i, base;
+srfTriangles_t *idMD5Mesh::SetupSurface( modelSurface_t *surf, bool deriveTangents ) {
+	int i;
 	srfTriangles_t *tri;
 
 	tr.pc.c_deformedSurfaces++;
@@ -315,8 +317,33 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 		}
 	}
 
-	if ( ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] != 0.0f ) {
-		TransformScaledVerts( tri->verts, entJoints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] );
+	// SkinSurface can't allocate the face planes or count the work R_DeriveTangents does
+	if ( deriveTangents && tri->dominantTris == NULL ) {
+		tr.pc.c_tangentIndexes += tri->numIndexes;
+		if ( !tri->facePlanes ) {
+			R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
+		}
+	}
+
+	tr.pc.c_skinnedVerts += deformInfo->numSourceVerts;
+
+	return tri;
+}
+
+/*
+====================
+idMD5Mesh::SkinSurface
+
+Transforms the vertexes of a surface returned by SetupSurface. This only writes
+to the surface so it can run on the job pool, the face planes have to be
+allocated already if the tangents are derived.
+====================
+*/
+void idMD5Mesh::SkinSurface( srfTriangles_t *tri, const idJointMat *entJoints, float skinScale, bool deriveTangents ) {
+	int i, base;
+
+	if ( skinScale != 0.0f ) {
+		TransformScaledVerts( tri->verts, entJoints, skinScale );
 	} else {
 		TransformVerts( tri->verts, entJoints );
 	}
@@ -333,8 +360,32 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 	// R_DeriveTangents() to get normals, tangents, and face planes.  If it only
 	// needs shadows generated, it will only have to generate face planes.  If it only
 	// has ambient drawing, or is culled, no additional work will be necessary
-	if ( !r_useDeferredTangents.GetBool() ) {
+	if ( deriveTangents ) {
 		// set face planes, vertex normals, tangents
+		R_DeriveTangentsNoAlloc( tri );
+	}
+}
+
+/*
+====================
+idMD5Mesh::ReuseSurface
+====================
+*/
+void idMD5Mesh::ReuseSurface( modelSurface_t *surf ) {
+	srfTriangles_t *tri = surf->geometry;
+
+	tr.pc.c_skinCacheVerts += deformInfo->numSourceVerts;
+
+	// the vertexes and bounds are still valid, but the vertex caches are
+	// released every time the model is instantiated
+	R_FreeStaticTriSurfVertexCaches( tri );
+
+	if ( !r_useSkinCacheTangents.GetBool() ) {
+		tri->tangentsCalculated = false;
+		tri->facePlanesCalculated = false;
+	}
+
+	if ( !r_useDeferredTangents.GetBool() ) {
 		R_DeriveTangents( tri );
 	}
 }
@@ -707,6 +758,33 @@ void idRenderModelMD5::DrawJoints( const renderEntity_t *ent, const struct viewD
 	}
 }
 
+/*
+====================
+MD5_SkinSurfacesJob
+====================
+*/
+// below this many vertexes it isn't worth waking up the job pool
+static const int MD5_MIN_PARALLEL_SKIN_VERTS = 2048;
+
+typedef struct {
+	idMD5Mesh *			mesh;
+	srfTriangles_t *	tri;
+} md5SkinSurface_t;
+
+typedef struct {
+	md5SkinSurface_t *	surfaces;
+	const idJointMat *	joints;
+	float				skinScale;
+	bool				deriveTangents;
+} md5SkinJob_t;
+
+static void MD5_SkinSurfacesJob( void *data, int index ) {
+	md5SkinJob_t *job = (md5SkinJob_t *)data;
+	md5SkinSurface_t *surface = &job->surfaces[index];
+
+	surface->mesh->SkinSurface( surface->tri, job->joints, job->skinScale, job->deriveTangents );
+}
+
 /*
 ====================
 idRenderModelMD5::InstantiateDynamicModel
@@ -715,7 +793,10 @@ idRenderModelMD5::InstantiateDynamicModel
 idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEntity_s *ent, const struct viewDef_s *view, idRenderModel *cachedModel ) {
 	int					i, surfaceNum;
 	idMD5Mesh			*mesh;
-	idRenderModelStatic	*staticModel;
+	idRenderModelMD5Instance *staticModel;
+	md5SkinJob_t		job;
+	int					numSkinSurfaces, numSkinVerts;
+	bool				jointsChanged;
 
 	if ( cachedModel && !r_useCachedDynamicModels.GetBool() ) {
 		delete cachedModel;
@@ -740,16 +821,31 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 	tr.pc.c_generateMd5++;
 
 	if ( cachedModel ) {
-		assert( dynamic_cast<idRenderModelStatic *>(cachedModel) != NULL );
+		assert( dynamic_cast<idRenderModelMD5Instance *>(cachedModel) != NULL );
 		assert( idStr::Icmp( cachedModel->Name(), MD5_SnapshotName ) == 0 );
-		staticModel = static_cast<idRenderModelStatic *>(cachedModel);
+		staticModel = static_cast<idRenderModelMD5Instance *>(cachedModel);
 	} else {
-		staticModel = new idRenderModelStatic;
+		staticModel = new idRenderModelMD5Instance;
 		staticModel->InitEmpty( MD5_SnapshotName );
 	}
 
 	staticModel->bounds.Clear();
 
+	job.joints = ent->joints;
+	job.skinScale = ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ];
+	job.deriveTangents = !r_useDeferredTangents.GetBool();
+
+	// the surfaces that are still in the snapshot were skinned with the joints from
+	// the last time, if they are the same the surfaces don't have to be skinned again
+	jointsChanged = !r_useSkinCache.GetBool() || !cachedModel || staticModel->skinScale != job.skinScale
+					|| staticModel->skinJoints.Num() != ent->numJoints
+					|| memcmp( staticModel->skinJoints.Ptr(), ent->joints, ent->numJoints * sizeof( ent->joints[0] ) ) != 0;
+	if ( jointsChanged ) {
+		staticModel->skinJoints.SetNum( ent->numJoints, false );
+		memcpy( staticModel->skinJoints.Ptr(), ent->joints, ent->numJoints * sizeof( ent->joints[0] ) );
+		staticModel->skinScale = job.skinScale;
+	}
+
 	if ( r_showSkel.GetInteger() ) {
 		if ( ( view != NULL ) && ( !r_skipSuppress.GetBool() || !ent->suppressSurfaceInViewID || ( ent->suppressSurfaceInViewID != view->renderView.viewID ) ) ) {
 			// only draw the skeleton
@@ -763,6 +859,10 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 		}
 	}
 
+	job.surfaces = (md5SkinSurface_t *)_alloca( meshes.Num() * sizeof( job.surfaces[0] ) );
+	numSkinSurfaces = 0;
+	numSkinVerts = 0;
+
 	// create all the surfaces
 	for( mesh = meshes.Ptr(), i = 0; i < meshes.Num(); i++, mesh++ ) {
 		// avoid deforming the surface if it will be a nodraw due to a skin remapping
@@ -782,6 +882,13 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 		if ( staticModel->FindSurfaceWithId( i, surfaceNum ) ) {
 			mesh->surfaceNum = surfaceNum;
 			surf = &staticModel->surfaces[surfaceNum];
+
+			if ( !jointsChanged && surf->geometry != NULL ) {
+				mesh->ReuseSurface( surf );
+				staticModel->bounds.AddPoint( surf->geometry->bounds[0] );
+				staticModel->bounds.AddPoint( surf->geometry->bounds[1] );
+				continue;
+			}
 		} else {
 
 			// Remove Overlays before adding new surfaces
@@ -794,10 +901,25 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 			surf->id = i;
 		}
 
-		mesh->UpdateSurface( ent, ent->joints, surf );
+		job.surfaces[numSkinSurfaces].mesh = mesh;
+		job.surfaces[numSkinSurfaces].tri = mesh->SetupSurface( surf, job.deriveTangents );
+		numSkinSurfaces++;
+		numSkinVerts += mesh->deformInfo->numSourceVerts;
+	}
+
+	// skin the meshes of large models in parallel, the rest of the model setup
+	// allocates memory and has to stay on this thread
+	if ( r_parallelSkinning.GetBool() && jobPool.GetNumThreads() > 0 && numSkinSurfaces > 1 && numSkinVerts >= MD5_MIN_PARALLEL_SKIN_VERTS ) {
+		jobPool.ParallelFor( MD5_SkinSurfacesJob, &job, numSkinSurfaces );
+	} else {
+		for ( i = 0; i < numSkinSurfaces; i++ ) {
+			MD5_SkinSurfacesJob( &job, i );
+		}
+	}
 
-		staticModel->bounds.AddPoint( surf->geometry->bounds[0] );
-		staticModel->bounds.AddPoint( surf->geometry->bounds[1] );
+	for ( i = 0; i < numSkinSurfaces; i++ ) {
+		staticModel->bounds.AddPoint( job.surfaces[i].tri->bounds[0] );
+		staticModel->bounds.AddPoint( job.surfaces[i].tri->bounds[1] );
 	}
 
 	return staticModel;
@@ -65,13 +65,15 @@ static void R_PerformanceCounters( void ) {
 	}
 
 	if ( r_showDynamic.GetBool() ) {
-		common->Printf( "callback:%i md5:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i\n",
+		common->Printf( "callback:%i md5:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i skinVerts:%i cachedVerts:%i\n",
 			tr.pc.c_entityDefCallbacks,
 			tr.pc.c_generateMd5,
 			tr.pc.c_deformedVerts,
 			tr.pc.c_deformedIndexes/3,
 			tr.pc.c_tangentIndexes/3,
-			tr.pc.c_guiSurfs
+			tr.pc.c_guiSurfs,
+			tr.pc.c_skinnedVerts,
+			tr.pc.c_skinCacheVerts
 			); 
 	}
 
@@ -86,8 +88,9 @@ static void R_PerformanceCounters( void ) {
 	}
 
 	if ( r_showInteractions.GetBool() ) {
-		common->Printf( "createInteractions:%i createLightTris:%i createShadowVolumes:%i\n",
-			tr.pc.c_createInteractions, tr.pc.c_createLightTris, tr.pc.c_createShadowVolumes );
+		common->Printf( "createInteractions:%i createLightTris:%i createShadowVolumes:%i cachedLightTris:%i cachedShadowVolumes:%i\n",
+			tr.pc.c_createInteractions, tr.pc.c_createLightTris, tr.pc.c_createShadowVolumes,
+			tr.pc.c_cachedLightTris, tr.pc.c_cachedShadowVolumes );
  	}
 	if ( r_showDefs.GetBool() ) {
 		common->Printf( "viewEntities:%i  shadowEntities:%i  viewLights:%i\n", tr.pc.c_visibleViewEntities,
@@ -1003,6 +1006,90 @@ void idRenderSystemLocal::CaptureRenderToBuffer(unsigned char* buffer)
 	qglReadPixels(rc->x, rc->y, rc->width, rc->height, GL_RGB, GL_UNSIGNED_BYTE, buffer);
 }
 
+/*
+==============
+CaptureRenderToBufferAsync
+
+Queues the read back of the current render crop into a pixel buffer object and copies
+the previous capture of the stream into the buffer. The two buffers of a stream alternate,
+so the previous read back had a whole frame to finish and mapping it doesn't stall.
+==============
+*/
+bool idRenderSystemLocal::CaptureRenderToBufferAsync( unsigned char* buffer, int stream ) {
+	if ( !glConfig.isInitialized ) {
+		return false;
+	}
+
+	if ( !glConfig.ARBPixelBufferObjectAvailable || stream < 0 || stream >= MAX_ASYNC_CAPTURES ) {
+		CaptureRenderToBuffer( buffer );
+		return true;
+	}
+
+	renderCrop_t *rc = &renderCrops[currentRenderCrop];
+	asyncCapture_t *capture = &asyncCaptures[stream];
+
+	// rows are padded to 4 bytes like in CaptureRenderToBuffer
+	const int size = ( ( rc->width * 3 + 3 ) & ~3 ) * rc->height;
+
+	guiModel->EmitFullScreen();
+	guiModel->Clear();
+	R_IssueRenderCommands();
+
+	if ( capture->pbo[0] == 0 ) {
+		qglGenBuffersARB( 2, capture->pbo );
+	}
+
+	if ( capture->size != size ) {
+		// (re)allocate the buffers, any pending capture has the wrong size now
+		for ( int i = 0; i < 2; i++ ) {
+			qglBindBufferARB( GL_PIXEL_PACK_BUFFER_ARB, capture->pbo[i] );
+			qglBufferDataARB( GL_PIXEL_PACK_BUFFER_ARB, size, NULL, GL_STREAM_READ_ARB );
+			capture->filled[i] = false;
+		}
+		capture->size = size;
+		capture->current = 0;
+	}
+
+	// start reading this render, the data pointer is an offset into the bound buffer
+	qglReadBuffer( GL_BACK );
+	qglBindBufferARB( GL_PIXEL_PACK_BUFFER_ARB, capture->pbo[capture->current] );
+	qglReadPixels( rc->x, rc->y, rc->width, rc->height, GL_RGB, GL_UNSIGNED_BYTE, NULL );
+	capture->filled[capture->current] = true;
+
+	// fetch the previous render
+	bool result = false;
+	const int previous = capture->current ^ 1;
+	if ( capture->filled[previous] ) {
+		qglBindBufferARB( GL_PIXEL_PACK_BUFFER_ARB, capture->pbo[previous] );
+		const void *data = qglMapBufferARB( GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB );
+		if ( data != NULL ) {
+			memcpy( buffer, data, size );
+			qglUnmapBufferARB( GL_PIXEL_PACK_BUFFER_ARB );
+			result = true;
+		}
+		capture->filled[previous] = false;
+	}
+
+	qglBindBufferARB( GL_PIXEL_PACK_BUFFER_ARB, 0 );
+	capture->current = previous;
+
+	return result;
+}
+
+/*
+==============
+PurgeAsyncCaptures
+==============
+*/
+void idRenderSystemLocal::PurgeAsyncCaptures( void ) {
+	for ( int i = 0; i < MAX_ASYNC_CAPTURES; i++ ) {
+		if ( glConfig.isInitialized && asyncCaptures[i].pbo[0] != 0 ) {
+			qglDeleteBuffersARB( 2, asyncCaptures[i].pbo );
+		}
+	}
+	memset( asyncCaptures, 0, sizeof( asyncCaptures ) );
+}
+
 /*
 ==============
 AllocRenderWorld
@@ -62,6 +62,7 @@ typedef struct glconfig_s {
 
 	bool				registerCombinersAvailable;
 	bool				ARBVertexBufferObjectAvailable;
+	bool				ARBPixelBufferObjectAvailable;
 	bool				ARBVertexProgramAvailable;
 	bool				ARBFragmentProgramAvailable;
 	bool				twoSidedStencilAvailable;
@@ -82,6 +83,9 @@ typedef struct glconfig_s {
 	bool				isInitialized;
 } glconfig_t;
 
+// number of streams for CaptureRenderToBufferAsync
+const int MAX_ASYNC_CAPTURES	= 4;
+
 #define SMALLCHAR_WIDTH		8
 #define SMALLCHAR_HEIGHT	16
 #define BIGCHAR_WIDTH		16
@@ -246,6 +250,14 @@ public:
 	 */
 	virtual void			CaptureRenderToBuffer(unsigned char* buffer) = 0;
 
+	/**
+	 * Like CaptureRenderToBuffer, but the read back goes into one of two pixel buffer objects of the given
+	 * capture stream and the buffer receives the previous capture of that stream instead, so the caller
+	 * doesn't stall on the GPU. Returns false if the stream had no previous capture of the same size yet.
+	 * Falls back to a synchronous read if pixel buffer objects are not available.
+	 */
+	virtual bool			CaptureRenderToBufferAsync(unsigned char* buffer, int stream) = 0;
+
 	virtual void			UnCrop() = 0;
 	virtual void			GetCardCaps( bool &oldCard, bool &nv10or20 ) = 0;
 
@@ -56,10 +56,16 @@ idCVar r_useShadowProjectedCull( "r_useShadowProjectedCull", "1", CVAR_RENDERER
 idCVar r_useShadowVertexProgram( "r_useShadowVertexProgram", "1", CVAR_RENDERER | CVAR_BOOL, "do the shadow projection in the vertex program on capable cards" );
 idCVar r_useShadowSurfaceScissor( "r_useShadowSurfaceScissor", "1", CVAR_RENDERER | CVAR_BOOL, "scissor shadows by the scissor rect of the interaction surfaces" );
 idCVar r_useInteractionTable( "r_useInteractionTable", "1", CVAR_RENDERER | CVAR_BOOL, "create a full entityDefs * lightDefs table to make finding interactions faster" );
+idCVar r_useShadowSSE2( "r_useShadowSSE2", R_SHADOW_SSE2_DEFAULT, CVAR_RENDERER | CVAR_BOOL, "use the SSE2 paths of the shadow volume generation if the CPU supports them, matches the C code exactly unless that runs the generic SIMD code on the x87" );
 idCVar r_useTurboShadow( "r_useTurboShadow", "1", CVAR_RENDERER | CVAR_BOOL, "use the infinite projection with W technique for dynamic shadows" );
 idCVar r_useTwoSidedStencil( "r_useTwoSidedStencil", "1", CVAR_RENDERER | CVAR_BOOL, "do stencil shadows in one pass with different ops on each side" );
 idCVar r_useDeferredTangents( "r_useDeferredTangents", "1", CVAR_RENDERER | CVAR_BOOL, "defer tangents calculations after deform" );
 idCVar r_useCachedDynamicModels( "r_useCachedDynamicModels", "1", CVAR_RENDERER | CVAR_BOOL, "cache snapshots of dynamic models" );
+idCVar r_useSkinCache( "r_useSkinCache", "1", CVAR_RENDERER | CVAR_BOOL, "reuse the skinned vertexes of md5 models whose joints didn't change since they were last instantiated" );
+idCVar r_useSkinCacheTangents( "r_useSkinCacheTangents", "1", CVAR_RENDERER | CVAR_BOOL, "keep the tangents of md5 meshes taken from the skin cache instead of deriving them again" );
+idCVar r_parallelSkinning( "r_parallelSkinning", "1", CVAR_RENDERER | CVAR_BOOL, "skin the meshes of large md5 models on the job pool" );
+idCVar r_useBinaryProc( "r_useBinaryProc", "1", CVAR_RENDERER | CVAR_BOOL, "load the world from a binary .procb with the surfaces already cleaned up, and write it when the .proc is newer" );
+idCVar r_useInteractionCache( "r_useInteractionCache", "1", CVAR_RENDERER | CVAR_BOOL, "save the light and shadow triangles of the world geometry per map and reuse them when the map is loaded again, takes effect on map load" );
 
 idCVar r_useVertexBuffers( "r_useVertexBuffers", "1", CVAR_RENDERER | CVAR_INTEGER, "use ARB_vertex_buffer_object for vertexes", 0, 1, idCmdSystem::ArgCompletion_Integer<0,1>  );
 // Serp - Enabled IndexBuffers by default, increases performance - however untested on a wide range of hardware.
@@ -114,6 +120,7 @@ idCVar r_useClippedLightScissors( "r_useClippedLightScissors", "1", CVAR_RENDERE
 idCVar r_useEntityCulling( "r_useEntityCulling", "1", CVAR_RENDERER | CVAR_BOOL, "0 = none, 1 = box" );
 idCVar r_useEntityScissors( "r_useEntityScissors", "0", CVAR_RENDERER | CVAR_BOOL, "1 = use custom scissor rectangle for each entity" );
 idCVar r_useInteractionCulling( "r_useInteractionCulling", "1", CVAR_RENDERER | CVAR_BOOL, "1 = cull interactions" );
+idCVar r_parallelAddModels( "r_parallelAddModels", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = calculate entity scissors and cull interactions on the job pool, 2 = also check the results against the serial code", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 idCVar r_useInteractionScissors( "r_useInteractionScissors", "2", CVAR_RENDERER | CVAR_INTEGER, "1 = use a custom scissor rectangle for each shadow interaction, 2 = also crop using portal scissors", -2, 2, idCmdSystem::ArgCompletion_Integer<-2,2> );
 idCVar r_useShadowCulling( "r_useShadowCulling", "1", CVAR_RENDERER | CVAR_BOOL, "try to cull shadows from partially visible lights" );
 idCVar r_useFrustumFarDistance( "r_useFrustumFarDistance", "0", CVAR_RENDERER | CVAR_FLOAT, "if != 0 force the view frustum far distance to this distance" );
@@ -481,6 +488,9 @@ static void R_CheckPortableExtensions( void ) {
 		qglGetBufferPointervARB = (PFNGLGETBUFFERPOINTERVARBPROC)GLimp_ExtensionPointer( "glGetBufferPointervARB");
 	}
 
+	// ARB_pixel_buffer_object, uses the buffer object functions
+	glConfig.ARBPixelBufferObjectAvailable = glConfig.ARBVertexBufferObjectAvailable && R_CheckExtension( "GL_ARB_pixel_buffer_object" );
+
 	// ARB_vertex_program
 	glConfig.ARBVertexProgramAvailable = R_CheckExtension( "GL_ARB_vertex_program" );
 	if (glConfig.ARBVertexProgramAvailable) {
@@ -1879,6 +1889,7 @@ void R_VidRestart_f( const idCmdArgs &args ) {
 		soundSystem->ShutdownHW();
 		Sys_ShutdownInput();
 		globalImages->PurgeAllImages();
+		tr.PurgeAsyncCaptures();
 		// free the context and close the window
 		GLimp_Shutdown();
 		glConfig.isInitialized = false;
@@ -2031,6 +2042,8 @@ void R_InitCommands( void ) {
 	cmdSystem->AddCommand( "reportImageDuplication", R_ReportImageDuplication_f, CMD_FL_RENDERER, "checks all referenced images for duplications" );
 	cmdSystem->AddCommand( "regenerateWorld", R_RegenerateWorld_f, CMD_FL_RENDERER, "regenerates all interactions" );
 	cmdSystem->AddCommand( "showInteractionMemory", R_ShowInteractionMemory_f, CMD_FL_RENDERER, "shows memory used by interactions" );
+	cmdSystem->AddCommand( "shadowBenchmark", R_ShadowBenchmark_f, CMD_FL_RENDERER, "times the shadow volume generation for the surfaces in view with and without SSE2, optionally takes the number of iterations" );
+	cmdSystem->AddCommand( "procLoadBenchmark", R_ProcLoadBenchmark_f, CMD_FL_RENDERER, "times loading the given map from the text .proc and from the binary .procb" );
 	cmdSystem->AddCommand( "showTriSurfMemory", R_ShowTriSurfMemory_f, CMD_FL_RENDERER, "shows memory used by triangle surfaces" );
 	cmdSystem->AddCommand( "vid_restart", R_VidRestart_f, CMD_FL_RENDERER, "restarts renderSystem" );
 	cmdSystem->AddCommand( "listRenderEntityDefs", R_ListRenderEntityDefs_f, CMD_FL_RENDERER, "lists the entity defs" );
@@ -2075,6 +2088,7 @@ void idRenderSystemLocal::Clear( void ) {
 	stencilDecr = 0;
 	memset( renderCrops, 0, sizeof( renderCrops ) );
 	currentRenderCrop = 0;
+	memset( asyncCaptures, 0, sizeof( asyncCaptures ) );
 	guiRecursionLevel = 0;
 	guiModel = NULL;
 	demoGuiModel = NULL;
@@ -2147,6 +2161,11 @@ idRenderSystemLocal::Shutdown
 void idRenderSystemLocal::Shutdown( void ) {	
 	common->Printf( "idRenderSystem::Shutdown()\n" );
 
+	// the worlds aren't freed, so save their interaction caches here
+	for ( int i = 0; i < worlds.Num(); i++ ) {
+		worlds[i]->interactionCache.Write( worlds[i] );
+	}
+
 	R_DoneFreeType( );
 
 	if ( glConfig.isInitialized ) {
@@ -2235,6 +2254,7 @@ idRenderSystemLocal::ShutdownOpenGL
 */
 void idRenderSystemLocal::ShutdownOpenGL( void ) {
 	// free the context and close the window
+	PurgeAsyncCaptures();
 	R_ShutdownFrameData();
 	GLimp_Shutdown();
 	glConfig.isInitialized = false;
@@ -120,6 +120,7 @@ idRenderWorldLocal::idRenderWorldLocal
 idRenderWorldLocal::idRenderWorldLocal() {
 	mapName.Clear();
 	mapTimeStamp = FILE_NOT_FOUND_TIMESTAMP;
+	mapChecksum = 0;
 
 	generateAllInteractionsCalled = false;
 
@@ -1486,6 +1487,24 @@ void idRenderWorldLocal::GenerateAllInteractions() {
 		this->CreateLightDefInteractions( ldef );
 	}
 
+	// create the interactions that are in the interaction cache now instead
+	// of when they first come into view, this also marks the cache entries
+	// still in use
+	if ( interactionCache.NumEntries() > 0 ) {
+		for ( int i = 0 ; i < this->lightDefs.Num() ; i++ ) {
+			idRenderLightLocal	*ldef = this->lightDefs[i];
+			if ( !ldef ) {
+				continue;
+			}
+			idInteraction *next;
+			for ( idInteraction *inter = ldef->firstInteraction; inter != NULL; inter = next ) {
+				next = inter->lightNext;
+				inter->CreateCachedInteraction();
+			}
+		}
+	}
+	interactionCache.Compact();
+
 #ifdef _DEBUG
 	int end = Sys_Milliseconds();
 	int	msec = end - start;
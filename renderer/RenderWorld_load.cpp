@@ -23,6 +23,7 @@
 static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "tr_local.h"
+#include "Model_local.h"
 
 
 /*
@@ -87,6 +88,9 @@ void idRenderWorldLocal::FreeWorld() {
 	interactionAllocator.Shutdown();
 	areaNumRefAllocator.Shutdown();
 
+	interactionCache.Write( this );
+	interactionCache.Clear();
+
 	mapName = "<FREED>";
 }
 
@@ -290,7 +294,6 @@ void idRenderWorldLocal::ParseInterAreaPortals( idLexer *src ) {
 	for ( i = 0 ; i < numInterAreaPortals ; i++ ) {
 		int		numPoints, a1, a2;
 		idWinding	*w;
-		portal_t	*p;
 
 		numPoints = src->ParseInt();
 		a1 = src->ParseInt();
@@ -305,32 +308,45 @@ void idRenderWorldLocal::ParseInterAreaPortals( idLexer *src ) {
 			(*w)[j][4] = 0;
 		}
 
-		// add the portal to a1
-		p = (portal_t *)R_ClearedStaticAlloc( sizeof( *p ) );
-		p->intoArea = a2;
-		p->doublePortal = &doublePortals[i];
-		p->w = w;
-		p->w->GetPlane( p->plane );
+		AddInterAreaPortal( i, a1, a2, w );
+	}
 
-		p->next = portalAreas[a1].portals;
-		portalAreas[a1].portals = p;
+	src->ExpectTokenString( "}" );
+}
 
-		doublePortals[i].portals[0] = p;
+/*
+================
+idRenderWorldLocal::AddInterAreaPortal
 
-		// reverse it for a2
-		p = (portal_t *)R_ClearedStaticAlloc( sizeof( *p ) );
-		p->intoArea = a1;
-		p->doublePortal = &doublePortals[i];
-		p->w = w->Reverse();
-		p->w->GetPlane( p->plane );
+Links the portal into both areas, the winding faces from a1 into a2.
+================
+*/
+void idRenderWorldLocal::AddInterAreaPortal( int portalNum, int a1, int a2, idWinding *w ) {
+	portal_t	*p;
 
-		p->next = portalAreas[a2].portals;
-		portalAreas[a2].portals = p;
+	// add the portal to a1
+	p = (portal_t *)R_ClearedStaticAlloc( sizeof( *p ) );
+	p->intoArea = a2;
+	p->doublePortal = &doublePortals[portalNum];
+	p->w = w;
+	p->w->GetPlane( p->plane );
 
-		doublePortals[i].portals[1] = p;
-	}
+	p->next = portalAreas[a1].portals;
+	portalAreas[a1].portals = p;
 
-	src->ExpectTokenString( "}" );
+	doublePortals[portalNum].portals[0] = p;
+
+	// reverse it for a2
+	p = (portal_t *)R_ClearedStaticAlloc( sizeof( *p ) );
+	p->intoArea = a1;
+	p->doublePortal = &doublePortals[portalNum];
+	p->w = w->Reverse();
+	p->w->GetPlane( p->plane );
+
+	p->next = portalAreas[a2].portals;
+	portalAreas[a2].portals = p;
+
+	doublePortals[portalNum].portals[1] = p;
 }
 
 /*
@@ -362,6 +378,461 @@ void idRenderWorldLocal::ParseNodes( idLexer *src ) {
 	src->ExpectTokenString( "}" );
 }
 
+/*
+===============================================================================
+
+	Binary .procb
+
+	The same world as the .proc, but with the surfaces already cleaned up by
+	FinishSurfaces, including the back sides, sil edges and dominant tris, so
+	loading is a few bulk copies instead of tokenizing the text and running
+	R_CleanupTriangles on every surface. It is written whenever the .proc is
+	parsed, by dmap and on the first load of a map, and is only used while the
+	.proc it was made from is unchanged.
+
+===============================================================================
+*/
+
+#define BINARY_PROC_FILE_EXT		"procb"
+#define BINARY_PROC_FILE_ID			"PRCB"
+#define BINARY_PROC_VERSION			1
+
+/*
+================
+R_BinaryProcMaterialFlags
+
+The material properties FinishSurfaces depends on, if any of them changed
+since the .procb was written the surfaces have to be cleaned up again.
+================
+*/
+static int R_BinaryProcMaterialFlags( const idMaterial *shader ) {
+	int flags = shader->Deform() << 2;
+	if ( shader->ShouldCreateBackSides() ) {
+		flags |= 1;
+	}
+	if ( shader->UseUnsmoothedTangents() ) {
+		flags |= 2;
+	}
+	return flags;
+}
+
+/*
+================
+R_ReadBinaryProcString
+================
+*/
+static bool R_ReadBinaryProcString( idFile *file, idStr &string ) {
+	int len;
+
+	file->ReadInt( len );
+	if ( len < 0 || len > MAX_STRING_CHARS || len > file->Length() - file->Tell() ) {
+		return false;
+	}
+	string.Fill( ' ', len );
+	return ( file->Read( &string[0], len ) == len );
+}
+
+/*
+================
+idRenderWorldLocal::ReadBinaryModel
+
+Returns NULL if the model is damaged or one of its materials changed.
+================
+*/
+idRenderModel *idRenderWorldLocal::ReadBinaryModel( idFile *file ) {
+	idRenderModelStatic	*model;
+	idStr			name, materialName;
+	bool			shadowModel;
+	int				numSurfaces, numBaseSurfaces, materialFlags, i;
+	modelSurface_t	surf;
+
+	file->ReadBool( shadowModel );
+	file->ReadInt( numSurfaces );
+	file->ReadInt( numBaseSurfaces );
+	if ( !R_ReadBinaryProcString( file, name ) || numSurfaces < 0 || numSurfaces > file->Length() - file->Tell()
+			|| numBaseSurfaces < 0 || numBaseSurfaces > numSurfaces ) {
+		return NULL;
+	}
+
+	model = static_cast<idRenderModelStatic *>( renderModelManager->AllocModel() );
+	model->InitEmpty( name );
+
+	for ( i = 0 ; i < numSurfaces ; i++ ) {
+		if ( !R_ReadBinaryProcString( file, materialName ) ) {
+			delete model;
+			return NULL;
+		}
+		file->ReadInt( materialFlags );
+
+		surf.id = 0;
+		if ( shadowModel ) {
+			surf.shader = tr.defaultMaterial;
+		} else {
+			surf.shader = declManager->FindMaterial( materialName );
+			if ( R_BinaryProcMaterialFlags( surf.shader ) != materialFlags ) {
+				common->Printf( "idRenderWorldLocal::InitFromMap: material '%s' changed since the .procb was written\n", materialName.c_str() );
+				delete model;
+				return NULL;
+			}
+			// the back sides FinishSurfaces added are not referenced by the .proc
+			if ( i < numBaseSurfaces ) {
+				((idMaterial*)surf.shader)->AddReference();
+			}
+		}
+
+		surf.geometry = R_ReadStaticTriSurf( file );
+		if ( !surf.geometry ) {
+			delete model;
+			return NULL;
+		}
+
+		model->AddSurface( surf );
+	}
+
+	// shadow models never get a FinishSurfaces, see ParseShadowModel
+	if ( !shadowModel ) {
+		model->FinishCleanedSurfaces();
+	}
+
+	return model;
+}
+
+/*
+================
+idRenderWorldLocal::ReadBinaryPortals
+================
+*/
+bool idRenderWorldLocal::ReadBinaryPortals( idFile *file ) {
+	int i, j;
+
+	file->ReadInt( numPortalAreas );
+	file->ReadInt( numInterAreaPortals );
+	if ( numPortalAreas < 0 || numPortalAreas > file->Length() || numInterAreaPortals < 0 || numInterAreaPortals > file->Length() ) {
+		numPortalAreas = 0;
+		numInterAreaPortals = 0;
+		return false;
+	}
+
+	portalAreas = (portalArea_t *)R_ClearedStaticAlloc( numPortalAreas * sizeof( portalAreas[0] ) );
+	areaScreenRect = (idScreenRect *) R_ClearedStaticAlloc( numPortalAreas * sizeof( idScreenRect ) );
+
+	// set the doubly linked lists
+	SetupAreaRefs();
+
+	doublePortals = (doublePortal_t *)R_ClearedStaticAlloc( numInterAreaPortals * sizeof( doublePortals[0] ) );
+
+	for ( i = 0 ; i < numInterAreaPortals ; i++ ) {
+		int		numPoints, a1, a2;
+		idWinding	*w;
+
+		file->ReadInt( numPoints );
+		file->ReadInt( a1 );
+		file->ReadInt( a2 );
+		if ( numPoints < 3 || numPoints > ( file->Length() - file->Tell() ) / (int)sizeof( idVec3 )
+				|| a1 < 0 || a1 >= numPortalAreas || a2 < 0 || a2 >= numPortalAreas ) {
+			return false;
+		}
+
+		w = new idWinding( numPoints );
+		w->SetNumPoints( numPoints );
+		for ( j = 0 ; j < numPoints ; j++ ) {
+			idVec3 point;
+			file->ReadVec3( point );
+			(*w)[j][0] = point[0];
+			(*w)[j][1] = point[1];
+			(*w)[j][2] = point[2];
+			// no texture coordinates
+			(*w)[j][3] = 0;
+			(*w)[j][4] = 0;
+		}
+
+		AddInterAreaPortal( i, a1, a2, w );
+	}
+
+	return true;
+}
+
+/*
+================
+idRenderWorldLocal::ReadBinaryNodes
+================
+*/
+bool idRenderWorldLocal::ReadBinaryNodes( idFile *file ) {
+	int i;
+
+	file->ReadInt( numAreaNodes );
+	if ( numAreaNodes < 0 || numAreaNodes > file->Length() - file->Tell() ) {
+		numAreaNodes = 0;
+		return false;
+	}
+	areaNodes = (areaNode_t *)R_ClearedStaticAlloc( numAreaNodes * sizeof( areaNodes[0] ) );
+
+	for ( i = 0 ; i < numAreaNodes ; i++ ) {
+		areaNode_t	*node;
+
+		node = &areaNodes[i];
+
+		file->Read( node->plane.ToFloatPtr(), 4 * sizeof( float ) );
+		file->ReadInt( node->children[0] );
+		file->ReadInt( node->children[1] );
+
+		// positive children are nodes, the others are -1 - areaNum
+		for ( int j = 0 ; j < 2 ; j++ ) {
+			if ( node->children[j] >= numAreaNodes || node->children[j] < -numPortalAreas ) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+================
+idRenderWorldLocal::LoadBinaryProc
+
+Returns false if there is no usable .procb, the world is left empty then.
+A procLength of -1 means there is no .proc to check it against. The stored
+checksum is trusted if the time stamp and length of the .proc match, the text
+is only read and checksummed if just the time stamp changed.
+================
+*/
+bool idRenderWorldLocal::LoadBinaryProc( const char *fileName, const char *procFileName, ID_TIME_T procTimeStamp, int procLength ) {
+	void *			buffer;
+	void *			procBuffer;
+	int				length, version, vertSize, indexSize, fileProcLength, numModels, i;
+	unsigned int	fileProcTimeStamp, fileProcChecksum;
+	char			id[4];
+	bool			ok;
+
+	length = fileSystem->ReadFile( fileName, &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+
+	idFile_Memory file( fileName, (const char *)buffer, length );
+
+	file.Read( id, sizeof( id ) );
+	file.ReadInt( version );
+	file.ReadInt( vertSize );
+	file.ReadInt( indexSize );
+	file.ReadUnsignedInt( fileProcTimeStamp );
+	file.ReadInt( fileProcLength );
+	file.ReadUnsignedInt( fileProcChecksum );
+	if ( memcmp( id, BINARY_PROC_FILE_ID, sizeof( id ) ) != 0 || version != BINARY_PROC_VERSION
+			|| vertSize != sizeof( idDrawVert ) || indexSize != sizeof( glIndex_t ) ) {
+		// written by a different version of the engine
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+	if ( procLength >= 0 && fileProcLength != procLength ) {
+		// the map was compiled again since
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+	if ( procLength >= 0 && fileProcTimeStamp != (unsigned int)procTimeStamp ) {
+		// the .proc may just have been copied or extracted again
+		ok = ( fileSystem->ReadFile( procFileName, &procBuffer, NULL ) == procLength );
+		if ( procBuffer ) {
+			ok = ok && CRC32_BlockChecksum( procBuffer, procLength ) == fileProcChecksum;
+			fileSystem->FreeFile( procBuffer );
+		}
+		if ( !ok ) {
+			fileSystem->FreeFile( buffer );
+			return false;
+		}
+	}
+
+	file.ReadInt( numModels );
+	ok = ( numModels >= 0 && numModels <= length );
+	for ( i = 0 ; ok && i < numModels ; i++ ) {
+		idRenderModel *model = ReadBinaryModel( &file );
+		if ( !model ) {
+			ok = false;
+			break;
+		}
+
+		// add it to the model manager list
+		renderModelManager->AddModel( model );
+
+		// save it in the list to free when clearing this map
+		localModels.Append( model );
+	}
+	ok = ok && ReadBinaryPortals( &file ) && ReadBinaryNodes( &file ) && file.Tell() == file.Length();
+
+	fileSystem->FreeFile( buffer );
+
+	if ( !ok ) {
+		common->Printf( "idRenderWorldLocal::InitFromMap: couldn't use %s\n", fileName );
+		FreeWorld();
+		return false;
+	}
+
+	mapChecksum = fileProcChecksum;
+
+	return true;
+}
+
+/*
+================
+idRenderWorldLocal::WriteBinaryProc
+
+Writes the world as it is after parsing the .proc.
+================
+*/
+void idRenderWorldLocal::WriteBinaryProc( const char *fileName, ID_TIME_T procTimeStamp, int procLength ) const {
+	int i, j;
+
+	idFile *file = fileSystem->OpenFileWrite( fileName );
+	if ( !file ) {
+		common->Warning( "Couldn't write %s", fileName );
+		return;
+	}
+
+	file->Write( BINARY_PROC_FILE_ID, 4 );
+	file->WriteInt( BINARY_PROC_VERSION );
+	file->WriteInt( sizeof( idDrawVert ) );
+	file->WriteInt( sizeof( glIndex_t ) );
+	file->WriteUnsignedInt( (unsigned int)procTimeStamp );
+	file->WriteInt( procLength );
+	file->WriteUnsignedInt( mapChecksum );
+
+	file->WriteInt( localModels.Num() );
+	for ( i = 0 ; i < localModels.Num() ; i++ ) {
+		const idRenderModel *model = localModels[i];
+
+		// shadow models only have shadow vertexes
+		const bool shadowModel = ( model->NumSurfaces() == 1 && model->Surface( 0 )->geometry->verts == NULL );
+
+		// FinishSurfaces appended a back side for each of these
+		int numBackSides = 0;
+		if ( !shadowModel ) {
+			for ( j = 0 ; j < model->NumSurfaces() ; j++ ) {
+				if ( model->Surface( j )->shader->ShouldCreateBackSides() ) {
+					numBackSides++;
+				}
+			}
+		}
+
+		file->WriteBool( shadowModel );
+		file->WriteInt( model->NumSurfaces() );
+		file->WriteInt( model->NumSurfaces() - numBackSides / 2 );
+		file->WriteString( model->Name() );
+
+		for ( j = 0 ; j < model->NumSurfaces() ; j++ ) {
+			const modelSurface_t *surf = model->Surface( j );
+
+			file->WriteString( surf->shader->GetName() );
+			file->WriteInt( shadowModel ? 0 : R_BinaryProcMaterialFlags( surf->shader ) );
+			R_WriteStaticTriSurf( file, surf->geometry );
+		}
+	}
+
+	file->WriteInt( numPortalAreas );
+	file->WriteInt( numInterAreaPortals );
+	for ( i = 0 ; i < numInterAreaPortals ; i++ ) {
+		const idWinding *w = doublePortals[i].portals[0]->w;
+
+		file->WriteInt( w->GetNumPoints() );
+		file->WriteInt( doublePortals[i].portals[1]->intoArea );
+		file->WriteInt( doublePortals[i].portals[0]->intoArea );
+		for ( j = 0 ; j < w->GetNumPoints() ; j++ ) {
+			file->WriteVec3( (*w)[j].ToVec3() );
+		}
+	}
+
+	const int numNodes = areaNodes ? numAreaNodes : 0;
+	file->WriteInt( numNodes );
+	for ( i = 0 ; i < numNodes ; i++ ) {
+		file->Write( areaNodes[i].plane.ToFloatPtr(), 4 * sizeof( float ) );
+		file->WriteInt( areaNodes[i].children[0] );
+		file->WriteInt( areaNodes[i].children[1] );
+	}
+
+	fileSystem->CloseFile( file );
+}
+
+/*
+================
+idRenderWorldLocal::ParseProcFile
+
+Returns false if the file is missing or isn't a .proc.
+================
+*/
+bool idRenderWorldLocal::ParseProcFile( const char *fileName ) {
+	idLexer *		src;
+	idToken			token;
+	idRenderModel *	lastModel;
+	void *			buffer;
+	int				length;
+
+	// load the file ourselves to get the checksum the interaction cache is validated against
+	length = fileSystem->ReadFile( fileName, &buffer, NULL );
+	if ( length < 0 ) {
+		common->Printf( "idRenderWorldLocal::InitFromMap: %s not found\n", fileName );
+		ClearWorld();
+		return false;
+	}
+
+	src = new idLexer( LEXFL_NOSTRINGCONCAT | LEXFL_NODOLLARPRECOMPILE );
+	src->LoadMemory( (const char *)buffer, length, fileName );
+
+	mapChecksum = CRC32_BlockChecksum( buffer, length );
+
+	if ( !src->ReadToken( &token ) || token.Icmp( PROC_FILE_ID ) ) {
+		common->Printf( "idRenderWorldLocal::InitFromMap: bad id '%s' instead of '%s'\n", token.c_str(), PROC_FILE_ID );
+		delete src;
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	// parse the file
+	while ( 1 ) {
+		if ( !src->ReadToken( &token ) ) {
+			break;
+		}
+
+		if ( token == "model" ) {
+			lastModel = ParseModel( src );
+
+			// add it to the model manager list
+			renderModelManager->AddModel( lastModel );
+
+			// save it in the list to free when clearing this map
+			localModels.Append( lastModel );
+			continue;
+		}
+
+		if ( token == "shadowModel" ) {
+			lastModel = ParseShadowModel( src );
+
+			// add it to the model manager list
+			renderModelManager->AddModel( lastModel );
+
+			// save it in the list to free when clearing this map
+			localModels.Append( lastModel );
+			continue;
+		}
+
+		if ( token == "interAreaPortals" ) {
+			ParseInterAreaPortals( src );
+			continue;
+		}
+
+		if ( token == "nodes" ) {
+			ParseNodes( src );
+			continue;
+		}
+
+		src->Error( "idRenderWorldLocal::InitFromMap: bad token \"%s\"", token.c_str() );
+	}
+
+	delete src;
+	fileSystem->FreeFile( buffer );
+
+	return true;
+}
+
 /*
 ================
 idRenderWorldLocal::CommonChildrenArea_r
@@ -470,10 +941,9 @@ is still useful for displaying a bare model
 =================
 */
 bool idRenderWorldLocal::InitFromMap( const char *name ) {
-	idLexer *		src;
-	idToken			token;
-	idStr			filename;
-	idRenderModel *	lastModel;
+	idStr			filename, binaryName;
+	int				procLength, startTime;
+	bool			binary;
 
 	// if this is an empty world, initialize manually
 	if ( !name || !name[0] ) {
@@ -487,11 +957,13 @@ bool idRenderWorldLocal::InitFromMap( const char *name ) {
 	// load it
 	filename = name;
 	filename.SetFileExtension( PROC_FILE_EXT );
+	binaryName = name;
+	binaryName.SetFileExtension( BINARY_PROC_FILE_EXT );
 
 	// if we are reloading the same map, check the timestamp
 	// and try to skip all the work
 	ID_TIME_T currentTimeStamp;
-	fileSystem->ReadFile( filename, NULL, &currentTimeStamp );
+	procLength = fileSystem->ReadFile( filename, NULL, &currentTimeStamp );
 
 	if ( name == mapName ) {
 		if ( currentTimeStamp != FILE_NOT_FOUND_TIMESTAMP && currentTimeStamp == mapTimeStamp ) {
@@ -507,13 +979,22 @@ bool idRenderWorldLocal::InitFromMap( const char *name ) {
 
 	FreeWorld();
 
-	src = new idLexer( filename, LEXFL_NOSTRINGCONCAT | LEXFL_NODOLLARPRECOMPILE );
-	if ( !src->IsLoaded() ) {
-		common->Printf( "idRenderWorldLocal::InitFromMap: %s not found\n", filename.c_str() );
-		ClearWorld();
+	startTime = Sys_Milliseconds();
+
+	// the .procb is only used if it was written from the same .proc
+	binary = r_useBinaryProc.GetBool() && LoadBinaryProc( binaryName, filename, currentTimeStamp, procLength );
+	if ( !binary && !ParseProcFile( filename ) ) {
 		return false;
 	}
 
+	common->Printf( "idRenderWorldLocal::InitFromMap: loaded %s in %i msec\n", binary ? binaryName.c_str() : filename.c_str(), Sys_Milliseconds() - startTime );
+
+	// save the cleaned up surfaces so the next load doesn't have to parse the text
+	if ( !binary && r_useBinaryProc.GetBool() ) {
+		startTime = Sys_Milliseconds();
+		WriteBinaryProc( binaryName, currentTimeStamp, procLength );
+		common->Printf( "idRenderWorldLocal::InitFromMap: wrote %s in %i msec\n", binaryName.c_str(), Sys_Milliseconds() - startTime );
+	}
 
 	mapName = name;
 	mapTimeStamp = currentTimeStamp;
@@ -523,68 +1004,69 @@ bool idRenderWorldLocal::InitFromMap( const char *name ) {
 		WriteLoadMap();
 	}
 
-	if ( !src->ReadToken( &token ) || token.Icmp( PROC_FILE_ID ) ) {
-		common->Printf( "idRenderWorldLocal::InitFromMap: bad id '%s' instead of '%s'\n", token.c_str(), PROC_FILE_ID );
-		delete src;
-		return false;
+	// if it was a trivial map without any areas, create a single area
+	if ( !numPortalAreas ) {
+		ClearWorld();
 	}
 
-	// parse the file
-	while ( 1 ) {
-		if ( !src->ReadToken( &token ) ) {
-			break;
-		}
+	// find the points where we can early-our of reference pushing into the BSP tree
+	CommonChildrenArea_r( &areaNodes[0] );
 
-		if ( token == "model" ) {
-			lastModel = ParseModel( src );
+	AddWorldModelEntities();
+	ClearPortalStates();
 
-			// add it to the model manager list
-			renderModelManager->AddModel( lastModel );
+	interactionCache.Load( mapName, mapChecksum );
 
-			// save it in the list to free when clearing this map
-			localModels.Append( lastModel );
-			continue;
-		}
-
-		if ( token == "shadowModel" ) {
-			lastModel = ParseShadowModel( src );
+	// done!
+	return true;
+}
 
-			// add it to the model manager list
-			renderModelManager->AddModel( lastModel );
+/*
+=================
+R_ProcLoadBenchmark_f
 
-			// save it in the list to free when clearing this map
-			localModels.Append( lastModel );
-			continue;
-		}
+Loads the map into a scratch world from the .proc and from the .procb
+and prints both times.
+=================
+*/
+void R_ProcLoadBenchmark_f( const idCmdArgs &args ) {
+	int		textTime, binaryTime, startTime;
 
-		if ( token == "interAreaPortals" ) {
-			ParseInterAreaPortals( src );
-			continue;
-		}
+	if ( args.Argc() != 2 ) {
+		common->Printf( "usage: procLoadBenchmark <maps/mapName>\n" );
+		return;
+	}
 
-		if ( token == "nodes" ) {
-			ParseNodes( src );
-			continue;
-		}
+	const bool useBinaryProc = r_useBinaryProc.GetBool();
+	const bool useInteractionCache = r_useInteractionCache.GetBool();
+	idRenderWorld *world = renderSystem->AllocRenderWorld();
 
-		src->Error( "idRenderWorldLocal::InitFromMap: bad token \"%s\"", token.c_str() );
-	}
+	// the scratch world shouldn't touch the interaction cache of the map
+	r_useInteractionCache.SetBool( false );
 
-	delete src;
+	// the first load brings the .procb up to date and both files into the OS file cache
+	r_useBinaryProc.SetBool( true );
+	if ( world->InitFromMap( args.Argv( 1 ) ) ) {
+		world->InitFromMap( NULL );
 
-	// if it was a trivial map without any areas, create a single area
-	if ( !numPortalAreas ) {
-		ClearWorld();
-	}
+		r_useBinaryProc.SetBool( false );
+		startTime = Sys_Milliseconds();
+		world->InitFromMap( args.Argv( 1 ) );
+		textTime = Sys_Milliseconds() - startTime;
+		world->InitFromMap( NULL );
 
-	// find the points where we can early-our of reference pushing into the BSP tree
-	CommonChildrenArea_r( &areaNodes[0] );
+		r_useBinaryProc.SetBool( true );
+		startTime = Sys_Milliseconds();
+		world->InitFromMap( args.Argv( 1 ) );
+		binaryTime = Sys_Milliseconds() - startTime;
+		world->InitFromMap( NULL );
 
-	AddWorldModelEntities();
-	ClearPortalStates();
+		common->Printf( "%s: %i msec from the .proc, %i msec from the .procb\n", args.Argv( 1 ), textTime, binaryTime );
+	}
 
-	// done!
-	return true;
+	renderSystem->FreeRenderWorld( world );
+	r_useBinaryProc.SetBool( useBinaryProc );
+	r_useInteractionCache.SetBool( useInteractionCache );
 }
 
 /*
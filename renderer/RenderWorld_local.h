@@ -132,6 +132,9 @@ public:
 
 	idStr					mapName;				// ie: maps/tim_dm2.proc, written to demoFile
 	ID_TIME_T				mapTimeStamp;			// for fast reloads of the same level
+	unsigned int			mapChecksum;			// crc of the .proc file, the interaction cache is only valid for it
+
+	idInteractionCache		interactionCache;		// static interactions saved from earlier runs of this map
 
 	areaNode_t *			areaNodes;
 	int						numAreaNodes;
@@ -174,6 +177,13 @@ public:
 	void					SetupAreaRefs();
 	void					ParseInterAreaPortals( idLexer *src );
 	void					ParseNodes( idLexer *src );
+	void					AddInterAreaPortal( int portalNum, int a1, int a2, idWinding *w );
+	bool					ParseProcFile( const char *fileName );
+	bool					LoadBinaryProc( const char *fileName, const char *procFileName, ID_TIME_T procTimeStamp, int procLength );
+	idRenderModel *			ReadBinaryModel( idFile *file );
+	bool					ReadBinaryPortals( idFile *file );
+	bool					ReadBinaryNodes( idFile *file );
+	void					WriteBinaryProc( const char *fileName, ID_TIME_T procTimeStamp, int procLength ) const;
 	int						CommonChildrenArea_r( areaNode_t *node );
 	void					FreeWorld();
 	void					ClearWorld();
@@ -256,4 +266,7 @@ public:
 	void					CreateLightDefInteractions( idRenderLightLocal *ldef );
 };
 
+// RenderWorld_load.cpp
+void R_ProcLoadBenchmark_f( const idCmdArgs &args );
+
 #endif /* !__RENDERWORLDLOCAL_H__ */
@@ -1404,6 +1404,96 @@ idScreenRect R_CalcEntityScissorRectangle( viewEntity_t *vEntity ) {
 	return R_ScreenRectFromViewFrustumBounds( bounds );
 }
 
+/*
+===================
+R_CullViewEntitiesJob
+
+The part of R_AddModelSurfaces that only reads shared data.  Every job takes
+a range of the view entities and calculates their scissor rectangles and culls
+their interactions against the view.  Entities with a pending callback are
+left to the serial code since the callback may still move them.
+===================
+*/
+typedef struct {
+	viewEntity_t **		vEntities;
+	idScreenRect *		scissorRects;		// NULL if entity scissors aren't used
+	int					numEntities;
+	int					numJobs;
+} cullViewEntitiesJob_t;
+
+static void R_CullViewEntitiesJob( void *data, int index ) {
+	cullViewEntitiesJob_t *job = (cullViewEntitiesJob_t *)data;
+	int first = job->numEntities * index / job->numJobs;
+	int last = job->numEntities * ( index + 1 ) / job->numJobs;
+
+	for ( int i = first; i < last; i++ ) {
+		viewEntity_t *vEntity = job->vEntities[i];
+
+		if ( job->scissorRects ) {
+			job->scissorRects[i] = R_CalcEntityScissorRectangle( vEntity );
+		}
+
+		if ( vEntity->entityDef->parms.callback ) {
+			continue;
+		}
+
+		// R_AddModelSurfaces only adds the interactions of xrayIndex 2 entities in an xray subview, and none of them otherwise
+		if ( ( vEntity->entityDef->parms.xrayIndex == 2 ) != tr.viewDef->isXraySubview ) {
+			continue;
+		}
+
+		for ( idInteraction *inter = vEntity->entityDef->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = inter->entityNext ) {
+			if ( inter->lightDef->viewCount != tr.viewCount ) {
+				continue;
+			}
+			inter->CullActiveInteraction();
+		}
+	}
+}
+
+/*
+===================
+R_CullViewEntities
+
+Runs R_CullViewEntitiesJob over all view entities if it is worth it. Returns
+the entity scissor rectangles in view entity order if they were calculated.
+===================
+*/
+static idScreenRect *R_CullViewEntities( void ) {
+	cullViewEntitiesJob_t	job;
+	viewEntity_t *			vEntity;
+
+	// the debug drawing isn't thread safe
+	if ( !r_parallelAddModels.GetInteger() || jobPool.GetNumThreads() == 0 || r_showInteractionFrustums.GetInteger() || r_showEntityScissors.GetBool() ) {
+		return NULL;
+	}
+
+	job.numEntities = 0;
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		job.numEntities++;
+	}
+	if ( job.numEntities < 16 ) {
+		return NULL;
+	}
+
+	job.vEntities = (viewEntity_t **)R_FrameAlloc( job.numEntities * sizeof( job.vEntities[0] ) );
+	job.numEntities = 0;
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		job.vEntities[job.numEntities++] = vEntity;
+	}
+
+	job.scissorRects = NULL;
+	if ( r_useEntityScissors.GetBool() ) {
+		job.scissorRects = (idScreenRect *)R_FrameAlloc( job.numEntities * sizeof( job.scissorRects[0] ) );
+	}
+
+	// a few ranges per thread keeps the threads busy without taking the pool lock for every entity
+	job.numJobs = Min( job.numEntities, ( jobPool.GetNumThreads() + 1 ) * 4 );
+	jobPool.ParallelFor( R_CullViewEntitiesJob, &job, job.numJobs );
+
+	return job.scissorRects;
+}
+
 /*
 ===================
 R_AddModelSurfaces
@@ -1419,18 +1509,32 @@ void R_AddModelSurfaces( void ) {
 	viewEntity_t		*vEntity;
 	idInteraction		*inter, *next;
 	idRenderModel		*model;
+	idScreenRect		*scissorRects;
+	int					entityNum;
 
 	// clear the ambient surface list
 	tr.viewDef->numDrawSurfs = 0;
 	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_AddDrawSurf
 
+	// do the culling that doesn't depend on anything else first, the surfaces
+	// are still added in order below so the draw surfaces don't change
+	scissorRects = R_CullViewEntities();
+
 	// go through each entity that is either visible to the view, or to
 	// any light that intersects the view (for shadows)
-	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+	for ( vEntity = tr.viewDef->viewEntitys, entityNum = 0; vEntity; vEntity = vEntity->next, entityNum++ ) {
 
 		if ( r_useEntityScissors.GetBool() ) {
 			// calculate the screen area covered by the entity
-			idScreenRect scissorRect = R_CalcEntityScissorRectangle( vEntity );
+			idScreenRect scissorRect;
+			if ( scissorRects ) {
+				scissorRect = scissorRects[entityNum];
+				if ( r_parallelAddModels.GetInteger() > 1 && !scissorRect.Equals( R_CalcEntityScissorRectangle( vEntity ) ) ) {
+					common->Printf( "parallel entity scissor mismatch on entity %i\n", vEntity->entityDef->index );
+				}
+			} else {
+				scissorRect = R_CalcEntityScissorRectangle( vEntity );
+			}
 			// intersect with the portal crossing scissor rectangle
 			vEntity->scissorRect.Intersect( scissorRect );
 
@@ -568,6 +568,8 @@ typedef struct {
 	int		c_createInteractions;	// number of calls to idInteraction::CreateInteraction
 	int		c_createLightTris;
 	int		c_createShadowVolumes;
+	int		c_cachedLightTris;		// restored from the interaction cache
+	int		c_cachedShadowVolumes;
 	int		c_generateMd5;
 	int		c_entityDefCallbacks;
 	int		c_alloc, c_free;	// counts for R_StaticAllc/R_StaticFree
@@ -579,6 +581,8 @@ typedef struct {
 	int		c_deformedVerts;	// idMD5Mesh::GenerateSurface
 	int		c_deformedIndexes;	// idMD5Mesh::GenerateSurface
 	int		c_tangentIndexes;	// R_DeriveTangents()
+	int		c_skinnedVerts;		// idMD5Mesh::SkinSurface
+	int		c_skinCacheVerts;	// idMD5Mesh::ReuseSurface
 	int		c_entityUpdates, c_lightUpdates, c_entityReferences, c_lightReferences;
 	int		c_guiSurfs;
 	int		frontEndMsec;		// sum of time in all RE_RenderScene's in a frame
@@ -677,6 +681,14 @@ typedef struct {
 } renderCrop_t;
 static const int	MAX_RENDER_CROPS = 8;
 
+// double buffered read back for CaptureRenderToBufferAsync
+typedef struct {
+	GLuint	pbo[2];
+	bool	filled[2];				// the buffer holds a capture that hasn't been read yet
+	int		current;				// buffer the next capture is read into
+	int		size;
+} asyncCapture_t;
+
 /*
 ** Most renderer globals are defined here.
 ** backend functions should never modify any of these fields,
@@ -724,6 +736,7 @@ public:
 	virtual void			CaptureRenderToImage( const char *imageName );
 	virtual void			CaptureRenderToFile( const char *fileName, bool fixAlpha );
 	virtual void			CaptureRenderToBuffer(unsigned char* buffer);
+	virtual bool			CaptureRenderToBufferAsync(unsigned char* buffer, int stream);
 	virtual void			UnCrop();
 	virtual void			GetCardCaps( bool &oldCard, bool &nv10or20 );
 	virtual bool			UploadImage( const char *imageName, const byte *data, int width, int height );
@@ -736,6 +749,7 @@ public:
 	void					Clear( void );
 	void					SetBackEndRenderer();			// sets tr.backEndRenderer based on cvars
 	void					RenderViewToViewport( const renderView_t *renderView, idScreenRect *viewport );
+	void					PurgeAsyncCaptures( void );	// frees the pixel buffers, must be called before the context goes away
 
 public:
 	// renderer globals
@@ -796,6 +810,8 @@ public:
 	renderCrop_t			renderCrops[MAX_RENDER_CROPS];
 	int						currentRenderCrop;
 
+	asyncCapture_t			asyncCaptures[MAX_ASYNC_CAPTURES];
+
 	// GUI drawing variables for surface creation
 	int						guiRecursionLevel;		// to prevent infinite overruns
 	class idGuiModel *		guiModel;
@@ -862,10 +878,12 @@ extern idCVar r_useClippedLightScissors;// 0 = full screen when near clipped, 1
 extern idCVar r_useEntityCulling;		// 0 = none, 1 = box
 extern idCVar r_useEntityScissors;		// 1 = use custom scissor rectangle for each entity
 extern idCVar r_useInteractionCulling;	// 1 = cull interactions
+extern idCVar r_parallelAddModels;		// 1 = cull interactions on the job pool, 2 = also check against the serial code
 extern idCVar r_useInteractionScissors;	// 1 = use a custom scissor rectangle for each interaction
 extern idCVar r_useFrustumFarDistance;	// if != 0 force the view frustum far distance to this distance
 extern idCVar r_useShadowCulling;		// try to cull shadows from partially visible lights
 extern idCVar r_usePreciseTriangleInteractions;	// 1 = do winding clipping to determine if each ambiguous tri should be lit
+extern idCVar r_useShadowSSE2;			// 1 = use the SSE2 paths of the shadow volume generation
 extern idCVar r_useTurboShadow;			// 1 = use the infinite projection with W technique for dynamic shadows
 extern idCVar r_useExternalShadows;		// 1 = skip drawing caps when outside the light volume
 extern idCVar r_useOptimizedShadows;	// 1 = use the dmap generated static shadow volumes
@@ -873,6 +891,11 @@ extern idCVar r_useShadowVertexProgram;	// 1 = do the shadow projection in the v
 extern idCVar r_useShadowProjectedCull;	// 1 = discard triangles outside light volume before shadowing
 extern idCVar r_useDeferredTangents;	// 1 = don't always calc tangents after deform
 extern idCVar r_useCachedDynamicModels;	// 1 = cache snapshots of dynamic models
+extern idCVar r_useSkinCache;			// 1 = don't skin md5 meshes again if the joints didn't change
+extern idCVar r_useSkinCacheTangents;	// 1 = keep the tangents of md5 meshes taken from the skin cache
+extern idCVar r_parallelSkinning;		// 1 = skin the meshes of large md5 models on the job pool
+extern idCVar r_useBinaryProc;			// 1 = load the world from the binary .procb when it is up to date
+extern idCVar r_useInteractionCache;	// 1 = save and reuse the static interactions of each map
 extern idCVar r_useTwoSidedStencil;		// 1 = do stencil shadows in one pass with different ops on each side
 extern idCVar r_useInfiniteFarZ;		// 1 = use the no-far-clip-plane trick
 extern idCVar r_useScissor;				// 1 = scissor clip as portals and lights are processed
@@ -1414,6 +1437,26 @@ srfTriangles_t *R_CreateShadowVolume( const idRenderEntityLocal *ent,
 									 const srfTriangles_t *tri, const idRenderLightLocal *light,
 									 shadowGen_t optimize, srfCullInfo_t &cullInfo );
 
+// the SSE2 facing and point cull code sums the plane distances in the same order as the
+// idSIMDProcessor::Dot the C code calls: idSIMD_SSE on win32 and OSX adds the plane distance
+// right after the first product, the generic code adds it last
+#if defined( _WIN32 ) || ( defined( MACOS_X ) && defined( __i386__ ) )
+#define R_SHADOW_SSE_DOT_ORDER
+#endif
+
+// the results are bit identical where the C code does its float math in SSE registers,
+// which idSIMD_SSE always does, the generic code only in builds with SSE float math. x87
+// code keeps the plane distances at a higher precision, so the SSE2 paths are off there
+#if defined( R_SHADOW_SSE_DOT_ORDER ) || defined( __SSE2_MATH__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define R_SHADOW_SSE2_DEFAULT	"1"
+#else
+#define R_SHADOW_SSE2_DEFAULT	"0"
+#endif
+
+ID_INLINE bool R_UseShadowSSE2( void ) {
+	return SIMD_HasSSE2() && r_useShadowSSE2.GetBool();
+}
+
 /*
 ============================================================
 
@@ -1481,6 +1524,8 @@ void				R_ShowTriSurfMemory_f( const idCmdArgs &args );
 
 srfTriangles_t *	R_AllocStaticTriSurf( void );
 srfTriangles_t *	R_CopyStaticTriSurf( const srfTriangles_t *tri );
+void				R_WriteStaticTriSurf( idFile *file, const srfTriangles_t *tri );
+srfTriangles_t *	R_ReadStaticTriSurf( idFile *file );
 void				R_AllocStaticTriSurfVerts( srfTriangles_t *tri, int numVerts );
 void				R_AllocStaticTriSurfIndexes( srfTriangles_t *tri, int numIndexes );
 void				R_AllocStaticTriSurfShadowVerts( srfTriangles_t *tri, int numVerts );
@@ -1516,6 +1561,7 @@ srfTriangles_t *	R_MergeTriangles( const srfTriangles_t *tri1, const srfTriangle
 // if the deformed verts have significant enough texture coordinate changes to reverse the texture
 // polarity of a triangle, the tangents will be incorrect
 void				R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes = true );
+void				R_DeriveTangentsNoAlloc( srfTriangles_t *tri );	// thread safe, doesn't count or allocate
 
 // deformable meshes precalculate as much as possible from a base frame, then generate
 // complete srfTriangles_t from just a new set of vertexes
@@ -24,6 +24,10 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "tr_local.h"
 
+#ifdef ID_SSE2_INTRINSICS
+#include <emmintrin.h>
+#endif
+
 // tr_stencilShadow.c -- creaton of stencil shadow volumes
 
 /*
@@ -734,6 +738,69 @@ static void R_AddSilEdges( const srfTriangles_t *tri, unsigned short *pointCull,
 	}
 }
 
+#ifdef ID_SSE2_INTRINSICS
+/*
+================
+R_CalcPointCullSSE2
+
+The per vertex plane tests of R_CalcPointCull for four vertexes at a time.
+The vertexes are transposed so every lane holds one vertex, and the distances
+are summed in the order of the idSIMDProcessor::Dot of this platform, see
+R_SHADOW_SSE_DOT_ORDER. The last vertexes are padded to a group of four so
+they get the same math.
+================
+*/
+ID_SSE2_FUNC static void R_CalcPointCullSSE2( unsigned short *pointCull, const idPlane frustum[6], int frontBits, const idDrawVert *verts, int numVerts ) {
+	const __m128 epsilon = _mm_set1_ps( LIGHT_CLIP_EPSILON );
+	const __m128 negEpsilon = _mm_set1_ps( -LIGHT_CLIP_EPSILON );
+	const __m128i front = _mm_set1_epi32( frontBits );
+	const int count = numVerts & ~3;
+	idDrawVert lastVerts[4];
+	unsigned short lastPointCull[4];
+
+	for ( int i = 0; i < numVerts; i += 4 ) {
+		if ( i == count ) {
+			// copy the remaining vertexes so the loads stay inside the array
+			idDrawVert pad;
+			pad.Clear();
+			for ( int j = 0; j < 4; j++ ) {
+				lastVerts[j] = ( i + j < numVerts ) ? verts[i+j] : pad;
+			}
+			R_CalcPointCullSSE2( lastPointCull, frustum, frontBits, lastVerts, 4 );
+			memcpy( pointCull + i, lastPointCull, ( numVerts - i ) * sizeof( pointCull[0] ) );
+			break;
+		}
+
+		// the fourth float of each load is the s texture coordinate and is ignored
+		__m128 x = _mm_loadu_ps( verts[i+0].xyz.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( verts[i+1].xyz.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( verts[i+2].xyz.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( verts[i+3].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		__m128i bits = front;
+		for ( int j = 0; j < 6; j++ ) {
+			if ( frontBits & ( 1 << ( j + 6 ) ) ) {
+				continue;
+			}
+			const idPlane &plane = frustum[j];
+#ifdef R_SHADOW_SSE_DOT_ORDER
+			const __m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps( plane[0] ), x ), _mm_set1_ps( plane[3] ) ),
+									_mm_mul_ps( _mm_set1_ps( plane[1] ), y ) ), _mm_mul_ps( _mm_set1_ps( plane[2] ), z ) );
+#else
+			const __m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps( plane[0] ), x ),
+									_mm_mul_ps( _mm_set1_ps( plane[1] ), y ) ), _mm_mul_ps( _mm_set1_ps( plane[2] ), z ) ), _mm_set1_ps( plane[3] ) );
+#endif
+			bits = _mm_or_si128( bits, _mm_and_si128( _mm_castps_si128( _mm_cmplt_ps( d, epsilon ) ), _mm_set1_epi32( 1 << j ) ) );
+			bits = _mm_or_si128( bits, _mm_and_si128( _mm_castps_si128( _mm_cmpgt_ps( d, negEpsilon ) ), _mm_set1_epi32( 1 << ( j + 6 ) ) ) );
+		}
+
+		// all bits fit in 12 bits so the signed pack can't saturate
+		_mm_storel_epi64( (__m128i *)( pointCull + i ), _mm_packs_epi32( bits, bits ) );
+	}
+}
+#endif
+
 /*
 ================
 R_CalcPointCull
@@ -756,6 +823,14 @@ static void R_CalcPointCull( const srfTriangles_t *tri, const idPlane frustum[6]
 		}
 	}
 
+#ifdef ID_SSE2_INTRINSICS
+	// if the surface is not completely inside the light frustum
+	if ( frontBits != ( ( ( 1 << 6 ) - 1 ) ) << 6 && R_UseShadowSSE2() ) {
+		R_CalcPointCullSSE2( pointCull, frustum, frontBits, tri->verts, tri->numVerts );
+		return;
+	}
+#endif
+
 	// initialize point cull
 	for ( i = 0; i < tri->numVerts; i++ ) {
 		pointCull[i] = frontBits;
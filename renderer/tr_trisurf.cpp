@@ -540,6 +540,231 @@ srfTriangles_t *R_CopyStaticTriSurf( const srfTriangles_t *tri ) {
 	return newTri;
 }
 
+// flags written in front of each surface by R_WriteStaticTriSurf
+#define TRISURF_GENERATE_NORMALS		BIT( 0 )
+#define TRISURF_TANGENTS_CALCULATED		BIT( 1 )
+#define TRISURF_FACE_PLANES_CALCULATED	BIT( 2 )
+#define TRISURF_PERFECT_HULL			BIT( 3 )
+#define TRISURF_VERTS					BIT( 4 )
+#define TRISURF_SIL_INDEXES				BIT( 5 )
+#define TRISURF_DOMINANT_TRIS			BIT( 6 )
+#define TRISURF_FACE_PLANES				BIT( 7 )
+#define TRISURF_SHADOW_VERTS			BIT( 8 )
+
+/*
+=================
+R_WriteStaticTriSurf
+
+Writes a cleaned up surface with all of its derived data, so R_ReadStaticTriSurf
+can restore it without another R_CleanupTriangles.
+=================
+*/
+void R_WriteStaticTriSurf( idFile *file, const srfTriangles_t *tri ) {
+	int flags = 0;
+
+	if ( tri->generateNormals ) {
+		flags |= TRISURF_GENERATE_NORMALS;
+	}
+	if ( tri->tangentsCalculated ) {
+		flags |= TRISURF_TANGENTS_CALCULATED;
+	}
+	if ( tri->facePlanesCalculated ) {
+		flags |= TRISURF_FACE_PLANES_CALCULATED;
+	}
+	if ( tri->perfectHull ) {
+		flags |= TRISURF_PERFECT_HULL;
+	}
+	if ( tri->verts ) {
+		flags |= TRISURF_VERTS;
+	}
+	if ( tri->silIndexes ) {
+		flags |= TRISURF_SIL_INDEXES;
+	}
+	if ( tri->dominantTris ) {
+		flags |= TRISURF_DOMINANT_TRIS;
+	}
+	if ( tri->facePlanes ) {
+		flags |= TRISURF_FACE_PLANES;
+	}
+	if ( tri->shadowVertexes ) {
+		flags |= TRISURF_SHADOW_VERTS;
+	}
+
+	file->WriteInt( flags );
+	file->WriteVec3( tri->bounds[0] );
+	file->WriteVec3( tri->bounds[1] );
+	file->WriteInt( tri->numVerts );
+	file->WriteInt( tri->numIndexes );
+	file->WriteInt( tri->numSilEdges );
+	file->WriteInt( tri->numMirroredVerts );
+	file->WriteInt( tri->numDupVerts );
+	file->WriteInt( tri->numShadowIndexesNoFrontCaps );
+	file->WriteInt( tri->numShadowIndexesNoCaps );
+	file->WriteInt( tri->shadowCapPlaneBits );
+
+	if ( tri->verts ) {
+		file->Write( tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
+	}
+	file->Write( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+	if ( tri->silIndexes ) {
+		file->Write( tri->silIndexes, tri->numIndexes * sizeof( tri->silIndexes[0] ) );
+	}
+	file->Write( tri->silEdges, tri->numSilEdges * sizeof( tri->silEdges[0] ) );
+	file->Write( tri->mirroredVerts, tri->numMirroredVerts * sizeof( tri->mirroredVerts[0] ) );
+	file->Write( tri->dupVerts, tri->numDupVerts * 2 * sizeof( tri->dupVerts[0] ) );
+	if ( tri->dominantTris ) {
+		file->Write( tri->dominantTris, tri->numVerts * sizeof( tri->dominantTris[0] ) );
+	}
+	if ( tri->facePlanes ) {
+		file->Write( tri->facePlanes, ( tri->numIndexes / 3 ) * sizeof( tri->facePlanes[0] ) );
+	}
+	if ( tri->shadowVertexes ) {
+		file->Write( tri->shadowVertexes, tri->numVerts * sizeof( tri->shadowVertexes[0] ) );
+	}
+}
+
+/*
+=================
+R_ReadTriSurfBlock
+
+Reads count elements if the file has that much data left.
+=================
+*/
+static bool R_ReadTriSurfBlock( idFile *file, void *data, int count, int size ) {
+	if ( count == 0 ) {
+		return true;
+	}
+	if ( count < 0 || count > ( file->Length() - file->Tell() ) / size ) {
+		return false;
+	}
+	return ( file->Read( data, count * size ) == count * size );
+}
+
+/*
+=================
+R_CheckTriSurfIndexes
+=================
+*/
+static bool R_CheckTriSurfIndexes( const glIndex_t *indexes, int numIndexes, int numVerts ) {
+	for ( int i = 0 ; i < numIndexes ; i++ ) {
+		if ( indexes[i] < 0 || indexes[i] >= numVerts ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+=================
+R_ReadStaticTriSurf
+
+Returns NULL if the data is truncated or out of range.
+=================
+*/
+srfTriangles_t *R_ReadStaticTriSurf( idFile *file ) {
+	srfTriangles_t *tri;
+	int flags, i;
+
+	tri = R_AllocStaticTriSurf();
+
+	file->ReadInt( flags );
+	file->ReadVec3( tri->bounds[0] );
+	file->ReadVec3( tri->bounds[1] );
+	file->ReadInt( tri->numVerts );
+	file->ReadInt( tri->numIndexes );
+	file->ReadInt( tri->numSilEdges );
+	file->ReadInt( tri->numMirroredVerts );
+	file->ReadInt( tri->numDupVerts );
+	file->ReadInt( tri->numShadowIndexesNoFrontCaps );
+	file->ReadInt( tri->numShadowIndexesNoCaps );
+	file->ReadInt( tri->shadowCapPlaneBits );
+
+	tri->generateNormals = ( flags & TRISURF_GENERATE_NORMALS ) != 0;
+	tri->tangentsCalculated = ( flags & TRISURF_TANGENTS_CALCULATED ) != 0;
+	tri->facePlanesCalculated = ( flags & TRISURF_FACE_PLANES_CALCULATED ) != 0;
+	tri->perfectHull = ( flags & TRISURF_PERFECT_HULL ) != 0;
+
+	// check the counts before allocating anything
+	const int remaining = file->Length() - file->Tell();
+	if ( tri->numVerts < 0 || tri->numVerts > remaining || tri->numIndexes < 0 || tri->numIndexes > remaining
+			|| tri->numIndexes % 3 != 0 || tri->numSilEdges < 0 || tri->numSilEdges > remaining
+			|| tri->numMirroredVerts < 0 || tri->numMirroredVerts > tri->numVerts
+			|| tri->numDupVerts < 0 || tri->numDupVerts > tri->numVerts
+			|| tri->numShadowIndexesNoCaps < 0 || tri->numShadowIndexesNoCaps > tri->numShadowIndexesNoFrontCaps
+			|| tri->numShadowIndexesNoFrontCaps > tri->numIndexes
+			|| ( tri->shadowCapPlaneBits & ~( 63 | SHADOW_CAP_INFINITE ) ) != 0 ) {
+		R_ReallyFreeStaticTriSurf( tri );
+		return NULL;
+	}
+
+	bool ok = true;
+
+	if ( flags & TRISURF_VERTS ) {
+		R_AllocStaticTriSurfVerts( tri, tri->numVerts );
+		ok = ok && R_ReadTriSurfBlock( file, tri->verts, tri->numVerts, sizeof( tri->verts[0] ) );
+	}
+	R_AllocStaticTriSurfIndexes( tri, tri->numIndexes );
+	ok = ok && R_ReadTriSurfBlock( file, tri->indexes, tri->numIndexes, sizeof( tri->indexes[0] ) );
+	if ( flags & TRISURF_SIL_INDEXES ) {
+		tri->silIndexes = triSilIndexAllocator.Alloc( tri->numIndexes );
+		ok = ok && R_ReadTriSurfBlock( file, tri->silIndexes, tri->numIndexes, sizeof( tri->silIndexes[0] ) );
+	}
+	if ( tri->numSilEdges ) {
+		tri->silEdges = triSilEdgeAllocator.Alloc( tri->numSilEdges );
+		ok = ok && R_ReadTriSurfBlock( file, tri->silEdges, tri->numSilEdges, sizeof( tri->silEdges[0] ) );
+	}
+	if ( tri->numMirroredVerts ) {
+		tri->mirroredVerts = triMirroredVertAllocator.Alloc( tri->numMirroredVerts );
+		ok = ok && R_ReadTriSurfBlock( file, tri->mirroredVerts, tri->numMirroredVerts, sizeof( tri->mirroredVerts[0] ) );
+	}
+	if ( tri->numDupVerts ) {
+		tri->dupVerts = triDupVertAllocator.Alloc( tri->numDupVerts * 2 );
+		ok = ok && R_ReadTriSurfBlock( file, tri->dupVerts, tri->numDupVerts * 2, sizeof( tri->dupVerts[0] ) );
+	}
+	if ( flags & TRISURF_DOMINANT_TRIS ) {
+		tri->dominantTris = triDominantTrisAllocator.Alloc( tri->numVerts );
+		ok = ok && R_ReadTriSurfBlock( file, tri->dominantTris, tri->numVerts, sizeof( tri->dominantTris[0] ) );
+	}
+	if ( flags & TRISURF_FACE_PLANES ) {
+		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
+		ok = ok && R_ReadTriSurfBlock( file, tri->facePlanes, tri->numIndexes / 3, sizeof( tri->facePlanes[0] ) );
+	}
+	if ( flags & TRISURF_SHADOW_VERTS ) {
+		R_AllocStaticTriSurfShadowVerts( tri, tri->numVerts );
+		ok = ok && R_ReadTriSurfBlock( file, tri->shadowVertexes, tri->numVerts, sizeof( tri->shadowVertexes[0] ) );
+	}
+
+	// make sure nothing points outside of the surface
+	if ( ok ) {
+		ok = R_CheckTriSurfIndexes( tri->indexes, tri->numIndexes, tri->numVerts );
+	}
+	if ( ok && tri->silIndexes ) {
+		ok = R_CheckTriSurfIndexes( tri->silIndexes, tri->numIndexes, tri->numVerts );
+	}
+	for ( i = 0 ; ok && i < tri->numSilEdges ; i++ ) {
+		const silEdge_t &edge = tri->silEdges[i];
+		ok = edge.v1 >= 0 && edge.v1 < tri->numVerts && edge.v2 >= 0 && edge.v2 < tri->numVerts
+			&& edge.p1 >= 0 && edge.p1 <= tri->numIndexes / 3 && edge.p2 >= 0 && edge.p2 <= tri->numIndexes / 3;
+	}
+	if ( ok && tri->mirroredVerts ) {
+		ok = R_CheckTriSurfIndexes( tri->mirroredVerts, tri->numMirroredVerts, tri->numVerts );
+	}
+	if ( ok && tri->dupVerts ) {
+		ok = R_CheckTriSurfIndexes( tri->dupVerts, tri->numDupVerts * 2, tri->numVerts );
+	}
+	for ( i = 0 ; ok && tri->dominantTris && i < tri->numVerts ; i++ ) {
+		const dominantTri_t &dt = tri->dominantTris[i];
+		ok = dt.v2 >= 0 && dt.v2 < tri->numVerts && dt.v3 >= 0 && dt.v3 < tri->numVerts;
+	}
+
+	if ( !ok ) {
+		R_ReallyFreeStaticTriSurf( tri );
+		return NULL;
+	}
+
+	return tri;
+}
+
 /*
 =================
 R_AllocStaticTriSurfVerts
@@ -1630,31 +1855,15 @@ void R_DeriveUnsmoothedTangents( srfTriangles_t *tri ) {
 
 /*
 ==================
-R_DeriveTangents
-
-This is called once for static surfaces, and every frame for deforming surfaces
+R_DeriveSmoothedTangents
 
-Builds tangents, normals, and face planes
+Builds tangents, normals, and face planes if tri->facePlanes is allocated
 ==================
 */
-void R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes ) {
+static void R_DeriveSmoothedTangents( srfTriangles_t *tri ) {
 	int				i;
 	idPlane			*planes;
 
-	if ( tri->dominantTris != NULL ) {
-		R_DeriveUnsmoothedTangents( tri );
-		return;
-	}
-
-	if ( tri->tangentsCalculated ) {
-		return;
-	}
-
-	tr.pc.c_tangentIndexes += tri->numIndexes;
-
-	if ( !tri->facePlanes && allocFacePlanes ) {
-		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
-	}
 	planes = tri->facePlanes;
 
 #if 1
@@ -1822,6 +2031,55 @@ void R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes ) {
 	tri->facePlanesCalculated = true;
 }
 
+/*
+==================
+R_DeriveTangents
+
+This is called once for static surfaces, and every frame for deforming surfaces
+
+Builds tangents, normals, and face planes
+==================
+*/
+void R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes ) {
+	if ( tri->dominantTris != NULL ) {
+		R_DeriveUnsmoothedTangents( tri );
+		return;
+	}
+
+	if ( tri->tangentsCalculated ) {
+		return;
+	}
+
+	tr.pc.c_tangentIndexes += tri->numIndexes;
+
+	if ( !tri->facePlanes && allocFacePlanes ) {
+		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
+	}
+
+	R_DeriveSmoothedTangents( tri );
+}
+
+/*
+==================
+R_DeriveTangentsNoAlloc
+
+R_DeriveTangents for jobs, the face planes have to be allocated up front if
+they are wanted and the caller has to count the tangent indexes
+==================
+*/
+void R_DeriveTangentsNoAlloc( srfTriangles_t *tri ) {
+	if ( tri->dominantTris != NULL ) {
+		R_DeriveUnsmoothedTangents( tri );
+		return;
+	}
+
+	if ( tri->tangentsCalculated ) {
+		return;
+	}
+
+	R_DeriveSmoothedTangents( tri );
+}
+
 /*
 =================
 R_RemoveDuplicatedTriangles
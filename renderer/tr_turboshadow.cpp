@@ -24,40 +24,166 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "tr_local.h"
 
+#ifdef ID_SSE2_INTRINSICS
+#include <emmintrin.h>
+#endif
+
 int	c_turboUsedVerts;
 int c_turboUnusedVerts;
 
+#ifdef ID_SSE2_INTRINSICS
+/*
+=====================
+R_CountFacingSSE2
+
+Counts the facing triangles sixteen at a time, the facing bytes are 0 or 1 so
+the byte sums can't overflow. Only the first ( numFaces & ~15 ) are counted.
+=====================
+*/
+ID_SSE2_FUNC static int R_CountFacingSSE2( const byte *facing, int numFaces ) {
+	const __m128i zero = _mm_setzero_si128();
+	const int count = numFaces & ~15;
+	__m128i sum = zero;
+
+	for ( int i = 0; i < count; i += 16 ) {
+		sum = _mm_add_epi64( sum, _mm_sad_epu8( _mm_loadu_si128( (const __m128i *)( facing + i ) ), zero ) );
+	}
+	return _mm_cvtsi128_si32( sum ) + _mm_cvtsi128_si32( _mm_srli_si128( sum, 8 ) );
+}
 
 /*
 =====================
-R_CreateVertexProgramTurboShadowVolume
+R_CreateSilIndexesSSE2
 
-are dangling edges that are outside the light frustum still making planes?
+Finds the silhouette edges four at a time. The facing of both sides of four
+edges is gathered into vectors, so a group without any silhouette edge is
+skipped with a single test, which is by far the most common case. The quads
+are built in the vectors as well and written out in edge order, so the indexes
+are identical to the C code. Only the first ( numSilEdges & ~3 ) edges are done.
 =====================
 */
-srfTriangles_t *R_CreateVertexProgramTurboShadowVolume( const idRenderEntityLocal *ent, 
-														const srfTriangles_t *tri, const idRenderLightLocal *light,
-														srfCullInfo_t &cullInfo ) {
-	int		i, j;
-	srfTriangles_t	*newTri;
-	silEdge_t	*sil;
-	const glIndex_t *indexes;
-	const byte *facing;
+ID_SSE2_FUNC static glIndex_t *R_CreateSilIndexesSSE2( glIndex_t *shadowIndexes, const byte *facing, const silEdge_t *sil, int numSilEdges, const int *vertRemap ) {
+	ALIGN16( int quads[6][4] );
+	const __m128i one = _mm_set1_epi32( 1 );
+	const int count = numSilEdges & ~3;
 
-	R_CalcInteractionFacing( ent, tri, light, cullInfo );
-	if ( r_useShadowProjectedCull.GetBool() ) {
-		R_CalcInteractionCullBits( ent, tri, light, cullInfo );
+	for ( int i = 0; i < count; i += 4, sil += 4 ) {
+		const __m128i f1 = _mm_setr_epi32( facing[sil[0].p1], facing[sil[1].p1], facing[sil[2].p1], facing[sil[3].p1] );
+		const __m128i f2 = _mm_setr_epi32( facing[sil[0].p2], facing[sil[1].p2], facing[sil[2].p2], facing[sil[3].p2] );
+		const int silMask = _mm_movemask_ps( _mm_castsi128_ps( _mm_slli_epi32( _mm_xor_si128( f1, f2 ), 31 ) ) );
+
+		if ( !silMask ) {
+			continue;
+		}
+
+		__m128i v1, v2;
+		if ( vertRemap ) {
+			v1 = _mm_setr_epi32( vertRemap[sil[0].v1], vertRemap[sil[1].v1], vertRemap[sil[2].v1], vertRemap[sil[3].v1] );
+			v2 = _mm_setr_epi32( vertRemap[sil[0].v2], vertRemap[sil[1].v2], vertRemap[sil[2].v2], vertRemap[sil[3].v2] );
+		} else {
+			v1 = _mm_slli_epi32( _mm_setr_epi32( sil[0].v1, sil[1].v1, sil[2].v1, sil[3].v1 ), 1 );
+			v2 = _mm_slli_epi32( _mm_setr_epi32( sil[0].v2, sil[1].v2, sil[2].v2, sil[3].v2 ), 1 );
+		}
+
+		_mm_store_si128( (__m128i *)quads[0], v1 );
+		_mm_store_si128( (__m128i *)quads[1], _mm_xor_si128( v2, f1 ) );
+		_mm_store_si128( (__m128i *)quads[2], _mm_xor_si128( v2, f2 ) );
+		_mm_store_si128( (__m128i *)quads[3], _mm_xor_si128( v1, f2 ) );
+		_mm_store_si128( (__m128i *)quads[4], _mm_xor_si128( v1, f1 ) );
+		_mm_store_si128( (__m128i *)quads[5], _mm_xor_si128( v2, one ) );
+
+		for ( int j = 0; j < 4; j++ ) {
+			if ( !( silMask & ( 1 << j ) ) ) {
+				continue;
+			}
+			shadowIndexes[0] = quads[0][j];
+			shadowIndexes[1] = quads[1][j];
+			shadowIndexes[2] = quads[2][j];
+			shadowIndexes[3] = quads[3][j];
+			shadowIndexes[4] = quads[4][j];
+			shadowIndexes[5] = quads[5][j];
+			shadowIndexes += 6;
+		}
 	}
+	return shadowIndexes;
+}
 
-	int numFaces = tri->numIndexes / 3;
-	int	numShadowingFaces = 0;
-	facing = cullInfo.facing;
+/*
+=====================
+R_CreateCapIndexesSSE2
+
+Tests the facing of sixteen triangles at once and skips the whole block if
+all of them are facing the light. Only the first ( numFaces & ~15 ) triangles
+are done.
+=====================
+*/
+ID_SSE2_FUNC static glIndex_t *R_CreateCapIndexesSSE2( glIndex_t *shadowIndexes, const byte *facing, const glIndex_t *indexes, int numFaces, const int *vertRemap ) {
+	const __m128i zero = _mm_setzero_si128();
+	const int count = numFaces & ~15;
+
+	for ( int i = 0; i < count; i += 16 ) {
+		const int capMask = _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i *)( facing + i ) ), zero ) );
+
+		if ( !capMask ) {
+			continue;
+		}
+
+		for ( int j = 0; j < 16; j++ ) {
+			if ( !( capMask & ( 1 << j ) ) ) {
+				continue;
+			}
+			const glIndex_t *tri = indexes + ( i + j ) * 3;
+			int i0, i1, i2;
+			if ( vertRemap ) {
+				i0 = vertRemap[tri[0]];
+				i1 = vertRemap[tri[1]];
+				i2 = vertRemap[tri[2]];
+			} else {
+				i0 = tri[0] << 1;
+				i1 = tri[1] << 1;
+				i2 = tri[2] << 1;
+			}
+			shadowIndexes[0] = i2;
+			shadowIndexes[1] = i1;
+			shadowIndexes[2] = i0;
+			shadowIndexes[3] = i0 ^ 1;
+			shadowIndexes[4] = i1 ^ 1;
+			shadowIndexes[5] = i2 ^ 1;
+			shadowIndexes += 6;
+		}
+	}
+	return shadowIndexes;
+}
+#endif
+
+/*
+=====================
+R_CalcShadowingFaces
+
+Returns the number of triangles that face away from the light and are at
+least partially inside the light frustum. Triangles outside the light frustum
+are made "facing", so they won't cast shadows.
+=====================
+*/
+static int R_CalcShadowingFaces( const srfTriangles_t *tri, srfCullInfo_t &cullInfo ) {
+	int		i, j;
+	int		numFaces = tri->numIndexes / 3;
+	int		numShadowingFaces = 0;
 
 	// if all the triangles are inside the light frustum
 	if ( cullInfo.cullBits == LIGHT_CULL_ALL_FRONT || !r_useShadowProjectedCull.GetBool() ) {
 
+		const byte *facing = cullInfo.facing;
+
 		// count the number of shadowing faces
-		for ( i = 0; i < numFaces; i++ ) {
+		i = 0;
+#ifdef ID_SSE2_INTRINSICS
+		if ( R_UseShadowSSE2() ) {
+			numShadowingFaces = R_CountFacingSSE2( facing, numFaces );
+			i = numFaces & ~15;
+		}
+#endif
+		for ( ; i < numFaces; i++ ) {
 			numShadowingFaces += facing[i];
 		}
 		numShadowingFaces = numFaces - numShadowingFaces;
@@ -65,7 +191,7 @@ srfTriangles_t *R_CreateVertexProgramTurboShadowVolume( const idRenderEntityLoca
 	} else {
 
 		// make all triangles that are outside the light frustum "facing", so they won't cast shadows
-		indexes = tri->indexes;
+		const glIndex_t *indexes = tri->indexes;
 		byte *modifyFacing = cullInfo.facing;
 		const byte *cullBits = cullInfo.cullBits;
 		for ( j = i = 0; i < tri->numIndexes; i += 3, j++ ) {
@@ -82,28 +208,31 @@ srfTriangles_t *R_CreateVertexProgramTurboShadowVolume( const idRenderEntityLoca
 		}
 	}
 
-	if ( !numShadowingFaces ) {
-		// no faces are inside the light frustum and still facing the right way
-		return NULL;
-	}
-
-	// shadowVerts will be NULL on these surfaces, so the shadowVerts will be taken from the ambient surface
-	newTri = R_AllocStaticTriSurf();
+	return numShadowingFaces;
+}
 
-	newTri->numVerts = tri->numVerts * 2;
+/*
+=====================
+R_CreateSilIndexes
 
-	// alloc the max possible size
-#ifdef USE_TRI_DATA_ALLOCATOR
-	R_AllocStaticTriSurfIndexes( newTri, ( numShadowingFaces + tri->numSilEdges ) * 6 );
-	glIndex_t *tempIndexes = newTri->indexes;
-	glIndex_t *shadowIndexes = newTri->indexes;
-#else
-	glIndex_t *tempIndexes = (glIndex_t *)_alloca16( tri->numSilEdges * 6 * sizeof( tempIndexes[0] ) );
-	glIndex_t *shadowIndexes = tempIndexes;
+Creates new triangles along the silhouette planes. Without a vertRemap the
+shadow verts are laid out for the vertex program, with the projected vertex
+of v at v * 2 + 1. Returns the end of the written indexes.
+=====================
+*/
+static glIndex_t *R_CreateSilIndexes( glIndex_t *shadowIndexes, const byte *facing, const srfTriangles_t *tri, const int *vertRemap ) {
+	const silEdge_t *sil = tri->silEdges;
+	int i = 0;
+
+#ifdef ID_SSE2_INTRINSICS
+	if ( R_UseShadowSSE2() ) {
+		shadowIndexes = R_CreateSilIndexesSSE2( shadowIndexes, facing, sil, tri->numSilEdges, vertRemap );
+		i = tri->numSilEdges & ~3;
+		sil += i;
+	}
 #endif
 
-	// create new triangles along sil planes
-	for ( sil = tri->silEdges, i = tri->numSilEdges; i > 0; i--, sil++ ) {
+	for ( ; i < tri->numSilEdges; i++, sil++ ) {
 
 		int f1 = facing[sil->p1];
 		int f2 = facing[sil->p2];
@@ -112,8 +241,14 @@ srfTriangles_t *R_CreateVertexProgramTurboShadowVolume( const idRenderEntityLoca
 			continue;
 		}
 
-		int v1 = sil->v1 << 1;
-		int v2 = sil->v2 << 1;
+		int v1, v2;
+		if ( vertRemap ) {
+			v1 = vertRemap[sil->v1];
+			v2 = vertRemap[sil->v2];
+		} else {
+			v1 = sil->v1 << 1;
+			v2 = sil->v2 << 1;
+		}
 
 		// set the two triangle winding orders based on facing
 		// without using a poorly-predictable branch
@@ -128,6 +263,98 @@ srfTriangles_t *R_CreateVertexProgramTurboShadowVolume( const idRenderEntityLoca
 		shadowIndexes += 6;
 	}
 
+	return shadowIndexes;
+}
+
+/*
+=====================
+R_CreateCapIndexes
+
+Puts some faces on the model and some on the distant projection. The
+vertRemap works like for R_CreateSilIndexes.
+=====================
+*/
+static void R_CreateCapIndexes( glIndex_t *shadowIndexes, const byte *facing, const glIndex_t *indexes, int numIndexes, const int *vertRemap ) {
+	int i = 0, j = 0;
+
+#ifdef ID_SSE2_INTRINSICS
+	if ( R_UseShadowSSE2() ) {
+		shadowIndexes = R_CreateCapIndexesSSE2( shadowIndexes, facing, indexes, numIndexes / 3, vertRemap );
+		j = ( numIndexes / 3 ) & ~15;
+		i = j * 3;
+	}
+#endif
+
+	for ( ; i < numIndexes; i += 3, j++ ) {
+		if ( facing[j] ) {
+			continue;
+		}
+
+		int i0, i1, i2;
+		if ( vertRemap ) {
+			i0 = vertRemap[indexes[i+0]];
+			i1 = vertRemap[indexes[i+1]];
+			i2 = vertRemap[indexes[i+2]];
+		} else {
+			i0 = indexes[i+0] << 1;
+			i1 = indexes[i+1] << 1;
+			i2 = indexes[i+2] << 1;
+		}
+		shadowIndexes[2] = i0;
+		shadowIndexes[3] = i0 ^ 1;
+		shadowIndexes[1] = i1;
+		shadowIndexes[4] = i1 ^ 1;
+		shadowIndexes[0] = i2;
+		shadowIndexes[5] = i2 ^ 1;
+
+		shadowIndexes += 6;
+	}
+}
+
+/*
+=====================
+R_CreateVertexProgramTurboShadowVolume
+
+are dangling edges that are outside the light frustum still making planes?
+=====================
+*/
+srfTriangles_t *R_CreateVertexProgramTurboShadowVolume( const idRenderEntityLocal *ent, 
+														const srfTriangles_t *tri, const idRenderLightLocal *light,
+														srfCullInfo_t &cullInfo ) {
+	srfTriangles_t	*newTri;
+	const byte *facing;
+
+	R_CalcInteractionFacing( ent, tri, light, cullInfo );
+	if ( r_useShadowProjectedCull.GetBool() ) {
+		R_CalcInteractionCullBits( ent, tri, light, cullInfo );
+	}
+
+	int	numShadowingFaces = R_CalcShadowingFaces( tri, cullInfo );
+	facing = cullInfo.facing;
+
+	if ( !numShadowingFaces ) {
+		// no faces are inside the light frustum and still facing the right way
+		return NULL;
+	}
+
+	// shadowVerts will be NULL on these surfaces, so the shadowVerts will be taken from the ambient surface
+	newTri = R_AllocStaticTriSurf();
+
+	newTri->numVerts = tri->numVerts * 2;
+
+	// alloc the max possible size
+#ifdef USE_TRI_DATA_ALLOCATOR
+	R_AllocStaticTriSurfIndexes( newTri, ( numShadowingFaces + tri->numSilEdges ) * 6 );
+	glIndex_t *tempIndexes = newTri->indexes;
+	glIndex_t *shadowIndexes = newTri->indexes;
+#else
+	glIndex_t *tempIndexes = (glIndex_t *)_alloca16( tri->numSilEdges * 6 * sizeof( tempIndexes[0] ) );
+	glIndex_t *shadowIndexes = tempIndexes;
+#endif
+
+	// create new triangles along sil planes
+	shadowIndexes = R_CreateSilIndexes( shadowIndexes, facing, tri, NULL );
+
 	int	numShadowIndexes = shadowIndexes - tempIndexes;
 
 	// we aren't bothering to separate front and back caps on these
@@ -149,25 +376,7 @@ srfTriangles_t *R_CreateVertexProgramTurboShadowVolume( const idRenderEntityLoca
 	newTri->bounds.Clear();
 
 	// put some faces on the model and some on the distant projection
-	indexes = tri->indexes;
-	shadowIndexes = newTri->indexes + numShadowIndexes;
-	for ( i = 0, j = 0; i < tri->numIndexes; i += 3, j++ ) {
-		if ( facing[j] ) {
-			continue;
-		}
-
-		int i0 = indexes[i+0] << 1;
-		shadowIndexes[2] = i0;
-		shadowIndexes[3] = i0 ^ 1;
-		int i1 = indexes[i+1] << 1;
-		shadowIndexes[1] = i1;
-		shadowIndexes[4] = i1 ^ 1;
-		int i2 = indexes[i+2] << 1;
-		shadowIndexes[0] = i2;
-		shadowIndexes[5] = i2 ^ 1;
-
-		shadowIndexes += 6;
-	}
+	R_CreateCapIndexes( newTri->indexes + numShadowIndexes, facing, tri->indexes, tri->numIndexes, NULL );
 
 	return newTri;
 }
@@ -183,8 +392,6 @@ srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 	int		i, j;
 	idVec3	localLightOrigin;
 	srfTriangles_t	*newTri;
-	silEdge_t	*sil;
-	const glIndex_t *indexes;
 	const byte *facing;
 
 	R_CalcInteractionFacing( ent, tri, light, cullInfo );
@@ -192,39 +399,9 @@ srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 		R_CalcInteractionCullBits( ent, tri, light, cullInfo );
 	}
 
-	int numFaces = tri->numIndexes / 3;
-	int	numShadowingFaces = 0;
+	int	numShadowingFaces = R_CalcShadowingFaces( tri, cullInfo );
 	facing = cullInfo.facing;
 
-	// if all the triangles are inside the light frustum
-	if ( cullInfo.cullBits == LIGHT_CULL_ALL_FRONT || !r_useShadowProjectedCull.GetBool() ) {
-
-		// count the number of shadowing faces
-		for ( i = 0; i < numFaces; i++ ) {
-			numShadowingFaces += facing[i];
-		}
-		numShadowingFaces = numFaces - numShadowingFaces;
-
-	} else {
-
-		// make all triangles that are outside the light frustum "facing", so they won't cast shadows
-		indexes = tri->indexes;
-		byte *modifyFacing = cullInfo.facing;
-		const byte *cullBits = cullInfo.cullBits;
-		for ( j = i = 0; i < tri->numIndexes; i += 3, j++ ) {
-			if ( !modifyFacing[j] ) {
-				int	i1 = indexes[i+0];
-				int	i2 = indexes[i+1];
-				int	i3 = indexes[i+2];
-				if ( cullBits[i1] & cullBits[i2] & cullBits[i3] ) {
-					modifyFacing[j] = 1;
-				} else {
-					numShadowingFaces++;
-				}
-			}
-		}
-	}
-
 	if ( !numShadowingFaces ) {
 		// no faces are inside the light frustum and still facing the right way
 		return NULL;
@@ -279,30 +456,7 @@ srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 #endif
 
 	// create new triangles along sil planes
-	for ( sil = tri->silEdges, i = tri->numSilEdges; i > 0; i--, sil++ ) {
-
-		int f1 = facing[sil->p1];
-		int f2 = facing[sil->p2];
-
-		if ( !( f1 ^ f2 ) ) {
-			continue;
-		}
-
-		int v1 = vertRemap[sil->v1];
-		int v2 = vertRemap[sil->v2];
-
-		// set the two triangle winding orders based on facing
-		// without using a poorly-predictable branch
-
-		shadowIndexes[0] = v1;
-		shadowIndexes[1] = v2 ^ f1;
-		shadowIndexes[2] = v2 ^ f2;
-		shadowIndexes[3] = v1 ^ f2;
-		shadowIndexes[4] = v1 ^ f1;
-		shadowIndexes[5] = v2 ^ 1;
-
-		shadowIndexes += 6;
-	}
+	shadowIndexes = R_CreateSilIndexes( shadowIndexes, facing, tri, vertRemap );
 
 	int numShadowIndexes = shadowIndexes - tempIndexes;
 
@@ -325,25 +479,7 @@ srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 	newTri->bounds.Clear();
 
 	// put some faces on the model and some on the distant projection
-	indexes = tri->silIndexes;
-	shadowIndexes = newTri->indexes + numShadowIndexes;
-	for ( i = 0, j = 0; i < tri->numIndexes; i += 3, j++ ) {
-		if ( facing[j] ) {
-			continue;
-		}
-
-		int i0 = vertRemap[indexes[i+0]];
-		shadowIndexes[2] = i0;
-		shadowIndexes[3] = i0 ^ 1;
-		int i1 = vertRemap[indexes[i+1]];
-		shadowIndexes[1] = i1;
-		shadowIndexes[4] = i1 ^ 1;
-		int i2 = vertRemap[indexes[i+2]];
-		shadowIndexes[0] = i2;
-		shadowIndexes[5] = i2 ^ 1;
-
-		shadowIndexes += 6;
-	}
+	R_CreateCapIndexes( newTri->indexes + numShadowIndexes, facing, tri->silIndexes, tri->numIndexes, vertRemap );
 
 	return newTri;
 }
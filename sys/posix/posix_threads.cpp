@@ -79,6 +79,15 @@ void Sys_LeaveCriticalSection( int index ) {
 #endif
 }
 
+/*
+==================
+Sys_InterlockedIncrement
+==================
+*/
+int Sys_InterlockedIncrement( volatile int &value ) {
+	return __sync_add_and_fetch( &value, 1 );
+}
+
 /*
 ======================================================
 wait and trigger events
@@ -213,7 +213,8 @@ typedef struct sysEvent_s {
 
 typedef unsigned long address_t;
 
-template<class type> class idList;		// for Sys_ListFiles
+class idListNewAllocator;
+template<class type, class allocator = idListNewAllocator> class idList;		// for Sys_ListFiles
 
 
 void			Sys_Init( void );
@@ -492,6 +493,9 @@ enum {
 void				Sys_EnterCriticalSection( int index = CRITICAL_SECTION_ZERO );
 void				Sys_LeaveCriticalSection( int index = CRITICAL_SECTION_ZERO );
 
+// atomically increments value and returns the incremented value
+int					Sys_InterlockedIncrement( volatile int &value );
+
 const int MAX_TRIGGER_EVENTS		= 4;
 
 enum {
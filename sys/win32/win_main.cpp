@@ -162,6 +162,15 @@ void Sys_LeaveCriticalSection( int index ) {
 	LeaveCriticalSection( &win32.criticalSections[index] );
 }
 
+/*
+==================
+Sys_InterlockedIncrement
+==================
+*/
+int Sys_InterlockedIncrement( volatile int &value ) {
+	return InterlockedIncrement( (volatile LONG *)&value );
+}
+
 /*
 ==================
 Sys_WaitForEvent
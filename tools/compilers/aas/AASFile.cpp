@@ -739,11 +739,300 @@ bool idAASFileLocal::Write( const idStr &fileName, const unsigned int mapFileCRC
 	// close file
 	fileSystem->CloseFile( aasFile );
 
+	// write the binary copy that is loaded instead of the text file
+	WriteBinary( fileName, mapFileCRC );
+
 	common->Printf( "done.\n" );
 
 	return true;
 }
 
+/*
+================
+AAS_BinaryFileName
+================
+*/
+static idStr AAS_BinaryFileName( const idStr &fileName ) {
+	return fileName + "b";
+}
+
+/*
+================
+AAS_WriteBinaryList
+================
+*/
+template< class type >
+static void AAS_WriteBinaryList( idFile *fp, const idList<type> &list ) {
+	fp->WriteInt( list.Num() );
+	fp->Write( list.Ptr(), list.Num() * sizeof( type ) );
+}
+
+/*
+================
+AAS_ReadBinaryList
+================
+*/
+template< class type >
+static bool AAS_ReadBinaryList( idFile *fp, idList<type> &list ) {
+	int num;
+
+	if ( fp->ReadInt( num ) != sizeof( num ) || num < 0 || num > ( fp->Length() - fp->Tell() ) / (int)sizeof( type ) ) {
+		return false;
+	}
+	list.SetNum( num );
+	return ( fp->Read( list.Ptr(), num * sizeof( type ) ) == num * (int)sizeof( type ) );
+}
+
+/*
+================
+AAS_BinaryLayout
+
+  Identifies the byte order and the sizes of the structures that are stored
+  with bulk writes, so a file written by a different build is not used.
+================
+*/
+static int AAS_BinaryLayout( void ) {
+	int layout;
+
+	layout = Swap_IsBigEndian() ? 1 : 0;
+	layout = layout * 31 + sizeof( idPlane );
+	layout = layout * 31 + sizeof( aasVertex_t );
+	layout = layout * 31 + sizeof( aasEdge_t );
+	layout = layout * 31 + sizeof( aasIndex_t );
+	layout = layout * 31 + sizeof( aasFace_t );
+	layout = layout * 31 + sizeof( aasNode_t );
+	layout = layout * 31 + sizeof( aasPortal_t );
+	layout = layout * 31 + sizeof( aasCluster_t );
+	return layout;
+}
+
+/*
+================
+idAASFileLocal::WriteBinary
+
+  The binary file holds the same data as the text file. The lists without
+  pointers are stored as raw memory in native byte order so they can be
+  loaded with a single read each.
+================
+*/
+bool idAASFileLocal::WriteBinary( const idStr &fileName, const unsigned int mapFileCRC ) {
+	int i, j, num;
+	idFile *fp;
+	idFile_Memory settingsFile( "settings" );
+	idStr binaryName, settingsText;
+	idReachability *reach;
+	const idKeyValue *keyValue;
+
+	binaryName = AAS_BinaryFileName( fileName );
+	common->Printf( "writing %s\n", binaryName.c_str() );
+
+	fp = fileSystem->OpenFileWrite( binaryName, "fs_devpath", "" );
+	if ( !fp ) {
+		common->Warning( "Error opening %s", binaryName.c_str() );
+		return false;
+	}
+
+	fp->WriteString( AAS_BINARY_FILEID );
+	fp->WriteInt( AAS_BINARY_FILEVERSION );
+	fp->WriteInt( AAS_BinaryLayout() );
+	fp->WriteUnsignedInt( mapFileCRC );
+
+	// the settings are rarely used and small, keep them in their text form
+	settings.WriteToFile( &settingsFile );
+	settingsText.Append( settingsFile.GetDataPtr(), settingsFile.Length() );
+	fp->WriteString( settingsText );
+
+	AAS_WriteBinaryList( fp, planeList );
+	AAS_WriteBinaryList( fp, vertices );
+	AAS_WriteBinaryList( fp, edges );
+	AAS_WriteBinaryList( fp, edgeIndex );
+	AAS_WriteBinaryList( fp, faces );
+	AAS_WriteBinaryList( fp, faceIndex );
+	AAS_WriteBinaryList( fp, nodes );
+	AAS_WriteBinaryList( fp, portals );
+	AAS_WriteBinaryList( fp, portalIndex );
+	AAS_WriteBinaryList( fp, clusters );
+
+	// areas with their reachabilities, the bounds and center are stored so they don't need to be calculated on load
+	fp->WriteInt( areas.Num() );
+	for ( i = 0; i < areas.Num(); i++ ) {
+		const aasArea_t &area = areas[i];
+		fp->WriteUnsignedShort( area.flags );
+		fp->WriteUnsignedShort( area.contents );
+		fp->WriteInt( area.firstFace );
+		fp->WriteInt( area.numFaces );
+		fp->WriteShort( area.cluster );
+		fp->WriteShort( area.clusterAreaNum );
+		fp->WriteVec3( area.bounds[0] );
+		fp->WriteVec3( area.bounds[1] );
+		fp->WriteVec3( area.center );
+		for ( num = 0, reach = area.reach; reach; reach = reach->next ) {
+			num++;
+		}
+		fp->WriteInt( num );
+		for ( reach = area.reach; reach; reach = reach->next ) {
+			fp->WriteInt( reach->travelType );
+			fp->WriteShort( reach->toAreaNum );
+			fp->WriteVec3( reach->start );
+			fp->WriteVec3( reach->end );
+			fp->WriteInt( reach->edgeNum );
+			fp->WriteUnsignedShort( reach->travelTime );
+			if ( reach->travelType == TFL_SPECIAL ) {
+				const idDict &dict = static_cast<idReachability_Special *>(reach)->dict;
+				fp->WriteInt( dict.GetNumKeyVals() );
+				for ( j = 0; j < dict.GetNumKeyVals(); j++ ) {
+					keyValue = dict.GetKeyVal( j );
+					fp->WriteString( keyValue->GetKey() );
+					fp->WriteString( keyValue->GetValue() );
+				}
+			}
+		}
+	}
+
+	fileSystem->CloseFile( fp );
+
+	return true;
+}
+
+/*
+================
+idAASFileLocal::LoadBinary
+================
+*/
+bool idAASFileLocal::LoadBinary( const idStr &fileName, const unsigned int mapFileCRC ) {
+	int i, j, num, numKeyVals, length, version, layout, depth;
+	unsigned int c;
+	void *buffer;
+	idFile_Memory *fp;
+	idStr binaryName, fileId, settingsText, key, value;
+	idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWPATHNAMES );
+	idReachability *newReach;
+	idReachability_Special *special;
+	bool ok;
+
+	binaryName = AAS_BinaryFileName( fileName );
+	length = fileSystem->ReadFile( binaryName, &buffer );
+	if ( length <= 0 ) {
+		return false;
+	}
+
+	fp = new idFile_Memory( binaryName, (const char *) buffer, length );
+
+	fp->ReadString( fileId );
+	fp->ReadInt( version );
+	fp->ReadInt( layout );
+	fp->ReadUnsignedInt( c );
+	if ( fileId != AAS_BINARY_FILEID || version != AAS_BINARY_FILEVERSION || layout != AAS_BinaryLayout() ) {
+		common->Printf( "%s was written by a different version, using the text file\n", binaryName.c_str() );
+		delete fp;
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+	if ( c != mapFileCRC ) {
+		common->Printf( "%s is out of date, using the text file\n", binaryName.c_str() );
+		delete fp;
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	// clear the file in memory
+	Clear();
+
+	fp->ReadString( settingsText );
+	ok = src.LoadMemory( settingsText, settingsText.Length(), binaryName ) && settings.FromParser( src );
+
+	ok = ok && AAS_ReadBinaryList( fp, planeList );
+	ok = ok && AAS_ReadBinaryList( fp, vertices );
+	ok = ok && AAS_ReadBinaryList( fp, edges );
+	ok = ok && AAS_ReadBinaryList( fp, edgeIndex );
+	ok = ok && AAS_ReadBinaryList( fp, faces );
+	ok = ok && AAS_ReadBinaryList( fp, faceIndex );
+	ok = ok && AAS_ReadBinaryList( fp, nodes );
+	ok = ok && AAS_ReadBinaryList( fp, portals );
+	ok = ok && AAS_ReadBinaryList( fp, portalIndex );
+	ok = ok && AAS_ReadBinaryList( fp, clusters );
+
+	num = 0;
+	if ( ok ) {
+		ok = fp->ReadInt( num ) == sizeof( num ) && num >= 0 && num <= ( fp->Length() - fp->Tell() ) / 40;
+	}
+	if ( ok ) {
+		areas.SetNum( num );
+		for ( i = 0; i < num; i++ ) {
+			areas[i].reach = NULL;
+			areas[i].rev_reach = NULL;
+		}
+	}
+	for ( i = 0; ok && i < areas.Num(); i++ ) {
+		aasArea_t &area = areas[i];
+		fp->ReadUnsignedShort( area.flags );
+		fp->ReadUnsignedShort( area.contents );
+		fp->ReadInt( area.firstFace );
+		fp->ReadInt( area.numFaces );
+		fp->ReadShort( area.cluster );
+		fp->ReadShort( area.clusterAreaNum );
+		fp->ReadVec3( area.bounds[0] );
+		fp->ReadVec3( area.bounds[1] );
+		fp->ReadVec3( area.center );
+		area.travelFlags = AreaContentsTravelFlags( i );
+		if ( fp->ReadInt( num ) != sizeof( num ) || num < 0 || num > ( fp->Length() - fp->Tell() ) / 36 ) {
+			ok = false;
+			break;
+		}
+		// prepend like the text parser does, so both give the same list order
+		for ( j = 0; j < num; j++ ) {
+			idReachability reach;
+			fp->ReadInt( reach.travelType );
+			fp->ReadShort( reach.toAreaNum );
+			fp->ReadVec3( reach.start );
+			fp->ReadVec3( reach.end );
+			fp->ReadInt( reach.edgeNum );
+			fp->ReadUnsignedShort( reach.travelTime );
+			if ( reach.toAreaNum < 0 || reach.toAreaNum >= areas.Num() ) {
+				ok = false;
+				break;
+			}
+			if ( reach.travelType == TFL_SPECIAL ) {
+				newReach = special = new idReachability_Special();
+				if ( fp->ReadInt( numKeyVals ) != sizeof( numKeyVals ) || numKeyVals < 0 || numKeyVals > fp->Length() - fp->Tell() ) {
+					numKeyVals = 0;
+					ok = false;
+				}
+				for ( int k = 0; k < numKeyVals; k++ ) {
+					fp->ReadString( key );
+					fp->ReadString( value );
+					special->dict.Set( key, value );
+				}
+			} else {
+				newReach = new idReachability();
+			}
+			newReach->CopyBase( reach );
+			newReach->fromAreaNum = i;
+			newReach->next = area.reach;
+			area.reach = newReach;
+		}
+	}
+
+	delete fp;
+	fileSystem->FreeFile( buffer );
+
+	if ( !ok ) {
+		common->Warning( "%s is damaged, using the text file", binaryName.c_str() );
+		DeleteReachabilities();
+		Clear();
+		return false;
+	}
+
+	LinkReversedReachability();
+
+	depth = MaxTreeDepth();
+	if ( depth > MAX_AAS_TREE_DEPTH ) {
+		common->Warning( "idAASFileLocal::LoadBinary: tree depth = %d", depth );
+	}
+
+	return true;
+}
+
 /*
 ================
 idAASFileLocal::ParseIndex
@@ -1101,6 +1390,12 @@ bool idAASFileLocal::Load( const idStr &fileName, const unsigned int mapFileCRC
 	common->Printf( "[Load AAS]\n" );
 	common->Printf( "loading %s\n", name.c_str() );
 
+	// the binary file can only be validated against the map it belongs to
+	if ( mapFileCRC && LoadBinary( fileName, mapFileCRC ) ) {
+		common->Printf( "done.\n" );
+		return true;
+	}
+
 	if ( !src.LoadFile( name ) ) {
 		return false;
 	}
@@ -1184,6 +1479,11 @@ bool idAASFileLocal::Load( const idStr &fileName, const unsigned int mapFileCRC
 		src.Error( "idAASFileLocal::Load: tree depth = %d", depth );
 	}
 
+	// write the binary file for the next load
+	if ( mapFileCRC ) {
+		WriteBinary( fileName, mapFileCRC );
+	}
+
 	common->Printf( "done.\n" );
 
 	return true;
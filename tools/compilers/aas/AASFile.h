@@ -31,6 +31,10 @@
 #define AAS_FILEID					"DewmAAS"
 #define AAS_FILEVERSION				"1.07"
 
+// the binary copy is stored next to the text file with a 'b' appended to the extension
+#define AAS_BINARY_FILEID			"DewmAASB"
+#define AAS_BINARY_FILEVERSION		1
+
 // travel flags
 #define TFL_INVALID					BIT(0)		// not valid
 #define TFL_WALK					BIT(1)		// walking
@@ -78,6 +78,9 @@ private:
 	bool						ParsePortals( idLexer &src );
 	bool						ParseClusters( idLexer &src );
 
+	bool						LoadBinary( const idStr &fileName, const unsigned int mapFileCRC );
+	bool						WriteBinary( const idStr &fileName, const unsigned int mapFileCRC );
+
 private:
 	int							BoundsReachableAreaNum_r( int nodeNum, const idBounds &bounds, const int areaFlags, const int excludeTravelFlags ) const;
 	void						MaxTreeDepth_r( int nodeNum, int &depth, int &maxDepth ) const;
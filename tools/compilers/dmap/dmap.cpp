@@ -368,6 +368,19 @@ void Dmap( const idCmdArgs &args ) {
 			common->Printf( "%5.0f seconds to create collision map\n", ( end - start ) * 0.001f );
 		}
 
+		if ( r_useBinaryProc.GetBool() ) {
+			// loading the new .proc into a render world writes the binary .procb
+			start = Sys_Milliseconds();
+
+			idRenderWorld *world = renderSystem->AllocRenderWorld();
+			world->InitFromMap( dmapGlobals.mapFileBase );
+			renderSystem->FreeRenderWorld( world );
+
+			end = Sys_Milliseconds();
+			common->Printf( "-------------------------------------\n" );
+			common->Printf( "%5.0f seconds to create binary .procb\n", ( end - start ) * 0.001f );
+		}
+
 		if ( !noAAS && !region ) {
 			// create AAS files
 			RunAAS_f( args );